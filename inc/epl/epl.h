@@ -23,13 +23,34 @@
 //#include "swig_help.h"		// Macros for SWIG processing
 
 #include "epl_core.h"		// Core/General API definitions/prototypes
+#include "epl_mdio.h"		// MDIO scheduler definitions/prototypes
+#include "epl_trace.h"		// Register trace definitions/prototypes
 //#include "epl_bist.h"		// BIST API definitions/prototypes
 #include "epl_link.h"		// Link API definitions/prototypes
 //#include "epl_miiconfig.h"	// MII config API definitions/prototypes
-//#include "epl_quality.h"	// Link Quality API definitions/prototypes
-//#include "epl_tdr.h"		// TDR API definitions/prototypes
+#include "epl_quality.h"	// Link Quality API definitions/prototypes
+#include "epl_tdr.h"		// TDR API definitions/prototypes
+#include "epl_errcnt.h"		// Error counter API definitions/prototypes
 
+#include "epl_time.h"		// PTP time arithmetic
 #include "epl_1588.h"		// PTP protocol related API definitions/prototypes
+#include "epl_e2e.h"		// End-to-end delay mechanism definitions/prototypes
+#include "epl_p2p.h"		// Peer delay mechanism definitions/prototypes
+#include "epl_tc.h"			// Transparent clock definitions/prototypes
+#include "epl_bsync.h"		// Board clock synchronizer definitions/prototypes
+#include "epl_slew.h"		// Slew planner definitions/prototypes
+#include "epl_holdover.h"	// Holdover definitions/prototypes
+#include "epl_checkpoint.h"	// Servo checkpoint definitions/prototypes
+#include "epl_xts.h"		// Cross-timestamping definitions/prototypes
+#include "epl_onestep.h"	// One-step Sync transmit definitions/prototypes
+#include "epl_ntp.h"		// NTP timestamping definitions/prototypes
+#include "epl_stability.h"	// Clock stability analysis definitions/prototypes
+#include "epl_pdv.h"		// PDV filter definitions/prototypes
+#include "epl_phc.h"		// PHC style clock adapter definitions/prototypes
+#include "epl_tsd.h"		// Timestamp delivery manager definitions/prototypes
+#include "epl_demux.h"		// PTP domain demultiplexer definitions/prototypes
+
+#include "epl_sim.h"		// Simulated PHY model (EPL_SIMULATION builds only)
 
 // Other modules for the DLL
 //#include "ifGenMAC.h"		// Interface for generic MAC - Not filled in/used
@@ -79,7 +79,7 @@ typedef struct RX_CFG_ITEMS
     NS_UINT tsMinIFG;
     NS_UINT srcIdHash;
     NS_UINT ptpDomain;
-    NS_UINT tsSecLen;
+    NS_UINT tsSecLen;           // Inserted seconds, 0 - 3 = 1 - 4 octets
     NS_UINT rxTsNanoSecOffset;
     NS_UINT rxTsSecondsOffset;
 } RX_CFG_ITEMS;
@@ -150,6 +150,27 @@ typedef struct PHYMSG_LIST {
 
 #define PTP_EVENT_PACKET_LENGTH         93
 
+// PTP version 2 message types and common header layout
+#define PTP_MSG_SYNC                    0x0
+#define PTP_MSG_DELAY_REQ               0x1
+#define PTP_MSG_PDELAY_REQ              0x2
+#define PTP_MSG_PDELAY_RESP             0x3
+#define PTP_MSG_FOLLOW_UP               0x8
+#define PTP_MSG_DELAY_RESP              0x9
+#define PTP_MSG_PDELAY_RESP_FOLLOW_UP   0xA
+#define PTP_MSG_ANNOUNCE                0xB
+
+#define PTP_HDR_MSG_TYPE_OFFSET         0       // Low nibble
+#define PTP_HDR_DOMAIN_OFFSET           4
+#define PTP_HDR_FLAGS_OFFSET            6
+#define PTP_FLAG_TWO_STEP               0x02    // In the first flags byte
+#define PTP_HDR_CORRECTION_OFFSET       8       // 64-bit scaled ns
+#define PTP_HDR_SOURCE_PORT_ID_OFFSET   20
+#define PTP_HDR_SEQUENCE_ID_OFFSET      30
+#define PTP_HDR_LENGTH                  34
+#define PTP_REQ_PORT_ID_OFFSET          44      // requestingPortIdentity
+#define PTP_PORT_ID_LENGTH              10
+
 // EPL Function Prototypes
 #ifdef __cplusplus
 extern "C" {
@@ -325,6 +346,34 @@ EXPORT void
         IN OUT NS_UINT32 *retNumberOfSeconds,
         IN OUT NS_UINT32 *retNumberOfNanoSeconds);
 
+EXPORT NS_STATUS
+    PTPGetTimestampsFromFrames (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_UINT8 **receiveFrameData,
+        IN NS_UINT numFrames,
+        OUT NS_UINT64 *retTimes);
+
+EXPORT void
+    PTPSetTimestampReference (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_UINT64 numberOfSeconds,
+        IN NS_UINT32 numberOfNanoSeconds);
+
+EXPORT NS_STATUS
+    PTPExtendTimestamp (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_UINT32 partialSeconds,
+        IN NS_UINT secondsBits,
+        IN NS_UINT32 numberOfNanoSeconds,
+        OUT NS_UINT64 *retNumberOfSeconds);
+
+EXPORT NS_STATUS
+    PTPGetFullTimestampFromFrame (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_UINT8 *receiveFrameData,
+        OUT NS_UINT64 *retNumberOfSeconds,
+        OUT NS_UINT32 *retNumberOfNanoSeconds);
+
 EXPORT NS_BOOL
     PTPGetEvent (
         IN PEPL_PORT_HANDLE portHandle,
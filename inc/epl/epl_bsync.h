@@ -0,0 +1,129 @@
+//****************************************************************************
+// epl_bsync.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// This file contains all of the board clock synchronizer related
+// definitions and prototypes
+//
+//****************************************************************************
+
+#ifndef _EPL_BSYNC_INCLUDE
+#define _EPL_BSYNC_INCLUDE
+
+#include "epl.h"
+
+// Follower PHYs per synchronizer
+#define BSYNC_MAX_FOLLOWERS     15
+
+// Largest rate adjustment, in ppb. PTP_RATEH/L hold 2^26-1 units of
+// 2^-32ns per 8ns cycle, about 1950ppm.
+#define BSYNC_MAX_PPB           1900000
+
+// PTPGetEvent() eventsMissed sticks at this value, the number of edges
+// lost is unknown from there
+#define BSYNC_MISSED_SATURATED  7
+
+// Rate adjustment units (2^-32ns per 8ns reference cycle) for ppb:
+// ppb * 8 * 2^32 / 10^9 = ppb * 2^26 / 1953125
+#define BSYNC_PPB_TO_RATE(ppb)  ((NS_UINT32)(((NS_UINT64)(ppb) << 26) / 1953125))
+
+typedef struct EPL_BSYNC_CFG {
+    NS_UINT trigger;            // Leader trigger, 0 - 7 (0 or 1 recommended)
+    NS_UINT triggerGpio;        // GPIO driven by the leader trigger, 1 - 12
+    NS_UINT event;              // Follower event, 0 - 7
+    NS_UINT32 periodNs;         // Trigger period, must divide 10^9
+    NS_SINT32 kp;               // Proportional gain, ppb per ns / 1024
+    NS_SINT32 ki;               // Integral gain, ppb per ns / 1024
+    NS_UINT32 stepThresholdNs;  // Larger offsets are stepped out
+} EPL_BSYNC_CFG, *PEPL_BSYNC_CFG;
+
+typedef struct EPL_BSYNC_STATS {
+    NS_UINT32 samples;          // Offset measurements
+    NS_UINT32 steps;            // Step adjustments made
+    NS_UINT32 secondErrors;     // Edges the follower was whole seconds off
+    NS_UINT32 missed;           // Events lost to event queue overflow
+    NS_SINT32 lastOffsetNs;     // Follower - leader at the last edge,
+                                // saturated for whole second errors
+    NS_SINT32 minOffsetNs;      // Since the last reset, excluding steps
+    NS_SINT32 maxOffsetNs;
+    NS_SINT64 sumOffsetNs;      // For the mean
+    NS_UINT64 sumSquaresNs;     // For the RMS
+    NS_SINT32 freqPpb;          // Current rate adjustment
+} EPL_BSYNC_STATS, *PEPL_BSYNC_STATS;
+
+typedef struct EPL_BSYNC_FOLLOWER {
+    PEPL_PORT_HANDLE portHandle;
+    NS_UINT eventGpio;          // GPIO the trigger signal is wired to
+    NS_SINT64 drift;            // Integral term, ppb * 1024
+    NS_BOOL stepped;            // Last sample was stepped out
+    PTP_TIME lastEdge;          // Leader time of the previous edge
+    NS_BOOL haveEdge;           // lastEdge is known
+    EPL_BSYNC_STATS stats;
+} EPL_BSYNC_FOLLOWER;
+
+typedef struct EPL_BSYNC {
+    EPL_BSYNC_CFG cfg;
+    PEPL_PORT_HANDLE leader;
+    NS_UINT numFollowers;
+    EPL_BSYNC_FOLLOWER follower[BSYNC_MAX_FOLLOWERS];
+} EPL_BSYNC, *PEPL_BSYNC;
+
+// EPL Function Prototypes
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+EXPORT void
+    EPLBSyncGetDefaultConfig (
+        IN OUT PEPL_BSYNC_CFG syncConfig);
+
+EXPORT NS_STATUS
+    EPLBSyncInit (
+        IN OUT PEPL_BSYNC sync,
+        IN PEPL_PORT_HANDLE leader,
+        IN PEPL_BSYNC_CFG syncConfig);
+
+EXPORT NS_STATUS
+    EPLBSyncAddFollower (
+        IN OUT PEPL_BSYNC sync,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_UINT eventGpio,
+        OUT NS_UINT *index);
+
+EXPORT NS_STATUS
+    EPLBSyncStart (
+        IN OUT PEPL_BSYNC sync);
+
+EXPORT void
+    EPLBSyncStop (
+        IN OUT PEPL_BSYNC sync);
+
+EXPORT NS_UINT
+    EPLBSyncPoll (
+        IN OUT PEPL_BSYNC sync);
+
+EXPORT NS_BOOL
+    EPLBSyncEventSample (
+        IN OUT PEPL_BSYNC sync,
+        IN NS_UINT index,
+        IN NS_UINT32 eventSeconds,
+        IN NS_UINT32 eventNanoSeconds,
+        IN NS_UINT eventsMissed);
+
+EXPORT NS_STATUS
+    EPLBSyncGetStats (
+        IN PEPL_BSYNC sync,
+        IN NS_UINT index,
+        OUT PEPL_BSYNC_STATS stats);
+
+EXPORT void
+    EPLBSyncResetStats (
+        IN OUT PEPL_BSYNC sync);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _EPL_BSYNC_INCLUDE
@@ -0,0 +1,67 @@
+//****************************************************************************
+// epl_checkpoint.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// This file contains all of the servo checkpoint and warm start related
+// definitions and prototypes
+//
+//****************************************************************************
+
+#ifndef _EPL_CHECKPOINT_INCLUDE
+#define _EPL_CHECKPOINT_INCLUDE
+
+#include "epl.h"
+
+#define CKPT_MAGIC              0x434B5054  // "CKPT"
+
+// PTP configuration registers kept in a checkpoint (page 5 and 6)
+#define CKPT_NUM_REGS           21
+
+typedef struct EPL_CHECKPOINT {
+    NS_UINT32 magic;            // CKPT_MAGIC
+    NS_UINT32 rate;             // PTP_RATEH (upper 16 bits) and PTP_RATEL
+    NS_SINT64 integrator;       // Servo integrator, in the servo's units
+    NS_SINT64 meanPathDelay;    // Scaled ns
+
+    // Configuration shadow: register values in page order and the port
+    // object fields set by the configuration functions
+    NS_UINT16 regs[CKPT_NUM_REGS];
+    NS_UINT32 rxConfigOptions;
+    NS_UINT32 psfConfigOptions;
+    NS_UINT8 tsSecondsLen;
+    NS_UINT8 rxTsNanoSecOffset;
+    NS_UINT8 rxTsSecondsOffset;
+    NS_UINT8 rxTsNanoField;
+    NS_UINT8 rxTsSecField;
+    NS_UINT8 rxTsSecBytes;
+    NS_UINT8 psfSrcMacAddr[6];
+
+    NS_UINT32 check;            // Ones complement of the byte sum of the above
+} EPL_CHECKPOINT, *PEPL_CHECKPOINT;
+
+// EPL Function Prototypes
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+EXPORT NS_STATUS
+    EPLCheckpointSave (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_SINT64 integrator,
+        IN NS_SINT64 meanPathDelay,
+        OUT PEPL_CHECKPOINT checkpoint);
+
+EXPORT NS_STATUS
+    EPLCheckpointWarmStart (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN PEPL_CHECKPOINT checkpoint,
+        OUT NS_SINT64 *integrator,
+        OUT NS_SINT64 *meanPathDelay);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _EPL_CHECKPOINT_INCLUDE
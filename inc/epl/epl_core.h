@@ -29,6 +29,14 @@ EXPORT void
         IN NS_UINT registerIndex,
         IN NS_UINT value);
 
+EXPORT void
+    EPLInvalidatePageCache(
+        IN PEPL_PORT_HANDLE portHandle);
+
+EXPORT NS_UINT32
+    EPLGetMdioAccessCount(
+        IN PEPL_PORT_HANDLE portHandle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,192 @@
+//****************************************************************************
+// epl_demux.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// This file contains all of the PTP domain demultiplexer related
+// definitions and prototypes
+//
+//****************************************************************************
+
+#ifndef _EPL_DEMUX_INCLUDE
+#define _EPL_DEMUX_INCLUDE
+
+#include "epl.h"
+
+// Domains followed at the same time, and foreign masters remembered per
+// domain
+#define DEMUX_MAX_DOMAINS       4
+#define DEMUX_MAX_FOREIGN       4
+
+// Transmitted event messages awaiting their timestamp
+#define DEMUX_TX_QUEUE          8
+
+// EPL_DEMUX.slot[] value of domains not followed
+#define DEMUX_NO_SLOT           0xFF
+
+typedef struct EPL_DEMUX_FOREIGN {
+    NS_UINT8 portIdentity[PTP_PORT_ID_LENGTH];
+    NS_UINT8 priority1;         // From the last Announce
+    NS_UINT8 clockClass;
+    NS_UINT8 clockAccuracy;
+    NS_UINT16 offsetScaledLogVariance;
+    NS_UINT8 priority2;
+    NS_UINT16 stepsRemoved;
+    NS_UINT32 announces;        // Announce messages received
+    NS_UINT32 lastSeen;         // OAIGetTimeStamp() of the last Announce
+} EPL_DEMUX_FOREIGN, *PEPL_DEMUX_FOREIGN;
+
+// Offset samples of a domain, e.g. for that domain's servo
+typedef void (*EPL_DEMUX_CALLBACK)(
+    IN void *context,
+    IN NS_UINT8 domainNumber,
+    IN PEPL_E2E_SAMPLE sample);
+
+typedef struct EPL_DEMUX_DOMAIN {
+    NS_UINT8 domainNumber;
+    NS_BOOL active;
+    EPL_E2E_ENGINE e2e;         // Outstanding exchanges and path delay
+    EPL_DEMUX_FOREIGN foreign[DEMUX_MAX_FOREIGN];
+    NS_UINT numForeign;
+    EPL_DEMUX_CALLBACK callback;
+    void *context;
+
+    // Master selected with EPLDemuxSelectMaster(). Messages of other
+    // sources (except Announce) are ignored.
+    NS_BOOL haveMaster;
+    NS_UINT8 masterIdentity[PTP_PORT_ID_LENGTH];
+    NS_UINT masterHash;         // PTPCalcSourceIdHash() of masterIdentity
+
+    // Statistics
+    NS_UINT32 rxMessages;
+    NS_UINT32 notSelected;      // Messages of masters not selected
+    NS_UINT32 masterChanges;
+    NS_UINT32 txTimestamps;
+    NS_UINT32 samples;
+} EPL_DEMUX_DOMAIN, *PEPL_DEMUX_DOMAIN;
+
+typedef struct EPL_DEMUX_TX {
+    NS_UINT8 slot;              // domains[] index at transmit time
+    NS_UINT8 domainNumber;
+    NS_UINT8 messageType;
+    NS_UINT16 sequenceId;
+} EPL_DEMUX_TX;
+
+typedef struct EPL_DEMUX {
+    PEPL_PORT_HANDLE portHandle;
+    PEPL_TSD tsd;               // Timestamp source, NULL if the caller
+                                // passes the timestamps
+    NS_UINT8 portIdentity[PTP_PORT_ID_LENGTH];
+    NS_BOOL checkPortIdentity;  // Delay_Resp requestingPortIdentity check
+    NS_SINT32 rxLatencyNs;      // Wire to receive timestamp point
+    NS_SINT32 txLatencyNs;      // Transmit timestamp point to wire
+
+    // Domain number to domains[] index, DEMUX_NO_SLOT if not followed
+    NS_UINT8 slot[256];
+    EPL_DEMUX_DOMAIN domains[DEMUX_MAX_DOMAINS];
+    NS_UINT numActive;
+
+    // Event messages transmitted, oldest first
+    EPL_DEMUX_TX txQueue[DEMUX_TX_QUEUE];
+    NS_UINT txHead;
+    NS_UINT txCount;
+
+    // Hardware domain filter (RXOPT_DOMAIN_EN), on while one domain is
+    // followed
+    NS_BOOL hwFilter;
+    NS_UINT8 hwDomain;
+
+    // Source port identity hash filter (RXOPT_SRC_ID_HASH_EN), on while one
+    // domain is followed and its master selected, see
+    // EPLDemuxSetMasterFilter()
+    NS_BOOL hashManaged;
+    NS_UINT32 hashHoldUs;       // Filter off after a master change
+    NS_BOOL hashTransition;
+    NS_UINT32 hashTransitionStart;  // OAIGetTimeStamp()
+    NS_BOOL hashFilter;
+    NS_UINT hashValue;          // Programmed in PTP_RXHASH
+
+    // Statistics
+    NS_UINT32 otherDomain;      // Messages of domains not followed
+    NS_UINT32 txUnmatched;      // Transmit timestamps without a message
+    NS_UINT32 txDropped;        // Messages lost from a full txQueue
+    NS_UINT32 filterWrites;     // Hardware filter reprogrammed
+    NS_UINT32 hashWrites;       // Hash filter reprogrammed
+    NS_UINT32 suppressed;       // Unwanted receive timestamps the hash
+                                // filter kept the PHY from taking
+} EPL_DEMUX, *PEPL_DEMUX;
+
+// EPL Function Prototypes
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+EXPORT void
+    EPLDemuxInit (
+        IN OUT PEPL_DEMUX demux,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN PEPL_TSD tsd,
+        IN NS_UINT8 *portIdentity);
+
+EXPORT void
+    EPLDemuxSetPortLatency (
+        IN OUT PEPL_DEMUX demux,
+        IN NS_SINT32 rxLatencyNs,
+        IN NS_SINT32 txLatencyNs);
+
+EXPORT NS_STATUS
+    EPLDemuxAddDomain (
+        IN OUT PEPL_DEMUX demux,
+        IN NS_UINT8 domainNumber,
+        IN EPL_DEMUX_CALLBACK callback,
+        IN void *context);
+
+EXPORT NS_STATUS
+    EPLDemuxRemoveDomain (
+        IN OUT PEPL_DEMUX demux,
+        IN NS_UINT8 domainNumber);
+
+EXPORT PEPL_DEMUX_DOMAIN
+    EPLDemuxGetDomain (
+        IN PEPL_DEMUX demux,
+        IN NS_UINT8 domainNumber);
+
+EXPORT void
+    EPLDemuxSetMasterFilter (
+        IN OUT PEPL_DEMUX demux,
+        IN NS_BOOL enable,
+        IN NS_UINT32 holdUs);
+
+EXPORT NS_STATUS
+    EPLDemuxSelectMaster (
+        IN OUT PEPL_DEMUX demux,
+        IN NS_UINT8 domainNumber,
+        IN NS_UINT8 *portIdentity);
+
+EXPORT NS_STATUS
+    EPLDemuxReceive (
+        IN OUT PEPL_DEMUX demux,
+        IN OUT NS_UINT8 *ptpMessage,
+        IN NS_UINT length,
+        IN PPTP_TIME rxTime);
+
+EXPORT void
+    EPLDemuxTransmitted (
+        IN OUT PEPL_DEMUX demux,
+        IN NS_UINT8 *ptpMessage);
+
+EXPORT NS_STATUS
+    EPLDemuxTxTimestamp (
+        IN OUT PEPL_DEMUX demux,
+        IN PPTP_TIME txTime);
+
+EXPORT NS_UINT
+    EPLDemuxService (
+        IN OUT PEPL_DEMUX demux);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _EPL_DEMUX_INCLUDE
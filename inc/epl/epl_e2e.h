@@ -0,0 +1,145 @@
+//****************************************************************************
+// epl_e2e.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// This file contains all of the end-to-end (delay request/response) delay
+// mechanism related definitions and prototypes
+//
+//****************************************************************************
+
+#ifndef _EPL_E2E_INCLUDE
+#define _EPL_E2E_INCLUDE
+
+#include "epl.h"
+
+// Outstanding exchanges tracked per engine, must be a power of 2. At 128
+// Sync/s a slot is reused after 125ms.
+#define E2E_TABLE_SIZE          16
+
+// Time intervals are kept in scaled nanoseconds (ns * 2^16), the format of
+// the PTP correctionField
+#define E2E_SCALED_NS_SHIFT     16
+#define E2E_NS_TO_SCALED(ns)    ((NS_SINT64)(ns) * (1 << E2E_SCALED_NS_SHIFT))
+#define E2E_SCALED_TO_NS(sns)   ((sns) / (1 << E2E_SCALED_NS_SHIFT))
+
+// EPL_E2E_SLOT flags
+#define E2E_HAVE_T1             0x0001  // Sync: origin timestamp known
+#define E2E_HAVE_T2             0x0002  // Sync: receive timestamp known
+#define E2E_HAVE_T3             0x0001  // Delay_Req: transmit timestamp known
+#define E2E_HAVE_T4             0x0002  // Delay_Req: master receive time known
+#define E2E_COMPLETE            0x0003
+
+typedef enum EPL_E2E_FILTER_ENUM {
+    E2E_FILTER_DELAY,           // Applied to each mean path delay measurement
+    E2E_FILTER_OFFSET,          // Applied to each offset from master sample
+    E2E_NUM_FILTERS
+} EPL_E2E_FILTER_ENUM;
+
+// Filter hook. May replace *value with a filtered value; returns FALSE to
+// discard the measurement.
+typedef NS_BOOL (*EPL_E2E_FILTER)(
+    IN OUT void *context,
+    IN OUT NS_SINT64 *value);
+
+typedef struct EPL_E2E_SLOT {
+    NS_UINT16 sequenceId;
+    NS_UINT16 flags;
+    NS_UINT32 seconds[2];       // Sync: t1, t2    Delay_Req: t3, t4
+    NS_UINT32 nanoSeconds[2];
+    NS_SINT64 correction;       // Scaled ns, summed correctionFields
+} EPL_E2E_SLOT;
+
+typedef struct EPL_E2E_SAMPLE {
+    NS_UINT16 sequenceId;       // Sync sequenceId
+    NS_UINT32 rxSeconds;        // Local receive time of the Sync (t2)
+    NS_UINT32 rxNanoSeconds;
+    NS_SINT64 offset;           // Offset from master, scaled ns
+    NS_SINT64 meanPathDelay;    // Mean path delay used, scaled ns
+} EPL_E2E_SAMPLE, *PEPL_E2E_SAMPLE;
+
+typedef struct EPL_E2E_STATS {
+    NS_UINT32 syncs;            // Completed t1/t2 pairs
+    NS_UINT32 delays;           // Completed t3/t4 pairs
+    NS_UINT32 offsetsRejected;  // Discarded by the offset filter
+    NS_UINT32 delaysRejected;   // Discarded by the delay filter or negative
+    NS_UINT32 overwritten;      // Incomplete exchanges lost to slot reuse
+    NS_UINT32 unmatched;        // Inputs for a sequenceId no longer tracked
+} EPL_E2E_STATS, *PEPL_E2E_STATS;
+
+typedef struct EPL_E2E_ENGINE {
+    EPL_E2E_SLOT syncTable[E2E_TABLE_SIZE];
+    EPL_E2E_SLOT delayTable[E2E_TABLE_SIZE];
+    NS_SINT64 masterToSlave;    // Latest t2 - t1 - correction, scaled ns
+    NS_BOOL haveMasterToSlave;
+    NS_SINT64 meanPathDelay;    // Filtered, scaled ns
+    NS_BOOL haveDelay;
+    EPL_E2E_SAMPLE last;        // Most recent accepted sample
+    NS_BOOL haveSample;         // last is from the most recent Sync
+    EPL_E2E_FILTER filter[E2E_NUM_FILTERS];
+    void *filterContext[E2E_NUM_FILTERS];
+    EPL_E2E_STATS stats;
+} EPL_E2E_ENGINE, *PEPL_E2E_ENGINE;
+
+// EPL Function Prototypes
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+EXPORT void
+    EPLE2EInit (
+        IN OUT PEPL_E2E_ENGINE engine);
+
+EXPORT void
+    EPLE2ESetFilter (
+        IN OUT PEPL_E2E_ENGINE engine,
+        IN EPL_E2E_FILTER_ENUM which,
+        IN EPL_E2E_FILTER filter,
+        IN void *context);
+
+EXPORT void
+    EPLE2ESetMeanPathDelay (
+        IN OUT PEPL_E2E_ENGINE engine,
+        IN NS_SINT64 meanPathDelay);
+
+EXPORT NS_BOOL
+    EPLE2ESyncReceived (
+        IN OUT PEPL_E2E_ENGINE engine,
+        IN NS_UINT16 sequenceId,
+        IN NS_UINT32 rxSeconds,
+        IN NS_UINT32 rxNanoSeconds);
+
+EXPORT NS_BOOL
+    EPLE2ESyncOrigin (
+        IN OUT PEPL_E2E_ENGINE engine,
+        IN NS_UINT16 sequenceId,
+        IN NS_UINT32 originSeconds,
+        IN NS_UINT32 originNanoSeconds,
+        IN NS_SINT64 correction);
+
+EXPORT void
+    EPLE2EDelayReqSent (
+        IN OUT PEPL_E2E_ENGINE engine,
+        IN NS_UINT16 sequenceId,
+        IN NS_UINT32 txSeconds,
+        IN NS_UINT32 txNanoSeconds);
+
+EXPORT NS_BOOL
+    EPLE2EDelayResp (
+        IN OUT PEPL_E2E_ENGINE engine,
+        IN NS_UINT16 sequenceId,
+        IN NS_UINT32 rxSeconds,
+        IN NS_UINT32 rxNanoSeconds,
+        IN NS_SINT64 correction);
+
+EXPORT NS_BOOL
+    EPLE2EGetSample (
+        IN PEPL_E2E_ENGINE engine,
+        OUT PEPL_E2E_SAMPLE sample);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _EPL_E2E_INCLUDE
@@ -0,0 +1,102 @@
+//****************************************************************************
+// epl_errcnt.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// This file contains all of the receive error counter harvesting related
+// definitions and prototypes
+//
+//****************************************************************************
+
+#ifndef _EPL_ERRCNT_INCLUDE
+#define _EPL_ERRCNT_INCLUDE
+
+#include "epl.h"
+
+// Maximum number of ports a single harvester object can service
+#define ERRCNT_MAX_PORTS        8
+
+// Number of harvest intervals kept per port
+#define ERRCNT_HISTORY_LEN      32
+
+// Largest value of the 8-bit hardware counters, they stick at this value
+#define ERRCNT_HW_MAX           0xFF
+
+typedef enum EPL_ERRCNT_ENUM {
+    ERRCNT_FALSE_CARRIER,       // PHY_FCSCR false carrier events
+    ERRCNT_RX_ERROR,            // PHY_RECR receive error events
+    ERRCNT_NUM_COUNTERS
+} EPL_ERRCNT_ENUM;
+
+typedef struct EPL_ERRCNT_SAMPLE {
+    NS_UINT32 timeStamp;        // OAIGetTimeStamp() when harvested
+    NS_UINT32 intervalUs;       // Time since the previous harvest
+    NS_UINT16 delta[ERRCNT_NUM_COUNTERS];
+    NS_UINT16 saturated;        // Bit per counter, set if the hardware counter
+                                // was stuck at ERRCNT_HW_MAX (count is a minimum)
+} EPL_ERRCNT_SAMPLE, *PEPL_ERRCNT_SAMPLE;
+
+typedef struct EPL_ERRCNT_PORT {
+    PEPL_PORT_HANDLE portHandle;
+    NS_UINT64 total[ERRCNT_NUM_COUNTERS];
+    NS_UINT32 saturations[ERRCNT_NUM_COUNTERS]; // Harvests that found a stuck counter
+    EPL_ERRCNT_SAMPLE history[ERRCNT_HISTORY_LEN];
+    NS_UINT historyHead;        // Next history slot to write
+    NS_UINT historyCount;       // Valid history entries
+} EPL_ERRCNT_PORT;
+
+typedef struct EPL_ERRCNT_HARVESTER {
+    EPL_ERRCNT_PORT ports[ERRCNT_MAX_PORTS];
+    NS_UINT numPorts;
+    NS_UINT32 lastHarvestTime;
+    NS_UINT32 harvests;
+} EPL_ERRCNT_HARVESTER, *PEPL_ERRCNT_HARVESTER;
+
+// EPL Function Prototypes
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+EXPORT void
+    EPLErrCntInit (
+        IN OUT PEPL_ERRCNT_HARVESTER harvester);
+
+EXPORT NS_STATUS
+    EPLErrCntAddPort (
+        IN OUT PEPL_ERRCNT_HARVESTER harvester,
+        IN PEPL_PORT_HANDLE portHandle);
+
+EXPORT void
+    EPLErrCntHarvest (
+        IN OUT PEPL_ERRCNT_HARVESTER harvester);
+
+EXPORT NS_UINT64
+    EPLErrCntGetTotal (
+        IN PEPL_ERRCNT_HARVESTER harvester,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN EPL_ERRCNT_ENUM counter);
+
+EXPORT NS_STATUS
+    EPLErrCntGetHistory (
+        IN PEPL_ERRCNT_HARVESTER harvester,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_UINT age,
+        OUT PEPL_ERRCNT_SAMPLE sample);
+
+EXPORT NS_UINT32
+    EPLErrCntGetRate (
+        IN PEPL_ERRCNT_HARVESTER harvester,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN EPL_ERRCNT_ENUM counter,
+        IN NS_UINT numIntervals);
+
+EXPORT void
+    EPLErrCntClear (
+        IN OUT PEPL_ERRCNT_HARVESTER harvester);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _EPL_ERRCNT_INCLUDE
@@ -0,0 +1,143 @@
+//****************************************************************************
+// epl_holdover.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// This file contains all of the holdover related definitions and
+// prototypes
+//
+//****************************************************************************
+
+#ifndef _EPL_HOLDOVER_INCLUDE
+#define _EPL_HOLDOVER_INCLUDE
+
+#include "epl.h"
+
+// Servo rate samples the frequency model is fitted to
+#define HOLDOVER_HISTORY        64
+
+// Learning restarts if the history would span more seconds than this, or
+// a rate differs from the first one of the history by more than
+// HOLDOVER_MAX_DEVIATION (2^-32ns per cycle, about 490ppm)
+#define HOLDOVER_MAX_SPAN       65535
+#define HOLDOVER_MAX_DEVIATION  0x00FFFFFF
+
+// Largest rate adjustment (PTP_RATEH/L), 2^-32ns per 8ns cycle
+#define HOLDOVER_MAX_RATE       0x03FFFFFF
+
+// Largest drift used, 2^-16 units of 2^-32ns per cycle per second (about
+// 7ppb/s)
+#define HOLDOVER_MAX_DRIFT      0x01000000
+
+#define HOLDOVER_STATE_MAGIC    0x484F4C44  // "HOLD"
+
+typedef struct EPL_HOLDOVER_CFG {
+    NS_UINT minSamples;         // Samples needed to fit a drift, 3 or more
+    NS_UINT32 updateInterval;   // Seconds between rate updates in holdover
+    NS_UINT32 maxDriftSeconds;  // Drift is extrapolated for at most this
+                                // long, then the rate is held
+} EPL_HOLDOVER_CFG, *PEPL_HOLDOVER_CFG;
+
+// Learned frequency, to be kept across restarts, see EPLHoldoverSave()
+typedef struct EPL_HOLDOVER_STATE {
+    NS_UINT32 magic;            // HOLDOVER_STATE_MAGIC
+    NS_UINT32 time;             // Clock seconds the state was saved at
+    NS_SINT32 rate;             // Rate at time, 2^-32ns per cycle
+    NS_SINT32 drift;            // Rate change, 2^-16 rate units per second
+    NS_UINT32 samples;          // Samples the model was fitted to
+    NS_UINT32 check;            // Ones complement of the sum of the above
+} EPL_HOLDOVER_STATE, *PEPL_HOLDOVER_STATE;
+
+typedef struct EPL_HOLDOVER {
+    PEPL_PORT_HANDLE portHandle;
+    EPL_HOLDOVER_CFG cfg;
+
+    // Servo history and its regression sums, times relative to timeBase
+    // and rates relative to rateBase
+    NS_UINT32 sampleTime[HOLDOVER_HISTORY];
+    NS_SINT32 sampleRate[HOLDOVER_HISTORY];
+    NS_UINT head;               // Oldest sample
+    NS_UINT count;
+    NS_UINT32 timeBase;         // Time of the oldest sample
+    NS_SINT32 rateBase;
+    NS_SINT64 sumT, sumTT, sumY, sumTY;
+    NS_SINT32 lastOffsetNs;     // Servo offset of the newest sample
+
+    // Model used before enough samples are available (restored state)
+    NS_BOOL restored;
+    EPL_HOLDOVER_STATE restoredState;
+
+    // Holdover
+    NS_BOOL active;
+    NS_UINT32 startTime;
+    NS_UINT32 nextUpdate;
+    NS_UINT32 modelTime;        // Time of the newest sample
+    NS_SINT64 modelRate;        // Model rate at modelTime, 2^-16 units
+    NS_SINT64 drift;            // 2^-16 units per second
+    NS_UINT64 sigmaRate;        // Rate uncertainty at modelTime, 2^-8 units
+    NS_UINT64 sigmaDrift;       // Drift uncertainty, 2^-8 units per second
+    NS_UINT32 startErrorNs;
+    NS_SINT32 appliedRate;
+    NS_UINT32 rateUpdates;
+} EPL_HOLDOVER, *PEPL_HOLDOVER;
+
+// EPL Function Prototypes
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+EXPORT void
+    EPLHoldoverGetDefaultConfig (
+        IN OUT PEPL_HOLDOVER_CFG holdoverConfig);
+
+EXPORT NS_STATUS
+    EPLHoldoverInit (
+        IN OUT PEPL_HOLDOVER holdover,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN PEPL_HOLDOVER_CFG holdoverConfig);
+
+EXPORT void
+    EPLHoldoverAddSample (
+        IN OUT PEPL_HOLDOVER holdover,
+        IN NS_UINT32 time,
+        IN NS_SINT32 rate,
+        IN NS_SINT32 offsetNs);
+
+EXPORT NS_STATUS
+    EPLHoldoverEnter (
+        IN OUT PEPL_HOLDOVER holdover,
+        IN NS_UINT32 time);
+
+EXPORT void
+    EPLHoldoverService (
+        IN OUT PEPL_HOLDOVER holdover,
+        IN NS_UINT32 time);
+
+EXPORT NS_UINT64
+    EPLHoldoverGetTimeError (
+        IN PEPL_HOLDOVER holdover,
+        IN NS_UINT32 time);
+
+EXPORT void
+    EPLHoldoverExit (
+        IN OUT PEPL_HOLDOVER holdover);
+
+EXPORT NS_STATUS
+    EPLHoldoverSave (
+        IN PEPL_HOLDOVER holdover,
+        IN NS_UINT32 time,
+        OUT PEPL_HOLDOVER_STATE state);
+
+EXPORT NS_STATUS
+    EPLHoldoverRestore (
+        IN OUT PEPL_HOLDOVER holdover,
+        IN PEPL_HOLDOVER_STATE state,
+        IN NS_UINT32 time,
+        OUT NS_SINT32 *rate);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _EPL_HOLDOVER_INCLUDE
@@ -0,0 +1,196 @@
+//****************************************************************************
+// epl_mdio.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// This file contains all of the MDIO scheduler related definitions and
+// prototypes
+//
+//****************************************************************************
+
+#ifndef _EPL_MDIO_INCLUDE
+#define _EPL_MDIO_INCLUDE
+
+#include "epl.h"
+
+// Number of register operations needed to read one transmit timestamp,
+// one receive timestamp and one event timestamp (PTP_ESTS and at most five
+// PTP_EDATA)
+#define MDIO_TXTS_OPS           4
+#define MDIO_RXTS_OPS           6
+#define MDIO_EVENT_OPS          6
+
+// Priority classes, serviced strictly in this order
+typedef enum EPL_MDIO_CLASS_ENUM {
+    MDIO_CLASS_TIMESTAMP,       // Timestamp retrieval (TXTS/RXTS/event)
+    MDIO_CLASS_SERVO,           // Clock rate/step adjustments
+    MDIO_CLASS_MONITOR,         // Status, link quality and counter polling
+    MDIO_CLASS_CONFIG,          // Configuration
+    MDIO_NUM_CLASSES
+} EPL_MDIO_CLASS_ENUM;
+
+// EPL_MDIO_OP flags
+#define MDIO_OP_READ            0x0000
+#define MDIO_OP_WRITE           0x0001
+#define MDIO_OP_CHAIN           0x0002  // Next op runs in the same atomic group
+#define MDIO_OP_EVENT_STATUS    0x0004  // PTP_ESTS read, the request ends with
+                                        // the PTP_EDATA reads it announces
+
+typedef struct EPL_MDIO_OP {
+    NS_UINT flags;
+    NS_UINT registerIndex;      // As passed to EPLReadReg()/EPLWriteReg()
+    NS_UINT value;              // Data to write, or set to the data read
+} EPL_MDIO_OP, *PEPL_MDIO_OP;
+
+struct EPL_MDIO_REQUEST;
+
+typedef void (*EPL_MDIO_CALLBACK)(
+    IN struct EPL_MDIO_REQUEST *request,
+    IN void *context);
+
+typedef struct EPL_MDIO_REQUEST {
+    struct EPL_MDIO_REQUEST *next;
+    PEPL_PORT_HANDLE portHandle;
+    EPL_MDIO_CLASS_ENUM mdioClass;
+    PEPL_MDIO_OP ops;
+    NS_UINT numOps;
+    NS_BOOL atomic;             // Run all ops without preemption
+    EPL_MDIO_CALLBACK callback; // Called on completion, may be NULL
+    void *context;
+
+    // Maintained by the scheduler
+    NS_UINT nextOp;
+    volatile NS_BOOL done;
+    NS_UINT32 submitTime;
+} EPL_MDIO_REQUEST, *PEPL_MDIO_REQUEST;
+
+typedef struct EPL_MDIO_CLASS_STATS {
+    NS_UINT32 requests;         // Completed requests
+    NS_UINT32 operations;       // Register operations executed
+    NS_UINT64 totalQueuedUs;    // Sum of submit to first operation times
+    NS_UINT32 maxQueuedUs;      // Worst submit to first operation time
+    NS_UINT32 maxCompleteUs;    // Worst submit to completion time
+    NS_UINT32 deadlineMisses;   // Requests completed after the class deadline
+} EPL_MDIO_CLASS_STATS, *PEPL_MDIO_CLASS_STATS;
+
+typedef struct EPL_MDIO_SCHED {
+    OAI_DEV_HANDLE oaiDevHandle;
+    PEPL_MDIO_REQUEST head[MDIO_NUM_CLASSES];
+    PEPL_MDIO_REQUEST tail[MDIO_NUM_CLASSES];
+    NS_UINT32 deadlineUs[MDIO_NUM_CLASSES];     // 0 = no deadline
+    EPL_MDIO_CLASS_STATS stats[MDIO_NUM_CLASSES];
+} EPL_MDIO_SCHED, *PEPL_MDIO_SCHED;
+
+// EPL Function Prototypes
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+EXPORT void
+    EPLMdioInitScheduler (
+        IN OUT PEPL_MDIO_SCHED sched,
+        IN OAI_DEV_HANDLE oaiDevHandle);
+
+EXPORT void
+    EPLMdioSetDeadline (
+        IN OUT PEPL_MDIO_SCHED sched,
+        IN EPL_MDIO_CLASS_ENUM mdioClass,
+        IN NS_UINT32 deadlineUs);
+
+EXPORT void
+    EPLMdioInitRequest (
+        IN OUT PEPL_MDIO_REQUEST request,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN EPL_MDIO_CLASS_ENUM mdioClass,
+        IN PEPL_MDIO_OP ops,
+        IN NS_UINT numOps,
+        IN NS_BOOL atomic);
+
+EXPORT NS_STATUS
+    EPLMdioSubmit (
+        IN OUT PEPL_MDIO_SCHED sched,
+        IN OUT PEPL_MDIO_REQUEST request);
+
+EXPORT NS_UINT
+    EPLMdioService (
+        IN OUT PEPL_MDIO_SCHED sched,
+        IN NS_UINT maxGroups);
+
+EXPORT NS_STATUS
+    EPLMdioExecute (
+        IN OUT PEPL_MDIO_SCHED sched,
+        IN OUT PEPL_MDIO_REQUEST request);
+
+EXPORT void
+    EPLMdioAttachPort (
+        IN OUT PEPL_PORT_HANDLE portHandle,
+        IN PEPL_MDIO_SCHED sched);
+
+EXPORT NS_STATUS
+    EPLMdioRun (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN EPL_MDIO_CLASS_ENUM mdioClass,
+        IN OUT PEPL_MDIO_OP ops,
+        IN NS_UINT numOps,
+        IN NS_BOOL atomic);
+
+EXPORT void
+    EPLMdioPrepareTxTimestamp (
+        IN OUT PEPL_MDIO_REQUEST request,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN OUT EPL_MDIO_OP ops[MDIO_TXTS_OPS]);
+
+EXPORT void
+    EPLMdioGetTxTimestamp (
+        IN PEPL_MDIO_REQUEST request,
+        OUT NS_UINT32 *retNumberOfSeconds,
+        OUT NS_UINT32 *retNumberOfNanoSeconds,
+        OUT NS_UINT *overflowCount);
+
+EXPORT void
+    EPLMdioPrepareRxTimestamp (
+        IN OUT PEPL_MDIO_REQUEST request,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN OUT EPL_MDIO_OP ops[MDIO_RXTS_OPS]);
+
+EXPORT void
+    EPLMdioGetRxTimestamp (
+        IN PEPL_MDIO_REQUEST request,
+        OUT NS_UINT32 *retNumberOfSeconds,
+        OUT NS_UINT32 *retNumberOfNanoSeconds,
+        OUT NS_UINT *overflowCount,
+        OUT NS_UINT *sequenceId,
+        OUT NS_UINT8 *messageType,
+        OUT NS_UINT *hashValue);
+
+EXPORT void
+    EPLMdioPrepareEvent (
+        IN OUT PEPL_MDIO_REQUEST request,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN OUT EPL_MDIO_OP ops[MDIO_EVENT_OPS]);
+
+EXPORT NS_BOOL
+    EPLMdioGetEvent (
+        IN PEPL_MDIO_REQUEST request,
+        OUT NS_UINT *eventBits,
+        OUT NS_UINT *riseFlags,
+        OUT NS_UINT32 *eventTimeSeconds,
+        OUT NS_UINT32 *eventTimeNanoSeconds,
+        OUT NS_UINT *eventsMissed);
+
+EXPORT void
+    EPLMdioGetStats (
+        IN PEPL_MDIO_SCHED sched,
+        IN EPL_MDIO_CLASS_ENUM mdioClass,
+        OUT PEPL_MDIO_CLASS_STATS stats);
+
+EXPORT void
+    EPLMdioResetStats (
+        IN OUT PEPL_MDIO_SCHED sched);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _EPL_MDIO_INCLUDE
@@ -0,0 +1,149 @@
+//****************************************************************************
+// epl_ntp.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// This file contains all of the NTP hardware timestamping related
+// definitions and prototypes
+//
+//****************************************************************************
+
+#ifndef _EPL_NTP_INCLUDE
+#define _EPL_NTP_INCLUDE
+
+#include "epl.h"
+
+#define NTP_UDP_PORT                123
+#define NTP_PACKET_LENGTH           48      // NTP header, without extensions
+#define NTP_VERSION                 4
+
+// Seconds from the NTP epoch (1900) to the PTP epoch (1970)
+#define NTP_EPOCH_OFFSET            2208988800UL
+
+// NTP packet field offsets
+#define NTP_LI_VN_MODE_OFFSET       0
+#define NTP_STRATUM_OFFSET          1
+#define NTP_POLL_OFFSET             2
+#define NTP_PRECISION_OFFSET        3
+#define NTP_ROOT_DELAY_OFFSET       4
+#define NTP_ROOT_DISPERSION_OFFSET  8
+#define NTP_REF_ID_OFFSET           12
+#define NTP_REF_TS_OFFSET           16
+#define NTP_ORIGIN_TS_OFFSET        24
+#define NTP_RECEIVE_TS_OFFSET       32
+#define NTP_TRANSMIT_TS_OFFSET      40
+
+#define NTP_MODE_CLIENT             3
+#define NTP_MODE_SERVER             4
+
+// NTP 32.32 fixed point timestamp
+typedef struct EPL_NTP_TS {
+    NS_UINT32 seconds;          // Seconds since the start of the NTP era
+    NS_UINT32 fraction;         // Fraction of a second, 2^-32 units
+} EPL_NTP_TS, *PEPL_NTP_TS;
+
+// PHY 1588 clock timestamp
+typedef struct EPL_NTP_PHC_TS {
+    NS_UINT32 seconds;
+    NS_UINT32 nanoSeconds;
+} EPL_NTP_PHC_TS, *PEPL_NTP_PHC_TS;
+
+// Relation between the PHY clock and NTP time, see EPLNtpSetTimescale()
+typedef struct EPL_NTP_TIMESCALE {
+    NS_UINT32 epochOffset;      // Added to PHY clock seconds, modulo 2^32
+} EPL_NTP_TIMESCALE, *PEPL_NTP_TIMESCALE;
+
+// Server side fields of an NTP response
+typedef struct EPL_NTP_SERVER_CFG {
+    NS_UINT8 leap;              // Leap indicator, 0 - 3
+    NS_UINT8 stratum;
+    NS_SINT8 precision;         // log2 seconds
+    NS_UINT32 rootDelay;        // NTP short format, 16.16 seconds
+    NS_UINT32 rootDispersion;
+    NS_UINT32 refId;
+    EPL_NTP_TS refTime;         // Time the server clock was last set
+} EPL_NTP_SERVER_CFG, *PEPL_NTP_SERVER_CFG;
+
+// EPL Function Prototypes
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+EXPORT void
+    EPLNtpConfigure (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_BOOL ipv6);
+
+EXPORT void
+    EPLNtpSetTimescale (
+        OUT PEPL_NTP_TIMESCALE timescale,
+        IN NS_BOOL phcRunsNtp,
+        IN NS_SINT utcOffset);
+
+EXPORT void
+    EPLNtpFromPhc (
+        IN PEPL_NTP_TIMESCALE timescale,
+        IN NS_UINT32 seconds,
+        IN NS_UINT32 nanoSeconds,
+        OUT PEPL_NTP_TS ntpTime);
+
+EXPORT void
+    EPLNtpToPhc (
+        IN PEPL_NTP_TIMESCALE timescale,
+        IN PEPL_NTP_TS ntpTime,
+        OUT NS_UINT32 *seconds,
+        OUT NS_UINT32 *nanoSeconds);
+
+EXPORT void
+    EPLNtpFromPhcArray (
+        IN PEPL_NTP_TIMESCALE timescale,
+        IN EPL_NTP_PHC_TS *phcTimes,
+        OUT EPL_NTP_TS *ntpTimes,
+        IN NS_UINT count);
+
+EXPORT void
+    EPLNtpToPhcArray (
+        IN PEPL_NTP_TIMESCALE timescale,
+        IN EPL_NTP_TS *ntpTimes,
+        OUT EPL_NTP_PHC_TS *phcTimes,
+        IN NS_UINT count);
+
+EXPORT void
+    EPLNtpGetTransmitTimestamp (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN PEPL_NTP_TIMESCALE timescale,
+        OUT PEPL_NTP_TS ntpTime,
+        OUT NS_UINT *overflowCount);
+
+EXPORT void
+    EPLNtpGetReceiveTimestamp (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN PEPL_NTP_TIMESCALE timescale,
+        OUT PEPL_NTP_TS ntpTime,
+        OUT NS_UINT *overflowCount);
+
+EXPORT void
+    EPLNtpPutTimestamp (
+        OUT NS_UINT8 *field,
+        IN PEPL_NTP_TS ntpTime);
+
+EXPORT void
+    EPLNtpGetTimestamp (
+        IN NS_UINT8 *field,
+        OUT PEPL_NTP_TS ntpTime);
+
+EXPORT NS_STATUS
+    EPLNtpBuildResponse (
+        IN PEPL_NTP_SERVER_CFG serverConfig,
+        IN NS_UINT8 *request,
+        IN NS_UINT requestLength,
+        IN PEPL_NTP_TS receiveTime,
+        IN PEPL_NTP_TS transmitTime,
+        OUT NS_UINT8 *response);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _EPL_NTP_INCLUDE
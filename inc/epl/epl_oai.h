@@ -40,8 +40,15 @@ void
     OAIEndMultiCriticalSection(
         IN OAI_DEV_HANDLE oaiDevHandle);
 
+NS_UINT32
+    OAIGetTimeStamp(
+        void);
+
 
 // Define EXPORTED if we're building for Windows
 #define EXPORT
 
+// Functions defined in headers (e.g. epl_time.h)
+#define EPL_INLINE static __inline
+
 #endif // _OAI_INCLUDE
@@ -0,0 +1,82 @@
+//****************************************************************************
+// epl_onestep.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// This file contains all of the one-step Sync transmit related definitions
+// and prototypes
+//
+//****************************************************************************
+
+#ifndef _EPL_ONESTEP_INCLUDE
+#define _EPL_ONESTEP_INCLUDE
+
+#include "epl.h"
+
+#define ONESTEP_SYNC_LENGTH         44      // PTPv2 Sync message
+#define ONESTEP_ORIGIN_TS_OFFSET    34      // originTimestamp in the message
+#define ONESTEP_CHK_TRAILER_LENGTH  2       // Bytes rewritten by CHK_1STEP
+#define ONESTEP_PTP_UDP_PORT        319     // PTP event port
+
+// Largest frame built (IPv6), excluding the FCS
+#define ONESTEP_MAX_FRAME_LENGTH    (14 + 40 + 8 + ONESTEP_SYNC_LENGTH + ONESTEP_CHK_TRAILER_LENGTH)
+
+typedef enum EPL_ONESTEP_TRANSPORT_ENUM {
+    ONESTEP_L2,                 // Ethernet, EtherType 0x88F7
+    ONESTEP_IPV4,               // UDP over IPv4
+    ONESTEP_IPV6                // UDP over IPv6
+} EPL_ONESTEP_TRANSPORT_ENUM;
+
+typedef struct EPL_ONESTEP_CFG {
+    EPL_ONESTEP_TRANSPORT_ENUM transport;
+    NS_UINT8 dstMac[6];
+    NS_UINT8 srcMac[6];
+    NS_UINT8 srcIp[16];         // IPv4 uses the first 4 bytes
+    NS_UINT8 dstIp[16];
+    NS_UINT8 hopLimit;          // IPv4 TTL / IPv6 hop limit
+    NS_UINT8 domain;
+    NS_SINT8 logMessageInterval;
+    NS_UINT8 sourcePortIdentity[PTP_PORT_ID_LENGTH];
+} EPL_ONESTEP_CFG, *PEPL_ONESTEP_CFG;
+
+// Offsets within a frame built by EPLOneStepBuildSync()
+typedef struct EPL_ONESTEP_FRAME {
+    NS_UINT16 length;           // Frame length, excluding the FCS
+    NS_UINT16 ptpOffset;        // Start of the PTP message
+    NS_UINT16 udpOffset;        // Start of the UDP header, 0 for L2
+} EPL_ONESTEP_FRAME, *PEPL_ONESTEP_FRAME;
+
+// EPL Function Prototypes
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+EXPORT void
+    EPLOneStepGetDefaultConfig (
+        IN OUT PEPL_ONESTEP_CFG syncConfig,
+        IN EPL_ONESTEP_TRANSPORT_ENUM transport);
+
+EXPORT void
+    EPLOneStepConfigure (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN EPL_ONESTEP_TRANSPORT_ENUM transport);
+
+EXPORT NS_STATUS
+    EPLOneStepBuildSync (
+        IN PEPL_ONESTEP_CFG syncConfig,
+        OUT NS_UINT8 *frameBuffer,
+        IN NS_UINT bufferSize,
+        OUT PEPL_ONESTEP_FRAME frameInfo);
+
+EXPORT void
+    EPLOneStepSetSequenceId (
+        IN PEPL_ONESTEP_FRAME frameInfo,
+        IN OUT NS_UINT8 *frameBuffer,
+        IN NS_UINT16 sequenceId);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _EPL_ONESTEP_INCLUDE
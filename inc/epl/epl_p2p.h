@@ -0,0 +1,140 @@
+//****************************************************************************
+// epl_p2p.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// This file contains all of the peer-to-peer (peer delay) mechanism related
+// definitions and prototypes
+//
+//****************************************************************************
+
+#ifndef _EPL_P2P_INCLUDE
+#define _EPL_P2P_INCLUDE
+
+#include "epl.h"
+
+// Outstanding Pdelay exchanges tracked per port, must be a power of 2
+#define P2P_TABLE_SIZE          4
+
+// Number of exchanges spanned by the neighbor rate ratio measurement
+#define P2P_RATIO_WINDOW        8
+
+// EPL_P2P_SLOT flags
+#define P2P_HAVE_T1             0x0001  // Pdelay_Req transmit timestamp
+#define P2P_HAVE_RESP           0x0002  // Pdelay_Resp received (t2, t4)
+#define P2P_HAVE_T3             0x0004  // Pdelay_Resp_Follow_Up received
+#define P2P_REQUESTED           0x0008  // Slot holds an issued request
+#define P2P_COMPLETE            0x000F
+
+// Rate ratio measurements beyond this are discarded
+#define P2P_MAX_RATIO_PPB       1000000
+
+// Neighbor and local intervals of the ratio window differing by more than
+// this are a time jump, discarded before the ratio is computed (which
+// would overflow for differences above ~9.2s)
+#define P2P_MAX_RATIO_JUMP_NS   1000000000
+
+typedef struct EPL_P2P_CFG {
+    NS_UINT32 intervalUs;       // Time between Pdelay_Req messages
+    NS_UINT32 timeoutUs;        // Time to wait for the response
+    NS_UINT allowedLost;        // Consecutive lost responses before the
+                                // link delay is reported invalid
+    NS_UINT filterShift;        // Link delay EWMA weight 1/2^n, 0 = none
+    NS_UINT32 maxLinkDelayNs;   // Larger measurements are discarded
+} EPL_P2P_CFG, *PEPL_P2P_CFG;
+
+typedef struct EPL_P2P_SLOT {
+    NS_UINT16 sequenceId;
+    NS_UINT16 flags;
+    NS_BOOL twoStep;
+    NS_UINT32 requestTime;      // OAIGetTimeStamp() when the request was issued
+    NS_UINT32 seconds[4];       // t1 - t4
+    NS_UINT32 nanoSeconds[4];
+    NS_SINT64 correction;       // Scaled ns, Pdelay_Resp + Follow_Up
+} EPL_P2P_SLOT;
+
+typedef struct EPL_P2P_STATS {
+    NS_UINT32 requests;         // Pdelay_Req messages issued
+    NS_UINT32 completed;        // Exchanges that produced a measurement
+    NS_UINT32 lost;             // Exchanges timed out
+    NS_UINT32 rejected;         // Measurements out of range
+    NS_UINT32 unmatched;        // Inputs for a sequenceId not outstanding
+} EPL_P2P_STATS, *PEPL_P2P_STATS;
+
+typedef struct EPL_P2P_ENGINE {
+    EPL_P2P_CFG cfg;
+    EPL_P2P_SLOT table[P2P_TABLE_SIZE];
+    NS_UINT16 nextSequenceId;
+    NS_UINT32 lastRequestTime;
+    NS_BOOL requestPending;     // A request has been issued at least once
+    NS_UINT lostInRow;
+
+    // Neighbor rate ratio: (t3, t4) of the last P2P_RATIO_WINDOW exchanges
+    NS_UINT32 ratioSeconds[P2P_RATIO_WINDOW][2];
+    NS_UINT32 ratioNanoSeconds[P2P_RATIO_WINDOW][2];
+    NS_UINT ratioHead;
+    NS_UINT ratioCount;
+    NS_SINT32 rateRatioPpb;     // (neighborRateRatio - 1) * 10^9
+
+    NS_SINT64 linkDelay;        // Filtered, scaled ns (E2E_SCALED_NS_SHIFT)
+    NS_BOOL haveLinkDelay;
+    EPL_P2P_STATS stats;
+} EPL_P2P_ENGINE, *PEPL_P2P_ENGINE;
+
+// EPL Function Prototypes
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+EXPORT void
+    EPLP2PGetDefaultConfig (
+        IN OUT PEPL_P2P_CFG p2pConfig);
+
+EXPORT void
+    EPLP2PInit (
+        IN OUT PEPL_P2P_ENGINE engine,
+        IN PEPL_P2P_CFG p2pConfig);
+
+EXPORT NS_BOOL
+    EPLP2PStartRequest (
+        IN OUT PEPL_P2P_ENGINE engine,
+        OUT NS_UINT16 *sequenceId);
+
+EXPORT void
+    EPLP2PReqSent (
+        IN OUT PEPL_P2P_ENGINE engine,
+        IN NS_UINT16 sequenceId,
+        IN NS_UINT32 txSeconds,
+        IN NS_UINT32 txNanoSeconds);
+
+EXPORT NS_BOOL
+    EPLP2PRespReceived (
+        IN OUT PEPL_P2P_ENGINE engine,
+        IN NS_UINT16 sequenceId,
+        IN NS_UINT32 rxSeconds,
+        IN NS_UINT32 rxNanoSeconds,
+        IN NS_UINT32 reqReceiptSeconds,
+        IN NS_UINT32 reqReceiptNanoSeconds,
+        IN NS_SINT64 correction,
+        IN NS_BOOL twoStep);
+
+EXPORT NS_BOOL
+    EPLP2PRespFollowUp (
+        IN OUT PEPL_P2P_ENGINE engine,
+        IN NS_UINT16 sequenceId,
+        IN NS_UINT32 respOriginSeconds,
+        IN NS_UINT32 respOriginNanoSeconds,
+        IN NS_SINT64 correction);
+
+EXPORT NS_BOOL
+    EPLP2PGetLinkDelay (
+        IN PEPL_P2P_ENGINE engine,
+        OUT NS_SINT64 *linkDelay,
+        OUT NS_SINT32 *rateRatioPpb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _EPL_P2P_INCLUDE
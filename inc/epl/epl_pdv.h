@@ -0,0 +1,95 @@
+//****************************************************************************
+// epl_pdv.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// This file contains all of the packet delay variation filter related
+// definitions and prototypes
+//
+//****************************************************************************
+
+#ifndef _EPL_PDV_INCLUDE
+#define _EPL_PDV_INCLUDE
+
+#include "epl.h"
+
+// Largest minimum and median filter window, samples (64 or less)
+#define PDV_MAX_WINDOW          64
+
+// Largest exponential filter shift
+#define PDV_MAX_SHIFT           16
+
+typedef enum EPL_PDV_FILTER_ENUM {
+    PDV_FILTER_NONE,            // Samples passed through unchanged
+    PDV_FILTER_MINIMUM,         // Smallest sample of the window (lucky packet)
+    PDV_FILTER_MEDIAN,          // Median of the window
+    PDV_FILTER_EXPONENTIAL,     // Exponentially weighted moving average
+    PDV_NUM_FILTERS
+} EPL_PDV_FILTER_ENUM;
+
+typedef struct EPL_PDV_CFG {
+    EPL_PDV_FILTER_ENUM type;
+    NS_UINT window;             // Minimum and median: samples, 1 - PDV_MAX_WINDOW
+    NS_BOOL decimate;           // Minimum and median: one output per window,
+                                // the other samples are discarded
+    NS_UINT shift;              // Exponential: a new sample has weight
+                                // 1/2^shift, 0 - PDV_MAX_SHIFT
+} EPL_PDV_CFG, *PEPL_PDV_CFG;
+
+typedef struct EPL_PDV_FILTER {
+    EPL_PDV_CFG cfg;
+
+    // Window: ring of the last cfg.window samples
+    NS_SINT64 sample[PDV_MAX_WINDOW];
+    NS_UINT next;               // Ring slot of the next sample
+    NS_UINT count;              // Samples in the window
+    NS_UINT phase;              // Samples since the last output (decimate)
+
+    // Minimum: ring slots of the samples that may still become the
+    // window's minimum, oldest (and smallest) first
+    NS_UINT8 queue[PDV_MAX_WINDOW];
+    NS_UINT queueHead;
+    NS_UINT queueCount;
+
+    // Median: ring slots arranged as a max-heap of the lower half at
+    // positions -1, -2, .., the median at 0 and a min-heap of the upper
+    // half at 1, 2, ..; heap[] is indexed by position + PDV_MAX_WINDOW / 2
+    NS_UINT8 heap[PDV_MAX_WINDOW];
+    NS_SINT8 heapPos[PDV_MAX_WINDOW];   // Heap position of each ring slot
+
+    // Exponential
+    NS_SINT64 average;
+
+    NS_UINT32 samples;          // Samples filtered
+    NS_UINT32 outputs;          // Samples passed on
+} EPL_PDV_FILTER, *PEPL_PDV_FILTER;
+
+// EPL Function Prototypes
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+EXPORT void
+    EPLPdvGetDefaultConfig (
+        IN OUT PEPL_PDV_CFG pdvConfig);
+
+EXPORT NS_STATUS
+    EPLPdvInit (
+        IN OUT PEPL_PDV_FILTER filter,
+        IN PEPL_PDV_CFG pdvConfig);
+
+EXPORT void
+    EPLPdvReset (
+        IN OUT PEPL_PDV_FILTER filter);
+
+EXPORT NS_BOOL
+    EPLPdvFilter (
+        IN OUT void *context,
+        IN OUT NS_SINT64 *value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _EPL_PDV_INCLUDE
@@ -0,0 +1,103 @@
+//****************************************************************************
+// epl_phc.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// This file contains all of the PTP hardware clock (PHC) style clock
+// adapter related definitions and prototypes
+//
+//****************************************************************************
+
+#ifndef _EPL_PHC_INCLUDE
+#define _EPL_PHC_INCLUDE
+
+#include "epl.h"
+
+// Largest frequency adjustments, the largest values that round to
+// SLEW_MAX_RATE (about 1953ppm). Larger adjustments are refused; a PHC
+// driver reports PHC_MAX_ADJ_PPB as its max_adj.
+#define PHC_MAX_ADJ_PPB         1953124
+#define PHC_MAX_SCALED_PPM      127999999
+
+typedef struct EPL_PHC_CFG {
+    NS_UINT32 slewMaxNs;        // EPLPhcAdjTime() slews offsets up to this
+                                // (SLEW_MAX_OFFSET_NS or less), 0 = always
+                                // step
+    EPL_SLEW_CFG slew;          // Slew planner configuration
+} EPL_PHC_CFG, *PEPL_PHC_CFG;
+
+typedef struct EPL_PHC {
+    PEPL_PORT_HANDLE portHandle;
+    EPL_PHC_CFG cfg;
+    NS_SINT32 rate;             // Normal rate programmed, 2^-32ns per cycle
+    NS_BOOL rateValid;          // rate is known to match PTP_RATEH/L
+    EPL_SLEW slew;
+    NS_UINT32 rateWrites;       // Normal rate register writes
+    NS_UINT32 rateWritesSkipped;// Adjustments that did not change the rate
+    NS_UINT32 steps;            // EPLPhcAdjTime() calls done by a step
+    NS_UINT32 slews;            // EPLPhcAdjTime() calls done by slewing
+} EPL_PHC, *PEPL_PHC;
+
+// EPL Function Prototypes
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+EXPORT NS_SINT32
+    EPLPhcScaledPpmToRate (
+        IN NS_SINT64 scaledPpm);
+
+EXPORT NS_SINT32
+    EPLPhcPpbToRate (
+        IN NS_SINT32 ppb);
+
+EXPORT NS_SINT64
+    EPLPhcRateToScaledPpm (
+        IN NS_SINT32 rate);
+
+EXPORT void
+    EPLPhcGetDefaultConfig (
+        IN OUT PEPL_PHC_CFG phcConfig);
+
+EXPORT NS_STATUS
+    EPLPhcInit (
+        IN OUT PEPL_PHC phc,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN PEPL_PHC_CFG phcConfig);
+
+EXPORT NS_STATUS
+    EPLPhcAdjFine (
+        IN OUT PEPL_PHC phc,
+        IN NS_SINT64 scaledPpm);
+
+EXPORT NS_STATUS
+    EPLPhcAdjFreq (
+        IN OUT PEPL_PHC phc,
+        IN NS_SINT32 ppb);
+
+EXPORT NS_STATUS
+    EPLPhcAdjTime (
+        IN OUT PEPL_PHC phc,
+        IN NS_SINT64 deltaNs);
+
+EXPORT NS_BOOL
+    EPLPhcService (
+        IN OUT PEPL_PHC phc,
+        IN PPTP_TIME currentTime);
+
+EXPORT void
+    EPLPhcGetTime (
+        IN OUT PEPL_PHC phc,
+        OUT PPTP_TIME time);
+
+EXPORT void
+    EPLPhcSetTime (
+        IN OUT PEPL_PHC phc,
+        IN PPTP_TIME time);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _EPL_PHC_INCLUDE
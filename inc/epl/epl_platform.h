@@ -12,6 +12,8 @@
 #ifndef _PLATFORM_INCLUDE
 #define _PLATFORM_INCLUDE
 
+#ifndef EPL_SIMULATION
+
 #include "stm32f2x7_eth.h"
 
 #include "FreeRTOS.h"
@@ -19,6 +21,14 @@
 
 #define VERSION_PTP     2
 
+// Free running microsecond counter for OAIGetTimeStamp(), wrapping at 2^32, 
+// e.g. a 32-bit timer (TIM2 or TIM5) prescaled to 1MHz:
+//
+//      #define OAI_TIMESTAMP_US()  (TIM2->CNT)
+//
+// Without it the FreeRTOS tick is used, with the resolution of one tick.
+//#define OAI_TIMESTAMP_US()
+
 
 typedef struct OAI_DEV_HANDLE_STRUCT {
   
@@ -27,6 +37,28 @@ typedef struct OAI_DEV_HANDLE_STRUCT {
     xSemaphoreHandle multiOpMutex;
 } OAI_DEV_HANDLE_STRUCT;
 
+#else // EPL_SIMULATION
+
+// Host build against the simulated PHY register model (epl_sim.c). The 
+// simulator provides the MDIO entry points normally supplied by the MAC 
+// driver and the OAI layer runs single threaded.
+
+#define VERSION_PTP     2
+
+#define PLATFORM_ASSERT(module, msg)
+
+NS_UINT32 ETH_ReadPHYRegister(NS_UINT16 PHYAddress, NS_UINT16 PHYReg);
+NS_UINT32 ETH_WritePHYRegister(NS_UINT16 PHYAddress, NS_UINT16 PHYReg, NS_UINT16 PHYValue);
+
+typedef struct OAI_DEV_HANDLE_STRUCT {
+  
+    // Nesting depth of the (no-op) critical sections, useful for debugging
+    NS_UINT regularMutex;    
+    NS_UINT multiOpMutex;
+} OAI_DEV_HANDLE_STRUCT;
+
+#endif // EPL_SIMULATION
+
 
 typedef OAI_DEV_HANDLE_STRUCT *OAI_DEV_HANDLE;
 
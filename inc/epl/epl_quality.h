@@ -0,0 +1,146 @@
+//****************************************************************************
+// epl_quality.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// This file contains all of the Link Quality Monitor related definitions
+// and prototypes
+//
+//****************************************************************************
+
+#ifndef _EPL_QUALITY_INCLUDE
+#define _EPL_QUALITY_INCLUDE
+
+#include "epl.h"
+
+// Maximum number of ports a single monitor object can service
+#define LQ_MAX_PORTS            8
+
+// Weight of new samples in the rolling mean/variance (1/2^n)
+#define LQ_EWMA_SHIFT           4
+
+// Rolling statistics are kept with LQ_STAT_FRAC_BITS fractional bits
+#define LQ_STAT_FRAC_BITS       8
+
+// Nominal MDIO capacity: one 64-bit frame per 25.6us at 2.5MHz MDC
+#define LQ_DEFAULT_MDIO_OPS_PER_SEC 39062
+
+// DSP parameters selectable through PHY_PG2_LQDR (LQ_PARAM_SEL)
+typedef enum EPL_LQ_PARAM_ENUM {
+    LQ_PARAM_C1,                // DEQ C1 coefficient (signed)
+    LQ_PARAM_DAGC,              // Digital AGC gain (unsigned)
+    LQ_PARAM_DBLW,              // Digital baseline wander (signed)
+    LQ_PARAM_FREQ,              // Recovered frequency offset (signed)
+    LQ_PARAM_FC,                // Frequency control (signed)
+    LQ_NUM_PARAMS
+} EPL_LQ_PARAM_ENUM;
+
+#define LQ_PARAM_BIT(param)     (1 << (param))
+#define LQ_PARAM_ALL            ((1 << LQ_NUM_PARAMS) - 1)
+
+typedef enum EPL_LQ_STATE_ENUM {
+    LQ_STATE_NORMAL,
+    LQ_STATE_LOW,               // Parameter at or below its low threshold
+    LQ_STATE_HIGH               // Parameter at or above its high threshold
+} EPL_LQ_STATE_ENUM;
+
+typedef struct EPL_LQ_THRESHOLD {
+    NS_BOOL enabled;
+    NS_SINT low;
+    NS_SINT high;
+    NS_BOOL breakLink;          // Let the PHY drop the link on a crossing
+} EPL_LQ_THRESHOLD;
+
+typedef struct EPL_LQ_STATS {
+    NS_SINT last;               // Most recent sample
+    NS_SINT min;
+    NS_SINT max;
+    NS_SINT32 mean;             // Rolling mean, LQ_STAT_FRAC_BITS fraction
+    NS_UINT32 variance;         // Rolling variance, LQ_STAT_FRAC_BITS fraction
+    NS_UINT32 samples;
+    NS_UINT32 crossings;        // Number of threshold crossings reported
+    EPL_LQ_STATE_ENUM state;
+} EPL_LQ_STATS, *PEPL_LQ_STATS;
+
+typedef void (*EPL_LQ_CALLBACK)(
+    IN PEPL_PORT_HANDLE portHandle,
+    IN EPL_LQ_PARAM_ENUM param,
+    IN EPL_LQ_STATE_ENUM state,
+    IN NS_SINT value,
+    IN void *context);
+
+typedef struct EPL_LQ_PORT {
+    PEPL_PORT_HANDLE portHandle;
+    NS_UINT paramMask;          // LQ_PARAM_BIT()s sampled on this port
+    NS_UINT lqmrConfig;         // PHY_PG2_LQMR enable/break link bits
+    EPL_LQ_THRESHOLD thresholds[LQ_NUM_PARAMS];
+    EPL_LQ_STATS stats[LQ_NUM_PARAMS];
+} EPL_LQ_PORT;
+
+typedef struct EPL_LQ_MONITOR {
+    EPL_LQ_PORT ports[LQ_MAX_PORTS];
+    NS_UINT numPorts;
+    NS_UINT nextPort;           // Round robin position
+    NS_UINT sharePermille;      // Share of MDIO capacity used for sampling
+    NS_UINT32 mdioOpsPerSec;    // MDIO capacity of the bus
+    NS_UINT64 credit;           // MDIO transactions available, 1e-9 units
+    NS_UINT32 lastPollTime;     // OAIGetTimeStamp() of the previous poll
+    NS_UINT32 mdioUsed;         // MDIO transactions spent on monitoring
+    EPL_LQ_CALLBACK callback;
+    void *context;
+} EPL_LQ_MONITOR, *PEPL_LQ_MONITOR;
+
+// EPL Function Prototypes
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+EXPORT NS_SINT
+    EPLLqSampleParam (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN EPL_LQ_PARAM_ENUM param);
+
+EXPORT void
+    EPLLqInitMonitor (
+        IN OUT PEPL_LQ_MONITOR monitor,
+        IN NS_UINT sharePermille,
+        IN NS_UINT32 mdioOpsPerSec,
+        IN EPL_LQ_CALLBACK callback,
+        IN void *context);
+
+EXPORT NS_STATUS
+    EPLLqAddPort (
+        IN OUT PEPL_LQ_MONITOR monitor,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_UINT paramMask);
+
+EXPORT NS_STATUS
+    EPLLqSetThreshold (
+        IN OUT PEPL_LQ_MONITOR monitor,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN EPL_LQ_PARAM_ENUM param,
+        IN NS_SINT low,
+        IN NS_SINT high,
+        IN NS_BOOL breakLink);
+
+EXPORT NS_UINT
+    EPLLqPoll (
+        IN OUT PEPL_LQ_MONITOR monitor);
+
+EXPORT NS_STATUS
+    EPLLqGetStats (
+        IN PEPL_LQ_MONITOR monitor,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN EPL_LQ_PARAM_ENUM param,
+        OUT PEPL_LQ_STATS stats);
+
+EXPORT void
+    EPLLqResetStats (
+        IN OUT PEPL_LQ_MONITOR monitor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _EPL_QUALITY_INCLUDE
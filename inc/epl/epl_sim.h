@@ -0,0 +1,171 @@
+//****************************************************************************
+// epl_sim.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// This file contains the definitions and prototypes of the simulated PHY
+// register model. It is only available in host builds with EPL_SIMULATION
+// defined, where it replaces the MAC driver's MDIO access functions.
+//
+//****************************************************************************
+
+#ifndef _EPL_SIM_INCLUDE
+#define _EPL_SIM_INCLUDE
+
+#include "epl.h"
+
+#ifdef EPL_SIMULATION
+
+#define EPL_SIM_MAX_PHYS            8
+#define EPL_SIM_MAX_REFLECTIONS     4
+#define EPL_SIM_NUM_LQ_PARAMS       5
+#define EPL_SIM_TS_DEPTH            4
+
+// Duration of one MDIO transaction: 64 bits (incl. preamble) at 2.5MHz MDC
+#define EPL_SIM_MDIO_FRAME_NS       25600
+
+typedef struct EPL_SIM_REFLECTION {
+    NS_BOOL rxPair;             // TRUE = reflection on RX pair, FALSE = TX pair
+    NS_UINT delayTicks;         // Round trip delay in 8ns TDR ticks
+    NS_SINT amplitude;          // Signed amplitude at the fault (ADC LSBs),
+                                // positive = open, negative = short
+} EPL_SIM_REFLECTION;
+
+// PTP_TXTS / PTP_RXTS timestamp queue
+typedef struct EPL_SIM_TS_QUEUE {
+    NS_UINT32 seconds[EPL_SIM_TS_DEPTH];
+    NS_UINT32 nanoSeconds[EPL_SIM_TS_DEPTH];
+    NS_UINT16 sequenceId[EPL_SIM_TS_DEPTH];     // Receive only
+    NS_UINT16 typeHash[EPL_SIM_TS_DEPTH];       // Receive only, messageType/hash
+    NS_UINT count;                      // Entries queued
+    NS_UINT overflow;                   // Entries dropped, up to 3
+    NS_UINT word;                       // Next word of the head entry to be read
+} EPL_SIM_TS_QUEUE;
+
+typedef struct EPL_SIM_PHY {
+    NS_BOOL present;
+    NS_UINT mdioAddress;
+    NS_UINT page;                       // Currently selected register page
+    NS_UINT16 baseRegs[0x14];           // Registers 0x00 - 0x13 (all pages)
+    NS_UINT16 pageRegs[8][0x0C];        // Registers 0x14 - 0x1F of each page
+
+    // TDR model
+    EPL_SIM_REFLECTION reflections[EPL_SIM_MAX_REFLECTIONS];
+    NS_UINT numReflections;
+    NS_UINT tdrNoise;                   // Peak noise amplitude per sample
+
+    // Link quality model, indexed by LQ_PARAM_SEL
+    NS_SINT lqValue[EPL_SIM_NUM_LQ_PARAMS];
+    NS_SINT lqThreshold[EPL_SIM_NUM_LQ_PARAMS][2];   // [0] = low, [1] = high
+
+    // Timestamp unit model
+    EPL_SIM_TS_QUEUE txTs;
+    EPL_SIM_TS_QUEUE rxTs;
+
+    // IEEE 1588 clock model. The clock advances 8ns plus the rate
+    // adjustment per 8ns cycle of simulated time.
+    NS_UINT64 clockNs;                  // PTP time at clockUpdated
+    NS_SINT64 clockFrac;                // Below 1ns, 2^-32 ns units
+    NS_UINT64 clockUpdated;             // Simulated time of the last update
+    NS_SINT32 rate;                     // Normal rate, 2^-32 ns per cycle
+    NS_SINT32 tempRate;                 // Temporary rate
+    NS_UINT32 tempCycles;               // Cycles left at the temporary rate
+    NS_SINT32 oscError;                 // Reference oscillator frequency
+                                        // error, 2^-32 ns per cycle
+    NS_UINT16 tdrIn[8];                 // PTP_TDR writes since the last PTP_CTL
+    NS_UINT tdrInCount;
+    NS_UINT16 tdrOut[4];                // Clock value latched by PTP_RD_CLK
+    NS_UINT tdrOutWord;
+    NS_UINT trigSelect;                 // Trigger selected by TRIG_LOAD
+    NS_UINT64 trigTime[8];              // Expiration time of armed triggers
+    NS_UINT trigArmed;                  // Bit per trigger
+    NS_BOOL trigDone;                   // PTP_STS TRIG_DONE
+
+    // Access statistics
+    NS_UINT32 readCount;
+    NS_UINT32 writeCount;
+    NS_UINT32 pageSelectCount;
+    NS_UINT32 tdrPulseCount;
+    NS_UINT32 oneStepCount;             // Syncs with an inserted timestamp
+} EPL_SIM_PHY, *PEPL_SIM_PHY;
+
+// EPL Function Prototypes
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+EXPORT void
+    EPLSimReset(
+        void);
+
+EXPORT PEPL_SIM_PHY
+    EPLSimAddPhy(
+        IN NS_UINT mdioAddress);
+
+EXPORT PEPL_SIM_PHY
+    EPLSimGetPhy(
+        IN NS_UINT mdioAddress);
+
+EXPORT NS_STATUS
+    EPLSimAddReflection(
+        IN PEPL_SIM_PHY simPhy,
+        IN NS_BOOL rxPair,
+        IN NS_UINT delayTicks,
+        IN NS_SINT amplitude);
+
+EXPORT void
+    EPLSimSetLinkQuality(
+        IN PEPL_SIM_PHY simPhy,
+        IN NS_UINT param,
+        IN NS_SINT value);
+
+EXPORT void
+    EPLSimAddRxErrors(
+        IN PEPL_SIM_PHY simPhy,
+        IN NS_UINT falseCarriers,
+        IN NS_UINT rxErrors);
+
+EXPORT NS_BOOL
+    EPLSimTransmit(
+        IN PEPL_SIM_PHY simPhy,
+        IN OUT NS_UINT8 *frameBuffer,
+        IN NS_UINT frameLength);
+
+EXPORT NS_BOOL
+    EPLSimReceive(
+        IN PEPL_SIM_PHY simPhy,
+        IN NS_UINT8 *frameBuffer,
+        IN NS_UINT frameLength);
+
+EXPORT NS_BOOL
+    EPLSimReceiveAt(
+        IN PEPL_SIM_PHY simPhy,
+        IN NS_UINT8 *frameBuffer,
+        IN NS_UINT frameLength,
+        IN NS_UINT64 arrivalTime);
+
+EXPORT NS_UINT64
+    EPLSimGetTime(
+        void);
+
+EXPORT void
+    EPLSimAdvanceTime(
+        IN NS_UINT64 nanoSeconds);
+
+EXPORT NS_UINT64
+    EPLSimGetPhyTime(
+        IN PEPL_SIM_PHY simPhy);
+
+EXPORT void
+    EPLSimSetClockDrift(
+        IN PEPL_SIM_PHY simPhy,
+        IN NS_SINT32 ppb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EPL_SIMULATION
+
+#endif // _EPL_SIM_INCLUDE
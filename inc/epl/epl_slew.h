@@ -0,0 +1,88 @@
+//****************************************************************************
+// epl_slew.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// This file contains all of the temporary rate slew planner related
+// definitions and prototypes
+//
+//****************************************************************************
+
+#ifndef _EPL_SLEW_INCLUDE
+#define _EPL_SLEW_INCLUDE
+
+#include "epl.h"
+
+// PTP_RATEH/L magnitude, 2^-32ns per 8ns cycle (about 1950ppm)
+#define SLEW_MAX_RATE           0x03FFFFFF
+
+// PTP_TRDH/L temporary rate duration, 8ns cycles (about 536ms)
+#define SLEW_MAX_DURATION       0x03FFFFFF
+
+// Largest offset slewed, larger ones should be stepped out
+#define SLEW_MAX_OFFSET_NS      1000000000
+
+#define SLEW_NO_TRIGGER         0xFF
+
+typedef struct EPL_SLEW_CFG {
+    NS_UINT32 maxRate;          // Largest temporary rate magnitude, 2^-32ns
+                                // per cycle, up to SLEW_MAX_RATE
+    NS_UINT trigger;            // Trigger armed at the end of every segment,
+                                // 0 - 7, or SLEW_NO_TRIGGER
+} EPL_SLEW_CFG, *PEPL_SLEW_CFG;
+
+typedef struct EPL_SLEW {
+    PEPL_PORT_HANDLE portHandle;
+    EPL_SLEW_CFG cfg;
+    NS_SINT64 offsetNs;         // Correction being slewed
+    NS_SINT32 normalRate;       // Signed, 2^-32ns per cycle
+    NS_SINT32 tempRate;         // Rate of every segment
+    NS_UINT32 numSegments;
+    NS_UINT32 nextSegment;      // Segments started
+    NS_UINT32 segmentCycles;    // Duration of a segment
+    NS_UINT32 longSegments;     // The first longSegments take one cycle more
+    NS_UINT32 lastDuration;     // PTP_TRD value, 0 = not written
+    PTP_TIME segmentEnd;        // Clock time the running segment is done by
+    PTP_TIME finishTime;        // Expected end of the last segment
+    NS_BOOL active;
+} EPL_SLEW, *PEPL_SLEW;
+
+// EPL Function Prototypes
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+EXPORT void
+    EPLSlewGetDefaultConfig (
+        IN OUT PEPL_SLEW_CFG slewConfig);
+
+EXPORT NS_STATUS
+    EPLSlewStart (
+        IN OUT PEPL_SLEW slew,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN PEPL_SLEW_CFG slewConfig,
+        IN NS_SINT64 offsetNs,
+        IN NS_SINT32 normalRate,
+        OUT PPTP_TIME finishTime);
+
+EXPORT NS_BOOL
+    EPLSlewService (
+        IN OUT PEPL_SLEW slew,
+        IN PPTP_TIME currentTime,
+        OUT PPTP_TIME finishTime);
+
+EXPORT NS_STATUS
+    EPLSlewSetNormalRate (
+        IN OUT PEPL_SLEW slew,
+        IN NS_SINT32 normalRate);
+
+EXPORT void
+    EPLSlewCancel (
+        IN OUT PEPL_SLEW slew);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _EPL_SLEW_INCLUDE
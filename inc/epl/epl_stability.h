@@ -0,0 +1,134 @@
+//****************************************************************************
+// epl_stability.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// This file contains all of the clock stability analysis (MTIE, TDEV and
+// Allan deviation) related definitions and prototypes
+//
+//****************************************************************************
+
+#ifndef _EPL_STABILITY_INCLUDE
+#define _EPL_STABILITY_INCLUDE
+
+#include "epl.h"
+
+// MTIE observation windows, and the blocks each window is tracked in.
+// Windows of up to STAB_MTIE_BLOCKS samples are exact; longer ones are
+// evaluated at block boundaries.
+#define STAB_MTIE_WINDOWS       8
+#define STAB_MTIE_BLOCKS        32
+
+// Allan and time deviation averaging times: 2^k samples for
+// k = 0 .. STAB_DEV_LEVELS - 1
+#define STAB_DEV_LEVELS         16
+
+// Fractional bits of the time error kept by the deviation accumulators
+#define STAB_FRAC_BITS          8
+
+typedef struct EPL_STABILITY_CFG {
+    NS_UINT32 sampleIntervalUs; // Time between samples (tau0), microseconds
+    NS_UINT32 mtieWindow[STAB_MTIE_WINDOWS];
+                                // MTIE observation windows in samples, 2
+                                // or more; 0 ends the list
+} EPL_STABILITY_CFG, *PEPL_STABILITY_CFG;
+
+typedef struct EPL_STAB_EXTREME {
+    NS_SINT32 value;            // Block minimum or maximum, ns
+    NS_UINT32 block;            // Block number
+} EPL_STAB_EXTREME;
+
+// Monotonic queue of block extremes: values of the current window that
+// may still become its minimum (or maximum), oldest first
+typedef struct EPL_STAB_QUEUE {
+    EPL_STAB_EXTREME entry[STAB_MTIE_BLOCKS];
+    NS_UINT head;
+    NS_UINT count;
+} EPL_STAB_QUEUE;
+
+typedef struct EPL_STAB_MTIE {
+    NS_UINT32 blockSamples;     // Samples per block
+    NS_UINT32 windowBlocks;     // Blocks per observation window
+    NS_UINT32 samples;          // Samples in the current block
+    NS_SINT32 blockMin;
+    NS_SINT32 blockMax;
+    NS_UINT32 block;            // Number of the current block
+    NS_BOOL full;               // A whole window has been seen
+    EPL_STAB_QUEUE minQueue;
+    EPL_STAB_QUEUE maxQueue;
+    NS_UINT32 mtieNs;
+} EPL_STAB_MTIE;
+
+// Accumulators for averaging time 2^k samples. Time errors are in
+// 2^-STAB_FRAC_BITS ns; sums of squares are 128 bits (low, high).
+typedef struct EPL_STAB_LEVEL {
+    NS_BOOL pending;            // pendingSum/Phase hold the first block of
+    NS_SINT64 pendingSum;       // the pair that forms the next level's block
+    NS_SINT64 pendingPhase;
+    NS_SINT64 sum[2];           // Previous two block sums, older first
+    NS_SINT64 phase[2];         // Time error at the start of those blocks
+    NS_UINT blocks;             // Blocks seen, up to 2
+    NS_UINT32 terms;            // Second differences accumulated
+    NS_UINT64 adevSum[2];       // Squared phase second differences
+    NS_UINT64 tdevSum[2];       // Squared block mean second differences
+} EPL_STAB_LEVEL;
+
+typedef struct EPL_STABILITY {
+    NS_UINT32 sampleIntervalUs;
+    NS_UINT numWindows;
+    EPL_STAB_MTIE mtie[STAB_MTIE_WINDOWS];
+    EPL_STAB_LEVEL level[STAB_DEV_LEVELS];
+    NS_UINT32 samples;          // Samples added
+} EPL_STABILITY, *PEPL_STABILITY;
+
+typedef struct EPL_STAB_MTIE_POINT {
+    NS_UINT64 tauUs;            // Observation interval, microseconds
+    NS_UINT32 windowSamples;    // Samples per window as tracked
+    NS_UINT32 mtieNs;           // Largest peak to peak time error in any
+                                // window so far
+} EPL_STAB_MTIE_POINT, *PEPL_STAB_MTIE_POINT;
+
+typedef struct EPL_STAB_DEV_POINT {
+    NS_UINT64 tauUs;            // Averaging time, microseconds
+    NS_UINT64 tdevPs;           // Time deviation, picoseconds
+    NS_UINT64 adev;             // Allan deviation, units of 10^-15
+    NS_UINT32 terms;            // Second differences the values are from
+} EPL_STAB_DEV_POINT, *PEPL_STAB_DEV_POINT;
+
+// EPL Function Prototypes
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+EXPORT void
+    EPLStabilityGetDefaultConfig (
+        IN OUT PEPL_STABILITY_CFG stabilityConfig);
+
+EXPORT NS_STATUS
+    EPLStabilityInit (
+        IN OUT PEPL_STABILITY stability,
+        IN PEPL_STABILITY_CFG stabilityConfig);
+
+EXPORT void
+    EPLStabilityAddSample (
+        IN OUT PEPL_STABILITY stability,
+        IN NS_SINT32 timeErrorNs);
+
+EXPORT NS_STATUS
+    EPLStabilityGetMtie (
+        IN PEPL_STABILITY stability,
+        IN NS_UINT window,
+        OUT PEPL_STAB_MTIE_POINT point);
+
+EXPORT NS_STATUS
+    EPLStabilityGetDeviation (
+        IN PEPL_STABILITY stability,
+        IN NS_UINT level,
+        OUT PEPL_STAB_DEV_POINT point);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _EPL_STABILITY_INCLUDE
@@ -0,0 +1,128 @@
+//****************************************************************************
+// epl_tc.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// This file contains all of the transparent clock related definitions and
+// prototypes
+//
+//****************************************************************************
+
+#ifndef _EPL_TC_INCLUDE
+#define _EPL_TC_INCLUDE
+
+#include "epl.h"
+
+// Ports of one transparent clock
+#define TC_MAX_PORTS            8
+
+// Event messages tracked per message class, must be a power of 2
+#define TC_TABLE_SIZE           32
+
+typedef enum EPL_TC_MODE_ENUM {
+    TC_MODE_E2E,                // End-to-end: Sync and Delay_Req corrected
+    TC_MODE_P2P                 // Peer-to-peer: Sync corrected, plus the
+                                // ingress link delay
+} EPL_TC_MODE_ENUM;
+
+typedef enum EPL_TC_CLASS_ENUM {
+    TC_CLASS_SYNC,              // Sync, corrected in the Follow_Up
+    TC_CLASS_DELAY_REQ,         // Delay_Req, corrected in the Delay_Resp
+    TC_NUM_CLASSES
+} EPL_TC_CLASS_ENUM;
+
+typedef struct EPL_TC_PORT {
+    NS_SINT64 clockOffset;      // PHY clock - reference clock, scaled ns
+    NS_SINT64 linkDelay;        // Ingress link delay (P2P mode), scaled ns
+    NS_UINT32 rxLatencyNs;      // Wire to receive timestamp point
+    NS_UINT32 txLatencyNs;      // Transmit timestamp point to wire
+} EPL_TC_PORT;
+
+typedef struct EPL_TC_ENTRY {
+    NS_UINT8 valid;
+    NS_UINT8 domain;
+    NS_UINT8 ingressPort;
+    NS_UINT8 egressMask;        // Ports with a residence time
+    NS_UINT16 sequenceId;
+    NS_UINT8 portIdentity[PTP_PORT_ID_LENGTH];
+    NS_UINT32 rxSeconds;        // Ingress timestamp, PHY time
+    NS_UINT32 rxNanoSeconds;
+    NS_SINT64 ingressAdjust;    // Added to every residence time, scaled ns
+    NS_SINT64 residence[TC_MAX_PORTS];
+} EPL_TC_ENTRY;
+
+typedef struct EPL_TC_STATS {
+    NS_UINT32 ingress;          // Event messages timestamped on ingress
+    NS_UINT32 egress;           // Residence times computed
+    NS_UINT32 patched;          // General messages corrected
+    NS_UINT32 unmatched;        // Egress or general messages with no entry
+    NS_UINT32 overwritten;      // Entries reused before being patched
+} EPL_TC_STATS, *PEPL_TC_STATS;
+
+typedef struct EPL_TC {
+    EPL_TC_MODE_ENUM mode;
+    NS_UINT numPorts;
+    EPL_TC_PORT port[TC_MAX_PORTS];
+    EPL_TC_ENTRY table[TC_NUM_CLASSES][TC_TABLE_SIZE];
+    EPL_TC_STATS stats;
+} EPL_TC, *PEPL_TC;
+
+// EPL Function Prototypes
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+EXPORT NS_STATUS
+    EPLTCInit (
+        IN OUT PEPL_TC tc,
+        IN EPL_TC_MODE_ENUM mode,
+        IN NS_UINT numPorts);
+
+EXPORT NS_STATUS
+    EPLTCSetPortLatency (
+        IN OUT PEPL_TC tc,
+        IN NS_UINT port,
+        IN NS_UINT32 rxLatencyNs,
+        IN NS_UINT32 txLatencyNs);
+
+EXPORT NS_STATUS
+    EPLTCSetPortOffset (
+        IN OUT PEPL_TC tc,
+        IN NS_UINT port,
+        IN NS_SINT64 clockOffset);
+
+EXPORT NS_STATUS
+    EPLTCSetLinkDelay (
+        IN OUT PEPL_TC tc,
+        IN NS_UINT port,
+        IN NS_SINT64 linkDelay);
+
+EXPORT NS_BOOL
+    EPLTCEventIngress (
+        IN OUT PEPL_TC tc,
+        IN NS_UINT port,
+        IN NS_UINT8 *ptpMessage,
+        IN NS_UINT32 rxSeconds,
+        IN NS_UINT32 rxNanoSeconds);
+
+EXPORT NS_BOOL
+    EPLTCEventEgress (
+        IN OUT PEPL_TC tc,
+        IN NS_UINT port,
+        IN NS_UINT8 *ptpMessage,
+        IN NS_UINT32 txSeconds,
+        IN NS_UINT32 txNanoSeconds);
+
+EXPORT NS_STATUS
+    EPLTCPatchGeneral (
+        IN OUT PEPL_TC tc,
+        IN NS_UINT port,
+        IN NS_UINT rxPort,
+        IN OUT NS_UINT8 *ptpMessage);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _EPL_TC_INCLUDE
@@ -0,0 +1,93 @@
+//****************************************************************************
+// epl_tdr.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// This file contains all of the TDR (cable diagnostics) related definitions
+// and prototypes
+//
+//****************************************************************************
+
+#ifndef _EPL_TDR_INCLUDE
+#define _EPL_TDR_INCLUDE
+
+#include "epl.h"
+
+// Maximum number of faults reported per cable pair
+#define TDR_MAX_FAULTS          4
+
+// Number of 8ns ticks after the launched pulse ignored by the receiver
+#define TDR_BLANK_TICKS         3
+
+// Default nominal velocity of propagation for CAT5 cable (percent of c)
+#define TDR_DEFAULT_NVP         66
+
+typedef enum EPL_TDR_PAIR_ENUM {
+    TDR_PAIR_TX,
+    TDR_PAIR_RX,
+    TDR_NUM_PAIRS
+} EPL_TDR_PAIR_ENUM;
+
+typedef enum EPL_TDR_FAULT_ENUM {
+    TDR_FAULT_NONE,
+    TDR_FAULT_OPEN,             // Positive reflection (open/high impedance)
+    TDR_FAULT_SHORT             // Negative reflection (short/low impedance)
+} EPL_TDR_FAULT_ENUM;
+
+typedef struct EPL_TDR_CFG {
+    NS_UINT minPulseWidth;      // First pulse width tried, 1 - 7 (8ns units)
+    NS_UINT maxPulseWidth;      // Widest pulse used for far faults, 1 - 7
+    NS_UINT threshold;          // Detection threshold, 1 - 63 (ADC LSBs)
+    NS_UINT maxTicks;           // End of the sweep window, up to 255
+    NS_UINT calOffsetTicks;     // Internal PHY delay subtracted from results
+    NS_UINT nvpPercent;         // Cable velocity of propagation, percent of c
+    NS_UINT maxFaults;          // Faults to locate per pair, 1 - TDR_MAX_FAULTS
+    NS_BOOL use100MbDriver;     // Use the 100Mb transmitter for the pulse
+} EPL_TDR_CFG, *PEPL_TDR_CFG;
+
+typedef struct EPL_TDR_FAULT {
+    EPL_TDR_FAULT_ENUM type;
+    NS_UINT timeTicks;          // Round trip time to the fault (8ns units)
+    NS_UINT distanceCm;         // Estimated distance to the fault
+    NS_UINT peak;               // Peak reflection amplitude
+    NS_UINT pulseWidth;         // Pulse width that located the fault
+} EPL_TDR_FAULT;
+
+typedef struct EPL_TDR_PAIR_RESULT {
+    NS_UINT numFaults;
+    EPL_TDR_FAULT faults[TDR_MAX_FAULTS];
+} EPL_TDR_PAIR_RESULT;
+
+typedef struct EPL_TDR_RESULTS {
+    EPL_TDR_PAIR_RESULT pair[TDR_NUM_PAIRS];
+    NS_UINT pulsesSent;         // Number of TDR pulses fired
+    NS_UINT32 mdioAccesses;     // MDIO transactions used by the sweep
+    NS_UINT32 durationUs;       // Elapsed time of the sweep
+} EPL_TDR_RESULTS, *PEPL_TDR_RESULTS;
+
+// EPL Function Prototypes
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+EXPORT void
+    EPLTdrGetDefaultConfig (
+        IN OUT PEPL_TDR_CFG tdrConfig);
+
+EXPORT NS_STATUS
+    EPLTdrRun (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN PEPL_TDR_CFG tdrConfig,
+        IN OUT PEPL_TDR_RESULTS tdrResults);
+
+EXPORT NS_UINT
+    EPLTdrTicksToCm (
+        IN NS_UINT timeTicks,
+        IN NS_UINT nvpPercent);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _EPL_TDR_INCLUDE
@@ -0,0 +1,104 @@
+//****************************************************************************
+// epl_time.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// This file contains the IEEE 1588 time (PTP_TIME) arithmetic. The
+// functions are inline; they compile to a few instructions without
+// branches on the carry.
+//
+// A normalized PTP_TIME has 0 <= nanoSeconds < PTP_NS_PER_SEC. Negative
+// times (differences) have negative seconds, e.g. -1.5s is {-2, 500000000}.
+// Add and subtract take normalized operands, or operands whose nanoseconds
+// sum (or differ) to within -10^9 and 2 * 10^9.
+//
+//****************************************************************************
+
+#ifndef _EPL_TIME_INCLUDE
+#define _EPL_TIME_INCLUDE
+
+#include "epl.h"
+
+#define PTP_NS_PER_SEC          1000000000
+
+//****************************************************************************
+EPL_INLINE void
+    PTPTimeNormalize (
+        IN OUT PPTP_TIME time)
+//  Normalizes a time with -10^9 <= nanoSeconds < 2 * 10^9, e.g. the result
+//  of adding or subtracting the fields of two normalized times.
+//****************************************************************************
+{
+NS_SINT32 carry;
+
+    carry = (time->nanoSeconds >= PTP_NS_PER_SEC) - (time->nanoSeconds < 0);
+    time->seconds += carry;
+    time->nanoSeconds -= carry * PTP_NS_PER_SEC;
+}
+
+//****************************************************************************
+EPL_INLINE void
+    PTPTimeAdd (
+        OUT PPTP_TIME result,
+        IN PPTP_TIME a,
+        IN PPTP_TIME b)
+//  result = a + b. result may be a or b.
+//****************************************************************************
+{
+    result->seconds = a->seconds + b->seconds;
+    result->nanoSeconds = a->nanoSeconds + b->nanoSeconds;
+    PTPTimeNormalize( result);
+}
+
+//****************************************************************************
+EPL_INLINE void
+    PTPTimeSub (
+        OUT PPTP_TIME result,
+        IN PPTP_TIME a,
+        IN PPTP_TIME b)
+//  result = a - b. result may be a or b.
+//****************************************************************************
+{
+    result->seconds = a->seconds - b->seconds;
+    result->nanoSeconds = a->nanoSeconds - b->nanoSeconds;
+    PTPTimeNormalize( result);
+}
+
+//****************************************************************************
+EPL_INLINE NS_SINT
+    PTPTimeCompare (
+        IN PPTP_TIME a,
+        IN PPTP_TIME b)
+//  Returns a negative value, 0 or a positive value if a is before, equal to
+//  or after b.
+//****************************************************************************
+{
+    return 2 * ((a->seconds > b->seconds) - (a->seconds < b->seconds)) +
+           ((a->nanoSeconds > b->nanoSeconds) - (a->nanoSeconds < b->nanoSeconds));
+}
+
+//****************************************************************************
+EPL_INLINE NS_SINT64
+    PTPTimeToNs (
+        IN PPTP_TIME time)
+//  Returns a time in nanoseconds (+/- 292 years).
+//****************************************************************************
+{
+    return time->seconds * PTP_NS_PER_SEC + time->nanoSeconds;
+}
+
+//****************************************************************************
+EPL_INLINE void
+    PTPTimeFromNs (
+        OUT PPTP_TIME time,
+        IN NS_SINT64 nanoSeconds)
+//  Sets a normalized time from nanoseconds.
+//****************************************************************************
+{
+    time->seconds = nanoSeconds / PTP_NS_PER_SEC;
+    time->nanoSeconds = (NS_SINT32)(nanoSeconds % PTP_NS_PER_SEC);
+    PTPTimeNormalize( time);
+}
+
+#endif // _EPL_TIME_INCLUDE
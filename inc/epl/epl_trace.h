@@ -0,0 +1,120 @@
+//****************************************************************************
+// epl_trace.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// This file contains the register level trace definitions and prototypes.
+//
+// Tracing is compiled in only when EPL_TRACE_ENABLE is defined. Otherwise
+// the tracepoint macros expand to nothing and no trace code or data is
+// linked in.
+//
+//****************************************************************************
+
+#ifndef _EPL_TRACE_INCLUDE
+#define _EPL_TRACE_INCLUDE
+
+#include "epl.h"
+#include "epl_trace_ids.h"
+
+// Number of records in the trace ring, must be a power of 2
+#ifndef EPL_TRACE_RING_SIZE
+#define EPL_TRACE_RING_SIZE     1024
+#endif
+
+// Time source of the trace records. Platforms with a free running hardware
+// timer can define this (and EPL_TRACE_TIME_UNIT_NS) for finer resolution.
+#ifndef EPL_TRACE_TIMESTAMP
+#define EPL_TRACE_TIMESTAMP()   OAIGetTimeStamp()
+#define EPL_TRACE_TIME_UNIT_NS  1000
+#endif
+
+#define EPL_TRACE_MAGIC         0x544C5045  // "EPLT" as little endian bytes
+
+typedef enum EPL_TRACE_TYPE_ENUM {
+    EPL_TRACE_REG_READ,         // MDIO read transaction
+    EPL_TRACE_REG_WRITE,        // MDIO write transaction (incl. page selects)
+    EPL_TRACE_API_ENTER,        // API entry point called
+    EPL_TRACE_API_EXIT          // API entry point returning
+} EPL_TRACE_TYPE_ENUM;
+
+#define EPL_TRACE_ID_ITEM(name) EPL_TRACE_ID_##name,
+typedef enum EPL_TRACE_ID_ENUM {
+    EPL_TRACE_ID_LIST(EPL_TRACE_ID_ITEM)
+    EPL_TRACE_NUM_IDS
+} EPL_TRACE_ID_ENUM;
+#undef EPL_TRACE_ID_ITEM
+
+// Records and the ring header only use 8, 16 and 32-bit (NS_UINT) fields so
+// the layout is the same on the target and on the host running the decoder.
+typedef struct EPL_TRACE_RECORD {
+    NS_UINT timeStamp;          // EPL_TRACE_TIMESTAMP() when recorded
+    NS_UINT16 seq;              // Low 16 bits of the ring index, written last
+    NS_UINT16 value;            // Register data (register records only)
+    NS_UINT8 type;              // EPL_TRACE_TYPE_ENUM
+    NS_UINT8 port;              // MDIO address of the port
+    NS_UINT8 page;              // Register page selected, 0xFF = unknown
+    NS_UINT8 reg;               // Register offset within the page
+    NS_UINT16 callerId;         // EPL_TRACE_ID_ENUM of the API in progress
+    NS_UINT16 reserved;
+} EPL_TRACE_RECORD, *PEPL_TRACE_RECORD;
+
+typedef struct EPL_TRACE_RING {
+    NS_UINT magic;              // EPL_TRACE_MAGIC
+    NS_UINT numRecords;         // EPL_TRACE_RING_SIZE
+    NS_UINT recordSize;         // sizeof( EPL_TRACE_RECORD)
+    NS_UINT timeUnitNs;         // Duration of one timestamp unit
+    volatile NS_UINT head;      // Total number of records ever claimed
+    EPL_TRACE_RECORD records[EPL_TRACE_RING_SIZE];
+} EPL_TRACE_RING, *PEPL_TRACE_RING;
+
+#ifdef EPL_TRACE_ENABLE
+
+// Tracepoints. Register records are attributed to the API entry point in
+// progress on the same port; API entry points do not nest.
+#define EPL_TRACE_REG( portHandle, type, registerIndex, value) \
+    EPLTraceRecord( (portHandle), (type), (registerIndex), (value), (portHandle)->traceCaller)
+
+#define EPL_TRACE_API_ENTER( portHandle, name) \
+    ((portHandle)->traceCaller = EPL_TRACE_ID_##name, \
+     EPLTraceRecord( (portHandle), EPL_TRACE_API_ENTER, 0, 0, EPL_TRACE_ID_##name))
+
+#define EPL_TRACE_API_EXIT( portHandle, name) \
+    (EPLTraceRecord( (portHandle), EPL_TRACE_API_EXIT, 0, 0, EPL_TRACE_ID_##name), \
+     (portHandle)->traceCaller = EPL_TRACE_ID_None)
+
+// EPL Function Prototypes
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void
+    EPLTraceRecord(
+        IN PEPL_PORT_HANDLE portHandle,
+        IN EPL_TRACE_TYPE_ENUM type,
+        IN NS_UINT registerIndex,
+        IN NS_UINT value,
+        IN NS_UINT callerId);
+
+EXPORT void
+    EPLTraceReset(
+        void);
+
+EXPORT PEPL_TRACE_RING
+    EPLTraceGetRing(
+        void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#else // EPL_TRACE_ENABLE
+
+#define EPL_TRACE_REG( portHandle, type, registerIndex, value)
+#define EPL_TRACE_API_ENTER( portHandle, name)
+#define EPL_TRACE_API_EXIT( portHandle, name)
+
+#endif // EPL_TRACE_ENABLE
+
+#endif // _EPL_TRACE_INCLUDE
@@ -0,0 +1,48 @@
+//****************************************************************************
+// epl_trace_ids.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// List of the API entry points that carry tracepoints. Each entry expands
+// to an EPL_TRACE_ID_xxx value (see epl_trace.h) and to a name in the host
+// side trace decoder, so this file must not depend on any other header.
+//
+// New entries must be appended so existing trace dumps still decode.
+//
+//****************************************************************************
+
+#ifndef _EPL_TRACE_IDS_INCLUDE
+#define _EPL_TRACE_IDS_INCLUDE
+
+#define EPL_TRACE_ID_LIST(X)            \
+    X(None)                             \
+    X(PTPEnable)                        \
+    X(PTPSetTriggerConfig)              \
+    X(PTPSetEventConfig)                \
+    X(PTPSetTransmitConfig)             \
+    X(PTPSetPhyStatusFrameConfig)       \
+    X(PTPSetReceiveConfig)              \
+    X(PTPSetTempRateDurationConfig)     \
+    X(PTPSetClockConfig)                \
+    X(PTPSetGpioInterruptConfig)        \
+    X(PTPSetMiscConfig)                 \
+    X(PTPClockReadCurrent)              \
+    X(PTPClockStepAdjustment)           \
+    X(PTPClockSet)                      \
+    X(PTPClockSetRateAdjustment)        \
+    X(PTPClockGetRateAdjustment)        \
+    X(PTPCheckForEvents)                \
+    X(PTPGetTransmitTimestamp)          \
+    X(PTPGetReceiveTimestamp)           \
+    X(PTPGetTimestampFromFrame)         \
+    X(PTPArmTrigger)                    \
+    X(PTPHasTriggerExpired)             \
+    X(PTPCancelTrigger)                 \
+    X(PTPGetEvent)                      \
+    X(PTPSetTimestampReference)         \
+    X(PTPExtendTimestamp)               \
+    X(PTPGetFullTimestampFromFrame)     \
+    X(PTPGetTimestampsFromFrames)
+
+#endif // _EPL_TRACE_IDS_INCLUDE
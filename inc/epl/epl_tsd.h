@@ -0,0 +1,160 @@
+//****************************************************************************
+// epl_tsd.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// This file contains all of the timestamp delivery manager related
+// definitions and prototypes
+//
+//****************************************************************************
+
+#ifndef _EPL_TSD_INCLUDE
+#define _EPL_TSD_INCLUDE
+
+#include "epl.h"
+
+// Timestamps held for the consumer
+#define TSD_TX_QUEUE            8
+#define TSD_RX_QUEUE            16
+
+// Timestamps the PHY queues in PTP_TXTS
+#define TSD_PHY_TX_QUEUE        4
+
+// MDIO transactions per timestamp read from the registers: the PTP_STS read
+// of PTPCheckForEvents() plus four PTP_TXTS or six PTP_RXTS reads
+#define TSD_TX_REG_OPS          5
+#define TSD_RX_REG_OPS          7
+
+// Delivery modes, in order of preference when MDIO capacity allows
+typedef enum EPL_TSD_MODE_ENUM {
+    TSD_MODE_REGISTER,          // PTP_TXTS and PTP_RXTS register reads
+    TSD_MODE_INSERT,            // Receive timestamps inserted into the frames
+                                // (RXOPT_TS_INSERT), transmit from PTP_TXTS
+    TSD_MODE_PSF,               // PHY Status Frames (STSOPT_TXTS_EN/RXTS_EN)
+    TSD_NUM_MODES
+} EPL_TSD_MODE_ENUM;
+
+#define TSD_MODE_BIT(mode)      (1 << (mode))
+
+typedef struct EPL_TSD_CFG {
+    NS_UINT modeMask;           // TSD_MODE_BIT()s of the modes the port is
+                                // configured for
+    EPL_TSD_MODE_ENUM initialMode;
+    NS_BOOL autoSelect;         // EPLTsdService() switches modes
+    NS_UINT32 windowUs;         // Measurement window
+    NS_UINT32 mdioOpsPerSec;    // MDIO capacity of the bus
+    NS_UINT highPermille;       // A mode projected to use more of the MDIO
+                                // capacity than this is left
+    NS_UINT lowPermille;        // A preferred mode projected to use less
+                                // than this is returned to
+    NS_UINT32 drainUs;          // Time Status Frames and frames with inserted
+                                // timestamps may arrive after a switch
+} EPL_TSD_CFG, *PEPL_TSD_CFG;
+
+typedef struct EPL_TSD_TS {
+    PTP_TIME time;              // 48-bit seconds
+    NS_UINT16 sequenceId;       // Receive only
+    NS_UINT16 typeHash;         // Receive only, messageType << 12 | hash
+    NS_BOOL psf;                // Delivered by a Status Frame
+} EPL_TSD_TS;
+
+// Status Frame messages other than transmit and receive timestamps
+typedef void (*EPL_TSD_CALLBACK)(
+    IN PEPL_PORT_HANDLE portHandle,
+    IN PHYMSG_MESSAGE_TYPE_ENUM messageType,
+    IN PHYMSG_MESSAGE *message,
+    IN void *context);
+
+typedef struct EPL_TSD {
+    PEPL_PORT_HANDLE portHandle;
+    EPL_TSD_CFG cfg;
+    EPL_TSD_MODE_ENUM mode;
+    EPL_TSD_CALLBACK callback;
+    void *context;
+
+    // Timestamps not yet taken, oldest first. Transmit timestamps are kept
+    // in time order.
+    EPL_TSD_TS txQueue[TSD_TX_QUEUE];
+    NS_UINT txCount;
+    EPL_TSD_TS rxQueue[TSD_RX_QUEUE];
+    NS_UINT rxCount;
+
+    // Previous mode's timestamps still in flight after a switch
+    NS_UINT32 switchTime;       // OAIGetTimeStamp() of the last switch
+    NS_BOOL psfDraining;
+    NS_BOOL insertDraining;
+
+    // Measurement window
+    NS_UINT32 windowStart;      // OAIGetTimeStamp()
+    NS_UINT32 windowMdio;       // Port MDIO count at windowStart
+    NS_UINT32 windowTx;         // Timestamps taken
+    NS_UINT32 windowRx;
+    NS_UINT32 windowTsMdio;     // MDIO transactions reading timestamps
+
+    // Last completed window
+    NS_UINT32 txPerSec;
+    NS_UINT32 rxPerSec;
+    NS_UINT mdioPermille;       // Port MDIO utilization
+    NS_UINT projectedPermille[TSD_NUM_MODES];
+
+    // Statistics
+    NS_UINT32 txTimestamps;
+    NS_UINT32 rxTimestamps;
+    NS_UINT32 psfFrames;
+    NS_UINT32 tsMdio;           // MDIO transactions reading timestamps
+    NS_UINT32 switches;
+    NS_UINT32 overflows;        // Dropped by the PHY (queue overflow counts)
+    NS_UINT32 discarded;        // Dropped from a full queue, never taken
+    NS_UINT32 drainsCut;        // Status Frame drains ended by a full queue
+    NS_UINT32 unextended;       // Dropped, seconds could not be extended
+} EPL_TSD, *PEPL_TSD;
+
+// EPL Function Prototypes
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+EXPORT void
+    EPLTsdGetDefaultConfig (
+        IN OUT PEPL_TSD_CFG tsdConfig);
+
+EXPORT NS_STATUS
+    EPLTsdInit (
+        IN OUT PEPL_TSD tsd,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN PEPL_TSD_CFG tsdConfig,
+        IN EPL_TSD_CALLBACK callback,
+        IN void *context);
+
+EXPORT NS_BOOL
+    EPLTsdProcessFrame (
+        IN OUT PEPL_TSD tsd,
+        IN NS_UINT8 *frameBuffer,
+        IN NS_UINT frameLength);
+
+EXPORT NS_STATUS
+    EPLTsdGetTxTimestamp (
+        IN OUT PEPL_TSD tsd,
+        OUT PPTP_TIME timestamp);
+
+EXPORT NS_STATUS
+    EPLTsdGetRxTimestamp (
+        IN OUT PEPL_TSD tsd,
+        IN OUT NS_UINT8 *ptpMessage,
+        OUT PPTP_TIME timestamp);
+
+EXPORT NS_STATUS
+    EPLTsdSetMode (
+        IN OUT PEPL_TSD tsd,
+        IN EPL_TSD_MODE_ENUM mode);
+
+EXPORT EPL_TSD_MODE_ENUM
+    EPLTsdService (
+        IN OUT PEPL_TSD tsd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _EPL_TSD_INCLUDE
@@ -24,6 +24,8 @@ typedef unsigned short int  NS_UINT16;  // unsigned 16-bit fixed
 typedef short int           NS_SINT16;  // signed 16-bit fixed 
 typedef unsigned long int   NS_UINT32;  // unsigned 32-bit fixed
 typedef long int            NS_SINT32;  // signed 32-bit fixed
+typedef unsigned long long  NS_UINT64;  // unsigned 64-bit fixed
+typedef long long           NS_SINT64;  // signed 64-bit fixed
 typedef unsigned char       NS_CHAR;
 typedef unsigned char       NS_BOOL;    // TRUE or FALSE
 
@@ -99,6 +101,13 @@ typedef struct DEVICE_OBJ {
 }DEVICE_OBJ,*PDEVICE_OBJ;
 */
  
+// IEEE 1588 time or time difference, see epl_time.h. Normalized when
+// 0 <= nanoSeconds < 10^9; negative times have negative seconds.
+typedef struct PTP_TIME {
+    NS_SINT64 seconds;
+    NS_SINT32 nanoSeconds;
+} PTP_TIME, *PPTP_TIME;
+
 typedef struct PORT_OBJ {
 //    struct PORT_OBJ *link;              // Must be first field in struct
     OAI_DEV_HANDLE oaiDevHandle;
@@ -109,10 +118,23 @@ typedef struct PORT_OBJ {
     NS_UINT tsSecondsLen;
     NS_UINT rxTsNanoSecOffset;
     NS_UINT rxTsSecondsOffset;
+    NS_UINT rxTsNanoField;              // Inserted timestamp location from the
+    NS_UINT rxTsSecField;               // start of the PTP message
+    NS_UINT rxTsSecBytes;               // Inserted seconds octets, 0 - 4
+    PTP_TIME tsRef;                     // Reference time for reconstructing
+                                        // truncated timestamp seconds
+    NS_BOOL tsRefValid;
     NS_UINT psfConfigOptions;
 //    void *psfList;
     NS_UINT8 psfSrcMacAddr[6];
 //    void *pktList;
+    NS_UINT pageCache;                  // Selected register page + 1, 0 = unknown
+    NS_UINT32 mdioAccessCount;          // Number of MDIO transactions issued
+    struct EPL_MDIO_SCHED *mdioSched;   // Scheduler of timestamp and monitor
+                                        // traffic, NULL = direct access
+#ifdef EPL_TRACE_ENABLE
+    NS_UINT traceCaller;                // EPL_TRACE_ID_xxx of the API in progress
+#endif
 }PORT_OBJ,*PPORT_OBJ;
 
 #define PEPL_DEV_HANDLE     PDEVICE_OBJ
@@ -0,0 +1,98 @@
+//****************************************************************************
+// epl_xts.h
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// This file contains all of the PHY to system clock cross-timestamping
+// related definitions and prototypes
+//
+//****************************************************************************
+
+#ifndef _EPL_XTS_INCLUDE
+#define _EPL_XTS_INCLUDE
+
+#include "epl.h"
+
+// (system, PHY) timestamp pairs in the regression window, 3 - 64
+#define XTS_WINDOW              16
+
+// A pair further than this from the current mapping restarts the window
+// (one of the clocks was stepped)
+#define XTS_RESTART_NS          100000
+
+typedef struct EPL_XTS_PAIR {
+    NS_UINT64 sysTime;          // System time of the edge, ns
+    NS_UINT64 phcTime;          // PHY 1588 clock time of the edge, ns
+} EPL_XTS_PAIR;
+
+typedef struct EPL_XTS_MAPPING {
+    NS_UINT64 sysRef;           // Reference point of the mapping, ns
+    NS_UINT64 phcRef;
+    NS_SINT64 rate;             // PHC rate relative to system - 1, 2^-32 units
+    NS_SINT32 ratePpb;          // Same, in parts per billion
+    NS_UINT32 residualRmsNs;    // RMS deviation of the pairs from the fit
+    NS_UINT32 residualMaxNs;    // Largest deviation of a pair from the fit
+    NS_UINT32 errorNs;          // Estimated error of the mapping at sysRef
+    NS_UINT numPairs;           // Pairs the mapping was fitted to
+} EPL_XTS_MAPPING, *PEPL_XTS_MAPPING;
+
+typedef struct EPL_XTS {
+    PEPL_PORT_HANDLE portHandle;
+    NS_UINT event;
+    EPL_XTS_PAIR pair[XTS_WINDOW];
+    NS_UINT head;               // Next pair to be written
+    NS_UINT count;
+    NS_BOOL haveMapping;
+    EPL_XTS_MAPPING mapping;
+    NS_UINT32 restarts;         // Window restarts caused by clock steps
+} EPL_XTS, *PEPL_XTS;
+
+// EPL Function Prototypes
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+EXPORT void
+    EPLXtsInit (
+        IN OUT PEPL_XTS xts,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_UINT event,
+        IN NS_UINT gpio);
+
+EXPORT NS_STATUS
+    EPLXtsCapture (
+        IN OUT PEPL_XTS xts,
+        IN NS_UINT64 sysTime);
+
+EXPORT NS_BOOL
+    EPLXtsAddPair (
+        IN OUT PEPL_XTS xts,
+        IN NS_UINT64 sysTime,
+        IN NS_UINT32 phcSeconds,
+        IN NS_UINT32 phcNanoSeconds);
+
+EXPORT NS_BOOL
+    EPLXtsGetMapping (
+        IN PEPL_XTS xts,
+        OUT PEPL_XTS_MAPPING mapping);
+
+EXPORT NS_BOOL
+    EPLXtsSysToPhc (
+        IN PEPL_XTS xts,
+        IN NS_UINT64 sysTime,
+        OUT NS_UINT32 *phcSeconds,
+        OUT NS_UINT32 *phcNanoSeconds);
+
+EXPORT NS_BOOL
+    EPLXtsPhcToSys (
+        IN PEPL_XTS xts,
+        IN NS_UINT32 phcSeconds,
+        IN NS_UINT32 phcNanoSeconds,
+        OUT NS_UINT64 *sysTime);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _EPL_XTS_INCLUDE
@@ -27,6 +27,10 @@
 //      PTPGetTransmitTimestamp
 //      PTPGetReceiveTimestamp
 //      PTPGetTimestampFromFrame
+//      PTPGetTimestampsFromFrames
+//      PTPSetTimestampReference
+//      PTPExtendTimestamp
+//      PTPGetFullTimestampFromFrame
 //      PTPArmTrigger
 //      PTPHasTriggerExpired
 //      PTPCancelTrigger
@@ -38,6 +42,107 @@
 
 #include "epl/epl.h"
 
+// Seconds of the PHY clock, the rest of the 48-bit PTP seconds is software
+#define PTP_PHC_SECONDS_MASK    0xFFFFFFFFULL
+#define PTP_SECONDS_MASK        0xFFFFFFFFFFFFULL
+
+//****************************************************************************
+static NS_UINT64
+    ExtendSeconds (
+        IN PPTP_TIME refTime,
+        IN NS_UINT32 partialSeconds,
+        IN NS_UINT secondsBits,
+        IN NS_UINT32 nanoSeconds)
+//  Returns the 48-bit seconds of a timestamp of which only the low
+//  secondsBits (0 - 32) bits of seconds are known, picking the value that
+//  puts the timestamp within half a wrap period of the reference time.
+//****************************************************************************
+{
+NS_SINT64 period, halfPeriodNs, seconds, delta;
+
+    period = (NS_SINT64)1 << secondsBits;
+    halfPeriodNs = period * (PTP_NS_PER_SEC / 2);
+
+    // First candidate, in the period starting at the reference seconds
+    seconds = (NS_SINT64)(((NS_UINT64)partialSeconds - refTime->seconds) & (period - 1));
+    delta = seconds * PTP_NS_PER_SEC + (NS_SINT64)nanoSeconds - refTime->nanoSeconds;
+
+    // Move it by one period into [-period/2, period/2) of the reference
+    seconds += refTime->seconds + period * ((delta < -halfPeriodNs) - (delta >= halfPeriodNs));
+    return (NS_UINT64)seconds & PTP_SECONDS_MASK;
+}
+
+//****************************************************************************
+static NS_UINT32
+    LoadClearField (
+        IN OUT NS_UINT8 *field,
+        IN NS_UINT numBytes)
+//  Returns a little endian field of up to 4 octets of an inserted timestamp
+//  and clears it. Byte accesses, so the field need not be aligned.
+//****************************************************************************
+{
+NS_UINT32 value = 0;
+NS_UINT x;
+
+    for ( x = 0; x < numBytes; x++)
+    {
+        value |= (NS_UINT32)field[x] << (8 * x);
+        field[x] = 0;
+    }
+    return value;
+}
+
+//****************************************************************************
+static void
+    UpdateTimestampReference (
+        IN PPORT_OBJ portHdl,
+        IN NS_UINT32 seconds,
+        IN NS_UINT32 nanoSeconds)
+//  Makes a PHY clock time (32-bit seconds, e.g. from a clock read or a
+//  timestamp) the reference for PTPExtendTimestamp(). The upper 16 bits of
+//  the seconds follow from the previous reference. All accesses to tsRef
+//  are made inside the multi critical section, and so must this call be.
+//****************************************************************************
+{
+    if ( portHdl->tsRefValid)
+        portHdl->tsRef.seconds = ExtendSeconds( &portHdl->tsRef, seconds, 32, nanoSeconds);
+    else
+        portHdl->tsRef.seconds = seconds;
+    portHdl->tsRef.nanoSeconds = nanoSeconds;
+    portHdl->tsRefValid = TRUE;
+}
+
+//****************************************************************************
+static NS_STATUS
+    ExtendFromReference (
+        IN PPORT_OBJ portHdl,
+        IN NS_UINT32 partialSeconds,
+        IN NS_UINT secondsBits,
+        IN NS_UINT32 nanoSeconds,
+        OUT NS_UINT64 *retNumberOfSeconds)
+//  PTPExtendTimestamp() without the tracepoints, so API entry points can
+//  use it without nesting.
+//****************************************************************************
+{
+NS_STATUS status;
+
+    OAIBeginMultiCriticalSection( portHdl->oaiDevHandle);
+    if ( portHdl->tsRefValid)
+    {
+        *retNumberOfSeconds = ExtendSeconds( &portHdl->tsRef, partialSeconds, secondsBits,
+                                             nanoSeconds);
+        portHdl->tsRef.seconds = *retNumberOfSeconds;
+        portHdl->tsRef.nanoSeconds = nanoSeconds;
+        status = NS_STATUS_SUCCESS;
+    }
+    else
+    {
+        status = NS_STATUS_FAILURE;
+    }
+    OAIEndMultiCriticalSection( portHdl->oaiDevHandle);
+    return status;
+}
+
 //****************************************************************************
 EXPORT void
     PTPEnable(
@@ -57,7 +162,10 @@ EXPORT void
 //      Nothing
 //****************************************************************************
 {
+    EPL_TRACE_API_ENTER( portHandle, PTPEnable);
+
     EPLWriteReg( portHandle, PHY_PG4_PTP_CTL, (enableFlag) ? P640_PTP_ENABLE : P640_PTP_DISABLE);
+    EPL_TRACE_API_EXIT( portHandle, PTPEnable);
     return;
 }
  
@@ -88,6 +196,8 @@ EXPORT void
 {
 NS_UINT reg;
 
+    EPL_TRACE_API_ENTER( portHandle, PTPSetTriggerConfig);
+
     reg = 0;
     if ( triggerBehavior & TRGOPT_PULSE)        reg |= P640_TRIG_PULSE;
     if ( triggerBehavior & TRGOPT_PERIODIC)     reg |= P640_TRIG_PER;
@@ -100,6 +210,7 @@ NS_UINT reg;
     reg |= P640_TRIG_WR;
     
     EPLWriteReg( portHandle, PHY_PG5_PTP_TRIG, reg);
+    EPL_TRACE_API_EXIT( portHandle, PTPSetTriggerConfig);
     return;
 }
  
@@ -135,6 +246,8 @@ EXPORT void
 {
 NS_UINT reg;
 
+    EPL_TRACE_API_ENTER( portHandle, PTPSetEventConfig);
+
     reg = 0;
     
     reg |= gpioConnection << P640_EVNT_GPIO_SHIFT;
@@ -146,6 +259,7 @@ NS_UINT reg;
     if ( eventFallFlag) reg |= P640_EVNT_FALL;
     if ( eventSingle) reg |= P640_EVNT_SINGLE;
     EPLWriteReg( portHandle, PHY_PG5_PTP_EVNT, reg);
+    EPL_TRACE_API_EXIT( portHandle, PTPSetEventConfig);
     return;
 }
 
@@ -184,6 +298,8 @@ EXPORT void
 {
 NS_UINT reg;
 
+    EPL_TRACE_API_ENTER( portHandle, PTPSetTransmitConfig);
+
     reg = 0;
     if ( txConfigOptions & TXOPT_SYNC_1STEP)    reg |= P640_SYNC_1STEP;
     if ( txConfigOptions & TXOPT_DR_INSERT)     reg |= P640_DR_INSERT;
@@ -202,6 +318,7 @@ NS_UINT reg;
 
     reg = (ptpFirstByteMask << P640_BYTE0_MASK_SHIFT) | (ptpFirstByteData << P640_BYTE0_DATA_SHIFT);
     EPLWriteReg( portHandle, PHY_PG5_PTP_TXCFG1, reg);
+    EPL_TRACE_API_EXIT( portHandle, PTPSetTransmitConfig);
     return;
 }
 
@@ -277,6 +394,8 @@ NS_UINT16 ocList[6] = { 0x4500, 0x0111, 0xE000, 0x0181, 0x0000, 0x0000 }; // Lit
 NS_UINT8  i;
 NS_UINT32 ipChecksum, rollover;
 
+    EPL_TRACE_API_ENTER( portHandle, PTPSetPhyStatusFrameConfig);
+
     ptr = srcAddrs[ srcAddrToUse ];
     portHdl->psfSrcMacAddr[0] = ptr[0];
     portHdl->psfSrcMacAddr[1] = ptr[1];
@@ -341,6 +460,7 @@ NS_UINT32 ipChecksum, rollover;
     EPLWriteReg( portHandle, PHY_PG6_PSF_CFG4, ipChecksum );
 
     portHdl->psfConfigOptions = statusConfigOptions;
+    EPL_TRACE_API_EXIT( portHandle, PTPSetPhyStatusFrameConfig);
     return;
 }
 
@@ -369,6 +489,8 @@ EXPORT void
 PPORT_OBJ portHdl = (PPORT_OBJ)portHandle;
 NS_UINT reg;
 
+    EPL_TRACE_API_ENTER( portHandle, PTPSetReceiveConfig);
+
     reg = 0;
     if ( rxConfigOptions & RXOPT_DOMAIN_EN)      reg |= P640_DOMAIN_EN;
     if ( rxConfigOptions & RXOPT_ALT_MAST_DIS)   reg |= P640_ALT_MAST_DIS;
@@ -407,11 +529,25 @@ NS_UINT reg;
     if ( rxConfigOptions & RXOPT_IPV4_UDP_MOD) reg |= P640_IPV4_UDP_MOD;
     if ( rxConfigOptions & RXOPT_TS_SEC_EN)    reg |= P640_TS_SEC_EN;
 
-    portHdl->tsSecondsLen = rxConfigItems->tsSecLen;
+    // 4 octets used to be passed as 4 rather than the field value 3
+    portHdl->tsSecondsLen = (rxConfigItems->tsSecLen == 4) ? 3 : rxConfigItems->tsSecLen;
     portHdl->rxTsNanoSecOffset = rxConfigItems->rxTsNanoSecOffset;
     portHdl->rxTsSecondsOffset = rxConfigItems->rxTsSecondsOffset;
+
+    // Inserted timestamp location, precomputed for the frame extraction
+    if ( rxConfigOptions & RXOPT_TS_APPEND)
+    {
+        portHdl->rxTsNanoField = PTP_EVENT_PACKET_LENGTH + portHdl->rxTsNanoSecOffset;
+        portHdl->rxTsSecField = portHdl->rxTsNanoField + portHdl->rxTsSecondsOffset;
+    }
+    else
+    {
+        portHdl->rxTsNanoField = portHdl->rxTsNanoSecOffset;
+        portHdl->rxTsSecField = portHdl->rxTsSecondsOffset;
+    }
+    portHdl->rxTsSecBytes = (rxConfigOptions & RXOPT_TS_SEC_EN) ? portHdl->tsSecondsLen + 1 : 0;
     
-    reg |= rxConfigItems->tsSecLen << P640_TS_SEC_LEN_SHIFT;
+    reg |= (portHdl->tsSecondsLen << P640_TS_SEC_LEN_SHIFT) & P640_TS_SEC_LEN_MASK;
     reg |= rxConfigItems->rxTsNanoSecOffset << P640_RXTS_NS_OFF_SHIFT;
     reg |= rxConfigItems->rxTsSecondsOffset << P640_RXTS_SEC_OFF_SHIFT;
     EPLWriteReg( portHandle, PHY_PG5_PTP_RXCFG4, reg);
@@ -419,6 +555,7 @@ NS_UINT reg;
     reg = rxConfigItems->srcIdHash << P640_PTP_RX_HASH_SHIFT;
     if ( rxConfigOptions & RXOPT_SRC_ID_HASH_EN) reg |= P640_RX_HASH_EN;
     EPLWriteReg( portHandle, PHY_PG6_PTP_RXHASH, reg);
+    EPL_TRACE_API_EXIT( portHandle, PTPSetReceiveConfig);
     return;
 }
 
@@ -488,8 +625,11 @@ EXPORT void
 //  remains constant.
 //****************************************************************************
 {
+    EPL_TRACE_API_ENTER( portHandle, PTPSetTempRateDurationConfig);
+
     EPLWriteReg( portHandle, PHY_PG5_PTP_TRDH, duration >> P640_PTP_RATE_HI_SHIFT);
     EPLWriteReg( portHandle, PHY_PG5_PTP_TRDL, duration & 0xFFFF);
+    EPL_TRACE_API_EXIT( portHandle, PTPSetTempRateDurationConfig);
     return;
 }
 
@@ -538,6 +678,8 @@ EXPORT void
 {
 NS_UINT reg;
 
+    EPL_TRACE_API_ENTER( portHandle, PTPSetClockConfig);
+
     reg = 0;
     if ( clockConfigOptions & CLKOPT_CLK_OUT_EN) reg |= P640_PTP_CLKOUT_EN;
     if ( clockConfigOptions & CLKOPT_CLK_OUT_SEL) reg |= P640_PTP_CLKOUT_SEL;
@@ -557,6 +699,7 @@ NS_UINT reg;
         reg |= PHYCR2_CLK_OUT_DIS;
     EPLWriteReg( portHandle, PHY_PG0_PHYCR2, reg);
     
+    EPL_TRACE_API_EXIT( portHandle, PTPSetClockConfig);
     return;
 }
 
@@ -580,7 +723,10 @@ EXPORT void
 //      Nothing
 //****************************************************************************
 {
+    EPL_TRACE_API_ENTER( portHandle, PTPSetGpioInterruptConfig);
+
     EPLWriteReg( portHandle, PHY_PG6_PTP_INTCTL, gpioInt);
+    EPL_TRACE_API_EXIT( portHandle, PTPSetGpioInterruptConfig);
     return;
 }
 
@@ -620,11 +766,14 @@ EXPORT void
 //      Nothing
 //****************************************************************************
 {
+    EPL_TRACE_API_ENTER( portHandle, PTPSetMiscConfig);
+
     EPLWriteReg( portHandle, PHY_PG6_PTP_ETR, ptpEtherType);
     EPLWriteReg( portHandle, PHY_PG6_PTP_OFF, ptpOffset);
     EPLWriteReg( portHandle, PHY_PG6_PTP_SFDCFG, 
                  (txSfdGpio << P640_TX_SFD_GPIO_SHIFT) | 
                  (rxSfdGpio << P640_RX_SFD_GPIO_SHIFT));
+    EPL_TRACE_API_EXIT( portHandle, PTPSetMiscConfig);
     return;
 }
 
@@ -652,6 +801,8 @@ EXPORT void
 //      Nothing
 //****************************************************************************
 {
+    EPL_TRACE_API_ENTER( portHandle, PTPClockReadCurrent);
+
     OAIBeginMultiCriticalSection( portHandle->oaiDevHandle);
     EPLWriteReg( portHandle, PHY_PG4_PTP_CTL, P640_PTP_RD_CLK);
     
@@ -659,7 +810,9 @@ EXPORT void
     *retNumberOfNanoSeconds |= EPLReadReg( portHandle, PHY_PG4_PTP_TDR) << 16;
     *retNumberOfSeconds  = EPLReadReg( portHandle, PHY_PG4_PTP_TDR);
     *retNumberOfSeconds |= EPLReadReg( portHandle, PHY_PG4_PTP_TDR) << 16;
+    UpdateTimestampReference( portHandle, *retNumberOfSeconds, *retNumberOfNanoSeconds);
     OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
+    EPL_TRACE_API_EXIT( portHandle, PTPClockReadCurrent);
     return;
 }
 
@@ -700,20 +853,31 @@ EXPORT void
 //  value.
 //****************************************************************************
 {
-    if ( negativeAdj)
-    {
-        // Convert to 2's complement
-        numberOfSeconds = (NS_UINT32)((0x100000000 - (long long)numberOfSeconds) & 0xFFFFFFFF);
-        numberOfNanoSeconds = (NS_UINT32)((0x100000000 - numberOfNanoSeconds) & 0xFFFFFFFF);
-    }
-        
+PTP_TIME step;
+
+    EPL_TRACE_API_ENTER( portHandle, PTPClockStepAdjustment);
+
+    // Both fields negated, the hardware adds them separately
+    step.seconds = negativeAdj ? -(NS_SINT64)numberOfSeconds : (NS_SINT64)numberOfSeconds;
+    step.nanoSeconds = negativeAdj ? -(NS_SINT32)numberOfNanoSeconds : (NS_SINT32)numberOfNanoSeconds;
+
+    // 2's complement
+    numberOfSeconds = (NS_UINT32)(step.seconds & 0xFFFFFFFF);
+    numberOfNanoSeconds = (NS_UINT32)(step.nanoSeconds & 0xFFFFFFFF);
+
     OAIBeginMultiCriticalSection( portHandle->oaiDevHandle);
+
+    // Move the seconds reconstruction reference with the clock
+    PTPTimeAdd( &portHandle->tsRef, &portHandle->tsRef, &step);
+    portHandle->tsRef.seconds &= PTP_SECONDS_MASK;
+
     EPLWriteReg( portHandle, PHY_PG4_PTP_TDR, numberOfNanoSeconds & 0xFFFF);
     EPLWriteReg( portHandle, PHY_PG4_PTP_TDR, numberOfNanoSeconds >> 16);
     EPLWriteReg( portHandle, PHY_PG4_PTP_TDR, numberOfSeconds & 0xFFFF);
     EPLWriteReg( portHandle, PHY_PG4_PTP_TDR, numberOfSeconds >> 16);
     EPLWriteReg( portHandle, PHY_PG4_PTP_CTL, P640_PTP_STEP_CLK);
     OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
+    EPL_TRACE_API_EXIT( portHandle, PTPClockStepAdjustment);
     return;
 
 }
@@ -740,13 +904,21 @@ EXPORT void
 //      Nothing
 //****************************************************************************
 {
+    EPL_TRACE_API_ENTER( portHandle, PTPClockSet);
+
     OAIBeginMultiCriticalSection( portHandle->oaiDevHandle);
     EPLWriteReg( portHandle, PHY_PG4_PTP_TDR, numberOfNanoSeconds & 0xFFFF);
     EPLWriteReg( portHandle, PHY_PG4_PTP_TDR, numberOfNanoSeconds >> 16);
     EPLWriteReg( portHandle, PHY_PG4_PTP_TDR, numberOfSeconds & 0xFFFF);
     EPLWriteReg( portHandle, PHY_PG4_PTP_TDR, numberOfSeconds >> 16);
     EPLWriteReg( portHandle, PHY_PG4_PTP_CTL, P640_PTP_LOAD_CLK);
+
+    // Keep the upper 16 bits of the seconds reconstruction reference
+    portHandle->tsRef.seconds = (portHandle->tsRef.seconds & ~PTP_PHC_SECONDS_MASK) | numberOfSeconds;
+    portHandle->tsRef.nanoSeconds = numberOfNanoSeconds;
+    portHandle->tsRefValid = TRUE;
     OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
+    EPL_TRACE_API_EXIT( portHandle, PTPClockSet);
     return;
 }
 
@@ -834,6 +1006,8 @@ EXPORT void
 {
 NS_UINT reg;
 
+    EPL_TRACE_API_ENTER( portHandle, PTPClockSetRateAdjustment);
+
     reg = (rateAdjValue >> P640_PTP_RATE_HI_SHIFT) & P640_PTP_RATE_HI_MASK;
     if ( tempAdjFlag) reg |= P640_PTP_TMP_RATE;
     if ( adjDirectionFlag) reg |= P640_PTP_RATE_DIR;
@@ -842,6 +1016,7 @@ NS_UINT reg;
     EPLWriteReg( portHandle, PHY_PG4_PTP_RATEH, reg);
     EPLWriteReg( portHandle, PHY_PG4_PTP_RATEL, rateAdjValue & 0xFFFF);
     OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
+    EPL_TRACE_API_EXIT( portHandle, PTPClockSetRateAdjustment);
     return;
 }
 
@@ -854,6 +1029,8 @@ EXPORT void
 {
 NS_UINT reg;
 
+    EPL_TRACE_API_ENTER( portHandle, PTPClockGetRateAdjustment);
+
     OAIBeginMultiCriticalSection( portHandle->oaiDevHandle);
     reg = EPLReadReg( portHandle, PHY_PG4_PTP_RATEH);
 
@@ -868,6 +1045,7 @@ NS_UINT reg;
     *rateAdjValue |= reg & 0xFFFF;    
     
     OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
+    EPL_TRACE_API_EXIT( portHandle, PTPClockGetRateAdjustment);
     return;
 }
 
@@ -908,14 +1086,26 @@ EXPORT NS_UINT
 //  as the other types of events with a single call.
 //****************************************************************************
 {
+EPL_MDIO_OP op;
 NS_UINT reg, eventFlags;
 
-    reg = EPLReadReg( portHandle, PHY_PG4_PTP_STS);
+    EPL_TRACE_API_ENTER( portHandle, PTPCheckForEvents);
+
+    if ( portHandle->mdioSched)
+    {
+        op.flags = MDIO_OP_READ;
+        op.registerIndex = PHY_PG4_PTP_STS;
+        EPLMdioRun( portHandle, MDIO_CLASS_TIMESTAMP, &op, 1, TRUE);
+        reg = op.value;
+    }
+    else
+        reg = EPLReadReg( portHandle, PHY_PG4_PTP_STS);
     eventFlags = 0;
     if ( reg & P640_TXTS_RDY) eventFlags |= PTPEVT_TRANSMIT_TIMESTAMP_BIT;
     if ( reg & P640_RXTS_RDY) eventFlags |= PTPEVT_RECEIVE_TIMESTAMP_BIT;
     if ( reg & P640_TRIG_DONE) eventFlags |= PTPEVT_TRIGGER_DONE_BIT;
     if ( reg & P640_EVENT_RDY) eventFlags |= PTPEVT_EVENT_TIMESTAMP_BIT;
+    EPL_TRACE_API_EXIT( portHandle, PTPCheckForEvents);
     return eventFlags;
 }
 
@@ -962,16 +1152,32 @@ EXPORT void
 //  10ns to the timestamp value.
 //****************************************************************************
 {
+EPL_MDIO_REQUEST request;
+EPL_MDIO_OP ops[MDIO_TXTS_OPS];
 NS_UINT reg;
 
-    OAIBeginMultiCriticalSection( portHandle->oaiDevHandle);
-    *retNumberOfNanoSeconds = EPLReadReg( portHandle, PHY_PG4_PTP_TXTS);
-    reg = EPLReadReg( portHandle, PHY_PG4_PTP_TXTS);
-    *overflowCount = (reg & 0xC000) >> 14;
-    *retNumberOfNanoSeconds |= (reg & 0x3FFF) << 16;
-    *retNumberOfSeconds = EPLReadReg( portHandle, PHY_PG4_PTP_TXTS);
-    *retNumberOfSeconds |= EPLReadReg( portHandle, PHY_PG4_PTP_TXTS) << 16;
+    EPL_TRACE_API_ENTER( portHandle, PTPGetTransmitTimestamp);
+
+    if ( portHandle->mdioSched)
+    {
+        EPLMdioPrepareTxTimestamp( &request, portHandle, ops);
+        EPLMdioExecute( portHandle->mdioSched, &request);
+        EPLMdioGetTxTimestamp( &request, retNumberOfSeconds, retNumberOfNanoSeconds, overflowCount);
+        OAIBeginMultiCriticalSection( portHandle->oaiDevHandle);
+    }
+    else
+    {
+        OAIBeginMultiCriticalSection( portHandle->oaiDevHandle);
+        *retNumberOfNanoSeconds = EPLReadReg( portHandle, PHY_PG4_PTP_TXTS);
+        reg = EPLReadReg( portHandle, PHY_PG4_PTP_TXTS);
+        *overflowCount = (reg & 0xC000) >> 14;
+        *retNumberOfNanoSeconds |= (reg & 0x3FFF) << 16;
+        *retNumberOfSeconds = EPLReadReg( portHandle, PHY_PG4_PTP_TXTS);
+        *retNumberOfSeconds |= EPLReadReg( portHandle, PHY_PG4_PTP_TXTS) << 16;
+    }
+    UpdateTimestampReference( portHandle, *retNumberOfSeconds, *retNumberOfNanoSeconds);
     OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
+    EPL_TRACE_API_EXIT( portHandle, PTPGetTransmitTimestamp);
     return;
 }
 
@@ -1049,21 +1255,38 @@ EXPORT void
 //  26 bit times) by subtracting 210ns from the returned value.
 //****************************************************************************
 {
+EPL_MDIO_REQUEST request;
+EPL_MDIO_OP ops[MDIO_RXTS_OPS];
 NS_UINT reg;
 
-    OAIBeginMultiCriticalSection( portHandle->oaiDevHandle);
-    *retNumberOfNanoSeconds = EPLReadReg( portHandle, PHY_PG4_PTP_RXTS);
-    reg = EPLReadReg( portHandle, PHY_PG4_PTP_RXTS);
-    *overflowCount = (reg & 0xC000) >> 14;
-    *retNumberOfNanoSeconds |= (reg & 0x3FFF) << 16;
-    *retNumberOfSeconds = EPLReadReg( portHandle, PHY_PG4_PTP_RXTS);
-    *retNumberOfSeconds |= EPLReadReg( portHandle, PHY_PG4_PTP_RXTS) << 16;
-    *sequenceId = EPLReadReg( portHandle, PHY_PG4_PTP_RXTS);
-    reg = EPLReadReg( portHandle, PHY_PG4_PTP_RXTS);
+    EPL_TRACE_API_ENTER( portHandle, PTPGetReceiveTimestamp);
+
+    if ( portHandle->mdioSched)
+    {
+        EPLMdioPrepareRxTimestamp( &request, portHandle, ops);
+        EPLMdioExecute( portHandle->mdioSched, &request);
+        EPLMdioGetRxTimestamp( &request, retNumberOfSeconds, retNumberOfNanoSeconds, overflowCount,
+                               sequenceId, messageType, hashValue);
+        OAIBeginMultiCriticalSection( portHandle->oaiDevHandle);
+    }
+    else
+    {
+        OAIBeginMultiCriticalSection( portHandle->oaiDevHandle);
+        *retNumberOfNanoSeconds = EPLReadReg( portHandle, PHY_PG4_PTP_RXTS);
+        reg = EPLReadReg( portHandle, PHY_PG4_PTP_RXTS);
+        *overflowCount = (reg & 0xC000) >> 14;
+        *retNumberOfNanoSeconds |= (reg & 0x3FFF) << 16;
+        *retNumberOfSeconds = EPLReadReg( portHandle, PHY_PG4_PTP_RXTS);
+        *retNumberOfSeconds |= EPLReadReg( portHandle, PHY_PG4_PTP_RXTS) << 16;
+        *sequenceId = EPLReadReg( portHandle, PHY_PG4_PTP_RXTS);
+        reg = EPLReadReg( portHandle, PHY_PG4_PTP_RXTS);
+
+        *messageType = reg >> 12;
+        *hashValue = reg & 0x0FFF;
+    }
+    UpdateTimestampReference( portHandle, *retNumberOfSeconds, *retNumberOfNanoSeconds);
     OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
-    
-    *messageType = reg >> 12;
-    *hashValue = reg & 0x0FFF;
+    EPL_TRACE_API_EXIT( portHandle, PTPGetReceiveTimestamp);
     return;
 }
 
@@ -1110,54 +1333,254 @@ EXPORT void
 //****************************************************************************
 {
 PPORT_OBJ portHdl = (PPORT_OBJ)portHandle;
-NS_UINT8 *nanoField, *secField;
-NS_UINT opts;
 
-    opts = portHdl->rxConfigOptions;
-    if ( !(opts & RXOPT_TS_INSERT))
+    EPL_TRACE_API_ENTER( portHandle, PTPGetTimestampFromFrame);
+
+    if ( !(portHdl->rxConfigOptions & RXOPT_TS_INSERT))
+    {
+        EPL_TRACE_API_EXIT( portHandle, PTPGetTimestampFromFrame);
         return;
+    }
+
+    // The timestamp is located at the configured offsets from the start of
+    // the PTP message, or from its end with RXOPT_TS_APPEND.
+    *retNumberOfNanoSeconds = LoadClearField( &receiveFrameData[portHdl->rxTsNanoField], 4);
+    *retNumberOfSeconds = LoadClearField( &receiveFrameData[portHdl->rxTsSecField],
+                                          portHdl->tsSecondsLen + 1);
+    
+    EPL_TRACE_API_EXIT( portHandle, PTPGetTimestampFromFrame);
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    PTPGetTimestampsFromFrames (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_UINT8 **receiveFrameData,
+        IN NS_UINT numFrames,
+        OUT NS_UINT64 *retTimes)
+
+//  Extracts the embedded receive timestamps from a batch of received PTP 
+//  frames.
+//  
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort 
+//      function.
+//  receiveFrameData
+//      Array of pointers to the start of the PTP header of each frame, in 
+//      the order the frames were received.
+//  numFrames
+//      Number of frames.
+//  retTimes
+//      Array of numFrames entries. Will be set on return to the timestamp of 
+//      each frame in nanoseconds (full 48-bit seconds * 10^9 + nanoseconds).
+//
+//  Returns
+//      NS_STATUS_SUCCESS - The timestamps were extracted
+//      NS_STATUS_FAILURE - Timestamp insertion is not enabled or no 
+//                          reference time is available
+//
+//  Equivalent to calling PTPGetFullTimestampFromFrame() for every frame. The 
+//  inserted fields are cleared. The field locations are precomputed by 
+//  PTPSetReceiveConfig() and read with byte accesses, so frames may be at 
+//  any alignment. Like PTPGetTimestampFromFrame(), the timestamps are not 
+//  adjusted for the delay from the wire.
+//****************************************************************************
+{
+PPORT_OBJ portHdl = (PPORT_OBJ)portHandle;
+NS_UINT nanoField, secField, secBytes, x;
+PTP_TIME refTime;
+
+    EPL_TRACE_API_ENTER( portHandle, PTPGetTimestampsFromFrames);
 
-    if ( opts & RXOPT_TS_APPEND)
+    if ( !(portHdl->rxConfigOptions & RXOPT_TS_INSERT))
     {
-        // Timestamp is located at the end of the PTP packet at the configured
-        // offsets from the end of the PTP message.
-        nanoField = &receiveFrameData[ PTP_EVENT_PACKET_LENGTH + portHdl->rxTsNanoSecOffset ];
-        secField = &nanoField[ portHdl->rxTsSecondsOffset ];
+        EPL_TRACE_API_EXIT( portHandle, PTPGetTimestampsFromFrames);
+        return NS_STATUS_FAILURE;
     }
-    else
+
+    nanoField = portHdl->rxTsNanoField;
+    secField = portHdl->rxTsSecField;
+    secBytes = portHdl->rxTsSecBytes;
+
+    // Pass 1: raw fields, seconds in the upper half
+    for ( x = 0; x < numFrames; x++)
     {
-        // Timestamp is located at the configured offsets from the start of the
-        // PTP message.
-        nanoField = &receiveFrameData[ portHdl->rxTsNanoSecOffset ];
-        secField = &receiveFrameData[ portHdl->rxTsSecondsOffset ];
+        retTimes[x] = LoadClearField( &receiveFrameData[x][nanoField], 4);
+        retTimes[x] |= (NS_UINT64)LoadClearField( &receiveFrameData[x][secField], secBytes) << 32;
     }
-            
-    *retNumberOfNanoSeconds = *(NS_UINT32*)nanoField;
-    *(NS_UINT32*)nanoField = 0L;
-    
-    if ( portHdl->tsSecondsLen == 0)
+
+    // Pass 2: each timestamp is the reference for the next one
+    OAIBeginMultiCriticalSection( portHdl->oaiDevHandle);
+    if ( !portHdl->tsRefValid)
     {
-        *retNumberOfSeconds = (NS_UINT32)*secField;
-        *secField = 0;
+        OAIEndMultiCriticalSection( portHdl->oaiDevHandle);
+        EPL_TRACE_API_EXIT( portHandle, PTPGetTimestampsFromFrames);
+        return NS_STATUS_FAILURE;
     }
-    else if ( portHdl->tsSecondsLen == 1)
+    refTime = portHdl->tsRef;
+    for ( x = 0; x < numFrames; x++)
     {
-        *retNumberOfSeconds = (NS_UINT32)*(NS_UINT16*)secField;
-        *(NS_UINT16*)secField = 0;
+        refTime.seconds = ExtendSeconds( &refTime, (NS_UINT32)(retTimes[x] >> 32), secBytes * 8,
+                                         (NS_UINT32)(retTimes[x] & 0xFFFFFFFF));
+        refTime.nanoSeconds = (NS_SINT32)(retTimes[x] & 0xFFFFFFFF);
+        retTimes[x] = (NS_UINT64)PTPTimeToNs( &refTime);
     }
-    else if ( portHdl->tsSecondsLen == 2)
+    portHdl->tsRef = refTime;
+    OAIEndMultiCriticalSection( portHdl->oaiDevHandle);
+
+    EPL_TRACE_API_EXIT( portHandle, PTPGetTimestampsFromFrames);
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT void
+    PTPSetTimestampReference (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_UINT64 numberOfSeconds,
+        IN NS_UINT32 numberOfNanoSeconds)
+
+//  Sets the reference time used to reconstruct truncated timestamp seconds.
+//  
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort 
+//      function.
+//  numberOfSeconds
+//      Full 48-bit PTP seconds of a recent IEEE 1588 clock time. The low 32 
+//      bits must match the hardware clock.
+//  numberOfNanoSeconds
+//      Nanoseconds of the reference time.
+//
+//  Returns
+//      Nothing
+//
+//  The reference is also refreshed, without any MDIO access of its own, by 
+//  PTPClockReadCurrent(), PTPClockSet(), PTPClockStepAdjustment(), 
+//  PTPGetTransmitTimestamp(), PTPGetReceiveTimestamp(), transmit and receive 
+//  timestamps parsed by GetNextPhyMessage(), and by every timestamp 
+//  reconstructed with PTPExtendTimestamp(). As the hardware clock only has 
+//  32 bits of seconds, this call is only needed to set the upper 16 bits 
+//  (which otherwise start at 0), or before the first timestamp when none of
+//  the above has been used.
+//****************************************************************************
+{
+    EPL_TRACE_API_ENTER( portHandle, PTPSetTimestampReference);
+    OAIBeginMultiCriticalSection( portHandle->oaiDevHandle);
+    portHandle->tsRef.seconds = numberOfSeconds & PTP_SECONDS_MASK;
+    portHandle->tsRef.nanoSeconds = numberOfNanoSeconds;
+    portHandle->tsRefValid = TRUE;
+    OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
+    EPL_TRACE_API_EXIT( portHandle, PTPSetTimestampReference);
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    PTPExtendTimestamp (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_UINT32 partialSeconds,
+        IN NS_UINT secondsBits,
+        IN NS_UINT32 numberOfNanoSeconds,
+        OUT NS_UINT64 *retNumberOfSeconds)
+
+//  Reconstructs the full 48-bit seconds of a timestamp of which only the 
+//  least significant bits of the seconds are known.
+//  
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort 
+//      function.
+//  partialSeconds
+//      Known low order bits of the seconds. Other bits are ignored.
+//  secondsBits
+//      Number of valid bits in partialSeconds, 0 - 32. With 0 the seconds are 
+//      derived from the nanoseconds alone.
+//  numberOfNanoSeconds
+//      Nanoseconds of the timestamp.
+//  retNumberOfSeconds
+//      Will be set on return to the full 48-bit seconds.
+//
+//  Returns
+//      NS_STATUS_SUCCESS - The seconds were reconstructed
+//      NS_STATUS_FAILURE - No reference time is available, see 
+//                          PTPSetTimestampReference()
+//      NS_STATUS_INVALID_PARM - secondsBits is larger than 32
+//
+//  The timestamp must be within half a wrap period (2^secondsBits / 2 
+//  seconds: 0.5s with no seconds, 128s with one octet) of the reference 
+//  time. The reconstructed timestamp becomes the new reference, so a steady
+//  stream of timestamps needs no further clock reads.
+//****************************************************************************
+{
+NS_STATUS status;
+
+    EPL_TRACE_API_ENTER( portHandle, PTPExtendTimestamp);
+
+    if ( secondsBits > 32)
     {
-        *retNumberOfSeconds = 0x00FFFFFF & *(NS_UINT32*)secField;
-        *(NS_UINT16*)secField = 0;
-        secField[2] = 0;
+        EPL_TRACE_API_EXIT( portHandle, PTPExtendTimestamp);
+        return NS_STATUS_INVALID_PARM;
     }
-    else if ( portHdl->tsSecondsLen == 4)
+
+    status = ExtendFromReference( portHandle, partialSeconds, secondsBits, numberOfNanoSeconds,
+                                  retNumberOfSeconds);
+
+    EPL_TRACE_API_EXIT( portHandle, PTPExtendTimestamp);
+    return status;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    PTPGetFullTimestampFromFrame (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_UINT8 *receiveFrameData,
+        OUT NS_UINT64 *retNumberOfSeconds,
+        OUT NS_UINT32 *retNumberOfNanoSeconds)
+
+//  Extracts the embedded receive timestamp from a received PTP frame and 
+//  reconstructs its full 48-bit seconds.
+//  
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort 
+//      function.
+//  receiveFrameData
+//      Points to the start of the PTP header.
+//  retNumberOfSeconds
+//      Will be set on return to the full 48-bit seconds of the timestamp.
+//  retNumberOfNanoSeconds
+//      Will be set on return to the nanoseconds of the timestamp.
+//
+//  Returns
+//      NS_STATUS_SUCCESS - The timestamp was extracted
+//      NS_STATUS_FAILURE - Timestamp insertion is not enabled or no 
+//                          reference time is available
+//
+//  Same as PTPGetTimestampFromFrame(), but the seconds inserted by the 
+//  hardware (none without RXOPT_TS_SEC_EN, otherwise 1 - 4 octets) are 
+//  extended using PTPExtendTimestamp(). This allows the shortest insertion 
+//  without ambiguous seconds and without any MDIO access per frame.
+//****************************************************************************
+{
+NS_UINT32 partialSeconds;
+NS_STATUS status;
+
+    EPL_TRACE_API_ENTER( portHandle, PTPGetFullTimestampFromFrame);
+
+    if ( !(portHandle->rxConfigOptions & RXOPT_TS_INSERT))
     {
-        *retNumberOfSeconds = *(NS_UINT32*)secField;
-        *(NS_UINT32*)secField = 0;
+        EPL_TRACE_API_EXIT( portHandle, PTPGetFullTimestampFromFrame);
+        return NS_STATUS_FAILURE;
     }
-    
-    return;
+
+    // As PTPGetTimestampFromFrame(), which is not called to keep the
+    // tracepoints from nesting
+    *retNumberOfNanoSeconds = LoadClearField( &receiveFrameData[portHandle->rxTsNanoField], 4);
+    partialSeconds = LoadClearField( &receiveFrameData[portHandle->rxTsSecField],
+                                     portHandle->rxTsSecBytes);
+    status = ExtendFromReference( portHandle, partialSeconds, portHandle->rxTsSecBytes * 8,
+                                  *retNumberOfNanoSeconds, retNumberOfSeconds);
+
+    EPL_TRACE_API_EXIT( portHandle, PTPGetFullTimestampFromFrame);
+    return status;
 }
 
 //****************************************************************************
@@ -1217,6 +1640,8 @@ EXPORT void
 {
 NS_UINT reg;
 
+    EPL_TRACE_API_ENTER( portHandle, PTPArmTrigger);
+
     OAIBeginMultiCriticalSection( portHandle->oaiDevHandle);
     reg = (trigger << P640_TRIG_SEL_SHIFT) | P640_TRIG_LOAD;
     EPLWriteReg( portHandle, PHY_PG4_PTP_CTL, reg);
@@ -1240,6 +1665,7 @@ NS_UINT reg;
     reg = (trigger << P640_TRIG_SEL_SHIFT) | P640_TRIG_EN;
     EPLWriteReg( portHandle, PHY_PG4_PTP_CTL, reg);
     OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
+    EPL_TRACE_API_EXIT( portHandle, PTPArmTrigger);
     return;
 }
  
@@ -1276,15 +1702,24 @@ EXPORT NS_STATUS
 {
 NS_UINT reg, trgBit;
 
+    EPL_TRACE_API_ENTER( portHandle, PTPHasTriggerExpired);
+
     OAIBeginMultiCriticalSection( portHandle->oaiDevHandle);
     reg = EPLReadReg( portHandle, PHY_PG4_PTP_TSTS);
     OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
     
     trgBit = 1 << (trigger * 2);
     if ( reg & trgBit)
+    {
+        EPL_TRACE_API_EXIT( portHandle, PTPHasTriggerExpired);
         return NS_STATUS_FAILURE;
+    }
     if ( reg & (trgBit << 1))
+    {
+        EPL_TRACE_API_EXIT( portHandle, PTPHasTriggerExpired);
         return NS_STATUS_INVALID_PARM;
+    }
+    EPL_TRACE_API_EXIT( portHandle, PTPHasTriggerExpired);
     return NS_STATUS_SUCCESS;
 }
 
@@ -1312,11 +1747,14 @@ EXPORT void
 {
 NS_UINT reg;
 
+    EPL_TRACE_API_ENTER( portHandle, PTPCancelTrigger);
+
     reg = (trigger << P640_TRIG_SEL_SHIFT) | P640_TRIG_DIS;
     OAIBeginMultiCriticalSection( portHandle->oaiDevHandle);
     EPLWriteReg( portHandle, PHY_PG4_PTP_CTL, reg);
     OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
     
+    EPL_TRACE_API_EXIT( portHandle, PTPCancelTrigger);
     return;
 }
 
@@ -1368,60 +1806,76 @@ EXPORT NS_BOOL
 {
 //PPORT_OBJ portHdl = (PPORT_OBJ)portHandle;
 NS_UINT reg, exSts, x;
+PTP_TIME eventTime, inputDelay = { 0, PIN_INPUT_DELAY};
+EPL_MDIO_REQUEST request;
+EPL_MDIO_OP ops[MDIO_EVENT_OPS];
+
+    EPL_TRACE_API_ENTER( portHandle, PTPGetEvent);
 
     *eventBits = 0;
     *riseFlags = 0;
 
-    OAIBeginMultiCriticalSection( portHandle->oaiDevHandle);
-    reg = EPLReadReg( portHandle, PHY_PG4_PTP_ESTS);
-    
-    *eventsMissed = (reg & P640_EVNTS_MISSED_MASK) >> P640_EVNTS_MISSED_SHIFT;
-    
-    if ( !(reg & P640_EVENT_DET))
-    {
-        OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
-        return FALSE;
-    }
-        
-    if ( reg & P640_MULT_EVENT)
+    if ( portHandle->mdioSched)
     {
-        exSts = EPLReadReg( portHandle, PHY_PG4_PTP_EDATA);
-        
-        for ( x = 8; x; x--)
+        EPLMdioPrepareEvent( &request, portHandle, ops);
+        EPLMdioExecute( portHandle->mdioSched, &request);
+        if ( !EPLMdioGetEvent( &request, eventBits, riseFlags, eventTimeSeconds,
+                               eventTimeNanoSeconds, eventsMissed))
         {
-            if ( exSts & 0x40)
-                *eventBits |= 1 << (x-1);
-                if ( exSts & 0x80)
-                    *riseFlags |= 1 << (x-1);    
-            exSts <<= 2;
+            EPL_TRACE_API_EXIT( portHandle, PTPGetEvent);
+            return FALSE;
         }
     }
-    else    
+    else
     {
-        *eventBits |= 1 << ((reg & P640_EVNT_NUM_MASK) >> P640_EVNT_NUM_SHIFT);
-        *riseFlags |= ((reg & P640_EVNT_RF) ? 1 : 0) << ((reg & P640_EVNT_NUM_MASK) >> P640_EVNT_NUM_SHIFT);
+        OAIBeginMultiCriticalSection( portHandle->oaiDevHandle);
+        reg = EPLReadReg( portHandle, PHY_PG4_PTP_ESTS);
+
+        *eventsMissed = (reg & P640_EVNTS_MISSED_MASK) >> P640_EVNTS_MISSED_SHIFT;
+
+        if ( !(reg & P640_EVENT_DET))
+        {
+            OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
+            EPL_TRACE_API_EXIT( portHandle, PTPGetEvent);
+            return FALSE;
+        }
+
+        if ( reg & P640_MULT_EVENT)
+        {
+            exSts = EPLReadReg( portHandle, PHY_PG4_PTP_EDATA);
+
+            for ( x = 8; x; x--)
+            {
+                if ( exSts & 0x40)
+                    *eventBits |= 1 << (x-1);
+                    if ( exSts & 0x80)
+                        *riseFlags |= 1 << (x-1);
+                exSts <<= 2;
+            }
+        }
+        else
+        {
+            *eventBits |= 1 << ((reg & P640_EVNT_NUM_MASK) >> P640_EVNT_NUM_SHIFT);
+            *riseFlags |= ((reg & P640_EVNT_RF) ? 1 : 0) << ((reg & P640_EVNT_NUM_MASK) >> P640_EVNT_NUM_SHIFT);
+        }
+
+        *eventTimeNanoSeconds = EPLReadReg( portHandle, PHY_PG4_PTP_EDATA);
+        *eventTimeNanoSeconds |= EPLReadReg( portHandle, PHY_PG4_PTP_EDATA) << 16;
+        *eventTimeSeconds = EPLReadReg( portHandle, PHY_PG4_PTP_EDATA);
+        *eventTimeSeconds |= EPLReadReg( portHandle, PHY_PG4_PTP_EDATA) << 16;
+        OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
     }
-    
-    *eventTimeNanoSeconds = EPLReadReg( portHandle, PHY_PG4_PTP_EDATA);
-    *eventTimeNanoSeconds |= EPLReadReg( portHandle, PHY_PG4_PTP_EDATA) << 16;
-    *eventTimeSeconds = EPLReadReg( portHandle, PHY_PG4_PTP_EDATA);
-    *eventTimeSeconds |= EPLReadReg( portHandle, PHY_PG4_PTP_EDATA) << 16;
-    OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
-    
-    // Adj for pin input delay and edge detection time
-	if( *eventTimeNanoSeconds < PIN_INPUT_DELAY )
-	{
-		if( *eventTimeSeconds > 0 )
-		{
-	        *eventTimeSeconds -= 1;
-			*eventTimeNanoSeconds += ((NS_UINT)1e9 - PIN_INPUT_DELAY);
-		}
-		else
-			*eventTimeSeconds = *eventTimeNanoSeconds = 0;
-	}
-	else
-		*eventTimeNanoSeconds -= PIN_INPUT_DELAY;
 
+    // Adj for pin input delay and edge detection time, not below 0
+    eventTime.seconds = *eventTimeSeconds;
+    eventTime.nanoSeconds = *eventTimeNanoSeconds;
+    PTPTimeSub( &eventTime, &eventTime, &inputDelay);
+    if ( eventTime.seconds < 0)
+        eventTime.seconds = eventTime.nanoSeconds = 0;
+    *eventTimeSeconds = (NS_UINT32)eventTime.seconds;
+    *eventTimeNanoSeconds = (NS_UINT32)eventTime.nanoSeconds;
+
+	EPL_TRACE_API_EXIT( portHandle, PTPGetEvent);
 	return TRUE;
 }
 
@@ -1632,6 +2086,10 @@ NS_UINT8 lEndian = portHdl->psfConfigOptions & STSOPT_LITTLE_ENDIAN;
             message->TxStatus.txTimestampNanoSecs = ByteSwap16( lEndian, *(NS_UINT16*)&msg[2]);
             message->TxStatus.txTimestampNanoSecs |= (val & ~0xC000) << 16;
             message->TxStatus.txOverflowCount = val >> 14;
+            OAIBeginMultiCriticalSection( portHdl->oaiDevHandle);
+            UpdateTimestampReference( portHdl, message->TxStatus.txTimestampSecs,
+                                      message->TxStatus.txTimestampNanoSecs);
+            OAIEndMultiCriticalSection( portHdl->oaiDevHandle);
             nextMsgOffset = 5 * sizeof( NS_UINT16);
             break;
         
@@ -1645,6 +2103,10 @@ NS_UINT8 lEndian = portHdl->psfConfigOptions & STSOPT_LITTLE_ENDIAN;
             message->RxStatus.rxTimestampNanoSecs = ByteSwap16( lEndian, *(NS_UINT16*)&msg[2]);
             message->RxStatus.rxTimestampNanoSecs |= (val & ~0xC000) << 16;
             message->RxStatus.rxOverflowCount = val >> 14;
+            OAIBeginMultiCriticalSection( portHdl->oaiDevHandle);
+            UpdateTimestampReference( portHdl, message->RxStatus.rxTimestampSecs,
+                                      message->RxStatus.rxTimestampNanoSecs);
+            OAIEndMultiCriticalSection( portHdl->oaiDevHandle);
          
             message->RxStatus.sequenceId = ByteSwap16( lEndian, *(NS_UINT16*)&msg[10]);
             val = ByteSwap16( lEndian, *(NS_UINT16*)&msg[12]);
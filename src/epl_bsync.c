@@ -0,0 +1,481 @@
+//****************************************************************************
+// epl_bsync.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Contains sources for the board clock synchronizer, which keeps the IEEE
+// 1588 clocks of several DP83640s on one board locked to a leader PHY (the
+// slave port of a boundary clock).
+//
+// The leader drives a periodic trigger onto a GPIO that is wired to a GPIO
+// of every follower. The leader's rising edges fall on multiples of the
+// period in leader time, so the event timestamp taken by each follower is
+// a direct measurement of the follower's offset:
+//
+//      offset = eventTime - nearest multiple of the period
+//
+// The nearest multiple alone cannot tell a follower that is off by whole
+// seconds, so each follower also tracks the leader time of the previous
+// edge. The expected edge is the next one (plus the edges reported as
+// missed); a follower whose seconds disagree with it is stepped by the
+// whole error.
+//
+// A PI servo per follower steers its rate with PTPClockSetRateAdjustment();
+// offsets beyond the step threshold are removed with a step adjustment.
+//
+// MDIO cost per sync round is fixed: one PTPGetEvent() per follower (one
+// register read if no edge was captured, six if one was) and one rate
+// adjustment write. Nothing is done on the leader after EPLBSyncStart().
+// Events can also be taken from PHY Status Frames and passed to
+// EPLBSyncEventSample(), leaving only the rate adjustment on MDIO.
+//
+// The following functions are implemented in this module:
+//
+//      EPLBSyncGetDefaultConfig
+//      EPLBSyncInit
+//      EPLBSyncAddFollower
+//      EPLBSyncStart
+//      EPLBSyncStop
+//      EPLBSyncPoll
+//      EPLBSyncEventSample
+//      EPLBSyncGetStats
+//      EPLBSyncResetStats
+//****************************************************************************
+
+#include "epl/epl.h"
+
+//****************************************************************************
+static void
+    BSyncSetRate (
+        IN EPL_BSYNC_FOLLOWER *follower,
+        IN NS_SINT32 ppb)
+//  Programs the normal rate adjustment of a follower.
+//****************************************************************************
+{
+    follower->stats.freqPpb = ppb;
+    PTPClockSetRateAdjustment( follower->portHandle,
+                               BSYNC_PPB_TO_RATE( (ppb < 0) ? -ppb : ppb),
+                               FALSE, (ppb < 0));
+    return;
+}
+
+//****************************************************************************
+static void
+    BSyncStep (
+        IN EPL_BSYNC_FOLLOWER *follower,
+        IN NS_SINT64 offset)
+//  Steps a follower's clock back by offset nanoseconds.
+//****************************************************************************
+{
+NS_UINT64 magnitude;
+
+    magnitude = (NS_UINT64)((offset < 0) ? -offset : offset);
+    PTPClockStepAdjustment( follower->portHandle, (NS_UINT32)(magnitude / PTP_NS_PER_SEC),
+                            (NS_UINT32)(magnitude % PTP_NS_PER_SEC), (offset > 0));
+    follower->stepped = TRUE;
+    follower->stats.steps++;
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLBSyncGetDefaultConfig (
+        IN OUT PEPL_BSYNC_CFG syncConfig)
+
+//  Returns a board synchronizer configuration using trigger 0 and event 0
+//  with a 1 second period.
+//
+//  syncConfig
+//      Configuration structure to fill in. The triggerGpio field must be
+//      set by the caller to match the board wiring.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    syncConfig->trigger = 0;
+    syncConfig->triggerGpio = 0;
+    syncConfig->event = 0;
+    syncConfig->periodNs = 1000000000;
+    syncConfig->kp = 717;               // 0.7
+    syncConfig->ki = 307;               // 0.3
+    syncConfig->stepThresholdNs = 20000;
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLBSyncInit (
+        IN OUT PEPL_BSYNC sync,
+        IN PEPL_PORT_HANDLE leader,
+        IN PEPL_BSYNC_CFG syncConfig)
+
+//  Initializes a board clock synchronizer.
+//
+//  sync
+//      Caller allocated synchronizer object.
+//  leader
+//      Port whose clock the other PHYs follow. This is obtained using the
+//      EPLEnumPort function.
+//  syncConfig
+//      Configuration, see EPLBSyncGetDefaultConfig(). Copied.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM if the configuration is
+//      not usable.
+//****************************************************************************
+{
+    if ( syncConfig->trigger > 7 || syncConfig->event > 7 ||
+         syncConfig->triggerGpio < 1 || syncConfig->triggerGpio > 12 ||
+         syncConfig->periodNs < 2 || syncConfig->periodNs > 1000000000 ||
+         1000000000 % syncConfig->periodNs)
+    {
+        return NS_STATUS_INVALID_PARM;
+    }
+
+    memset( sync, 0, sizeof( EPL_BSYNC));
+    sync->cfg = *syncConfig;
+    sync->leader = leader;
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLBSyncAddFollower (
+        IN OUT PEPL_BSYNC sync,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_UINT eventGpio,
+        OUT NS_UINT *index)
+
+//  Adds a PHY whose clock is to follow the leader.
+//
+//  sync
+//      Synchronizer initialized with EPLBSyncInit().
+//  portHandle
+//      Follower port. This is obtained using the EPLEnumPort function.
+//  eventGpio
+//      Follower GPIO the leader trigger signal is wired to, 1 - 12.
+//  index
+//      Set on return to the follower index used by the other functions.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, NS_STATUS_INVALID_PARM or NS_STATUS_RESOURCES.
+//****************************************************************************
+{
+EPL_BSYNC_FOLLOWER *follower;
+
+    if ( eventGpio < 1 || eventGpio > 12 || portHandle == sync->leader)
+        return NS_STATUS_INVALID_PARM;
+    if ( sync->numFollowers >= BSYNC_MAX_FOLLOWERS)
+        return NS_STATUS_RESOURCES;
+
+    follower = &sync->follower[sync->numFollowers];
+    memset( follower, 0, sizeof( EPL_BSYNC_FOLLOWER));
+    follower->portHandle = portHandle;
+    follower->eventGpio = eventGpio;
+    *index = sync->numFollowers++;
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLBSyncStart (
+        IN OUT PEPL_BSYNC sync)
+
+//  Starts synchronization: coarsely aligns every follower to the leader,
+//  enables the follower events and starts the periodic leader trigger on
+//  the next second boundary but one.
+//
+//  sync
+//      Synchronizer with at least one follower added.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM if there are no
+//      followers.
+//
+//  The coarse alignment copies the leader time with register reads, so
+//  followers start within a few MDIO transaction times of the leader; the
+//  first edge steps out the rest.
+//****************************************************************************
+{
+EPL_BSYNC_FOLLOWER *follower;
+PTP_TIME edge;
+NS_UINT32 seconds, nanoSeconds, halfPeriod;
+NS_UINT x;
+
+    if ( !sync->numFollowers)
+        return NS_STATUS_INVALID_PARM;
+
+    for ( x = 0; x < sync->numFollowers; x++)
+    {
+        follower = &sync->follower[x];
+        follower->drift = 0;
+        follower->stepped = FALSE;
+        follower->haveEdge = FALSE;
+        BSyncSetRate( follower, 0);
+        PTPSetEventConfig( follower->portHandle, sync->cfg.event, TRUE, FALSE, FALSE,
+                           follower->eventGpio);
+        PTPClockReadCurrent( sync->leader, &seconds, &nanoSeconds);
+        PTPClockSet( follower->portHandle, seconds, nanoSeconds);
+    }
+
+    halfPeriod = sync->cfg.periodNs / 2;
+    PTPSetTriggerConfig( sync->leader, sync->cfg.trigger, TRGOPT_PULSE | TRGOPT_PERIODIC,
+                         sync->cfg.triggerGpio);
+    PTPClockReadCurrent( sync->leader, &seconds, &nanoSeconds);
+    PTPArmTrigger( sync->leader, sync->cfg.trigger, seconds + 2, 0, FALSE, FALSE,
+                   halfPeriod, sync->cfg.periodNs - halfPeriod);
+
+    // The first edge is expected one period after this
+    for ( x = 0; x < sync->numFollowers; x++)
+    {
+        follower = &sync->follower[x];
+        follower->lastEdge.seconds = seconds + 2;
+        follower->lastEdge.nanoSeconds = 0;
+        PTPTimeFromNs( &edge, sync->cfg.periodNs);
+        PTPTimeSub( &follower->lastEdge, &follower->lastEdge, &edge);
+        follower->haveEdge = TRUE;
+    }
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLBSyncStop (
+        IN OUT PEPL_BSYNC sync)
+
+//  Stops the leader trigger and disables the follower events. The
+//  followers keep their last rate adjustment.
+//
+//  sync
+//      Synchronizer started with EPLBSyncStart().
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+NS_UINT x;
+
+    PTPCancelTrigger( sync->leader, sync->cfg.trigger);
+    for ( x = 0; x < sync->numFollowers; x++)
+    {
+        PTPSetEventConfig( sync->follower[x].portHandle, sync->cfg.event,
+                           FALSE, FALSE, FALSE, 0);
+    }
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_UINT
+    EPLBSyncPoll (
+        IN OUT PEPL_BSYNC sync)
+
+//  Collects at most one edge timestamp from every follower and updates its
+//  servo. Call at least once per trigger period.
+//
+//  sync
+//      Synchronizer started with EPLBSyncStart().
+//
+//  Returns
+//      The number of followers that produced a sample.
+//
+//  Events other than the configured one are discarded, so the follower
+//  event queues should be dedicated to board synchronization.
+//****************************************************************************
+{
+EPL_BSYNC_FOLLOWER *follower;
+NS_UINT eventBits, riseFlags, eventsMissed, samples, x;
+NS_UINT32 seconds, nanoSeconds;
+
+    samples = 0;
+    for ( x = 0; x < sync->numFollowers; x++)
+    {
+        follower = &sync->follower[x];
+        if ( !PTPGetEvent( follower->portHandle, &eventBits, &riseFlags,
+                           &seconds, &nanoSeconds, &eventsMissed))
+        {
+            continue;
+        }
+        if ( (eventBits & riseFlags & (1 << sync->cfg.event)) &&
+             EPLBSyncEventSample( sync, x, seconds, nanoSeconds, eventsMissed))
+        {
+            samples++;
+        }
+    }
+    return samples;
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLBSyncEventSample (
+        IN OUT PEPL_BSYNC sync,
+        IN NS_UINT index,
+        IN NS_UINT32 eventSeconds,
+        IN NS_UINT32 eventNanoSeconds,
+        IN NS_UINT eventsMissed)
+
+//  Processes a follower's timestamp of a leader trigger edge.
+//
+//  sync
+//      Synchronizer started with EPLBSyncStart().
+//  index
+//      Follower index returned by EPLBSyncAddFollower().
+//  eventSeconds, eventNanoSeconds
+//      Rising edge timestamp, as returned by PTPGetEvent() or an event
+//      PHY Status Frame.
+//  eventsMissed
+//      Events lost before this one.
+//
+//  Returns
+//      TRUE if the sample was used, FALSE if index is invalid.
+//
+//  Edges must be passed in order. The seconds are checked against the
+//  expected edge unless eventsMissed is BSYNC_MISSED_SATURATED; an error
+//  of whole seconds is stepped out without updating the servo.
+//****************************************************************************
+{
+EPL_BSYNC_FOLLOWER *follower;
+EPL_BSYNC_STATS *stats;
+PTP_TIME eventTime, edge;
+NS_SINT64 offset, error, ppb;
+NS_SINT64 maxDrift = (NS_SINT64)BSYNC_MAX_PPB * 1024;
+NS_UINT32 remainder;
+
+    if ( index >= sync->numFollowers)
+        return FALSE;
+    follower = &sync->follower[index];
+    stats = &follower->stats;
+    stats->missed += eventsMissed;
+
+    remainder = eventNanoSeconds % sync->cfg.periodNs;
+    offset = (remainder > sync->cfg.periodNs / 2) ?
+             (NS_SINT64)remainder - (NS_SINT64)sync->cfg.periodNs : (NS_SINT64)remainder;
+
+    // Compare with the expected edge. An error that differs from offset by
+    // other than whole seconds means edges were lost uncounted; the edge
+    // is then taken as the nearest one.
+    eventTime.seconds = eventSeconds;
+    eventTime.nanoSeconds = (NS_SINT32)eventNanoSeconds;
+    if ( follower->haveEdge && eventsMissed < BSYNC_MISSED_SATURATED)
+    {
+        PTPTimeFromNs( &edge, (NS_SINT64)(eventsMissed + 1) * sync->cfg.periodNs);
+        PTPTimeAdd( &edge, &follower->lastEdge, &edge);
+        PTPTimeSub( &edge, &eventTime, &edge);
+        error = PTPTimeToNs( &edge);
+        if ( error != offset && (error - offset) % PTP_NS_PER_SEC == 0)
+            offset = error;
+    }
+    PTPTimeFromNs( &edge, offset);
+    PTPTimeSub( &follower->lastEdge, &eventTime, &edge);
+    follower->haveEdge = TRUE;
+
+    if ( offset > (NS_SINT64)sync->cfg.periodNs / 2 || offset < -(NS_SINT64)sync->cfg.periodNs / 2)
+    {
+        stats->lastOffsetNs = (offset > 0) ? 0x7FFFFFFF : -0x7FFFFFFF;
+        stats->secondErrors++;
+        BSyncStep( follower, offset);
+        return TRUE;
+    }
+    stats->lastOffsetNs = (NS_SINT32)offset;
+
+    if ( follower->stepped)
+    {
+        // The offset accumulated since the step is all frequency error
+        follower->drift -= offset * 1024 * (1000000000 / sync->cfg.periodNs);
+        follower->stepped = FALSE;
+    }
+    else
+    {
+        // PI servo: a follower ahead of the leader (positive offset) is slowed
+        follower->drift -= offset * sync->cfg.ki;
+    }
+    if ( follower->drift > maxDrift)
+        follower->drift = maxDrift;
+    else if ( follower->drift < -maxDrift)
+        follower->drift = -maxDrift;
+
+    if ( offset > (NS_SINT64)sync->cfg.stepThresholdNs ||
+         offset < -(NS_SINT64)sync->cfg.stepThresholdNs)
+    {
+        BSyncStep( follower, offset);
+        BSyncSetRate( follower, (NS_SINT32)(follower->drift / 1024));
+        return TRUE;
+    }
+
+    ppb = (follower->drift - offset * sync->cfg.kp) / 1024;
+    if ( ppb > BSYNC_MAX_PPB)
+        ppb = BSYNC_MAX_PPB;
+    else if ( ppb < -BSYNC_MAX_PPB)
+        ppb = -BSYNC_MAX_PPB;
+    BSyncSetRate( follower, (NS_SINT32)ppb);
+
+    if ( !stats->samples || offset < stats->minOffsetNs)
+        stats->minOffsetNs = (NS_SINT32)offset;
+    if ( !stats->samples || offset > stats->maxOffsetNs)
+        stats->maxOffsetNs = (NS_SINT32)offset;
+    stats->sumOffsetNs += offset;
+    stats->sumSquaresNs += (NS_UINT64)(offset * offset);
+    stats->samples++;
+    return TRUE;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLBSyncGetStats (
+        IN PEPL_BSYNC sync,
+        IN NS_UINT index,
+        OUT PEPL_BSYNC_STATS stats)
+
+//  Returns the offset statistics of a follower.
+//
+//  sync
+//      Synchronizer initialized with EPLBSyncInit().
+//  index
+//      Follower index returned by EPLBSyncAddFollower().
+//  stats
+//      Set on return to the statistics since the last EPLBSyncResetStats().
+//      The mean offset is sumOffsetNs / samples and the RMS offset is
+//      sqrt( sumSquaresNs / samples). lastOffsetNs may be passed to
+//      EPLTCSetPortOffset() while the servo is settling.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM.
+//****************************************************************************
+{
+    if ( index >= sync->numFollowers)
+        return NS_STATUS_INVALID_PARM;
+    *stats = sync->follower[index].stats;
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLBSyncResetStats (
+        IN OUT PEPL_BSYNC sync)
+
+//  Clears the offset statistics of all followers. The servo state and the
+//  current rate adjustments are not affected.
+//
+//  sync
+//      Synchronizer initialized with EPLBSyncInit().
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+EPL_BSYNC_STATS *stats;
+NS_SINT32 freqPpb, lastOffsetNs;
+NS_UINT x;
+
+    for ( x = 0; x < sync->numFollowers; x++)
+    {
+        stats = &sync->follower[x].stats;
+        freqPpb = stats->freqPpb;
+        lastOffsetNs = stats->lastOffsetNs;
+        memset( stats, 0, sizeof( EPL_BSYNC_STATS));
+        stats->freqPpb = freqPpb;
+        stats->lastOffsetNs = lastOffsetNs;
+    }
+    return;
+}
@@ -0,0 +1,181 @@
+//****************************************************************************
+// epl_checkpoint.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Contains sources for the servo checkpoint, which lets a restarted
+// controller resume with the rate, servo state and PTP configuration it
+// had, instead of relearning the rate from zero.
+//
+// A checkpoint holds the rate word, the servo integrator and path delay
+// supplied by the caller, the PTP configuration registers of pages 5 and 6
+// and the port object fields the configuration functions maintain. It is
+// under 100 bytes with no pointers, so it can be kept in non-volatile or
+// reset-surviving memory as is.
+//
+// EPLCheckpointWarmStart() replaces PTPSetTransmitConfig(),
+// PTPSetReceiveConfig(), PTPSetPhyStatusFrameConfig(), PTPSetClockConfig(),
+// PTPSetMiscConfig(), PTPClockSetRateAdjustment() and PTPEnable() with one
+// pass over the registers in page order, so only three page selects are
+// needed. Trigger and event configurations are written through selection
+// registers and cannot be read back; they are not included.
+//
+// The following functions are implemented in this module:
+//
+//      EPLCheckpointSave
+//      EPLCheckpointWarmStart
+//****************************************************************************
+
+#include "epl/epl.h"
+
+// Registers saved and restored, in page order
+static const NS_UINT ckptRegs[CKPT_NUM_REGS] = {
+    PHY_PG5_PTP_TXCFG0, PHY_PG5_PTP_TXCFG1, PHY_PG5_PSF_CFG0,
+    PHY_PG5_PTP_RXCFG0, PHY_PG5_PTP_RXCFG1, PHY_PG5_PTP_RXCFG2,
+    PHY_PG5_PTP_RXCFG3, PHY_PG5_PTP_RXCFG4, PHY_PG5_PTP_TRDL,
+    PHY_PG5_PTP_TRDH,
+    PHY_PG6_PTP_COC, PHY_PG6_PSF_CFG1, PHY_PG6_PSF_CFG2,
+    PHY_PG6_PSF_CFG3, PHY_PG6_PSF_CFG4, PHY_PG6_PTP_SFDCFG,
+    PHY_PG6_PTP_INTCTL, PHY_PG6_PTP_CLKSRC, PHY_PG6_PTP_ETR,
+    PHY_PG6_PTP_OFF, PHY_PG6_PTP_RXHASH
+};
+
+//****************************************************************************
+static NS_UINT32
+    CkptCheck (
+        IN PEPL_CHECKPOINT checkpoint)
+//  Returns the check value of a checkpoint.
+//****************************************************************************
+{
+NS_UINT8 *data = (NS_UINT8 *)checkpoint;
+NS_UINT32 sum = 0;
+NS_UINT x;
+
+    for ( x = 0; x < (NS_UINT)((NS_UINT8 *)&checkpoint->check - data); x++)
+        sum += data[x];
+    return ~sum & 0xFFFFFFFF;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLCheckpointSave (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_SINT64 integrator,
+        IN NS_SINT64 meanPathDelay,
+        OUT PEPL_CHECKPOINT checkpoint)
+
+//  Records the rate, servo state and PTP configuration of a port.
+//
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort
+//      function.
+//  integrator
+//      Servo integrator (frequency term) to restore, in the servo's units.
+//  meanPathDelay
+//      Mean path delay estimate to restore, scaled ns (e.g. the
+//      meanPathDelay of the E2E engine).
+//  checkpoint
+//      Caller allocated checkpoint, set on return.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_FAILURE if a temporary rate was the
+//      last rate written. The normal rate is not readable then; save again
+//      once the temporary rate has been replaced.
+//
+//  Takes 23 register reads plus page selects.
+//****************************************************************************
+{
+NS_UINT x, rateH;
+
+    memset( checkpoint, 0, sizeof( EPL_CHECKPOINT));
+
+    OAIBeginMultiCriticalSection( portHandle->oaiDevHandle);
+    rateH = EPLReadReg( portHandle, PHY_PG4_PTP_RATEH);
+    checkpoint->rate = ((NS_UINT32)rateH << 16) | EPLReadReg( portHandle, PHY_PG4_PTP_RATEL);
+    for ( x = 0; x < CKPT_NUM_REGS; x++)
+        checkpoint->regs[x] = (NS_UINT16)EPLReadReg( portHandle, ckptRegs[x]);
+    OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
+
+    if ( rateH & P640_PTP_TMP_RATE)
+        return NS_STATUS_FAILURE;
+
+    checkpoint->magic = CKPT_MAGIC;
+    checkpoint->integrator = integrator;
+    checkpoint->meanPathDelay = meanPathDelay;
+    checkpoint->rxConfigOptions = portHandle->rxConfigOptions;
+    checkpoint->psfConfigOptions = portHandle->psfConfigOptions;
+    checkpoint->tsSecondsLen = (NS_UINT8)portHandle->tsSecondsLen;
+    checkpoint->rxTsNanoSecOffset = (NS_UINT8)portHandle->rxTsNanoSecOffset;
+    checkpoint->rxTsSecondsOffset = (NS_UINT8)portHandle->rxTsSecondsOffset;
+    checkpoint->rxTsNanoField = (NS_UINT8)portHandle->rxTsNanoField;
+    checkpoint->rxTsSecField = (NS_UINT8)portHandle->rxTsSecField;
+    checkpoint->rxTsSecBytes = (NS_UINT8)portHandle->rxTsSecBytes;
+    memcpy( checkpoint->psfSrcMacAddr, portHandle->psfSrcMacAddr, 6);
+    checkpoint->check = CkptCheck( checkpoint);
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLCheckpointWarmStart (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN PEPL_CHECKPOINT checkpoint,
+        OUT NS_SINT64 *integrator,
+        OUT NS_SINT64 *meanPathDelay)
+
+//  Restores the PTP configuration and rate of a checkpoint and enables the
+//  IEEE 1588 clock.
+//
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort
+//      function.
+//  checkpoint
+//      Checkpoint from EPLCheckpointSave().
+//  integrator
+//      Set on return to the servo integrator to resume with.
+//  meanPathDelay
+//      Set on return to the mean path delay estimate, scaled ns. See
+//      EPLE2ESetMeanPathDelay().
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM if the checkpoint is not
+//      valid; nothing is written then.
+//
+//  Takes 24 register writes and 3 page selects. The clock time is not
+//  changed; the servo steps it on the first offset as usual. Triggers,
+//  events and the timestamp reference (PTPSetTimestampReference()) must
+//  be set up again.
+//****************************************************************************
+{
+NS_UINT x;
+
+    if ( checkpoint->magic != CKPT_MAGIC || checkpoint->check != CkptCheck( checkpoint) ||
+         (checkpoint->rate & (P640_PTP_TMP_RATE << 16)))
+    {
+        return NS_STATUS_INVALID_PARM;
+    }
+
+    OAIBeginMultiCriticalSection( portHandle->oaiDevHandle);
+    for ( x = 0; x < CKPT_NUM_REGS; x++)
+        EPLWriteReg( portHandle, ckptRegs[x], checkpoint->regs[x]);
+    EPLWriteReg( portHandle, PHY_PG4_PTP_RATEH, (checkpoint->rate >> 16) & 0xFFFF);
+    EPLWriteReg( portHandle, PHY_PG4_PTP_RATEL, checkpoint->rate & 0xFFFF);
+    EPLWriteReg( portHandle, PHY_PG4_PTP_CTL, P640_PTP_ENABLE);
+    portHandle->tsRefValid = FALSE;
+    OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
+
+    portHandle->rxConfigOptions = checkpoint->rxConfigOptions;
+    portHandle->psfConfigOptions = checkpoint->psfConfigOptions;
+    portHandle->tsSecondsLen = checkpoint->tsSecondsLen;
+    portHandle->rxTsNanoSecOffset = checkpoint->rxTsNanoSecOffset;
+    portHandle->rxTsSecondsOffset = checkpoint->rxTsSecondsOffset;
+    portHandle->rxTsNanoField = checkpoint->rxTsNanoField;
+    portHandle->rxTsSecField = checkpoint->rxTsSecField;
+    portHandle->rxTsSecBytes = checkpoint->rxTsSecBytes;
+    memcpy( portHandle->psfSrcMacAddr, checkpoint->psfSrcMacAddr, 6);
+
+    *integrator = checkpoint->integrator;
+    *meanPathDelay = checkpoint->meanPathDelay;
+    return NS_STATUS_SUCCESS;
+}
@@ -20,10 +20,38 @@
 //      EPLWriteReg
 //      EPLGetPortMdioAddress
 //      EPLSetPortPowerMode
+//      EPLInvalidatePageCache
+//      EPLGetMdioAccessCount
 //****************************************************************************
 
 #include "epl/epl.h"
 
+//****************************************************************************
+void
+    IntWriteReg(
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_UINT registerIndex,
+        IN NS_UINT value);
+
+//****************************************************************************
+static void
+    IntSelectPage(
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_UINT registerIndex)
+//  Internal procedure that selects the register page encoded in bits 7:5 of
+//  registerIndex. The last page written is cached in the port object so 
+//  consecutive accesses to the same page cost a single MDIO transaction.
+//****************************************************************************
+{
+NS_UINT page;
+
+    page = (registerIndex & 0x00E0) >> 5;
+    if ( portHandle->pageCache == page + 1)
+        return;
+
+    IntWriteReg( portHandle, (PHY_PAGESEL | (registerIndex & 0x8000)), page);
+}
+
 //****************************************************************************
 void
     IntWriteReg(
@@ -37,12 +65,20 @@ void
     // See if we need to do a page select, but not if we are using PCFs
     if( (registerIndex & ~0x8000) > PHY_PAGESEL ) {
         // Make sure correct register page is selected
-        IntWriteReg( portHandle, (PHY_PAGESEL | (registerIndex & 0x8000)), (registerIndex & 0xE0) >> 5);
+        IntSelectPage( portHandle, registerIndex);
         registerIndex &= ~0xE0;
     }
 
     // Send data out direct "MAC" interface
     ETH_WritePHYRegister(portHandle->portMdioAddress, registerIndex, value);
+    portHandle->mdioAccessCount++;
+    EPL_TRACE_REG( portHandle, EPL_TRACE_REG_WRITE, registerIndex, value);
+
+    // Keep the page cache coherent with what the device has selected
+    if( (registerIndex & ~0x8000) == PHY_PAGESEL )
+        portHandle->pageCache = (value & 0x0007) + 1;
+    else if( (registerIndex & ~0x8000) == PHY_BMCR && (value & BMCR_RESET) )
+        portHandle->pageCache = 0;
 }
 
 //****************************************************************************
@@ -73,11 +109,13 @@ NS_UINT data;
     if( (registerIndex & ~0x8000) > PHY_PAGESEL ) {
 
         // Make sure correct register page is selected
-        IntWriteReg( portHandle, (PHY_PAGESEL | (registerIndex & 0x8000)), (registerIndex & 0x00E0) >> 5);
+        IntSelectPage( portHandle, registerIndex);
         registerIndex &= ~0xE0;
         // Preamble has been taken care of by the write operation
     }
     data = ETH_ReadPHYRegister( portHandle->portMdioAddress, registerIndex );
+    portHandle->mdioAccessCount++;
+    EPL_TRACE_REG( portHandle, EPL_TRACE_REG_READ, registerIndex, data);
 
     OAIEndRegCriticalSection( portHandle->oaiDevHandle);
     return data;
@@ -165,3 +203,49 @@ NS_UINT bmcr;
     OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
     return;
 }
+
+
+//****************************************************************************
+EXPORT void
+    EPLInvalidatePageCache(
+        IN PEPL_PORT_HANDLE portHandle)
+        
+//  Forgets the register page the library believes is currently selected, 
+//  forcing the next paged register access to rewrite PHY_PAGESEL.
+//
+//  portHandle
+//      Handle that represents a port. This is obtained using the 
+//      EPLEnumPort function.
+//
+//  Returns:
+//      Nothing
+//
+//  This must be called if anything other than this library may have changed 
+//  the PHY_PAGESEL register (e.g. a hardware reset of the PHY or MDIO 
+//  accesses made outside of EPLReadReg/EPLWriteReg).
+//****************************************************************************
+{
+    OAIBeginRegCriticalSection( portHandle->oaiDevHandle);
+    portHandle->pageCache = 0;
+    OAIEndRegCriticalSection( portHandle->oaiDevHandle);
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_UINT32
+    EPLGetMdioAccessCount(
+        IN PEPL_PORT_HANDLE portHandle)
+        
+//  Returns the number of MDIO transactions (reads, writes and page selects)
+//  issued to a port since it was initialized. The counter wraps at 2^32.
+//
+//  portHandle
+//      Handle that represents a port. This is obtained using the 
+//      EPLEnumPort function.
+//
+//  Returns:
+//      The port's MDIO transaction count.
+//****************************************************************************
+{
+    return portHandle->mdioAccessCount;
+}
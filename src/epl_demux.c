@@ -0,0 +1,826 @@
+//****************************************************************************
+// epl_demux.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Contains sources for the PTP domain demultiplexer, which lets one port
+// follow several PTP domains (slave side, end-to-end delay mechanism).
+//
+// The PHY filters on a single ptpDomain (RXOPT_DOMAIN_EN). Following more
+// than one domain means timestamping the event messages of every domain and
+// separating them in software. Each followed domain has its own state in
+// EPL_DEMUX.domains[]: an E2E engine holding its outstanding exchanges, a
+// foreign master table fed by its Announce messages and the callback of its
+// servo. EPL_DEMUX.slot[] maps the domainNumber of a message to its
+// domains[] entry, so every message and timestamp is routed with a single
+// table lookup.
+//
+// Receive timestamps are matched to their message by the timestamp
+// delivery manager (or passed by the caller). Transmit timestamps come back
+// in transmit order and are matched to the event messages reported with
+// EPLDemuxTransmitted(). Timestamps of domains that are not followed are
+// taken and dropped so they do not fill the PHY queues.
+//
+// While exactly one domain is followed the hardware filter is programmed
+// to that domain and the PHY no longer timestamps the other domains'
+// messages. Adding a second domain turns the filter off again.
+//
+// Once the best master of a domain is selected (EPLDemuxSelectMaster(),
+// called from the caller's best master clock algorithm) only its messages
+// are used. With EPLDemuxSetMasterFilter() the PHY's source port identity
+// hash filter is kept on the selected master of the only domain followed,
+// so the other masters' event messages are no longer timestamped. A master
+// change rewrites PTP_RXHASH alone instead of all the receive
+// configuration registers, and leaves the filter off for a hold time so
+// that nothing of the new master is lost while the change settles.
+//
+// The following functions are implemented in this module:
+//
+//      EPLDemuxInit
+//      EPLDemuxSetPortLatency
+//      EPLDemuxAddDomain
+//      EPLDemuxRemoveDomain
+//      EPLDemuxGetDomain
+//      EPLDemuxSetMasterFilter
+//      EPLDemuxSelectMaster
+//      EPLDemuxReceive
+//      EPLDemuxTransmitted
+//      EPLDemuxTxTimestamp
+//      EPLDemuxService
+//****************************************************************************
+
+#include "epl/epl.h"
+
+// Message lengths up to the end of the fields used
+#define DEMUX_TIMESTAMP_LENGTH  (PTP_HDR_LENGTH + 10)
+#define DEMUX_DELAY_RESP_LENGTH (PTP_REQ_PORT_ID_OFFSET + PTP_PORT_ID_LENGTH)
+#define DEMUX_ANNOUNCE_LENGTH   64
+
+// Announce body
+#define DEMUX_GM_PRIORITY1_OFFSET   47
+#define DEMUX_STEPS_REMOVED_OFFSET  61
+
+//****************************************************************************
+static PEPL_DEMUX_DOMAIN
+    DemuxOnlyDomain (
+        IN PEPL_DEMUX demux)
+//  Returns the domain followed if there is exactly one, NULL otherwise.
+//****************************************************************************
+{
+NS_UINT x;
+
+    if ( demux->numActive != 1)
+        return NULL;
+    for ( x = 0; x < DEMUX_MAX_DOMAINS; x++)
+    {
+        if ( demux->domains[x].active)
+            return &demux->domains[x];
+    }
+    return NULL;
+}
+
+//****************************************************************************
+static void
+    DemuxProgramFilter (
+        IN OUT PEPL_DEMUX demux)
+//  Enables the hardware domain filter if exactly one domain is followed,
+//  disables it otherwise. Registers are only written on a change.
+//****************************************************************************
+{
+PEPL_PORT_HANDLE portHandle = demux->portHandle;
+PEPL_DEMUX_DOMAIN domain = DemuxOnlyDomain( demux);
+NS_BOOL enable = (domain != NULL);
+NS_UINT8 domainNumber = enable ? domain->domainNumber : 0;
+NS_UINT reg, newReg;
+
+    if ( enable == demux->hwFilter && (!enable || domainNumber == demux->hwDomain))
+        return;
+
+    // Domain first, so the filter never passes a stale domain
+    if ( enable)
+    {
+        reg = EPLReadReg( portHandle, PHY_PG5_PTP_RXCFG3);
+        newReg = (reg & ~P640_PTP_DOMAIN_MASK) | (domainNumber << P640_PTP_DOMAIN_SHIFT);
+        if ( newReg != reg)
+            EPLWriteReg( portHandle, PHY_PG5_PTP_RXCFG3, newReg);
+    }
+
+    // USER_IP_SEL selects the RXCFG2 half and must be written as 0
+    reg = EPLReadReg( portHandle, PHY_PG5_PTP_RXCFG0) & ~P640_USER_IP_SEL;
+    newReg = reg & ~P640_DOMAIN_EN;
+    portHandle->rxConfigOptions &= ~RXOPT_DOMAIN_EN;
+    if ( enable)
+    {
+        newReg |= P640_DOMAIN_EN;
+        portHandle->rxConfigOptions |= RXOPT_DOMAIN_EN;
+    }
+    if ( newReg != reg)
+        EPLWriteReg( portHandle, PHY_PG5_PTP_RXCFG0, newReg);
+
+    demux->hwFilter = enable;
+    demux->hwDomain = domainNumber;
+    demux->filterWrites++;
+    return;
+}
+
+//****************************************************************************
+static void
+    DemuxProgramHash (
+        IN OUT PEPL_DEMUX demux)
+//  Sets the source port identity hash filter to the selected master of the
+//  only domain followed, or disables it. Only PTP_RXHASH is written, and
+//  only on a change.
+//****************************************************************************
+{
+PEPL_PORT_HANDLE portHandle = demux->portHandle;
+PEPL_DEMUX_DOMAIN domain = DemuxOnlyDomain( demux);
+NS_BOOL enable;
+NS_UINT hash, reg, newReg;
+
+    enable = demux->hashManaged && !demux->hashTransition && domain && domain->haveMaster;
+    hash = enable ? domain->masterHash : demux->hashValue;
+    if ( enable == demux->hashFilter && hash == demux->hashValue)
+        return;
+
+    reg = EPLReadReg( portHandle, PHY_PG6_PTP_RXHASH);
+    newReg = reg & ~(P640_RX_HASH_EN | (P640_PTP_RX_HASH_MASK << P640_PTP_RX_HASH_SHIFT));
+    portHandle->rxConfigOptions &= ~RXOPT_SRC_ID_HASH_EN;
+    if ( enable)
+    {
+        newReg |= P640_RX_HASH_EN | (hash << P640_PTP_RX_HASH_SHIFT);
+        portHandle->rxConfigOptions |= RXOPT_SRC_ID_HASH_EN;
+    }
+    if ( newReg != reg)
+        EPLWriteReg( portHandle, PHY_PG6_PTP_RXHASH, newReg);
+
+    demux->hashFilter = enable;
+    demux->hashValue = hash;
+    demux->hashWrites++;
+    return;
+}
+
+//****************************************************************************
+static void
+    DemuxGetTimestamp (
+        IN NS_UINT8 *field,
+        OUT NS_UINT32 *seconds,
+        OUT NS_UINT32 *nanoSeconds)
+//  Reads a 10 byte PTP timestamp (lower 32 bits of the seconds).
+//****************************************************************************
+{
+    *seconds = ((NS_UINT32)field[2] << 24) | ((NS_UINT32)field[3] << 16) |
+               ((NS_UINT32)field[4] << 8) | field[5];
+    *nanoSeconds = ((NS_UINT32)field[6] << 24) | ((NS_UINT32)field[7] << 16) |
+                   ((NS_UINT32)field[8] << 8) | field[9];
+    return;
+}
+
+//****************************************************************************
+static NS_SINT64
+    DemuxGetCorrection (
+        IN NS_UINT8 *ptpMessage)
+//  Returns the correctionField of a message, scaled ns.
+//****************************************************************************
+{
+NS_UINT8 *field = &ptpMessage[PTP_HDR_CORRECTION_OFFSET];
+NS_UINT64 correction = 0;
+NS_UINT x;
+
+    for ( x = 0; x < 8; x++)
+        correction = (correction << 8) | field[x];
+    return (NS_SINT64)correction;
+}
+
+//****************************************************************************
+static void
+    DemuxAnnounce (
+        IN OUT PEPL_DEMUX_DOMAIN domain,
+        IN NS_UINT8 *ptpMessage)
+//  Updates the foreign master table of a domain. A new master replaces the
+//  one heard from least recently when the table is full.
+//****************************************************************************
+{
+NS_UINT8 *portIdentity = &ptpMessage[PTP_HDR_SOURCE_PORT_ID_OFFSET];
+NS_UINT8 *body = &ptpMessage[DEMUX_GM_PRIORITY1_OFFSET];
+PEPL_DEMUX_FOREIGN foreign = NULL;
+NS_UINT32 now = OAIGetTimeStamp();
+NS_UINT x;
+
+    for ( x = 0; x < domain->numForeign; x++)
+    {
+        if ( !memcmp( domain->foreign[x].portIdentity, portIdentity, PTP_PORT_ID_LENGTH))
+        {
+            foreign = &domain->foreign[x];
+            break;
+        }
+    }
+    if ( !foreign)
+    {
+        if ( domain->numForeign < DEMUX_MAX_FOREIGN)
+        {
+            foreign = &domain->foreign[domain->numForeign++];
+        }
+        else
+        {
+            foreign = &domain->foreign[0];
+            for ( x = 1; x < DEMUX_MAX_FOREIGN; x++)
+            {
+                if ( (NS_UINT32)(now - domain->foreign[x].lastSeen) >
+                     (NS_UINT32)(now - foreign->lastSeen))
+                {
+                    foreign = &domain->foreign[x];
+                }
+            }
+        }
+        memcpy( foreign->portIdentity, portIdentity, PTP_PORT_ID_LENGTH);
+        foreign->announces = 0;
+    }
+
+    // grandmasterPriority1, grandmasterClockQuality, grandmasterPriority2
+    foreign->priority1 = body[0];
+    foreign->clockClass = body[1];
+    foreign->clockAccuracy = body[2];
+    foreign->offsetScaledLogVariance = (NS_UINT16)((body[3] << 8) | body[4]);
+    foreign->priority2 = body[5];
+    foreign->stepsRemoved = (NS_UINT16)((ptpMessage[DEMUX_STEPS_REMOVED_OFFSET] << 8) |
+                                        ptpMessage[DEMUX_STEPS_REMOVED_OFFSET + 1]);
+    foreign->announces++;
+    foreign->lastSeen = now;
+    return;
+}
+
+//****************************************************************************
+static void
+    DemuxSample (
+        IN OUT PEPL_DEMUX_DOMAIN domain)
+//  Passes a new offset sample of a domain to its callback.
+//****************************************************************************
+{
+EPL_E2E_SAMPLE sample;
+
+    if ( !EPLE2EGetSample( &domain->e2e, &sample))
+        return;
+    domain->samples++;
+    if ( domain->callback)
+        domain->callback( domain->context, domain->domainNumber, &sample);
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLDemuxInit (
+        IN OUT PEPL_DEMUX demux,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN PEPL_TSD tsd,
+        IN NS_UINT8 *portIdentity)
+
+//  Initializes a demultiplexer with no domains followed. The hardware
+//  domain filter is assumed to be off (RXOPT_DOMAIN_EN not set).
+//
+//  demux
+//      Caller allocated demultiplexer object, one per port.
+//  portHandle
+//      Handle that represents the port, as returned by EPLEnumPort().
+//  tsd
+//      Timestamp delivery manager of the port, initialized with
+//      EPLTsdInit(). NULL if the caller passes the receive timestamps to
+//      EPLDemuxReceive() and the transmit timestamps to
+//      EPLDemuxTxTimestamp().
+//  portIdentity
+//      10 byte portIdentity of this port, compared with the
+//      requestingPortIdentity of Delay_Resp messages. NULL accepts every
+//      Delay_Resp (e.g. unicast).
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    memset( demux, 0, sizeof( EPL_DEMUX));
+    demux->portHandle = portHandle;
+    demux->tsd = tsd;
+    if ( portIdentity)
+    {
+        memcpy( demux->portIdentity, portIdentity, PTP_PORT_ID_LENGTH);
+        demux->checkPortIdentity = TRUE;
+    }
+    memset( demux->slot, DEMUX_NO_SLOT, sizeof( demux->slot));
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLDemuxSetPortLatency (
+        IN OUT PEPL_DEMUX demux,
+        IN NS_SINT32 rxLatencyNs,
+        IN NS_SINT32 txLatencyNs)
+
+//  Sets the PHY path latencies applied to the timestamps before they are
+//  passed to the E2E engines.
+//
+//  demux
+//      Demultiplexer initialized with EPLDemuxInit().
+//  rxLatencyNs
+//      Wire to receive timestamp point, subtracted from receive timestamps.
+//  txLatencyNs
+//      Transmit timestamp point to wire, added to transmit timestamps.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    demux->rxLatencyNs = rxLatencyNs;
+    demux->txLatencyNs = txLatencyNs;
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLDemuxAddDomain (
+        IN OUT PEPL_DEMUX demux,
+        IN NS_UINT8 domainNumber,
+        IN EPL_DEMUX_CALLBACK callback,
+        IN void *context)
+
+//  Starts following a domain and reprograms the hardware domain filter.
+//
+//  demux
+//      Demultiplexer initialized with EPLDemuxInit().
+//  domainNumber
+//      PTP domainNumber.
+//  callback
+//      Called with each offset sample of the domain, e.g. to run its servo.
+//      May be NULL.
+//  context
+//      Passed to callback.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, NS_STATUS_INVALID_PARM if the domain is already
+//      followed, or NS_STATUS_RESOURCES if DEMUX_MAX_DOMAINS are.
+//
+//  The domain's E2E engine starts empty; install filters on it with
+//  EPLE2ESetFilter() through EPLDemuxGetDomain().
+//****************************************************************************
+{
+PEPL_DEMUX_DOMAIN domain;
+NS_UINT x;
+
+    if ( demux->slot[domainNumber] != DEMUX_NO_SLOT)
+        return NS_STATUS_INVALID_PARM;
+
+    for ( x = 0; x < DEMUX_MAX_DOMAINS; x++)
+    {
+        if ( !demux->domains[x].active)
+            break;
+    }
+    if ( x == DEMUX_MAX_DOMAINS)
+        return NS_STATUS_RESOURCES;
+
+    domain = &demux->domains[x];
+    memset( domain, 0, sizeof( EPL_DEMUX_DOMAIN));
+    domain->domainNumber = domainNumber;
+    domain->active = TRUE;
+    EPLE2EInit( &domain->e2e);
+    domain->callback = callback;
+    domain->context = context;
+
+    demux->slot[domainNumber] = (NS_UINT8)x;
+    demux->numActive++;
+    DemuxProgramFilter( demux);
+    DemuxProgramHash( demux);
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLDemuxRemoveDomain (
+        IN OUT PEPL_DEMUX demux,
+        IN NS_UINT8 domainNumber)
+
+//  Stops following a domain and reprograms the hardware domain filter.
+//
+//  demux
+//      Demultiplexer initialized with EPLDemuxInit().
+//  domainNumber
+//      PTP domainNumber.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM if the domain is not
+//      followed.
+//
+//  Transmit timestamps still pending for the domain are dropped when they
+//  arrive.
+//****************************************************************************
+{
+NS_UINT x = demux->slot[domainNumber];
+
+    if ( x == DEMUX_NO_SLOT)
+        return NS_STATUS_INVALID_PARM;
+
+    demux->domains[x].active = FALSE;
+    demux->slot[domainNumber] = DEMUX_NO_SLOT;
+    demux->numActive--;
+    DemuxProgramFilter( demux);
+    DemuxProgramHash( demux);
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT PEPL_DEMUX_DOMAIN
+    EPLDemuxGetDomain (
+        IN PEPL_DEMUX demux,
+        IN NS_UINT8 domainNumber)
+
+//  Returns the state of a followed domain.
+//
+//  demux
+//      Demultiplexer initialized with EPLDemuxInit().
+//  domainNumber
+//      PTP domainNumber.
+//
+//  Returns
+//      Pointer to the domain's entry, or NULL if it is not followed.
+//****************************************************************************
+{
+NS_UINT x = demux->slot[domainNumber];
+
+    if ( x == DEMUX_NO_SLOT)
+        return NULL;
+    return &demux->domains[x];
+}
+
+//****************************************************************************
+EXPORT void
+    EPLDemuxSetMasterFilter (
+        IN OUT PEPL_DEMUX demux,
+        IN NS_BOOL enable,
+        IN NS_UINT32 holdUs)
+
+//  Enables or disables the management of the source port identity hash
+//  filter (RXOPT_SRC_ID_HASH_EN).
+//
+//  demux
+//      Demultiplexer initialized with EPLDemuxInit().
+//  enable
+//      TRUE to keep the filter on the selected master of the only domain
+//      followed, FALSE to turn it off and leave it off.
+//  holdUs
+//      Time the filter stays off after the selected master changed. The
+//      filter is turned back on by EPLDemuxService().
+//
+//  Returns
+//      Nothing
+//
+//  The filter passes one 12-bit hash, so it is off while more than one
+//  domain is followed or no master is selected.
+//****************************************************************************
+{
+    demux->hashManaged = enable;
+    demux->hashHoldUs = holdUs;
+    demux->hashTransition = FALSE;
+
+    // Take over whatever PTPSetReceiveConfig() programmed
+    demux->hashFilter = (demux->portHandle->rxConfigOptions & RXOPT_SRC_ID_HASH_EN) ? TRUE : FALSE;
+    demux->hashValue = P640_PTP_RX_HASH_MASK + 1;
+    DemuxProgramHash( demux);
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLDemuxSelectMaster (
+        IN OUT PEPL_DEMUX demux,
+        IN NS_UINT8 domainNumber,
+        IN NS_UINT8 *portIdentity)
+
+//  Master selection hook, called when the best master of a domain changes.
+//
+//  demux
+//      Demultiplexer initialized with EPLDemuxInit().
+//  domainNumber
+//      PTP domainNumber.
+//  portIdentity
+//      10 byte portIdentity of the selected master (the sourcePortIdentity
+//      of its messages), e.g. from the domain's foreign master table. NULL
+//      if no master is selected; messages of every source are then used.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM if the domain is not
+//      followed.
+//
+//  On a change the hash filter, if managed, is turned off for the hold
+//  time set with EPLDemuxSetMasterFilter(). The domain's E2E engine is kept;
+//  exchanges of the previous master are not completed.
+//****************************************************************************
+{
+PEPL_DEMUX_DOMAIN domain;
+NS_UINT x = demux->slot[domainNumber];
+
+    if ( x == DEMUX_NO_SLOT)
+        return NS_STATUS_INVALID_PARM;
+    domain = &demux->domains[x];
+
+    if ( !portIdentity)
+    {
+        if ( !domain->haveMaster)
+            return NS_STATUS_SUCCESS;
+        domain->haveMaster = FALSE;
+    }
+    else
+    {
+        if ( domain->haveMaster &&
+             !memcmp( domain->masterIdentity, portIdentity, PTP_PORT_ID_LENGTH))
+        {
+            return NS_STATUS_SUCCESS;
+        }
+        memcpy( domain->masterIdentity, portIdentity, PTP_PORT_ID_LENGTH);
+        domain->masterHash = PTPCalcSourceIdHash( portIdentity);
+        domain->haveMaster = TRUE;
+    }
+    domain->masterChanges++;
+
+    if ( demux->hashManaged && demux->hashHoldUs)
+    {
+        demux->hashTransition = TRUE;
+        demux->hashTransitionStart = OAIGetTimeStamp();
+    }
+    DemuxProgramHash( demux);
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLDemuxReceive (
+        IN OUT PEPL_DEMUX demux,
+        IN OUT NS_UINT8 *ptpMessage,
+        IN NS_UINT length,
+        IN PPTP_TIME rxTime)
+
+//  Routes a received PTP message to its domain.
+//
+//  demux
+//      Demultiplexer initialized with EPLDemuxInit().
+//  ptpMessage
+//      Received message, from the start of the PTP header. An inserted
+//      timestamp is cleared from it.
+//  length
+//      Length of the message in bytes.
+//  rxTime
+//      Receive timestamp of an event message, 48-bit seconds, not yet
+//      corrected for the receive latency. NULL to take it from the
+//      timestamp delivery manager.
+//
+//  Returns
+//      NS_STATUS_SUCCESS if the message was processed.
+//      NS_STATUS_FAILURE if the receive timestamp is not available yet;
+//      hold the message and retry (see EPLTsdGetRxTimestamp()).
+//      NS_STATUS_INVALID_PARM if the message is too short or its domain is
+//      not followed. An event message's timestamp is dropped.
+//
+//  Sync and Follow_Up complete the domain's offset samples, which are
+//  passed to the domain callback; Delay_Resp updates its path delay and
+//  Announce its foreign master table. Other messages, and those of masters
+//  other than the selected one, are ignored.
+//****************************************************************************
+{
+PEPL_DEMUX_DOMAIN domain = NULL;
+PTP_TIME timestamp;
+NS_UINT32 seconds, nanoSeconds;
+NS_UINT16 sequenceId;
+NS_UINT8 messageType, domainNumber, *sourceIdentity;
+NS_UINT x;
+NS_BOOL sample = FALSE, selected;
+
+    if ( length < PTP_HDR_LENGTH)
+        return NS_STATUS_INVALID_PARM;
+
+    messageType = ptpMessage[PTP_HDR_MSG_TYPE_OFFSET] & 0x0F;
+    domainNumber = ptpMessage[PTP_HDR_DOMAIN_OFFSET];
+    sourceIdentity = &ptpMessage[PTP_HDR_SOURCE_PORT_ID_OFFSET];
+    x = demux->slot[domainNumber];
+    if ( x != DEMUX_NO_SLOT)
+        domain = &demux->domains[x];
+    selected = !domain || !domain->haveMaster || messageType == PTP_MSG_ANNOUNCE ||
+               !memcmp( sourceIdentity, domain->masterIdentity, PTP_PORT_ID_LENGTH);
+
+    // Event messages (types 0 - 7) carry a receive timestamp, except for
+    // those the hardware filters did not pass
+    if ( messageType < PTP_MSG_FOLLOW_UP && (domain || !demux->hwFilter))
+    {
+        if ( !selected && demux->hashFilter &&
+             PTPCalcSourceIdHash( sourceIdentity) != demux->hashValue)
+        {
+            // Not timestamped by the PHY
+            demux->suppressed++;
+        }
+        else
+        {
+            if ( rxTime)
+                timestamp = *rxTime;
+            else if ( !demux->tsd)
+                return NS_STATUS_INVALID_PARM;
+            else if ( EPLTsdGetRxTimestamp( demux->tsd, ptpMessage, &timestamp) != NS_STATUS_SUCCESS)
+                return NS_STATUS_FAILURE;
+            timestamp.nanoSeconds -= demux->rxLatencyNs;
+            PTPTimeNormalize( &timestamp);
+        }
+    }
+
+    if ( !domain)
+    {
+        demux->otherDomain++;
+        return NS_STATUS_INVALID_PARM;
+    }
+
+    domain->rxMessages++;
+    if ( !selected)
+    {
+        domain->notSelected++;
+        return NS_STATUS_SUCCESS;
+    }
+    sequenceId = (NS_UINT16)((ptpMessage[PTP_HDR_SEQUENCE_ID_OFFSET] << 8) |
+                             ptpMessage[PTP_HDR_SEQUENCE_ID_OFFSET + 1]);
+
+    switch ( messageType)
+    {
+    case PTP_MSG_SYNC:
+        sample = EPLE2ESyncReceived( &domain->e2e, sequenceId,
+                                     (NS_UINT32)timestamp.seconds, (NS_UINT32)timestamp.nanoSeconds);
+        if ( !(ptpMessage[PTP_HDR_FLAGS_OFFSET] & PTP_FLAG_TWO_STEP) &&
+             length >= DEMUX_TIMESTAMP_LENGTH)
+        {
+            DemuxGetTimestamp( &ptpMessage[PTP_HDR_LENGTH], &seconds, &nanoSeconds);
+            sample |= EPLE2ESyncOrigin( &domain->e2e, sequenceId, seconds, nanoSeconds,
+                                        DemuxGetCorrection( ptpMessage));
+        }
+        break;
+
+    case PTP_MSG_FOLLOW_UP:
+        // Two-step: the correction of the Sync itself is not included
+        // (transparent clocks correct the Follow_Up)
+        if ( length < DEMUX_TIMESTAMP_LENGTH)
+            return NS_STATUS_INVALID_PARM;
+        DemuxGetTimestamp( &ptpMessage[PTP_HDR_LENGTH], &seconds, &nanoSeconds);
+        sample = EPLE2ESyncOrigin( &domain->e2e, sequenceId, seconds, nanoSeconds,
+                                   DemuxGetCorrection( ptpMessage));
+        break;
+
+    case PTP_MSG_DELAY_RESP:
+        if ( length < DEMUX_DELAY_RESP_LENGTH)
+            return NS_STATUS_INVALID_PARM;
+        if ( demux->checkPortIdentity &&
+             memcmp( &ptpMessage[PTP_REQ_PORT_ID_OFFSET], demux->portIdentity, PTP_PORT_ID_LENGTH))
+        {
+            break;
+        }
+        DemuxGetTimestamp( &ptpMessage[PTP_HDR_LENGTH], &seconds, &nanoSeconds);
+        EPLE2EDelayResp( &domain->e2e, sequenceId, seconds, nanoSeconds,
+                         DemuxGetCorrection( ptpMessage));
+        break;
+
+    case PTP_MSG_ANNOUNCE:
+        if ( length < DEMUX_ANNOUNCE_LENGTH)
+            return NS_STATUS_INVALID_PARM;
+        DemuxAnnounce( domain, ptpMessage);
+        break;
+
+    default:
+        break;
+    }
+
+    if ( sample)
+        DemuxSample( domain);
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLDemuxTransmitted (
+        IN OUT PEPL_DEMUX demux,
+        IN NS_UINT8 *ptpMessage)
+
+//  Records a transmitted event message that the PHY timestamps, so its
+//  transmit timestamp can be routed to its domain.
+//
+//  demux
+//      Demultiplexer initialized with EPLDemuxInit().
+//  ptpMessage
+//      Transmitted message, from the start of the PTP header.
+//
+//  Returns
+//      Nothing
+//
+//  Call in transmit order, for every timestamped message of every domain
+//  (e.g. not for one-step Syncs). If DEMUX_TX_QUEUE messages are waiting
+//  their timestamps were most likely lost and the oldest is dropped.
+//****************************************************************************
+{
+EPL_DEMUX_TX *entry;
+
+    if ( demux->txCount == DEMUX_TX_QUEUE)
+    {
+        demux->txHead = (demux->txHead + 1) % DEMUX_TX_QUEUE;
+        demux->txCount--;
+        demux->txDropped++;
+    }
+
+    entry = &demux->txQueue[(demux->txHead + demux->txCount) % DEMUX_TX_QUEUE];
+    entry->domainNumber = ptpMessage[PTP_HDR_DOMAIN_OFFSET];
+    entry->slot = demux->slot[entry->domainNumber];
+    entry->messageType = ptpMessage[PTP_HDR_MSG_TYPE_OFFSET] & 0x0F;
+    entry->sequenceId = (NS_UINT16)((ptpMessage[PTP_HDR_SEQUENCE_ID_OFFSET] << 8) |
+                                    ptpMessage[PTP_HDR_SEQUENCE_ID_OFFSET + 1]);
+    demux->txCount++;
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLDemuxTxTimestamp (
+        IN OUT PEPL_DEMUX demux,
+        IN PPTP_TIME txTime)
+
+//  Routes the next transmit timestamp to the domain of the oldest message
+//  recorded with EPLDemuxTransmitted().
+//
+//  demux
+//      Demultiplexer initialized with EPLDemuxInit().
+//  txTime
+//      Transmit timestamp, not yet corrected for the transmit latency.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_FAILURE if no message is waiting for
+//      a timestamp.
+//
+//  Delay_Req timestamps complete the domain's delay measurements. Those of
+//  domains no longer followed are dropped.
+//****************************************************************************
+{
+PEPL_DEMUX_DOMAIN domain;
+EPL_DEMUX_TX *entry;
+PTP_TIME timestamp;
+
+    if ( !demux->txCount)
+    {
+        demux->txUnmatched++;
+        return NS_STATUS_FAILURE;
+    }
+    entry = &demux->txQueue[demux->txHead];
+    demux->txHead = (demux->txHead + 1) % DEMUX_TX_QUEUE;
+    demux->txCount--;
+
+    // The slot may have been given to another domain since
+    if ( entry->slot == DEMUX_NO_SLOT || demux->slot[entry->domainNumber] != entry->slot)
+        return NS_STATUS_SUCCESS;
+
+    domain = &demux->domains[entry->slot];
+    domain->txTimestamps++;
+    if ( entry->messageType == PTP_MSG_DELAY_REQ)
+    {
+        timestamp = *txTime;
+        timestamp.nanoSeconds += demux->txLatencyNs;
+        PTPTimeNormalize( &timestamp);
+        EPLE2EDelayReqSent( &domain->e2e, entry->sequenceId,
+                            (NS_UINT32)timestamp.seconds, (NS_UINT32)timestamp.nanoSeconds);
+    }
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT NS_UINT
+    EPLDemuxService (
+        IN OUT PEPL_DEMUX demux)
+
+//  Takes the available transmit timestamps from the timestamp delivery
+//  manager and routes them, and turns the hash filter back on at the end
+//  of a master change. Call after transmitting event messages and
+//  periodically, e.g. together with EPLTsdService().
+//
+//  demux
+//      Demultiplexer initialized with EPLDemuxInit().
+//
+//  Returns
+//      Number of transmit timestamps routed.
+//****************************************************************************
+{
+PTP_TIME timestamp;
+NS_UINT count = 0;
+
+    if ( demux->hashTransition &&
+         (NS_UINT32)(OAIGetTimeStamp() - demux->hashTransitionStart) >= demux->hashHoldUs)
+    {
+        demux->hashTransition = FALSE;
+        DemuxProgramHash( demux);
+    }
+
+    if ( !demux->tsd)
+        return 0;
+
+    while ( demux->txCount &&
+            EPLTsdGetTxTimestamp( demux->tsd, &timestamp) == NS_STATUS_SUCCESS)
+    {
+        EPLDemuxTxTimestamp( demux, &timestamp);
+        count++;
+    }
+    return count;
+}
@@ -0,0 +1,412 @@
+//****************************************************************************
+// epl_e2e.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Contains sources for the end-to-end delay mechanism (slave side).
+//
+// The four timestamps of an exchange arrive from different sources and in
+// no particular order: t2 and t3 from the PHY (PTPGetReceiveTimestamp(),
+// PTPGetTransmitTimestamp() or Status Frames), t1 from a one-step Sync or
+// its Follow_Up and t4 from the Delay_Resp. Each input is stored in a
+// fixed table slot selected by the low bits of its sequenceId and the
+// measurement is computed as soon as a pair is complete:
+//
+//      masterToSlave = t2 - t1 - correction(Sync/Follow_Up)
+//      slaveToMaster = t4 - t3 - correction(Delay_Resp)
+//      meanPathDelay = (masterToSlave + slaveToMaster) / 2
+//      offset        = masterToSlave - meanPathDelay
+//
+// An engine is meant to be driven from one context (the PTP task of the
+// port), so no locking is done. Nothing is allocated.
+//
+// The following functions are implemented in this module:
+//
+//      EPLE2EInit
+//      EPLE2ESetFilter
+//      EPLE2ESetMeanPathDelay
+//      EPLE2ESyncReceived
+//      EPLE2ESyncOrigin
+//      EPLE2EDelayReqSent
+//      EPLE2EDelayResp
+//      EPLE2EGetSample
+//****************************************************************************
+
+#include "epl/epl.h"
+
+//****************************************************************************
+static NS_SINT64
+    E2EDiff (
+        IN NS_UINT32 secondsA,
+        IN NS_UINT32 nanoSecondsA,
+        IN NS_UINT32 secondsB,
+        IN NS_UINT32 nanoSecondsB)
+//  Returns time A - time B in scaled nanoseconds.
+//****************************************************************************
+{
+NS_SINT64 ns;
+
+    ns = (NS_SINT64)(NS_SINT32)(secondsA - secondsB) * 1000000000 +
+         ((NS_SINT64)nanoSecondsA - (NS_SINT64)nanoSecondsB);
+    return E2E_NS_TO_SCALED( ns);
+}
+
+//****************************************************************************
+static EPL_E2E_SLOT *
+    E2EGetSlot (
+        IN OUT PEPL_E2E_ENGINE engine,
+        IN OUT EPL_E2E_SLOT *table,
+        IN NS_UINT16 sequenceId)
+//  Returns the table slot of sequenceId, claiming it if it holds an older
+//  exchange. Returns NULL if the slot already belongs to a newer sequenceId
+//  (a late input for an exchange that has been given up on).
+//****************************************************************************
+{
+EPL_E2E_SLOT *slot;
+
+    slot = &table[sequenceId & (E2E_TABLE_SIZE - 1)];
+    if ( slot->flags && slot->sequenceId != sequenceId)
+    {
+        if ( (NS_SINT16)(sequenceId - slot->sequenceId) < 0)
+        {
+            engine->stats.unmatched++;
+            return NULL;
+        }
+        engine->stats.overwritten++;
+        slot->flags = 0;
+    }
+    if ( !slot->flags)
+    {
+        slot->sequenceId = sequenceId;
+        slot->correction = 0;
+    }
+    return slot;
+}
+
+//****************************************************************************
+static NS_BOOL
+    E2ESyncComplete (
+        IN OUT PEPL_E2E_ENGINE engine,
+        IN OUT EPL_E2E_SLOT *slot)
+//  Computes the master to slave delay of a completed Sync and, once the
+//  mean path delay is known, the offset from master.
+//****************************************************************************
+{
+NS_SINT64 offset;
+
+    engine->masterToSlave = E2EDiff( slot->seconds[1], slot->nanoSeconds[1],
+                                     slot->seconds[0], slot->nanoSeconds[0]) - slot->correction;
+    engine->haveMasterToSlave = TRUE;
+    engine->stats.syncs++;
+    engine->haveSample = FALSE;
+    slot->flags = 0;
+
+    if ( !engine->haveDelay)
+        return FALSE;
+
+    offset = engine->masterToSlave - engine->meanPathDelay;
+    if ( engine->filter[E2E_FILTER_OFFSET] &&
+         !engine->filter[E2E_FILTER_OFFSET]( engine->filterContext[E2E_FILTER_OFFSET], &offset))
+    {
+        engine->stats.offsetsRejected++;
+        return FALSE;
+    }
+
+    engine->last.sequenceId = slot->sequenceId;
+    engine->last.rxSeconds = slot->seconds[1];
+    engine->last.rxNanoSeconds = slot->nanoSeconds[1];
+    engine->last.offset = offset;
+    engine->last.meanPathDelay = engine->meanPathDelay;
+    engine->haveSample = TRUE;
+    return TRUE;
+}
+
+//****************************************************************************
+static NS_BOOL
+    E2EDelayComplete (
+        IN OUT PEPL_E2E_ENGINE engine,
+        IN OUT EPL_E2E_SLOT *slot)
+//  Computes the mean path delay from a completed Delay_Req/Delay_Resp
+//  exchange and the most recent master to slave delay.
+//****************************************************************************
+{
+NS_SINT64 slaveToMaster, delay;
+
+    slaveToMaster = E2EDiff( slot->seconds[1], slot->nanoSeconds[1],
+                             slot->seconds[0], slot->nanoSeconds[0]) - slot->correction;
+    slot->flags = 0;
+    if ( !engine->haveMasterToSlave)
+        return FALSE;
+
+    delay = (engine->masterToSlave + slaveToMaster) / 2;
+    if ( delay < 0 ||
+         (engine->filter[E2E_FILTER_DELAY] &&
+          !engine->filter[E2E_FILTER_DELAY]( engine->filterContext[E2E_FILTER_DELAY], &delay)))
+    {
+        engine->stats.delaysRejected++;
+        return FALSE;
+    }
+
+    engine->meanPathDelay = delay;
+    engine->haveDelay = TRUE;
+    engine->stats.delays++;
+    return TRUE;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLE2EInit (
+        IN OUT PEPL_E2E_ENGINE engine)
+
+//  Initializes an end-to-end delay engine.
+//
+//  engine
+//      Caller allocated engine object, one per port.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    memset( engine, 0, sizeof( EPL_E2E_ENGINE));
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLE2ESetFilter (
+        IN OUT PEPL_E2E_ENGINE engine,
+        IN EPL_E2E_FILTER_ENUM which,
+        IN EPL_E2E_FILTER filter,
+        IN void *context)
+
+//  Installs a filter for delay or offset measurements.
+//
+//  engine
+//      Engine initialized with EPLE2EInit().
+//  which
+//      E2E_FILTER_DELAY or E2E_FILTER_OFFSET.
+//  filter
+//      Filter function, or NULL to use measurements unfiltered.
+//  context
+//      Passed through to the filter.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    if ( which < E2E_NUM_FILTERS)
+    {
+        engine->filter[which] = filter;
+        engine->filterContext[which] = context;
+    }
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLE2ESetMeanPathDelay (
+        IN OUT PEPL_E2E_ENGINE engine,
+        IN NS_SINT64 meanPathDelay)
+
+//  Seeds the mean path delay, e.g. from a checkpoint, so offsets are
+//  available from the first Sync instead of after the first Delay_Resp.
+//
+//  engine
+//      Engine initialized with EPLE2EInit().
+//  meanPathDelay
+//      Mean path delay, scaled ns. Replaced by the next measurement.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    engine->meanPathDelay = meanPathDelay;
+    engine->haveDelay = TRUE;
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLE2ESyncReceived (
+        IN OUT PEPL_E2E_ENGINE engine,
+        IN NS_UINT16 sequenceId,
+        IN NS_UINT32 rxSeconds,
+        IN NS_UINT32 rxNanoSeconds)
+
+//  Records the local receive timestamp (t2) of a Sync message.
+//
+//  engine
+//      Engine initialized with EPLE2EInit().
+//  sequenceId
+//      sequenceId of the Sync.
+//  rxSeconds, rxNanoSeconds
+//      Receive timestamp, already adjusted for the receive path latency.
+//
+//  Returns
+//      TRUE if this completed a Sync and produced a new offset sample (see
+//      EPLE2EGetSample()), FALSE otherwise.
+//****************************************************************************
+{
+EPL_E2E_SLOT *slot;
+
+    slot = E2EGetSlot( engine, engine->syncTable, sequenceId);
+    if ( !slot)
+        return FALSE;
+
+    slot->seconds[1] = rxSeconds;
+    slot->nanoSeconds[1] = rxNanoSeconds;
+    slot->flags |= E2E_HAVE_T2;
+    if ( slot->flags != E2E_COMPLETE)
+        return FALSE;
+    return E2ESyncComplete( engine, slot);
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLE2ESyncOrigin (
+        IN OUT PEPL_E2E_ENGINE engine,
+        IN NS_UINT16 sequenceId,
+        IN NS_UINT32 originSeconds,
+        IN NS_UINT32 originNanoSeconds,
+        IN NS_SINT64 correction)
+
+//  Records the master origin timestamp (t1) of a Sync message.
+//
+//  engine
+//      Engine initialized with EPLE2EInit().
+//  sequenceId
+//      sequenceId of the Sync (the Follow_Up carries the same value).
+//  originSeconds, originNanoSeconds
+//      originTimestamp of a one-step Sync, or preciseOriginTimestamp of the
+//      Follow_Up of a two-step Sync (lower 32 bits of the seconds).
+//  correction
+//      correctionField of the one-step Sync, or the sum of the Sync and
+//      Follow_Up correctionFields, in scaled nanoseconds.
+//
+//  Returns
+//      TRUE if this completed a Sync and produced a new offset sample (see
+//      EPLE2EGetSample()), FALSE otherwise.
+//****************************************************************************
+{
+EPL_E2E_SLOT *slot;
+
+    slot = E2EGetSlot( engine, engine->syncTable, sequenceId);
+    if ( !slot)
+        return FALSE;
+
+    slot->seconds[0] = originSeconds;
+    slot->nanoSeconds[0] = originNanoSeconds;
+    slot->correction = correction;
+    slot->flags |= E2E_HAVE_T1;
+    if ( slot->flags != E2E_COMPLETE)
+        return FALSE;
+    return E2ESyncComplete( engine, slot);
+}
+
+//****************************************************************************
+EXPORT void
+    EPLE2EDelayReqSent (
+        IN OUT PEPL_E2E_ENGINE engine,
+        IN NS_UINT16 sequenceId,
+        IN NS_UINT32 txSeconds,
+        IN NS_UINT32 txNanoSeconds)
+
+//  Records the local transmit timestamp (t3) of a Delay_Req message.
+//
+//  engine
+//      Engine initialized with EPLE2EInit().
+//  sequenceId
+//      sequenceId of the Delay_Req.
+//  txSeconds, txNanoSeconds
+//      Transmit timestamp, already adjusted for the transmit path latency.
+//
+//  Returns
+//      Nothing
+//
+//  The transmit timestamp normally becomes available before the Delay_Resp
+//  arrives, but either order is handled.
+//****************************************************************************
+{
+EPL_E2E_SLOT *slot;
+
+    slot = E2EGetSlot( engine, engine->delayTable, sequenceId);
+    if ( !slot)
+        return;
+
+    slot->seconds[0] = txSeconds;
+    slot->nanoSeconds[0] = txNanoSeconds;
+    slot->flags |= E2E_HAVE_T3;
+    if ( slot->flags == E2E_COMPLETE)
+        E2EDelayComplete( engine, slot);
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLE2EDelayResp (
+        IN OUT PEPL_E2E_ENGINE engine,
+        IN NS_UINT16 sequenceId,
+        IN NS_UINT32 rxSeconds,
+        IN NS_UINT32 rxNanoSeconds,
+        IN NS_SINT64 correction)
+
+//  Records the master receive timestamp (t4) from a Delay_Resp message.
+//
+//  engine
+//      Engine initialized with EPLE2EInit().
+//  sequenceId
+//      sequenceId of the Delay_Resp (same as the Delay_Req).
+//  rxSeconds, rxNanoSeconds
+//      receiveTimestamp field of the Delay_Resp (lower 32 bits of the
+//      seconds).
+//  correction
+//      correctionField of the Delay_Resp in scaled nanoseconds.
+//
+//  Returns
+//      TRUE if the mean path delay was updated, FALSE otherwise.
+//
+//  The caller is responsible for checking that requestingPortIdentity
+//  matches this port.
+//****************************************************************************
+{
+EPL_E2E_SLOT *slot;
+
+    slot = E2EGetSlot( engine, engine->delayTable, sequenceId);
+    if ( !slot)
+        return FALSE;
+
+    slot->seconds[1] = rxSeconds;
+    slot->nanoSeconds[1] = rxNanoSeconds;
+    slot->correction = correction;
+    slot->flags |= E2E_HAVE_T4;
+    if ( slot->flags != E2E_COMPLETE)
+        return FALSE;
+    return E2EDelayComplete( engine, slot);
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLE2EGetSample (
+        IN PEPL_E2E_ENGINE engine,
+        OUT PEPL_E2E_SAMPLE sample)
+
+//  Returns the most recent offset from master sample.
+//
+//  engine
+//      Engine initialized with EPLE2EInit().
+//  sample
+//      Set on return to the sample of the most recent Sync. Use
+//      E2E_SCALED_TO_NS() to convert the offset and delay.
+//
+//  Returns
+//      TRUE if a sample is available, FALSE if no offset has been computed
+//      yet (a mean path delay measurement is needed first) or the offset
+//      filter rejected the most recent Sync.
+//****************************************************************************
+{
+    if ( !engine->haveSample)
+        return FALSE;
+    *sample = engine->last;
+    return TRUE;
+}
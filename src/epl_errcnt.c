@@ -0,0 +1,349 @@
+//****************************************************************************
+// epl_errcnt.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Contains sources for the receive error counter harvesting functions.
+//
+// PHY_FCSCR and PHY_RECR are 8-bit counters that clear when read and stick
+// at 0xFF. They are harvested periodically and folded into 64-bit totals
+// so they can be correlated with other events (e.g. PTP offset spikes).
+//
+// Ports attached to an MDIO scheduler are read with monitor class requests,
+// one group per port, so pending timestamp reads run between ports.
+//
+// The following functions are implemented in this module:
+//
+//      EPLErrCntInit
+//      EPLErrCntAddPort
+//      EPLErrCntHarvest
+//      EPLErrCntGetTotal
+//      EPLErrCntGetHistory
+//      EPLErrCntGetRate
+//      EPLErrCntClear
+//****************************************************************************
+
+#include "epl/epl.h"
+
+//****************************************************************************
+static EPL_ERRCNT_PORT *
+    ErrCntFindPort (
+        IN PEPL_ERRCNT_HARVESTER harvester,
+        IN PEPL_PORT_HANDLE portHandle)
+//****************************************************************************
+{
+NS_UINT x;
+
+    for ( x = 0; x < harvester->numPorts; x++)
+    {
+        if ( harvester->ports[x].portHandle == portHandle)
+            return &harvester->ports[x];
+    }
+    return NULL;
+}
+
+//****************************************************************************
+static void
+    ErrCntPrepareReads (
+        OUT EPL_MDIO_OP ops[ERRCNT_NUM_COUNTERS])
+//  Builds the reads of both counters, in EPL_ERRCNT_ENUM order.
+//****************************************************************************
+{
+    ops[ERRCNT_FALSE_CARRIER].flags = MDIO_OP_READ;
+    ops[ERRCNT_FALSE_CARRIER].registerIndex = PHY_FCSCR;
+    ops[ERRCNT_RX_ERROR].flags = MDIO_OP_READ;
+    ops[ERRCNT_RX_ERROR].registerIndex = PHY_RECR;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLErrCntInit (
+        IN OUT PEPL_ERRCNT_HARVESTER harvester)
+
+//  Initializes an error counter harvester object.
+//
+//  harvester
+//      Caller allocated harvester object.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    memset( harvester, 0, sizeof( EPL_ERRCNT_HARVESTER));
+    harvester->lastHarvestTime = OAIGetTimeStamp();
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLErrCntAddPort (
+        IN OUT PEPL_ERRCNT_HARVESTER harvester,
+        IN PEPL_PORT_HANDLE portHandle)
+
+//  Adds a port to the harvester. The hardware counters are read once to
+//  discard any events counted before the port was added.
+//
+//  harvester
+//      Harvester object initialized with EPLErrCntInit().
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort
+//      function.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, NS_STATUS_RESOURCES if the harvester is full or
+//      NS_STATUS_INVALID_PARM if the port was already added.
+//****************************************************************************
+{
+EPL_ERRCNT_PORT *ecPort;
+EPL_MDIO_OP ops[ERRCNT_NUM_COUNTERS];
+
+    if ( ErrCntFindPort( harvester, portHandle))
+        return NS_STATUS_INVALID_PARM;
+    if ( harvester->numPorts >= ERRCNT_MAX_PORTS)
+        return NS_STATUS_RESOURCES;
+
+    ecPort = &harvester->ports[harvester->numPorts++];
+    memset( ecPort, 0, sizeof( EPL_ERRCNT_PORT));
+    ecPort->portHandle = portHandle;
+
+    ErrCntPrepareReads( ops);
+    EPLMdioRun( portHandle, MDIO_CLASS_MONITOR, ops, ERRCNT_NUM_COUNTERS, TRUE);
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLErrCntHarvest (
+        IN OUT PEPL_ERRCNT_HARVESTER harvester)
+
+//  Reads the error counters of all ports and accumulates them.
+//
+//  harvester
+//      Harvester object initialized with EPLErrCntInit().
+//
+//  Returns
+//      Nothing
+//
+//  All counters are read back to back first, holding the multi critical
+//  section across consecutive ports on the same device, so the samples of
+//  all ports cover the same interval. Ports attached to an MDIO scheduler
+//  are read as one group each instead, so a timestamp read waits for at
+//  most one port. Both counters are on page 0, so at most one page select
+//  is issued per port. Call this often enough that the counters do not
+//  reach 0xFF between harvests; a stuck counter is flagged in the history
+//  and counted in the saturations totals.
+//****************************************************************************
+{
+NS_UINT16 raw[ERRCNT_MAX_PORTS][ERRCNT_NUM_COUNTERS];
+EPL_MDIO_OP ops[ERRCNT_NUM_COUNTERS];
+OAI_DEV_HANDLE devHandle;
+PEPL_PORT_HANDLE portHandle;
+EPL_ERRCNT_PORT *ecPort;
+EPL_ERRCNT_SAMPLE *sample;
+NS_UINT32 now;
+NS_UINT x, cnt;
+
+    devHandle = NULL;
+    for ( x = 0; x < harvester->numPorts; x++)
+    {
+        portHandle = harvester->ports[x].portHandle;
+        if ( portHandle->mdioSched)
+        {
+            if ( devHandle)
+                OAIEndMultiCriticalSection( devHandle);
+            devHandle = NULL;
+
+            ErrCntPrepareReads( ops);
+            EPLMdioRun( portHandle, MDIO_CLASS_MONITOR, ops, ERRCNT_NUM_COUNTERS, TRUE);
+            raw[x][ERRCNT_FALSE_CARRIER] = ops[ERRCNT_FALSE_CARRIER].value & P848_FCSCR_FCSCNT_MASK;
+            raw[x][ERRCNT_RX_ERROR] = ops[ERRCNT_RX_ERROR].value & P848_RECR_RXERRCNT_MASK;
+            continue;
+        }
+        if ( portHandle->oaiDevHandle != devHandle)
+        {
+            if ( devHandle)
+                OAIEndMultiCriticalSection( devHandle);
+            devHandle = portHandle->oaiDevHandle;
+            OAIBeginMultiCriticalSection( devHandle);
+        }
+        raw[x][ERRCNT_FALSE_CARRIER] = EPLReadReg( portHandle, PHY_FCSCR) & P848_FCSCR_FCSCNT_MASK;
+        raw[x][ERRCNT_RX_ERROR] = EPLReadReg( portHandle, PHY_RECR) & P848_RECR_RXERRCNT_MASK;
+    }
+    if ( devHandle)
+        OAIEndMultiCriticalSection( devHandle);
+
+    now = OAIGetTimeStamp();
+    for ( x = 0; x < harvester->numPorts; x++)
+    {
+        ecPort = &harvester->ports[x];
+        sample = &ecPort->history[ecPort->historyHead];
+        sample->timeStamp = now;
+        sample->intervalUs = now - harvester->lastHarvestTime;
+        sample->saturated = 0;
+
+        for ( cnt = 0; cnt < ERRCNT_NUM_COUNTERS; cnt++)
+        {
+            sample->delta[cnt] = raw[x][cnt];
+            ecPort->total[cnt] += raw[x][cnt];
+            if ( raw[x][cnt] == ERRCNT_HW_MAX)
+            {
+                sample->saturated |= 1 << cnt;
+                ecPort->saturations[cnt]++;
+            }
+        }
+
+        ecPort->historyHead = (ecPort->historyHead + 1) % ERRCNT_HISTORY_LEN;
+        if ( ecPort->historyCount < ERRCNT_HISTORY_LEN)
+            ecPort->historyCount++;
+    }
+
+    harvester->lastHarvestTime = now;
+    harvester->harvests++;
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_UINT64
+    EPLErrCntGetTotal (
+        IN PEPL_ERRCNT_HARVESTER harvester,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN EPL_ERRCNT_ENUM counter)
+
+//  Returns the accumulated count of one counter.
+//
+//  harvester
+//      Harvester object initialized with EPLErrCntInit().
+//  portHandle
+//      Handle of a port added with EPLErrCntAddPort().
+//  counter
+//      ERRCNT_FALSE_CARRIER or ERRCNT_RX_ERROR.
+//
+//  Returns
+//      Events counted since the port was added or the last EPLErrCntClear(),
+//      or 0 if the port or counter is not valid.
+//****************************************************************************
+{
+EPL_ERRCNT_PORT *ecPort;
+
+    ecPort = ErrCntFindPort( harvester, portHandle);
+    if ( !ecPort || counter >= ERRCNT_NUM_COUNTERS)
+        return 0;
+    return ecPort->total[counter];
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLErrCntGetHistory (
+        IN PEPL_ERRCNT_HARVESTER harvester,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_UINT age,
+        OUT PEPL_ERRCNT_SAMPLE sample)
+
+//  Retrieves one harvest interval from the history of a port.
+//
+//  harvester
+//      Harvester object initialized with EPLErrCntInit().
+//  portHandle
+//      Handle of a port added with EPLErrCntAddPort().
+//  age
+//      0 for the most recent interval, 1 for the one before and so on, up
+//      to ERRCNT_HISTORY_LEN - 1.
+//  sample
+//      Set on return to the counts of that interval.
+//
+//  Returns
+//      NS_STATUS_SUCCESS or NS_STATUS_INVALID_PARM if the port is unknown or
+//      that many intervals have not been harvested yet.
+//****************************************************************************
+{
+EPL_ERRCNT_PORT *ecPort;
+
+    ecPort = ErrCntFindPort( harvester, portHandle);
+    if ( !ecPort || age >= ecPort->historyCount)
+        return NS_STATUS_INVALID_PARM;
+
+    *sample = ecPort->history[(ecPort->historyHead + ERRCNT_HISTORY_LEN - 1 - age) % ERRCNT_HISTORY_LEN];
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT NS_UINT32
+    EPLErrCntGetRate (
+        IN PEPL_ERRCNT_HARVESTER harvester,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN EPL_ERRCNT_ENUM counter,
+        IN NS_UINT numIntervals)
+
+//  Computes the event rate of one counter over the most recent intervals.
+//
+//  harvester
+//      Harvester object initialized with EPLErrCntInit().
+//  portHandle
+//      Handle of a port added with EPLErrCntAddPort().
+//  counter
+//      ERRCNT_FALSE_CARRIER or ERRCNT_RX_ERROR.
+//  numIntervals
+//      Number of harvest intervals to average over. Limited to the history
+//      available.
+//
+//  Returns
+//      Events per 1000 seconds (i.e. events per second with three implied
+//      decimals), or 0 if no interval is available.
+//****************************************************************************
+{
+EPL_ERRCNT_PORT *ecPort;
+EPL_ERRCNT_SAMPLE *sample;
+NS_UINT64 events, elapsedUs;
+NS_UINT x, idx;
+
+    ecPort = ErrCntFindPort( harvester, portHandle);
+    if ( !ecPort || counter >= ERRCNT_NUM_COUNTERS)
+        return 0;
+    if ( numIntervals > ecPort->historyCount)
+        numIntervals = ecPort->historyCount;
+
+    events = 0;
+    elapsedUs = 0;
+    idx = ecPort->historyHead;
+    for ( x = 0; x < numIntervals; x++)
+    {
+        idx = (idx + ERRCNT_HISTORY_LEN - 1) % ERRCNT_HISTORY_LEN;
+        sample = &ecPort->history[idx];
+        events += sample->delta[counter];
+        elapsedUs += sample->intervalUs;
+    }
+
+    if ( elapsedUs == 0)
+        return 0;
+    return (NS_UINT32)(events * 1000000000ULL / elapsedUs);
+}
+
+//****************************************************************************
+EXPORT void
+    EPLErrCntClear (
+        IN OUT PEPL_ERRCNT_HARVESTER harvester)
+
+//  Clears the totals and history of all ports. The ports stay registered.
+//
+//  harvester
+//      Harvester object initialized with EPLErrCntInit().
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+EPL_ERRCNT_PORT *ecPort;
+NS_UINT x;
+
+    for ( x = 0; x < harvester->numPorts; x++)
+    {
+        ecPort = &harvester->ports[x];
+        memset( ecPort->total, 0, sizeof( ecPort->total));
+        memset( ecPort->saturations, 0, sizeof( ecPort->saturations));
+        ecPort->historyHead = 0;
+        ecPort->historyCount = 0;
+    }
+    harvester->harvests = 0;
+    return;
+}
@@ -0,0 +1,581 @@
+//****************************************************************************
+// epl_holdover.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Contains sources for holdover, which keeps the IEEE 1588 clock running
+// at a learned frequency when the time source is lost.
+//
+// While locked, every rate the servo writes is passed to
+// EPLHoldoverAddSample(). The last HOLDOVER_HISTORY rates are kept in a
+// ring with running least squares sums, so adding a sample is O(1):
+//
+//      rate(t) = modelRate + drift * (t - modelTime)
+//
+// On loss of sync EPLHoldoverEnter() fits the model and
+// EPLHoldoverService() writes the extrapolated rate every updateInterval
+// seconds. EPLHoldoverGetTimeError() estimates the time error accumulated
+// since, from the servo offset and the uncertainty of the fit.
+//
+// EPLHoldoverSave() returns the learned rate and drift for non-volatile
+// storage; EPLHoldoverRestore() programs it after a restart so the servo
+// starts near the right frequency.
+//
+// Rates are signed, in 2^-32ns per 8ns cycle (see
+// PTPClockSetRateAdjustment()). One unit is about 0.029ppb.
+//
+// The following functions are implemented in this module:
+//
+//      EPLHoldoverGetDefaultConfig
+//      EPLHoldoverInit
+//      EPLHoldoverAddSample
+//      EPLHoldoverEnter
+//      EPLHoldoverService
+//      EPLHoldoverGetTimeError
+//      EPLHoldoverExit
+//      EPLHoldoverSave
+//      EPLHoldoverRestore
+//****************************************************************************
+
+#include "epl/epl.h"
+
+#define HOLDOVER_SATURATE       0x3FFFFFFFFFFFFFFFULL
+
+//****************************************************************************
+static NS_UINT64
+    HoldoverMul (
+        IN NS_UINT64 a,
+        IN NS_UINT64 b)
+//  Returns a * b, saturated.
+//****************************************************************************
+{
+    if ( b && a > HOLDOVER_SATURATE / b)
+        return HOLDOVER_SATURATE;
+    return a * b;
+}
+
+//****************************************************************************
+static NS_UINT64
+    HoldoverSqrt (
+        IN NS_UINT64 value)
+//  Returns the integer square root.
+//****************************************************************************
+{
+NS_UINT64 root = 0, bit = (NS_UINT64)1 << 62;
+
+    while ( bit > value)
+        bit >>= 2;
+    while ( bit)
+    {
+        if ( value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+//****************************************************************************
+static NS_UINT64
+    HoldoverToNs (
+        IN NS_UINT64 value)
+//  Converts rate units (2^-8) times seconds to nanoseconds: one unit is
+//  125 * 10^6 / 2^32 = 1953125 / 2^26 ns per second.
+//****************************************************************************
+{
+    return (value >> 34) * 1953125 + (((value & 0x3FFFFFFFFULL) * 1953125) >> 34);
+}
+
+//****************************************************************************
+static NS_SINT64
+    HoldoverElapsed (
+        IN NS_UINT32 from,
+        IN NS_UINT32 to)
+//  Returns the signed number of seconds from one clock time to another,
+//  modulo 2^32.
+//****************************************************************************
+{
+NS_SINT64 elapsed = (to - from) & 0xFFFFFFFF;
+
+    return (elapsed & 0x80000000) ? elapsed - 0x100000000LL : elapsed;
+}
+
+//****************************************************************************
+static void
+    HoldoverReset (
+        IN OUT PEPL_HOLDOVER holdover)
+//  Clears the servo history.
+//****************************************************************************
+{
+    holdover->head = holdover->count = 0;
+    holdover->sumT = holdover->sumTT = holdover->sumY = holdover->sumTY = 0;
+    return;
+}
+
+//****************************************************************************
+static NS_BOOL
+    HoldoverFit (
+        IN OUT PEPL_HOLDOVER holdover)
+//  Sets the model (modelTime, modelRate, drift and their uncertainties)
+//  from the servo history. With fewer than minSamples the mean rate is used
+//  with the restored drift, if any, and with no samples the restored state.
+//  Returns FALSE if there is neither.
+//****************************************************************************
+{
+PEPL_HOLDOVER_STATE state = &holdover->restoredState;
+NS_SINT64 n, num, den, t, residual, newest;
+NS_UINT64 sumSquares, variance, sigmaDrift2;
+NS_UINT x, index;
+NS_BOOL fitted;
+
+    n = holdover->count;
+    holdover->sigmaRate = holdover->sigmaDrift = 0;
+    if ( !n)
+    {
+        if ( !holdover->restored)
+            return FALSE;
+        holdover->modelTime = state->time;
+        holdover->modelRate = (NS_SINT64)state->rate << 16;
+        holdover->drift = state->drift;
+        return TRUE;
+    }
+
+    index = (holdover->head + holdover->count - 1) % HOLDOVER_HISTORY;
+    holdover->modelTime = holdover->sampleTime[index];
+    newest = holdover->modelTime - holdover->timeBase;
+
+    den = n * holdover->sumTT - holdover->sumT * holdover->sumT;
+    fitted = (holdover->count >= holdover->cfg.minSamples && den);
+    if ( fitted)
+    {
+        // Least squares slope, 2^-16 units per second
+        num = n * holdover->sumTY - holdover->sumT * holdover->sumY;
+        holdover->drift = (num / den) * 65536 + ((num % den) * 65536) / den;
+        if ( holdover->drift > HOLDOVER_MAX_DRIFT)
+            holdover->drift = HOLDOVER_MAX_DRIFT;
+        if ( holdover->drift < -HOLDOVER_MAX_DRIFT)
+            holdover->drift = -HOLDOVER_MAX_DRIFT;
+    }
+    else
+    {
+        // Too few samples, drift from the restored state if any
+        holdover->drift = holdover->restored ? state->drift : 0;
+    }
+
+    // Line through the mean, evaluated at the newest sample
+    holdover->modelRate = ((holdover->sumY << 16) + holdover->drift * (n * newest - holdover->sumT)) / n;
+
+    // Residuals in 2^-4 units
+    sumSquares = 0;
+    for ( x = 0; x < holdover->count; x++)
+    {
+        index = (holdover->head + x) % HOLDOVER_HISTORY;
+        t = holdover->sampleTime[index] - holdover->timeBase;
+        residual = (((NS_SINT64)holdover->sampleRate[index] << 16) - holdover->modelRate -
+                    holdover->drift * (t - newest)) >> 12;
+        if ( residual < 0) residual = -residual;
+        if ( residual > 0x3FFFFFF) residual = 0x3FFFFFF;
+        sumSquares += (NS_UINT64)(residual * residual);
+    }
+    holdover->modelRate += (NS_SINT64)holdover->rateBase << 16;
+    if ( !fitted)
+    {
+        variance = (n > 1) ? sumSquares / (NS_UINT64)(n - 1) : sumSquares;
+        holdover->sigmaRate = HoldoverSqrt( (variance << 8) / (NS_UINT64)n);
+        return TRUE;
+    }
+    variance = (n > 2) ? sumSquares / (NS_UINT64)(n - 2) : sumSquares;
+
+    // Drift: variance / Stt, Stt = den / n. Rate at the newest sample:
+    // variance / n + drift variance * (newest - mean time)^2. 2^-16 units^2.
+    sigmaDrift2 = HoldoverMul( variance << 8, (NS_UINT64)n) / (NS_UINT64)den;
+    t = newest - holdover->sumT / n;
+    holdover->sigmaDrift = HoldoverSqrt( sigmaDrift2);
+    holdover->sigmaRate = HoldoverSqrt( ((variance << 8) / (NS_UINT64)n) +
+                                        HoldoverMul( sigmaDrift2, (NS_UINT64)(t * t)));
+    return TRUE;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLHoldoverGetDefaultConfig (
+        IN OUT PEPL_HOLDOVER_CFG holdoverConfig)
+
+//  Returns a holdover configuration that fits a drift from 8 or more
+//  samples and updates the rate every 4 seconds for up to a day.
+//
+//  holdoverConfig
+//      Configuration structure to fill in.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    holdoverConfig->minSamples = 8;
+    holdoverConfig->updateInterval = 4;
+    holdoverConfig->maxDriftSeconds = 86400;
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLHoldoverInit (
+        IN OUT PEPL_HOLDOVER holdover,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN PEPL_HOLDOVER_CFG holdoverConfig)
+
+//  Initializes holdover for a port with an empty servo history.
+//
+//  holdover
+//      Caller allocated holdover object.
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort
+//      function.
+//  holdoverConfig
+//      Configuration, see EPLHoldoverGetDefaultConfig(). Copied.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM if the configuration is
+//      not usable.
+//****************************************************************************
+{
+    if ( holdoverConfig->minSamples < 3 || holdoverConfig->minSamples > HOLDOVER_HISTORY ||
+         !holdoverConfig->updateInterval)
+    {
+        return NS_STATUS_INVALID_PARM;
+    }
+
+    memset( holdover, 0, sizeof( EPL_HOLDOVER));
+    holdover->portHandle = portHandle;
+    holdover->cfg = *holdoverConfig;
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLHoldoverAddSample (
+        IN OUT PEPL_HOLDOVER holdover,
+        IN NS_UINT32 time,
+        IN NS_SINT32 rate,
+        IN NS_SINT32 offsetNs)
+
+//  Adds a servo rate to the history. O(1).
+//
+//  holdover
+//      Holdover object initialized with EPLHoldoverInit().
+//  time
+//      Clock seconds the rate was written at. Must not decrease.
+//  rate
+//      Rate written by the servo, 2^-32ns per cycle, negative when the
+//      clock is slowed down.
+//  offsetNs
+//      Servo offset (clock - master) at the time.
+//
+//  Returns
+//      Nothing
+//
+//  Call while locked only, not in holdover. The history restarts if the
+//  time goes backwards, spans more than HOLDOVER_MAX_SPAN seconds or the
+//  rate moves by more than HOLDOVER_MAX_DEVIATION.
+//****************************************************************************
+{
+NS_SINT64 n, t, y, d;
+NS_UINT index;
+
+    if ( holdover->count)
+    {
+        index = (holdover->head + holdover->count - 1) % HOLDOVER_HISTORY;
+        if ( HoldoverElapsed( holdover->sampleTime[index], time) < 0)
+            HoldoverReset( holdover);
+    }
+
+    // Drop the oldest sample and move the time origin to the next one
+    if ( holdover->count == HOLDOVER_HISTORY)
+    {
+        t = holdover->sampleTime[holdover->head] - holdover->timeBase;
+        y = holdover->sampleRate[holdover->head];
+        holdover->sumT -= t;
+        holdover->sumTT -= t * t;
+        holdover->sumY -= y;
+        holdover->sumTY -= t * y;
+        holdover->head = (holdover->head + 1) % HOLDOVER_HISTORY;
+        holdover->count--;
+
+        n = holdover->count;
+        d = (holdover->sampleTime[holdover->head] - holdover->timeBase) & 0xFFFFFFFF;
+        holdover->sumTT += n * d * d - 2 * d * holdover->sumT;
+        holdover->sumTY -= d * holdover->sumY;
+        holdover->sumT -= n * d;
+        holdover->timeBase = holdover->sampleTime[holdover->head];
+    }
+
+    if ( holdover->count &&
+         (((time - holdover->timeBase) & 0xFFFFFFFF) > HOLDOVER_MAX_SPAN ||
+          rate - holdover->rateBase > HOLDOVER_MAX_DEVIATION ||
+          holdover->rateBase - rate > HOLDOVER_MAX_DEVIATION))
+    {
+        HoldoverReset( holdover);
+    }
+    if ( !holdover->count)
+    {
+        holdover->timeBase = time;
+        holdover->rateBase = rate;
+    }
+
+    index = (holdover->head + holdover->count) % HOLDOVER_HISTORY;
+    holdover->sampleTime[index] = time;
+    holdover->sampleRate[index] = rate - holdover->rateBase;
+    holdover->count++;
+
+    t = (time - holdover->timeBase) & 0xFFFFFFFF;
+    y = holdover->sampleRate[index];
+    holdover->sumT += t;
+    holdover->sumTT += t * t;
+    holdover->sumY += y;
+    holdover->sumTY += t * y;
+    holdover->lastOffsetNs = offsetNs;
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLHoldoverEnter (
+        IN OUT PEPL_HOLDOVER holdover,
+        IN NS_UINT32 time)
+
+//  Enters holdover: fits the frequency model and writes the first rate.
+//
+//  holdover
+//      Holdover object initialized with EPLHoldoverInit().
+//  time
+//      Current clock seconds.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_FAILURE if there are no samples and
+//      no restored state; the clock then keeps its current rate.
+//
+//  With fewer than minSamples samples the mean rate is held, with the
+//  restored drift if any. The servo must not write rates until
+//  EPLHoldoverExit().
+//****************************************************************************
+{
+    if ( !HoldoverFit( holdover))
+        return NS_STATUS_FAILURE;
+
+    holdover->active = TRUE;
+    holdover->startTime = time;
+    holdover->nextUpdate = time;
+    holdover->startErrorNs = (NS_UINT32)((holdover->lastOffsetNs < 0) ?
+                                         -holdover->lastOffsetNs : holdover->lastOffsetNs);
+    holdover->rateUpdates = 0;
+    EPLHoldoverService( holdover, time);
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLHoldoverService (
+        IN OUT PEPL_HOLDOVER holdover,
+        IN NS_UINT32 time)
+
+//  Writes the extrapolated rate when an update is due.
+//
+//  holdover
+//      Holdover object in holdover, see EPLHoldoverEnter().
+//  time
+//      Current clock seconds.
+//
+//  Returns
+//      Nothing
+//
+//  Does not access the PHY between updates, or if the rate is unchanged.
+//****************************************************************************
+{
+NS_SINT64 elapsed, rate;
+
+    if ( !holdover->active || HoldoverElapsed( holdover->nextUpdate, time) < 0)
+        return;
+
+    elapsed = HoldoverElapsed( holdover->modelTime, time);
+    if ( elapsed < 0)
+        elapsed = 0;
+    if ( elapsed > (NS_SINT64)holdover->cfg.maxDriftSeconds)
+        elapsed = holdover->cfg.maxDriftSeconds;
+
+    rate = (holdover->modelRate + holdover->drift * elapsed + 32768) >> 16;
+    if ( rate > HOLDOVER_MAX_RATE)
+        rate = HOLDOVER_MAX_RATE;
+    if ( rate < -HOLDOVER_MAX_RATE)
+        rate = -HOLDOVER_MAX_RATE;
+
+    if ( !holdover->rateUpdates || rate != holdover->appliedRate)
+    {
+        PTPClockSetRateAdjustment( holdover->portHandle, (NS_UINT32)((rate < 0) ? -rate : rate),
+                                   FALSE, (rate < 0));
+        holdover->appliedRate = (NS_SINT32)rate;
+        holdover->rateUpdates++;
+    }
+    holdover->nextUpdate = time + holdover->cfg.updateInterval;
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_UINT64
+    EPLHoldoverGetTimeError (
+        IN PEPL_HOLDOVER holdover,
+        IN NS_UINT32 time)
+
+//  Estimates the time error accumulated since holdover was entered.
+//
+//  holdover
+//      Holdover object in holdover, see EPLHoldoverEnter().
+//  time
+//      Current clock seconds.
+//
+//  Returns
+//      One standard deviation of the time error in nanoseconds: the servo
+//      offset at the start, plus the rate uncertainty times the holdover
+//      time, plus half the drift uncertainty times its square. 0 if not in
+//      holdover.
+//
+//  The uncertainties come from the scatter of the servo rates around the
+//  fitted line, so oscillator wander beyond the history is not included.
+//****************************************************************************
+{
+NS_UINT64 elapsed, error;
+
+    if ( !holdover->active)
+        return 0;
+
+    elapsed = (time - holdover->startTime) & 0xFFFFFFFF;
+    error = HoldoverMul( holdover->sigmaRate, elapsed) +
+            HoldoverMul( HoldoverMul( holdover->sigmaDrift, elapsed), elapsed) / 2;
+    return holdover->startErrorNs + HoldoverToNs( error);
+}
+
+//****************************************************************************
+EXPORT void
+    EPLHoldoverExit (
+        IN OUT PEPL_HOLDOVER holdover)
+
+//  Leaves holdover. The servo takes over the rate again.
+//
+//  holdover
+//      Holdover object.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    holdover->active = FALSE;
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLHoldoverSave (
+        IN PEPL_HOLDOVER holdover,
+        IN NS_UINT32 time,
+        OUT PEPL_HOLDOVER_STATE state)
+
+//  Returns the learned frequency for non-volatile storage.
+//
+//  holdover
+//      Holdover object.
+//  time
+//      Current clock seconds.
+//  state
+//      Set on return to the model rate at time and the drift.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_FAILURE if nothing has been learned.
+//****************************************************************************
+{
+EPL_HOLDOVER model = *holdover;
+NS_SINT64 elapsed, rate;
+
+    if ( !HoldoverFit( &model))
+        return NS_STATUS_FAILURE;
+
+    elapsed = HoldoverElapsed( model.modelTime, time);
+    if ( elapsed < 0)
+        elapsed = 0;
+    if ( elapsed > (NS_SINT64)model.cfg.maxDriftSeconds)
+        elapsed = model.cfg.maxDriftSeconds;
+    rate = (model.modelRate + model.drift * elapsed + 32768) >> 16;
+
+    state->magic = HOLDOVER_STATE_MAGIC;
+    state->time = time;
+    state->rate = (NS_SINT32)rate;
+    state->drift = (NS_SINT32)model.drift;
+    state->samples = holdover->count;
+    state->check = ~(state->magic + state->time + (NS_UINT32)state->rate +
+                     (NS_UINT32)state->drift + state->samples) & 0xFFFFFFFF;
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLHoldoverRestore (
+        IN OUT PEPL_HOLDOVER holdover,
+        IN PEPL_HOLDOVER_STATE state,
+        IN NS_UINT32 time,
+        OUT NS_SINT32 *rate)
+
+//  Programs the rate of a saved state, extrapolated to the current time,
+//  as the normal rate and keeps the state as the model until enough
+//  samples have been collected.
+//
+//  holdover
+//      Holdover object initialized with EPLHoldoverInit().
+//  state
+//      State from EPLHoldoverSave().
+//  time
+//      Current clock seconds.
+//  rate
+//      Set on return to the rate written, to initialize the servo's
+//      frequency term with.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM if the state is not
+//      valid; nothing is written then.
+//****************************************************************************
+{
+NS_SINT64 elapsed, value;
+
+    if ( state->magic != HOLDOVER_STATE_MAGIC ||
+         state->check != (~(state->magic + state->time + (NS_UINT32)state->rate +
+                            (NS_UINT32)state->drift + state->samples) & 0xFFFFFFFF) ||
+         state->rate > HOLDOVER_MAX_RATE || state->rate < -HOLDOVER_MAX_RATE ||
+         state->drift > HOLDOVER_MAX_DRIFT || state->drift < -HOLDOVER_MAX_DRIFT)
+    {
+        return NS_STATUS_INVALID_PARM;
+    }
+
+    elapsed = HoldoverElapsed( state->time, time);
+    if ( elapsed < 0)
+        elapsed = 0;
+    if ( elapsed > (NS_SINT64)holdover->cfg.maxDriftSeconds)
+        elapsed = holdover->cfg.maxDriftSeconds;
+    value = (((NS_SINT64)state->rate << 16) + (NS_SINT64)state->drift * elapsed + 32768) >> 16;
+    if ( value > HOLDOVER_MAX_RATE)
+        value = HOLDOVER_MAX_RATE;
+    if ( value < -HOLDOVER_MAX_RATE)
+        value = -HOLDOVER_MAX_RATE;
+
+    holdover->restored = TRUE;
+    holdover->restoredState = *state;
+    holdover->restoredState.time = time;
+    holdover->restoredState.rate = (NS_SINT32)value;
+    PTPClockSetRateAdjustment( holdover->portHandle, (NS_UINT32)((value < 0) ? -value : value),
+                               FALSE, (value < 0));
+    *rate = (NS_SINT32)value;
+    return NS_STATUS_SUCCESS;
+}
@@ -0,0 +1,728 @@
+//****************************************************************************
+// epl_mdio.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Contains sources for the MDIO scheduler.
+//
+// Register traffic is submitted as requests (lists of read/write operations)
+// in one of four priority classes. The scheduler executes one atomic group
+// of operations at a time and always picks the highest priority class with
+// pending work, so a latency critical timestamp read waits for at most one
+// group of a long configuration or monitoring request.
+//
+// Each scheduler object serves one OAI device (one MDIO bus). Queue
+// manipulation is protected by the register critical section and each
+// group runs inside the multi critical section, so groups are also atomic
+// with respect to code that calls EPLReadReg()/EPLWriteReg() directly.
+//
+// Ports are attached to a scheduler with EPLMdioAttachPort(). The timestamp
+// getters of epl_1588.c, the link quality monitor and the error counter
+// harvester then submit their register traffic through it (EPLMdioRun()),
+// the monitors in small groups, so a timestamp read never waits for more
+// than one of them. Ports that are not attached access the registers
+// directly, as before.
+//
+// The following functions are implemented in this module:
+//
+//      EPLMdioInitScheduler
+//      EPLMdioSetDeadline
+//      EPLMdioInitRequest
+//      EPLMdioSubmit
+//      EPLMdioService
+//      EPLMdioExecute
+//      EPLMdioAttachPort
+//      EPLMdioRun
+//      EPLMdioPrepareTxTimestamp
+//      EPLMdioGetTxTimestamp
+//      EPLMdioPrepareRxTimestamp
+//      EPLMdioGetRxTimestamp
+//      EPLMdioPrepareEvent
+//      EPLMdioGetEvent
+//      EPLMdioGetStats
+//      EPLMdioResetStats
+//****************************************************************************
+
+#include "epl/epl.h"
+
+//****************************************************************************
+static void
+    MdioExecuteOp (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN OUT PEPL_MDIO_OP op)
+//****************************************************************************
+{
+    if ( op->flags & MDIO_OP_WRITE)
+        EPLWriteReg( portHandle, op->registerIndex, op->value);
+    else
+        op->value = EPLReadReg( portHandle, op->registerIndex);
+}
+
+//****************************************************************************
+static NS_UINT
+    MdioEventDataOps (
+        IN NS_UINT eventStatus)
+//  Returns the number of PTP_EDATA reads a PTP_ESTS value announces.
+//****************************************************************************
+{
+    if ( !(eventStatus & P640_EVENT_DET))
+        return 0;
+    return (eventStatus & P640_MULT_EVENT) ? 5 : 4;
+}
+
+//****************************************************************************
+static void
+    MdioPrepareReads (
+        IN OUT PEPL_MDIO_REQUEST request,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN OUT PEPL_MDIO_OP ops,
+        IN NS_UINT numOps,
+        IN NS_UINT registerIndex)
+//  Builds an atomic timestamp class request of numOps reads of one register.
+//****************************************************************************
+{
+NS_UINT x;
+
+    for ( x = 0; x < numOps; x++)
+    {
+        ops[x].flags = MDIO_OP_READ;
+        ops[x].registerIndex = registerIndex;
+        ops[x].value = 0;
+    }
+    EPLMdioInitRequest( request, portHandle, MDIO_CLASS_TIMESTAMP, ops, numOps, TRUE);
+}
+
+//****************************************************************************
+static PEPL_MDIO_REQUEST
+    MdioNextRequest (
+        IN PEPL_MDIO_SCHED sched)
+//  Returns the head of the highest priority non-empty queue, or NULL.
+//****************************************************************************
+{
+PEPL_MDIO_REQUEST request;
+NS_UINT cls;
+
+    request = NULL;
+    OAIBeginRegCriticalSection( sched->oaiDevHandle);
+    for ( cls = 0; cls < MDIO_NUM_CLASSES; cls++)
+    {
+        if ( sched->head[cls])
+        {
+            request = sched->head[cls];
+            break;
+        }
+    }
+    OAIEndRegCriticalSection( sched->oaiDevHandle);
+    return request;
+}
+
+//****************************************************************************
+static void
+    MdioComplete (
+        IN OUT PEPL_MDIO_SCHED sched,
+        IN PEPL_MDIO_REQUEST request,
+        IN NS_UINT32 now)
+//  Removes a finished request from its queue and updates the class stats.
+//****************************************************************************
+{
+EPL_MDIO_CLASS_STATS *stats;
+NS_UINT32 latency;
+
+    OAIBeginRegCriticalSection( sched->oaiDevHandle);
+    sched->head[request->mdioClass] = request->next;
+    if ( !request->next)
+        sched->tail[request->mdioClass] = NULL;
+    OAIEndRegCriticalSection( sched->oaiDevHandle);
+
+    stats = &sched->stats[request->mdioClass];
+    latency = now - request->submitTime;
+    stats->requests++;
+    if ( latency > stats->maxCompleteUs)
+        stats->maxCompleteUs = latency;
+    if ( sched->deadlineUs[request->mdioClass] && latency > sched->deadlineUs[request->mdioClass])
+        stats->deadlineMisses++;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLMdioInitScheduler (
+        IN OUT PEPL_MDIO_SCHED sched,
+        IN OAI_DEV_HANDLE oaiDevHandle)
+
+//  Initializes an MDIO scheduler object.
+//
+//  sched
+//      Caller allocated scheduler object.
+//  oaiDevHandle
+//      OAI device handle shared by all ports whose traffic is scheduled.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    memset( sched, 0, sizeof( EPL_MDIO_SCHED));
+    sched->oaiDevHandle = oaiDevHandle;
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLMdioSetDeadline (
+        IN OUT PEPL_MDIO_SCHED sched,
+        IN EPL_MDIO_CLASS_ENUM mdioClass,
+        IN NS_UINT32 deadlineUs)
+
+//  Sets the completion deadline of a priority class. Requests completing
+//  later than this after submission are counted in deadlineMisses.
+//
+//  sched
+//      Scheduler object initialized with EPLMdioInitScheduler().
+//  mdioClass
+//      Priority class.
+//  deadlineUs
+//      Deadline in microseconds, 0 to disable.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    if ( mdioClass < MDIO_NUM_CLASSES)
+        sched->deadlineUs[mdioClass] = deadlineUs;
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLMdioInitRequest (
+        IN OUT PEPL_MDIO_REQUEST request,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN EPL_MDIO_CLASS_ENUM mdioClass,
+        IN PEPL_MDIO_OP ops,
+        IN NS_UINT numOps,
+        IN NS_BOOL atomic)
+
+//  Initializes a request object.
+//
+//  request
+//      Caller allocated request object.
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort
+//      function.
+//  mdioClass
+//      Priority class of the request.
+//  ops
+//      Register operations, executed in order. Read results are returned
+//      in the value field of each operation.
+//  numOps
+//      Number of operations.
+//  atomic
+//      TRUE to execute all operations as one group (e.g. a PTP_TDR burst
+//      followed by its PTP_CTL command). Otherwise only operations linked
+//      with MDIO_OP_CHAIN are kept together.
+//
+//  Returns
+//      Nothing
+//
+//  The callback and context fields may be set after this call.
+//****************************************************************************
+{
+    memset( request, 0, sizeof( EPL_MDIO_REQUEST));
+    request->portHandle = portHandle;
+    request->mdioClass = mdioClass;
+    request->ops = ops;
+    request->numOps = numOps;
+    request->atomic = atomic;
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLMdioSubmit (
+        IN OUT PEPL_MDIO_SCHED sched,
+        IN OUT PEPL_MDIO_REQUEST request)
+
+//  Queues a request at the tail of its priority class.
+//
+//  sched
+//      Scheduler object initialized with EPLMdioInitScheduler().
+//  request
+//      Request initialized with EPLMdioInitRequest(). The request and its
+//      operations are owned by the scheduler until done is set (or the
+//      callback has been called).
+//
+//  Returns
+//      NS_STATUS_SUCCESS or NS_STATUS_INVALID_PARM if the request is empty,
+//      has an invalid class or belongs to a port on another device.
+//****************************************************************************
+{
+    if ( request->mdioClass >= MDIO_NUM_CLASSES || request->numOps == 0 ||
+         request->portHandle->oaiDevHandle != sched->oaiDevHandle)
+        return NS_STATUS_INVALID_PARM;
+
+    request->next = NULL;
+    request->nextOp = 0;
+    request->done = FALSE;
+    request->submitTime = OAIGetTimeStamp();
+
+    OAIBeginRegCriticalSection( sched->oaiDevHandle);
+    if ( sched->tail[request->mdioClass])
+        sched->tail[request->mdioClass]->next = request;
+    else
+        sched->head[request->mdioClass] = request;
+    sched->tail[request->mdioClass] = request;
+    OAIEndRegCriticalSection( sched->oaiDevHandle);
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT NS_UINT
+    EPLMdioService (
+        IN OUT PEPL_MDIO_SCHED sched,
+        IN NS_UINT maxGroups)
+
+//  Executes pending register operations in priority order.
+//
+//  sched
+//      Scheduler object initialized with EPLMdioInitScheduler().
+//  maxGroups
+//      Maximum number of atomic groups to execute before returning.
+//
+//  Returns
+//      Number of groups executed, 0 if all queues are empty.
+//
+//  Priority is re-evaluated before every group, so a request queued in a
+//  higher class preempts a lower class request between its groups.
+//  Completion callbacks are invoked from this function, outside of any
+//  critical section.
+//****************************************************************************
+{
+PEPL_MDIO_REQUEST request;
+PEPL_MDIO_OP op;
+EPL_MDIO_CLASS_STATS *stats;
+EPL_MDIO_CALLBACK callback;
+NS_UINT32 queuedUs;
+NS_UINT groups;
+NS_BOOL finished;
+
+    for ( groups = 0; groups < maxGroups; groups++)
+    {
+        OAIBeginMultiCriticalSection( sched->oaiDevHandle);
+        request = MdioNextRequest( sched);
+        if ( !request)
+        {
+            OAIEndMultiCriticalSection( sched->oaiDevHandle);
+            break;
+        }
+
+        stats = &sched->stats[request->mdioClass];
+        if ( request->nextOp == 0)
+        {
+            queuedUs = OAIGetTimeStamp() - request->submitTime;
+            stats->totalQueuedUs += queuedUs;
+            if ( queuedUs > stats->maxQueuedUs)
+                stats->maxQueuedUs = queuedUs;
+        }
+
+        do {
+            op = &request->ops[request->nextOp++];
+            MdioExecuteOp( request->portHandle, op);
+            stats->operations++;
+            if ( op->flags & MDIO_OP_EVENT_STATUS)
+                request->numOps = request->nextOp + MdioEventDataOps( op->value);
+        } while ( request->nextOp < request->numOps && (request->atomic || (op->flags & MDIO_OP_CHAIN)));
+
+        finished = (request->nextOp >= request->numOps) ? TRUE : FALSE;
+        callback = request->callback;
+        if ( finished)
+        {
+            MdioComplete( sched, request, OAIGetTimeStamp());
+            if ( !callback)
+                request->done = TRUE;
+        }
+        OAIEndMultiCriticalSection( sched->oaiDevHandle);
+
+        if ( finished && callback)
+        {
+            callback( request, request->context);
+            request->done = TRUE;
+        }
+    }
+
+    return groups;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLMdioExecute (
+        IN OUT PEPL_MDIO_SCHED sched,
+        IN OUT PEPL_MDIO_REQUEST request)
+
+//  Submits a request and services the scheduler until it has completed.
+//
+//  sched
+//      Scheduler object initialized with EPLMdioInitScheduler().
+//  request
+//      Request initialized with EPLMdioInitRequest(). It must not have a
+//      callback.
+//
+//  Returns
+//      NS_STATUS_SUCCESS or NS_STATUS_INVALID_PARM (see EPLMdioSubmit()).
+//
+//  Any higher priority work queued by other contexts is executed first,
+//  by this caller, in the usual priority order.
+//****************************************************************************
+{
+NS_STATUS status;
+
+    if ( request->callback)
+        return NS_STATUS_INVALID_PARM;
+
+    status = EPLMdioSubmit( sched, request);
+    if ( status != NS_STATUS_SUCCESS)
+        return status;
+
+    while ( !request->done)
+        EPLMdioService( sched, 1);
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLMdioAttachPort (
+        IN OUT PEPL_PORT_HANDLE portHandle,
+        IN PEPL_MDIO_SCHED sched)
+
+//  Routes the timestamp and monitoring traffic of a port through a
+//  scheduler.
+//
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort
+//      function.
+//  sched
+//      Scheduler object of the port's device, or NULL to go back to direct
+//      register access.
+//
+//  Returns
+//      Nothing
+//
+//  Once attached, PTPCheckForEvents(), PTPGetTransmitTimestamp(),
+//  PTPGetReceiveTimestamp() and PTPGetEvent() use timestamp class requests,
+//  the link quality monitor and the error counter harvester use monitor
+//  class requests. Do not change the attachment while any of them is in
+//  progress on the port.
+//****************************************************************************
+{
+    portHandle->mdioSched = (sched && sched->oaiDevHandle == portHandle->oaiDevHandle) ? sched : NULL;
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLMdioRun (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN EPL_MDIO_CLASS_ENUM mdioClass,
+        IN OUT PEPL_MDIO_OP ops,
+        IN NS_UINT numOps,
+        IN NS_BOOL atomic)
+
+//  Executes a list of register operations through the scheduler the port is
+//  attached to, or directly if it is not attached.
+//
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort
+//      function.
+//  mdioClass
+//      Priority class of the operations.
+//  ops
+//      Register operations, read results are returned in the value fields.
+//  numOps
+//      Number of operations.
+//  atomic
+//      See EPLMdioInitRequest().
+//
+//  Returns
+//      NS_STATUS_SUCCESS or NS_STATUS_INVALID_PARM (see EPLMdioSubmit()).
+//
+//  Without a scheduler all operations run inside one multi critical
+//  section, regardless of atomic.
+//****************************************************************************
+{
+EPL_MDIO_REQUEST request;
+NS_UINT x;
+
+    if ( portHandle->mdioSched)
+    {
+        EPLMdioInitRequest( &request, portHandle, mdioClass, ops, numOps, atomic);
+        return EPLMdioExecute( portHandle->mdioSched, &request);
+    }
+
+    OAIBeginMultiCriticalSection( portHandle->oaiDevHandle);
+    for ( x = 0; x < numOps; x++)
+    {
+        MdioExecuteOp( portHandle, &ops[x]);
+        if ( ops[x].flags & MDIO_OP_EVENT_STATUS)
+            numOps = x + 1 + MdioEventDataOps( ops[x].value);
+    }
+    OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLMdioPrepareTxTimestamp (
+        IN OUT PEPL_MDIO_REQUEST request,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN OUT EPL_MDIO_OP ops[MDIO_TXTS_OPS])
+
+//  Builds a timestamp class request that reads the next transmit timestamp.
+//  This is the scheduled equivalent of PTPGetTransmitTimestamp().
+//
+//  request
+//      Request object to initialize.
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort
+//      function.
+//  ops
+//      Storage for the operations, must remain valid until the request
+//      has completed.
+//
+//  Returns
+//      Nothing
+//
+//  The four PTP_TXTS reads pop one entry from the timestamp queue and
+//  always execute as one atomic group. Use EPLMdioGetTxTimestamp() to
+//  decode the result.
+//****************************************************************************
+{
+    MdioPrepareReads( request, portHandle, ops, MDIO_TXTS_OPS, PHY_PG4_PTP_TXTS);
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLMdioGetTxTimestamp (
+        IN PEPL_MDIO_REQUEST request,
+        OUT NS_UINT32 *retNumberOfSeconds,
+        OUT NS_UINT32 *retNumberOfNanoSeconds,
+        OUT NS_UINT *overflowCount)
+
+//  Decodes a completed request built with EPLMdioPrepareTxTimestamp().
+//
+//  request
+//      Completed request.
+//  retNumberOfSeconds
+//      Set on return to the transmit timestamp seconds.
+//  retNumberOfNanoSeconds
+//      Set on return to the transmit timestamp nanoseconds.
+//  overflowCount
+//      Set on return to the number of timestamps dropped (sticks at 3).
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+PEPL_MDIO_OP ops = request->ops;
+
+    *retNumberOfNanoSeconds = ops[0].value | ((NS_UINT32)(ops[1].value & 0x3FFF) << 16);
+    *overflowCount = (ops[1].value & 0xC000) >> 14;
+    *retNumberOfSeconds = ops[2].value | ((NS_UINT32)ops[3].value << 16);
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLMdioPrepareRxTimestamp (
+        IN OUT PEPL_MDIO_REQUEST request,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN OUT EPL_MDIO_OP ops[MDIO_RXTS_OPS])
+
+//  Builds a timestamp class request that reads the next receive timestamp.
+//  This is the scheduled equivalent of PTPGetReceiveTimestamp().
+//
+//  request
+//      Request object to initialize.
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort
+//      function.
+//  ops
+//      Storage for the operations, must remain valid until the request
+//      has completed.
+//
+//  Returns
+//      Nothing
+//
+//  The six PTP_RXTS reads pop one entry from the timestamp queue and
+//  always execute as one atomic group. Use EPLMdioGetRxTimestamp() to
+//  decode the result.
+//****************************************************************************
+{
+    MdioPrepareReads( request, portHandle, ops, MDIO_RXTS_OPS, PHY_PG4_PTP_RXTS);
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLMdioGetRxTimestamp (
+        IN PEPL_MDIO_REQUEST request,
+        OUT NS_UINT32 *retNumberOfSeconds,
+        OUT NS_UINT32 *retNumberOfNanoSeconds,
+        OUT NS_UINT *overflowCount,
+        OUT NS_UINT *sequenceId,
+        OUT NS_UINT8 *messageType,
+        OUT NS_UINT *hashValue)
+
+//  Decodes a completed request built with EPLMdioPrepareRxTimestamp(). The
+//  parameters are those of PTPGetReceiveTimestamp().
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+PEPL_MDIO_OP ops = request->ops;
+
+    *retNumberOfNanoSeconds = ops[0].value | ((NS_UINT32)(ops[1].value & 0x3FFF) << 16);
+    *overflowCount = (ops[1].value & 0xC000) >> 14;
+    *retNumberOfSeconds = ops[2].value | ((NS_UINT32)ops[3].value << 16);
+    *sequenceId = ops[4].value;
+    *messageType = (NS_UINT8)(ops[5].value >> 12);
+    *hashValue = ops[5].value & 0x0FFF;
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLMdioPrepareEvent (
+        IN OUT PEPL_MDIO_REQUEST request,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN OUT EPL_MDIO_OP ops[MDIO_EVENT_OPS])
+
+//  Builds a timestamp class request that reads PTP_ESTS and the event data
+//  (PTP_EDATA) it announces, the scheduled equivalent of PTPGetEvent().
+//
+//  request
+//      Request object to initialize.
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort
+//      function.
+//  ops
+//      Storage for the operations, must remain valid until the request
+//      has completed.
+//
+//  Returns
+//      Nothing
+//
+//  The PTP_ESTS read is marked MDIO_OP_EVENT_STATUS, so the request is cut
+//  to the PTP_EDATA reads it announces (none without an event, the extended
+//  status only for multiple events) and all run as one atomic group. The
+//  event is popped by the PTP_EDATA reads, so no other reader can take it
+//  between the status and its data.
+//****************************************************************************
+{
+    MdioPrepareReads( request, portHandle, ops, MDIO_EVENT_OPS, PHY_PG4_PTP_EDATA);
+    ops[0].flags = MDIO_OP_EVENT_STATUS;
+    ops[0].registerIndex = PHY_PG4_PTP_ESTS;
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLMdioGetEvent (
+        IN PEPL_MDIO_REQUEST request,
+        OUT NS_UINT *eventBits,
+        OUT NS_UINT *riseFlags,
+        OUT NS_UINT32 *eventTimeSeconds,
+        OUT NS_UINT32 *eventTimeNanoSeconds,
+        OUT NS_UINT *eventsMissed)
+
+//  Decodes a completed request built with EPLMdioPrepareEvent(). The
+//  parameters are those of PTPGetEvent().
+//
+//  Returns
+//      TRUE if an event was read, FALSE otherwise (only eventsMissed is
+//      set).
+//
+//  The timestamp is returned as read, without the pin input delay
+//  compensation PTPGetEvent() applies.
+//****************************************************************************
+{
+PEPL_MDIO_OP ops = &request->ops[1];
+NS_UINT eventStatus = request->ops[0].value;
+NS_UINT exSts, evt, x;
+
+    *eventBits = 0;
+    *riseFlags = 0;
+    *eventsMissed = (eventStatus & P640_EVNTS_MISSED_MASK) >> P640_EVNTS_MISSED_SHIFT;
+    if ( !(eventStatus & P640_EVENT_DET))
+        return FALSE;
+
+    if ( eventStatus & P640_MULT_EVENT)
+    {
+        exSts = ops[0].value;
+        for ( x = 8; x; x--)
+        {
+            if ( exSts & 0x40)
+                *eventBits |= 1 << (x-1);
+            if ( exSts & 0x80)
+                *riseFlags |= 1 << (x-1);
+            exSts <<= 2;
+        }
+        ops++;
+    }
+    else
+    {
+        evt = (eventStatus & P640_EVNT_NUM_MASK) >> P640_EVNT_NUM_SHIFT;
+        *eventBits = 1 << evt;
+        *riseFlags = ((eventStatus & P640_EVNT_RF) ? 1 : 0) << evt;
+    }
+
+    *eventTimeNanoSeconds = ops[0].value | ((NS_UINT32)ops[1].value << 16);
+    *eventTimeSeconds = ops[2].value | ((NS_UINT32)ops[3].value << 16);
+    return TRUE;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLMdioGetStats (
+        IN PEPL_MDIO_SCHED sched,
+        IN EPL_MDIO_CLASS_ENUM mdioClass,
+        OUT PEPL_MDIO_CLASS_STATS stats)
+
+//  Returns the latency statistics of a priority class.
+//
+//  sched
+//      Scheduler object initialized with EPLMdioInitScheduler().
+//  mdioClass
+//      Priority class.
+//  stats
+//      Set on return to the class statistics. The average queueing latency
+//      is totalQueuedUs / requests.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    if ( mdioClass < MDIO_NUM_CLASSES)
+        *stats = sched->stats[mdioClass];
+    else
+        memset( stats, 0, sizeof( EPL_MDIO_CLASS_STATS));
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLMdioResetStats (
+        IN OUT PEPL_MDIO_SCHED sched)
+
+//  Clears the statistics of all priority classes.
+//
+//  sched
+//      Scheduler object initialized with EPLMdioInitScheduler().
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    memset( sched->stats, 0, sizeof( sched->stats));
+    return;
+}
@@ -0,0 +1,473 @@
+//****************************************************************************
+// epl_ntp.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Contains sources for NTP hardware timestamping.
+//
+// With NTP_TS_EN set the timestamp unit timestamps UDP port 123 packets
+// instead of PTP event messages. The timestamps are still read from the
+// PTP_TXTS/PTP_RXTS queues as PHY clock seconds and nanoseconds. NTP
+// packets carry no sequenceId, so receive timestamps are matched with
+// received packets in arrival order. Packets are recognized by UDP
+// destination port 123, so responses to clients sending from another port
+// get no transmit timestamp.
+//
+// NTP uses 32.32 fixed point seconds since 1900. The PHY clock may run on
+// the PTP timescale (TAI since 1970) or directly on NTP time; both have
+// 32-bit seconds, so the conversion is an addition modulo 2^32 and NTP era
+// rollover needs no special handling. Fraction conversion uses a single
+// 32x32 multiply per direction; ns -> fraction -> ns is exact and the
+// fraction is within one unit (233ps) of the exact rounded value.
+//
+// The following functions are implemented in this module:
+//
+//      EPLNtpConfigure
+//      EPLNtpSetTimescale
+//      EPLNtpFromPhc
+//      EPLNtpToPhc
+//      EPLNtpFromPhcArray
+//      EPLNtpToPhcArray
+//      EPLNtpGetTransmitTimestamp
+//      EPLNtpGetReceiveTimestamp
+//      EPLNtpPutTimestamp
+//      EPLNtpGetTimestamp
+//      EPLNtpBuildResponse
+//****************************************************************************
+
+#include "epl/epl.h"
+
+// (2^32 / 1e9 - 4) * 2^32, rounded
+#define NTP_FRAC_PER_NS_LO      1266874890ULL
+
+//****************************************************************************
+static NS_UINT32
+    NtpNsToFraction (
+        IN NS_UINT32 nanoSeconds)
+//  Returns nanoSeconds * 2^32 / 1e9, rounded.
+//****************************************************************************
+{
+    return (nanoSeconds << 2) +
+           (NS_UINT32)(((NS_UINT64)nanoSeconds * NTP_FRAC_PER_NS_LO + 0x80000000ULL) >> 32);
+}
+
+//****************************************************************************
+static NS_UINT32
+    NtpFractionToNs (
+        IN NS_UINT32 fraction)
+//  Returns fraction * 1e9 / 2^32, rounded. May return 1e9.
+//****************************************************************************
+{
+    return (NS_UINT32)(((NS_UINT64)fraction * 1000000000 + 0x80000000ULL) >> 32);
+}
+
+//****************************************************************************
+static void
+    NtpPut32 (
+        OUT NS_UINT8 *field,
+        IN NS_UINT32 value)
+//  Stores a 32-bit value in network byte order.
+//****************************************************************************
+{
+    field[0] = (NS_UINT8)(value >> 24);
+    field[1] = (NS_UINT8)(value >> 16);
+    field[2] = (NS_UINT8)(value >> 8);
+    field[3] = (NS_UINT8)value;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLNtpConfigure (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_BOOL ipv6)
+
+//  Configures the transmit and receive timestamp units to timestamp NTP
+//  packets instead of PTP event messages.
+//
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort
+//      function.
+//  ipv6
+//      TRUE to timestamp NTP over IPv6, FALSE for IPv4.
+//
+//  Returns
+//      Nothing
+//
+//  This replaces the complete transmit and receive configuration (see
+//  PTPSetTransmitConfig() and PTPSetReceiveConfig()). NTP_TS_EN applies to
+//  both directions, so PTP and NTP cannot be timestamped at the same time.
+//****************************************************************************
+{
+RX_CFG_ITEMS rxCfgItems;
+
+    PTPSetTransmitConfig( portHandle,
+                          TXOPT_TS_EN | TXOPT_NTP_TS_EN | (ipv6 ? TXOPT_IPV6_EN : TXOPT_IPV4_EN),
+                          0, 0, 0);
+
+    memset( &rxCfgItems, 0, sizeof( rxCfgItems));
+    PTPSetReceiveConfig( portHandle,
+                         RXOPT_RX_TS_EN | (ipv6 ? RXOPT_RX_IPV6_EN : RXOPT_RX_IPV4_EN),
+                         &rxCfgItems);
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLNtpSetTimescale (
+        OUT PEPL_NTP_TIMESCALE timescale,
+        IN NS_BOOL phcRunsNtp,
+        IN NS_SINT utcOffset)
+
+//  Describes the timescale the PHY clock runs on.
+//
+//  timescale
+//      Timescale to initialize.
+//  phcRunsNtp
+//      TRUE if the PHY clock is set to NTP seconds (UTC since 1900), FALSE
+//      if it runs on the PTP timescale (TAI since 1970).
+//  utcOffset
+//      Current TAI - UTC offset in seconds (e.g. 34 in 2010). Ignored if
+//      phcRunsNtp is TRUE.
+//
+//  Returns
+//      Nothing
+//
+//  Must be called again when a leap second changes the UTC offset.
+//****************************************************************************
+{
+    if ( phcRunsNtp)
+        timescale->epochOffset = 0;
+    else
+        timescale->epochOffset = (NS_UINT32)(NTP_EPOCH_OFFSET - utcOffset);
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLNtpFromPhc (
+        IN PEPL_NTP_TIMESCALE timescale,
+        IN NS_UINT32 seconds,
+        IN NS_UINT32 nanoSeconds,
+        OUT PEPL_NTP_TS ntpTime)
+
+//  Converts a PHY clock time to an NTP timestamp.
+//
+//  timescale
+//      PHY clock timescale, see EPLNtpSetTimescale().
+//  seconds
+//      PHY clock seconds.
+//  nanoSeconds
+//      PHY clock nanoseconds, below 1e9.
+//  ntpTime
+//      Set on return to the NTP timestamp.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    ntpTime->seconds = (NS_UINT32)(seconds + timescale->epochOffset);
+    ntpTime->fraction = NtpNsToFraction( nanoSeconds);
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLNtpToPhc (
+        IN PEPL_NTP_TIMESCALE timescale,
+        IN PEPL_NTP_TS ntpTime,
+        OUT NS_UINT32 *seconds,
+        OUT NS_UINT32 *nanoSeconds)
+
+//  Converts an NTP timestamp to PHY clock time, rounded to the nearest
+//  nanosecond.
+//
+//  timescale
+//      PHY clock timescale, see EPLNtpSetTimescale().
+//  ntpTime
+//      NTP timestamp.
+//  seconds
+//      Set on return to the PHY clock seconds.
+//  nanoSeconds
+//      Set on return to the PHY clock nanoseconds.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+NS_UINT32 ns;
+
+    ns = NtpFractionToNs( ntpTime->fraction);
+    *seconds = (NS_UINT32)(ntpTime->seconds - timescale->epochOffset);
+    if ( ns >= 1000000000)
+    {
+        ns -= 1000000000;
+        (*seconds)++;
+    }
+    *nanoSeconds = ns;
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLNtpFromPhcArray (
+        IN PEPL_NTP_TIMESCALE timescale,
+        IN EPL_NTP_PHC_TS *phcTimes,
+        OUT EPL_NTP_TS *ntpTimes,
+        IN NS_UINT count)
+
+//  Converts an array of PHY clock times to NTP timestamps.
+//
+//  timescale
+//      PHY clock timescale, see EPLNtpSetTimescale().
+//  phcTimes
+//      PHY clock times to convert.
+//  ntpTimes
+//      Set on return to the NTP timestamps.
+//  count
+//      Number of timestamps.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+NS_UINT32 offset;
+NS_UINT x;
+
+    offset = timescale->epochOffset;
+    for ( x = 0; x < count; x++)
+    {
+        ntpTimes[x].seconds = (NS_UINT32)(phcTimes[x].seconds + offset);
+        ntpTimes[x].fraction = NtpNsToFraction( phcTimes[x].nanoSeconds);
+    }
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLNtpToPhcArray (
+        IN PEPL_NTP_TIMESCALE timescale,
+        IN EPL_NTP_TS *ntpTimes,
+        OUT EPL_NTP_PHC_TS *phcTimes,
+        IN NS_UINT count)
+
+//  Converts an array of NTP timestamps to PHY clock times.
+//
+//  timescale
+//      PHY clock timescale, see EPLNtpSetTimescale().
+//  ntpTimes
+//      NTP timestamps to convert.
+//  phcTimes
+//      Set on return to the PHY clock times.
+//  count
+//      Number of timestamps.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+NS_UINT32 offset, seconds, ns;
+NS_UINT x;
+
+    offset = timescale->epochOffset;
+    for ( x = 0; x < count; x++)
+    {
+        seconds = (NS_UINT32)(ntpTimes[x].seconds - offset);
+        ns = NtpFractionToNs( ntpTimes[x].fraction);
+        if ( ns >= 1000000000)
+        {
+            ns -= 1000000000;
+            seconds++;
+        }
+        phcTimes[x].seconds = seconds;
+        phcTimes[x].nanoSeconds = ns;
+    }
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLNtpGetTransmitTimestamp (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN PEPL_NTP_TIMESCALE timescale,
+        OUT PEPL_NTP_TS ntpTime,
+        OUT NS_UINT *overflowCount)
+
+//  Returns the next transmit timestamp from the device's transmit timestamp
+//  queue as an NTP timestamp.
+//
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort
+//      function.
+//  timescale
+//      PHY clock timescale, see EPLNtpSetTimescale().
+//  ntpTime
+//      Set on return to the transmit time of the NTP packet.
+//  overflowCount
+//      Set on return to the number of timestamps dropped before this one,
+//      see PTPGetTransmitTimestamp().
+//
+//  Returns
+//      Nothing
+//
+//  As with PTPGetTransmitTimestamp(), the caller must have determined that
+//  a transmit timestamp is available and the timestamp is not corrected for
+//  the delay to the wire.
+//****************************************************************************
+{
+NS_UINT32 seconds, nanoSeconds;
+
+    PTPGetTransmitTimestamp( portHandle, &seconds, &nanoSeconds, overflowCount);
+    EPLNtpFromPhc( timescale, seconds, nanoSeconds, ntpTime);
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLNtpGetReceiveTimestamp (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN PEPL_NTP_TIMESCALE timescale,
+        OUT PEPL_NTP_TS ntpTime,
+        OUT NS_UINT *overflowCount)
+
+//  Returns the next receive timestamp from the device's receive timestamp
+//  queue as an NTP timestamp.
+//
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort
+//      function.
+//  timescale
+//      PHY clock timescale, see EPLNtpSetTimescale().
+//  ntpTime
+//      Set on return to the receive time of the NTP packet.
+//  overflowCount
+//      Set on return to the number of timestamps dropped before this one,
+//      see PTPGetReceiveTimestamp().
+//
+//  Returns
+//      Nothing
+//
+//  The timestamps belong to the NTP packets in the order they were
+//  received. A non-zero overflowCount means that many packets were not
+//  timestamped and the caller must resynchronize, e.g. by dropping the
+//  packets received since the last timestamp. As with
+//  PTPGetReceiveTimestamp(), the timestamp is not corrected for the delay
+//  from the wire.
+//****************************************************************************
+{
+NS_UINT32 seconds, nanoSeconds;
+NS_UINT sequenceId, hashValue;
+NS_UINT8 messageType;
+
+    PTPGetReceiveTimestamp( portHandle, &seconds, &nanoSeconds, overflowCount,
+                            &sequenceId, &messageType, &hashValue);
+    EPLNtpFromPhc( timescale, seconds, nanoSeconds, ntpTime);
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLNtpPutTimestamp (
+        OUT NS_UINT8 *field,
+        IN PEPL_NTP_TS ntpTime)
+
+//  Stores an NTP timestamp in a packet field (network byte order).
+//
+//  field
+//      First of the 8 octets of the timestamp field.
+//  ntpTime
+//      Timestamp to store.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    NtpPut32( &field[0], ntpTime->seconds);
+    NtpPut32( &field[4], ntpTime->fraction);
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLNtpGetTimestamp (
+        IN NS_UINT8 *field,
+        OUT PEPL_NTP_TS ntpTime)
+
+//  Loads an NTP timestamp from a packet field (network byte order).
+//
+//  field
+//      First of the 8 octets of the timestamp field.
+//  ntpTime
+//      Set on return to the timestamp.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    ntpTime->seconds = ((NS_UINT32)field[0] << 24) | ((NS_UINT32)field[1] << 16) |
+                       ((NS_UINT32)field[2] << 8) | field[3];
+    ntpTime->fraction = ((NS_UINT32)field[4] << 24) | ((NS_UINT32)field[5] << 16) |
+                        ((NS_UINT32)field[6] << 8) | field[7];
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLNtpBuildResponse (
+        IN PEPL_NTP_SERVER_CFG serverConfig,
+        IN NS_UINT8 *request,
+        IN NS_UINT requestLength,
+        IN PEPL_NTP_TS receiveTime,
+        IN PEPL_NTP_TS transmitTime,
+        OUT NS_UINT8 *response)
+
+//  Builds the NTP server response to a client request.
+//
+//  serverConfig
+//      Server fields of the response.
+//  request
+//      NTP packet (UDP payload) received from the client.
+//  requestLength
+//      Length of the request.
+//  receiveTime
+//      Time the request was received, normally from
+//      EPLNtpGetReceiveTimestamp().
+//  transmitTime
+//      Transmit time to put in the response. The hardware transmit
+//      timestamp is only known after the response has been sent; it may be
+//      read with EPLNtpGetTransmitTimestamp() for interleaved mode.
+//  response
+//      Buffer of NTP_PACKET_LENGTH octets for the response. May be the same
+//      buffer as request.
+//
+//  Returns
+//      NS_STATUS_SUCCESS - The response was built
+//      NS_STATUS_INVALID_PARM - The request is not an NTP client request
+//****************************************************************************
+{
+NS_UINT version;
+NS_UINT8 poll;
+
+    if ( requestLength < NTP_PACKET_LENGTH ||
+         (request[NTP_LI_VN_MODE_OFFSET] & 0x07) != NTP_MODE_CLIENT)
+        return NS_STATUS_INVALID_PARM;
+    version = (request[NTP_LI_VN_MODE_OFFSET] >> 3) & 0x07;
+    if ( version < 1 || version > NTP_VERSION)
+        return NS_STATUS_INVALID_PARM;
+    poll = request[NTP_POLL_OFFSET];
+
+    // The client's transmit time is echoed as the origin time
+    memcpy( &response[NTP_ORIGIN_TS_OFFSET], &request[NTP_TRANSMIT_TS_OFFSET], 8);
+
+    response[NTP_LI_VN_MODE_OFFSET] = (NS_UINT8)((serverConfig->leap << 6) | (version << 3) | NTP_MODE_SERVER);
+    response[NTP_STRATUM_OFFSET] = serverConfig->stratum;
+    response[NTP_POLL_OFFSET] = poll;
+    response[NTP_PRECISION_OFFSET] = (NS_UINT8)serverConfig->precision;
+    NtpPut32( &response[NTP_ROOT_DELAY_OFFSET], serverConfig->rootDelay);
+    NtpPut32( &response[NTP_ROOT_DISPERSION_OFFSET], serverConfig->rootDispersion);
+    NtpPut32( &response[NTP_REF_ID_OFFSET], serverConfig->refId);
+    EPLNtpPutTimestamp( &response[NTP_REF_TS_OFFSET], &serverConfig->refTime);
+    EPLNtpPutTimestamp( &response[NTP_RECEIVE_TS_OFFSET], receiveTime);
+    EPLNtpPutTimestamp( &response[NTP_TRANSMIT_TS_OFFSET], transmitTime);
+    return NS_STATUS_SUCCESS;
+}
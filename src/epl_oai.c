@@ -10,12 +10,17 @@
 // Prevent inclusion of winsock.h in windows.h will be added as part 
 // epl.h by way of ptp stack includes.
 #include <stdlib.h>
+#ifndef EPL_SIMULATION
 #include "FreeRTOS.h"
 #include "semphr.h"
+#include "task.h"
+#endif
 
 
 #include "epl/epl.h"
 
+#ifndef EPL_SIMULATION
+
 //****************************************************************************
 void 
 	OAIInitialize( 
@@ -116,3 +121,93 @@ void
     OAIEndCriticalSection( oaiDevHandle->multiOpMutex );
     return;
 }
+
+//****************************************************************************
+NS_UINT32
+    OAIGetTimeStamp(
+        void)
+
+//  Returns a free running timestamp in microseconds, used by the library to 
+//  measure durations and latencies. The value wraps at 2^32.
+//
+//  If the platform defines OAI_TIMESTAMP_US() (see epl_platform.h) that 
+//  counter is returned. Otherwise the value is derived from the FreeRTOS 
+//  tick and only has the resolution of one tick (1ms at 1kHz): the MDIO 
+//  latency statistics then read in whole ticks and short timers (timestamp 
+//  delivery drain, hash filter hold) run up to one tick late.
+//
+//  Returns:
+//      Current timestamp in microseconds.
+//****************************************************************************
+{
+#ifdef OAI_TIMESTAMP_US
+    return (NS_UINT32)OAI_TIMESTAMP_US();
+#else
+    return (NS_UINT32)((NS_UINT64)xTaskGetTickCount() * 1000000 / configTICK_RATE_HZ);
+#endif
+}
+
+#else // EPL_SIMULATION
+
+//****************************************************************************
+void 
+	OAIInitialize( 
+		IN OAI_DEV_HANDLE oaiDevHandle)
+//  Simulation build: nothing to allocate, the simulator is single threaded.
+//****************************************************************************
+{
+    oaiDevHandle->regularMutex = 0;
+    oaiDevHandle->multiOpMutex = 0;
+}
+
+//****************************************************************************
+void 
+    OAIBeginRegCriticalSection(
+        IN OAI_DEV_HANDLE oaiDevHandle)
+//****************************************************************************
+{
+    oaiDevHandle->regularMutex++;
+    return;
+}
+
+//****************************************************************************
+void 
+    OAIEndRegCriticalSection(
+        IN OAI_DEV_HANDLE oaiDevHandle)
+//****************************************************************************
+{
+    oaiDevHandle->regularMutex--;
+    return;
+}
+
+//****************************************************************************
+void 
+    OAIBeginMultiCriticalSection(
+        IN OAI_DEV_HANDLE oaiDevHandle)
+//****************************************************************************
+{
+    oaiDevHandle->multiOpMutex++;
+    return;
+}
+
+//****************************************************************************
+void 
+    OAIEndMultiCriticalSection(
+        IN OAI_DEV_HANDLE oaiDevHandle)
+//****************************************************************************
+{
+    oaiDevHandle->multiOpMutex--;
+    return;
+}
+
+//****************************************************************************
+NS_UINT32
+    OAIGetTimeStamp(
+        void)
+//  Simulation build: returns the simulated time in microseconds.
+//****************************************************************************
+{
+    return (NS_UINT32)(EPLSimGetTime() / 1000);
+}
+
+#endif // EPL_SIMULATION
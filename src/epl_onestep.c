@@ -0,0 +1,310 @@
+//****************************************************************************
+// epl_onestep.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Contains sources for building one-step Sync frames.
+//
+// With TXOPT_SYNC_1STEP the PHY writes its transmit time into the
+// originTimestamp of outgoing Sync messages, so no Follow_Up is needed and
+// no transmit timestamp has to be read back. For this to work the frame
+// handed to the MAC must be laid out as follows:
+//
+//  - twoStepFlag clear. Without TXOPT_IGNORE_2STEP the PHY leaves Syncs
+//    with the flag set alone (and queues a transmit timestamp for them),
+//    so two-step Syncs can still be sent on the same port.
+//  - originTimestamp zero; the checksums are computed over the frame as
+//    the MAC sends it.
+//  - For UDP, two zero bytes after the PTP message. With TXOPT_CHK_1STEP
+//    the PHY rewrites them so that the UDP checksum remains valid after the
+//    timestamp is inserted. The UDP checksum is computed once when the
+//    frame is built.
+//  - The Ethernet FCS is recalculated by the PHY (TXOPT_CRC_1STEP).
+//
+// Per Sync only the sequenceId changes; EPLOneStepSetSequenceId() updates
+// it and the UDP checksum incrementally (RFC 1624).
+//
+// The following functions are implemented in this module:
+//
+//      EPLOneStepGetDefaultConfig
+//      EPLOneStepConfigure
+//      EPLOneStepBuildSync
+//      EPLOneStepSetSequenceId
+//****************************************************************************
+
+#include "epl/epl.h"
+
+//****************************************************************************
+static NS_UINT32
+    OneStepSum (
+        IN NS_UINT8 *data,
+        IN NS_UINT length,
+        IN NS_UINT32 sum)
+//  Adds data to a ones complement checksum as big endian 16-bit words.
+//****************************************************************************
+{
+NS_UINT x;
+
+    for ( x = 0; x + 1 < length; x += 2)
+        sum += (data[x] << 8) | data[x + 1];
+    if ( length & 1)
+        sum += data[length - 1] << 8;
+    return sum;
+}
+
+//****************************************************************************
+static NS_UINT16
+    OneStepFold (
+        IN NS_UINT32 sum)
+//  Folds the carries of a ones complement sum into 16 bits.
+//****************************************************************************
+{
+    while ( sum >> 16)
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    return (NS_UINT16)sum;
+}
+
+//****************************************************************************
+static void
+    OneStepPut16 (
+        OUT NS_UINT8 *field,
+        IN NS_UINT value)
+//  Stores a 16-bit value in network byte order.
+//****************************************************************************
+{
+    field[0] = (NS_UINT8)(value >> 8);
+    field[1] = (NS_UINT8)value;
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLOneStepGetDefaultConfig (
+        IN OUT PEPL_ONESTEP_CFG syncConfig,
+        IN EPL_ONESTEP_TRANSPORT_ENUM transport)
+
+//  Returns a Sync frame configuration for the default PTP multicast
+//  destination of a transport.
+//
+//  syncConfig
+//      Configuration structure to fill in. The caller must still set
+//      srcMac, srcIp (for UDP) and sourcePortIdentity.
+//  transport
+//      ONESTEP_L2, ONESTEP_IPV4 or ONESTEP_IPV6.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+static const NS_UINT8 l2Mac[6] = { 0x01, 0x1B, 0x19, 0x00, 0x00, 0x00 };
+static const NS_UINT8 ipv4Mac[6] = { 0x01, 0x00, 0x5E, 0x00, 0x01, 0x81 };
+static const NS_UINT8 ipv6Mac[6] = { 0x33, 0x33, 0x00, 0x00, 0x01, 0x81 };
+static const NS_UINT8 ipv4Dst[4] = { 224, 0, 1, 129 };
+static const NS_UINT8 ipv6Dst[16] = { 0xFF, 0x0E, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01, 0x81 };
+
+    memset( syncConfig, 0, sizeof( EPL_ONESTEP_CFG));
+    syncConfig->transport = transport;
+    syncConfig->hopLimit = 1;
+    switch ( transport)
+    {
+    case ONESTEP_IPV4:
+        memcpy( syncConfig->dstMac, ipv4Mac, 6);
+        memcpy( syncConfig->dstIp, ipv4Dst, 4);
+        break;
+    case ONESTEP_IPV6:
+        memcpy( syncConfig->dstMac, ipv6Mac, 6);
+        memcpy( syncConfig->dstIp, ipv6Dst, 16);
+        break;
+    default:
+        memcpy( syncConfig->dstMac, l2Mac, 6);
+        break;
+    }
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLOneStepConfigure (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN EPL_ONESTEP_TRANSPORT_ENUM transport)
+
+//  Configures the transmit timestamp unit for one-step Sync operation on
+//  the given transport.
+//
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort
+//      function.
+//  transport
+//      ONESTEP_L2, ONESTEP_IPV4 or ONESTEP_IPV6.
+//
+//  Returns
+//      Nothing
+//
+//  This replaces the complete transmit configuration (see
+//  PTPSetTransmitConfig()). TXOPT_IGNORE_2STEP is left clear so Syncs with
+//  the twoStepFlag set are still timestamped rather than modified.
+//****************************************************************************
+{
+NS_UINT opts;
+
+    opts = TXOPT_TS_EN | TXOPT_SYNC_1STEP | TXOPT_CRC_1STEP;
+    if ( transport == ONESTEP_IPV4)
+        opts |= TXOPT_IPV4_EN | TXOPT_CHK_1STEP;
+    else if ( transport == ONESTEP_IPV6)
+        opts |= TXOPT_IPV6_EN | TXOPT_CHK_1STEP;
+    else
+        opts |= TXOPT_L2_EN;
+
+    PTPSetTransmitConfig( portHandle, opts, 2, 0, 0);
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLOneStepBuildSync (
+        IN PEPL_ONESTEP_CFG syncConfig,
+        OUT NS_UINT8 *frameBuffer,
+        IN NS_UINT bufferSize,
+        OUT PEPL_ONESTEP_FRAME frameInfo)
+
+//  Builds a one-step Sync frame template with a sequenceId of 0.
+//
+//  syncConfig
+//      Frame configuration, see EPLOneStepGetDefaultConfig().
+//  frameBuffer
+//      Buffer to build the frame in. ONESTEP_MAX_FRAME_LENGTH bytes are
+//      always enough.
+//  bufferSize
+//      Size of frameBuffer.
+//  frameInfo
+//      Set on return to the frame length and the offsets needed by
+//      EPLOneStepSetSequenceId().
+//
+//  Returns
+//      NS_STATUS_SUCCESS, NS_STATUS_RESOURCES if the buffer is too small or
+//      NS_STATUS_INVALID_PARM for an unknown transport.
+//
+//  The frame excludes the FCS. L2 frames are padded to the 60 byte
+//  minimum.
+//****************************************************************************
+{
+NS_UINT8 *ip, *udp, *ptp;
+NS_UINT ipLength, udpLength, length;
+NS_UINT32 sum;
+
+    switch ( syncConfig->transport)
+    {
+    case ONESTEP_L2:    ipLength = 0;   break;
+    case ONESTEP_IPV4:  ipLength = 20;  break;
+    case ONESTEP_IPV6:  ipLength = 40;  break;
+    default:            return NS_STATUS_INVALID_PARM;
+    }
+    udpLength = ipLength ? 8 + ONESTEP_SYNC_LENGTH + ONESTEP_CHK_TRAILER_LENGTH : 0;
+    length = 14 + ipLength + (ipLength ? udpLength : ONESTEP_SYNC_LENGTH);
+    if ( length < 60)
+        length = 60;
+    if ( bufferSize < length)
+        return NS_STATUS_RESOURCES;
+
+    memset( frameBuffer, 0, length);
+    memcpy( &frameBuffer[0], syncConfig->dstMac, 6);
+    memcpy( &frameBuffer[6], syncConfig->srcMac, 6);
+    ip = &frameBuffer[14];
+    udp = &ip[ipLength];
+    ptp = ipLength ? &udp[8] : ip;
+
+    frameInfo->length = (NS_UINT16)length;
+    frameInfo->ptpOffset = (NS_UINT16)(ptp - frameBuffer);
+    frameInfo->udpOffset = (NS_UINT16)(ipLength ? udp - frameBuffer : 0);
+
+    // Sync message; flags, correctionField and originTimestamp stay zero
+    ptp[0] = PTP_MSG_SYNC;
+    ptp[1] = 2;
+    OneStepPut16( &ptp[2], ONESTEP_SYNC_LENGTH);
+    ptp[PTP_HDR_DOMAIN_OFFSET] = syncConfig->domain;
+    memcpy( &ptp[PTP_HDR_SOURCE_PORT_ID_OFFSET], syncConfig->sourcePortIdentity, PTP_PORT_ID_LENGTH);
+    ptp[32] = 0;                                // controlField: Sync
+    ptp[33] = (NS_UINT8)syncConfig->logMessageInterval;
+
+    if ( syncConfig->transport == ONESTEP_L2)
+    {
+        OneStepPut16( &frameBuffer[12], 0x88F7);
+        return NS_STATUS_SUCCESS;
+    }
+
+    OneStepPut16( &udp[0], ONESTEP_PTP_UDP_PORT);
+    OneStepPut16( &udp[2], ONESTEP_PTP_UDP_PORT);
+    OneStepPut16( &udp[4], udpLength);
+
+    if ( syncConfig->transport == ONESTEP_IPV4)
+    {
+        OneStepPut16( &frameBuffer[12], 0x0800);
+        ip[0] = 0x45;
+        OneStepPut16( &ip[2], ipLength + udpLength);
+        ip[8] = syncConfig->hopLimit;
+        ip[9] = 17;
+        memcpy( &ip[12], syncConfig->srcIp, 4);
+        memcpy( &ip[16], syncConfig->dstIp, 4);
+        OneStepPut16( &ip[10], (NS_UINT16)~OneStepFold( OneStepSum( ip, 20, 0)));
+
+        sum = OneStepSum( &ip[12], 8, 17 + udpLength);
+    }
+    else
+    {
+        OneStepPut16( &frameBuffer[12], 0x86DD);
+        ip[0] = 0x60;
+        OneStepPut16( &ip[4], udpLength);
+        ip[6] = 17;
+        ip[7] = syncConfig->hopLimit;
+        memcpy( &ip[8], syncConfig->srcIp, 16);
+        memcpy( &ip[24], syncConfig->dstIp, 16);
+
+        sum = OneStepSum( &ip[8], 32, 17 + udpLength);
+    }
+
+    // UDP checksum over the pseudo header and the datagram as the MAC
+    // sends it; the PHY keeps it valid through the trailer bytes
+    sum = (NS_UINT16)~OneStepFold( OneStepSum( udp, udpLength, sum));
+    OneStepPut16( &udp[6], sum ? sum : 0xFFFF);
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLOneStepSetSequenceId (
+        IN PEPL_ONESTEP_FRAME frameInfo,
+        IN OUT NS_UINT8 *frameBuffer,
+        IN NS_UINT16 sequenceId)
+
+//  Sets the sequenceId of a frame built by EPLOneStepBuildSync(), updating
+//  the UDP checksum.
+//
+//  frameInfo
+//      Frame information returned by EPLOneStepBuildSync().
+//  frameBuffer
+//      The frame.
+//  sequenceId
+//      New sequenceId.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+NS_UINT8 *seqField, *checksum;
+NS_UINT oldSeq, oldChecksum;
+
+    seqField = &frameBuffer[frameInfo->ptpOffset + PTP_HDR_SEQUENCE_ID_OFFSET];
+    oldSeq = (seqField[0] << 8) | seqField[1];
+    OneStepPut16( seqField, sequenceId);
+
+    if ( frameInfo->udpOffset)
+    {
+        // HC' = ~(~HC + ~m + m')
+        checksum = &frameBuffer[frameInfo->udpOffset + 6];
+        oldChecksum = (checksum[0] << 8) | checksum[1];
+        oldChecksum = (NS_UINT16)~OneStepFold( (~oldChecksum & 0xFFFF) + (~oldSeq & 0xFFFF) + sequenceId);
+        OneStepPut16( checksum, oldChecksum ? oldChecksum : 0xFFFF);
+    }
+    return;
+}
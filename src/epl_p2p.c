@@ -0,0 +1,433 @@
+//****************************************************************************
+// epl_p2p.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Contains sources for the peer delay mechanism (requester side).
+//
+// The requester issues a Pdelay_Req (t1 = its transmit timestamp), the
+// neighbor returns the receive time of the request (t2) in the Pdelay_Resp
+// and its transmit time (t3) in the Pdelay_Resp_Follow_Up, and t4 is the
+// local receive timestamp of the Pdelay_Resp:
+//
+//      linkDelay = (r * (t4 - t1) - (t3 - t2) - correction) / 2
+//
+// where r is the neighbor rate ratio, measured from (t3, t4) pairs spaced
+// P2P_RATIO_WINDOW exchanges apart. With a one-step responder t2 and t3
+// are not known individually; the turnaround time is carried in the
+// correctionField of the Pdelay_Resp and r is left at 1.
+//
+// Each engine keeps a fixed table of outstanding exchanges selected by the
+// low bits of the sequenceId. Every call does a bounded amount of work, so
+// one engine per port can be serviced from the PTP task of a multi-port
+// board. An engine must be driven from one context; no locking is done.
+//
+// The following functions are implemented in this module:
+//
+//      EPLP2PGetDefaultConfig
+//      EPLP2PInit
+//      EPLP2PStartRequest
+//      EPLP2PReqSent
+//      EPLP2PRespReceived
+//      EPLP2PRespFollowUp
+//      EPLP2PGetLinkDelay
+//****************************************************************************
+
+#include "epl/epl.h"
+
+//****************************************************************************
+static NS_SINT64
+    P2PDiff (
+        IN NS_UINT32 secondsA,
+        IN NS_UINT32 nanoSecondsA,
+        IN NS_UINT32 secondsB,
+        IN NS_UINT32 nanoSecondsB)
+//  Returns time A - time B in nanoseconds.
+//****************************************************************************
+{
+    return (NS_SINT64)(NS_SINT32)(secondsA - secondsB) * 1000000000 +
+           ((NS_SINT64)nanoSecondsA - (NS_SINT64)nanoSecondsB);
+}
+
+//****************************************************************************
+static EPL_P2P_SLOT *
+    P2PGetSlot (
+        IN OUT PEPL_P2P_ENGINE engine,
+        IN NS_UINT16 sequenceId)
+//  Returns the table slot of an outstanding request, or NULL if sequenceId
+//  was not issued or has already timed out.
+//****************************************************************************
+{
+EPL_P2P_SLOT *slot;
+
+    slot = &engine->table[sequenceId & (P2P_TABLE_SIZE - 1)];
+    if ( !(slot->flags & P2P_REQUESTED) || slot->sequenceId != sequenceId)
+    {
+        engine->stats.unmatched++;
+        return NULL;
+    }
+    return slot;
+}
+
+//****************************************************************************
+static void
+    P2PUpdateRatio (
+        IN OUT PEPL_P2P_ENGINE engine,
+        IN EPL_P2P_SLOT *slot)
+//  Adds the (t3, t4) pair of a two-step exchange to the rate ratio window
+//  and recomputes the neighbor rate ratio against the oldest pair.
+//****************************************************************************
+{
+NS_UINT oldest;
+NS_SINT64 neighbor, local, diff, ppb;
+
+    if ( engine->ratioCount == P2P_RATIO_WINDOW)
+    {
+        oldest = engine->ratioHead;
+        neighbor = P2PDiff( slot->seconds[2], slot->nanoSeconds[2],
+                            engine->ratioSeconds[oldest][0], engine->ratioNanoSeconds[oldest][0]);
+        local = P2PDiff( slot->seconds[3], slot->nanoSeconds[3],
+                         engine->ratioSeconds[oldest][1], engine->ratioNanoSeconds[oldest][1]);
+        diff = neighbor - local;
+        if ( local <= 0 || diff > P2P_MAX_RATIO_JUMP_NS || diff < -P2P_MAX_RATIO_JUMP_NS)
+        {
+            engine->ratioCount = 0;     // Time jumped, restart
+        }
+        else
+        {
+            ppb = diff * 1000000000 / local;
+            if ( ppb > P2P_MAX_RATIO_PPB || ppb < -P2P_MAX_RATIO_PPB)
+                engine->ratioCount = 0;     // Neighbor time jumped, restart
+            else
+                engine->rateRatioPpb = (NS_SINT32)ppb;
+        }
+    }
+
+    engine->ratioSeconds[engine->ratioHead][0] = slot->seconds[2];
+    engine->ratioNanoSeconds[engine->ratioHead][0] = slot->nanoSeconds[2];
+    engine->ratioSeconds[engine->ratioHead][1] = slot->seconds[3];
+    engine->ratioNanoSeconds[engine->ratioHead][1] = slot->nanoSeconds[3];
+    engine->ratioHead = (engine->ratioHead + 1) % P2P_RATIO_WINDOW;
+    if ( engine->ratioCount < P2P_RATIO_WINDOW)
+        engine->ratioCount++;
+    return;
+}
+
+//****************************************************************************
+static NS_BOOL
+    P2PComplete (
+        IN OUT PEPL_P2P_ENGINE engine,
+        IN OUT EPL_P2P_SLOT *slot)
+//  Computes the link delay of a completed exchange and folds it into the
+//  filtered estimate.
+//****************************************************************************
+{
+NS_SINT64 roundTrip, turnaround, delay;
+
+    slot->flags = 0;
+    engine->lostInRow = 0;
+
+    if ( slot->twoStep)
+        P2PUpdateRatio( engine, slot);
+
+    roundTrip = P2PDiff( slot->seconds[3], slot->nanoSeconds[3],
+                         slot->seconds[0], slot->nanoSeconds[0]);
+    roundTrip += roundTrip * engine->rateRatioPpb / 1000000000;
+    turnaround = P2PDiff( slot->seconds[2], slot->nanoSeconds[2],
+                          slot->seconds[1], slot->nanoSeconds[1]);
+    delay = (E2E_NS_TO_SCALED( roundTrip - turnaround) - slot->correction) / 2;
+
+    if ( delay < 0 || delay > E2E_NS_TO_SCALED( engine->cfg.maxLinkDelayNs))
+    {
+        engine->stats.rejected++;
+        return FALSE;
+    }
+
+    if ( !engine->haveLinkDelay)
+    {
+        engine->linkDelay = delay;
+        engine->haveLinkDelay = TRUE;
+    }
+    else
+    {
+        engine->linkDelay += (delay - engine->linkDelay) / (1 << engine->cfg.filterShift);
+    }
+    engine->stats.completed++;
+    return TRUE;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLP2PGetDefaultConfig (
+        IN OUT PEPL_P2P_CFG p2pConfig)
+
+//  Returns a peer delay configuration suitable for most links: one request
+//  per second, as in IEEE 802.1AS.
+//
+//  p2pConfig
+//      Configuration structure to fill in.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    p2pConfig->intervalUs = 1000000;
+    p2pConfig->timeoutUs = 500000;
+    p2pConfig->allowedLost = 3;
+    p2pConfig->filterShift = 3;
+    p2pConfig->maxLinkDelayNs = 100000;
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLP2PInit (
+        IN OUT PEPL_P2P_ENGINE engine,
+        IN PEPL_P2P_CFG p2pConfig)
+
+//  Initializes a peer delay engine.
+//
+//  engine
+//      Caller allocated engine object, one per port.
+//  p2pConfig
+//      Configuration, see EPLP2PGetDefaultConfig(). Copied into the engine.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    memset( engine, 0, sizeof( EPL_P2P_ENGINE));
+    engine->cfg = *p2pConfig;
+    if ( engine->cfg.filterShift > 16)
+        engine->cfg.filterShift = 16;
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLP2PStartRequest (
+        IN OUT PEPL_P2P_ENGINE engine,
+        OUT NS_UINT16 *sequenceId)
+
+//  Issues the next Pdelay_Req if one is due. Call periodically (at least as
+//  often as the configured interval) for each port.
+//
+//  engine
+//      Engine initialized with EPLP2PInit().
+//  sequenceId
+//      Set on return to the sequenceId to send the Pdelay_Req with.
+//
+//  Returns
+//      TRUE if a Pdelay_Req should be sent now, FALSE if it is not yet due.
+//
+//  Requests not answered within the configured timeout are counted as lost.
+//****************************************************************************
+{
+EPL_P2P_SLOT *slot;
+NS_UINT32 now;
+NS_UINT x;
+
+    now = OAIGetTimeStamp();
+    for ( x = 0; x < P2P_TABLE_SIZE; x++)
+    {
+        slot = &engine->table[x];
+        if ( slot->flags && (NS_UINT32)(now - slot->requestTime) >= engine->cfg.timeoutUs)
+        {
+            slot->flags = 0;
+            engine->stats.lost++;
+            engine->lostInRow++;
+        }
+    }
+
+    if ( engine->requestPending &&
+         (NS_UINT32)(now - engine->lastRequestTime) < engine->cfg.intervalUs)
+    {
+        return FALSE;
+    }
+
+    slot = &engine->table[engine->nextSequenceId & (P2P_TABLE_SIZE - 1)];
+    if ( slot->flags)
+    {
+        engine->stats.lost++;
+        engine->lostInRow++;
+    }
+    slot->sequenceId = engine->nextSequenceId;
+    slot->flags = P2P_REQUESTED;
+    slot->twoStep = FALSE;
+    slot->correction = 0;
+    slot->requestTime = now;
+
+    *sequenceId = engine->nextSequenceId++;
+    engine->lastRequestTime = now;
+    engine->requestPending = TRUE;
+    engine->stats.requests++;
+    return TRUE;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLP2PReqSent (
+        IN OUT PEPL_P2P_ENGINE engine,
+        IN NS_UINT16 sequenceId,
+        IN NS_UINT32 txSeconds,
+        IN NS_UINT32 txNanoSeconds)
+
+//  Records the local transmit timestamp (t1) of a Pdelay_Req.
+//
+//  engine
+//      Engine initialized with EPLP2PInit().
+//  sequenceId
+//      sequenceId returned by EPLP2PStartRequest().
+//  txSeconds, txNanoSeconds
+//      Transmit timestamp, already adjusted for the transmit path latency.
+//      Transmit timestamps carry no sequenceId; the caller pairs them with
+//      the frame it sent.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+EPL_P2P_SLOT *slot;
+
+    slot = P2PGetSlot( engine, sequenceId);
+    if ( !slot)
+        return;
+
+    slot->seconds[0] = txSeconds;
+    slot->nanoSeconds[0] = txNanoSeconds;
+    slot->flags |= P2P_HAVE_T1;
+    if ( slot->flags == P2P_COMPLETE)
+        P2PComplete( engine, slot);
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLP2PRespReceived (
+        IN OUT PEPL_P2P_ENGINE engine,
+        IN NS_UINT16 sequenceId,
+        IN NS_UINT32 rxSeconds,
+        IN NS_UINT32 rxNanoSeconds,
+        IN NS_UINT32 reqReceiptSeconds,
+        IN NS_UINT32 reqReceiptNanoSeconds,
+        IN NS_SINT64 correction,
+        IN NS_BOOL twoStep)
+
+//  Records a Pdelay_Resp: its local receive timestamp (t4) and the
+//  requestReceiptTimestamp (t2) it carries.
+//
+//  engine
+//      Engine initialized with EPLP2PInit().
+//  sequenceId
+//      sequenceId of the Pdelay_Resp (same as the Pdelay_Req). The receive
+//      timestamp matched by sequenceId, e.g. from PTPGetReceiveTimestamp().
+//  rxSeconds, rxNanoSeconds
+//      Receive timestamp, already adjusted for the receive path latency.
+//  reqReceiptSeconds, reqReceiptNanoSeconds
+//      requestReceiptTimestamp field (lower 32 bits of the seconds). Zero
+//      for a one-step responder.
+//  correction
+//      correctionField of the Pdelay_Resp in scaled nanoseconds.
+//  twoStep
+//      TRUE if the twoStepFlag is set and a Pdelay_Resp_Follow_Up follows.
+//
+//  Returns
+//      TRUE if the link delay was updated, FALSE otherwise.
+//
+//  The caller is responsible for checking that requestingPortIdentity
+//  matches this port.
+//****************************************************************************
+{
+EPL_P2P_SLOT *slot;
+
+    slot = P2PGetSlot( engine, sequenceId);
+    if ( !slot)
+        return FALSE;
+
+    slot->seconds[1] = reqReceiptSeconds;
+    slot->nanoSeconds[1] = reqReceiptNanoSeconds;
+    slot->seconds[3] = rxSeconds;
+    slot->nanoSeconds[3] = rxNanoSeconds;
+    slot->correction += correction;
+    slot->twoStep = twoStep;
+    slot->flags |= P2P_HAVE_RESP;
+    if ( !twoStep)
+    {
+        // Turnaround time is in the correctionField
+        slot->seconds[2] = reqReceiptSeconds;
+        slot->nanoSeconds[2] = reqReceiptNanoSeconds;
+        slot->flags |= P2P_HAVE_T3;
+    }
+    if ( slot->flags != P2P_COMPLETE)
+        return FALSE;
+    return P2PComplete( engine, slot);
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLP2PRespFollowUp (
+        IN OUT PEPL_P2P_ENGINE engine,
+        IN NS_UINT16 sequenceId,
+        IN NS_UINT32 respOriginSeconds,
+        IN NS_UINT32 respOriginNanoSeconds,
+        IN NS_SINT64 correction)
+
+//  Records a Pdelay_Resp_Follow_Up: the responseOriginTimestamp (t3).
+//
+//  engine
+//      Engine initialized with EPLP2PInit().
+//  sequenceId
+//      sequenceId of the Pdelay_Resp_Follow_Up.
+//  respOriginSeconds, respOriginNanoSeconds
+//      responseOriginTimestamp field (lower 32 bits of the seconds).
+//  correction
+//      correctionField of the Pdelay_Resp_Follow_Up in scaled nanoseconds.
+//
+//  Returns
+//      TRUE if the link delay was updated, FALSE otherwise.
+//****************************************************************************
+{
+EPL_P2P_SLOT *slot;
+
+    slot = P2PGetSlot( engine, sequenceId);
+    if ( !slot)
+        return FALSE;
+
+    slot->seconds[2] = respOriginSeconds;
+    slot->nanoSeconds[2] = respOriginNanoSeconds;
+    slot->correction += correction;
+    slot->twoStep = TRUE;
+    slot->flags |= P2P_HAVE_T3;
+    if ( slot->flags != P2P_COMPLETE)
+        return FALSE;
+    return P2PComplete( engine, slot);
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLP2PGetLinkDelay (
+        IN PEPL_P2P_ENGINE engine,
+        OUT NS_SINT64 *linkDelay,
+        OUT NS_SINT32 *rateRatioPpb)
+
+//  Returns the filtered link delay and the neighbor rate ratio.
+//
+//  engine
+//      Engine initialized with EPLP2PInit().
+//  linkDelay
+//      Set on return to the filtered link delay in scaled nanoseconds. Use
+//      E2E_SCALED_TO_NS() to convert.
+//  rateRatioPpb
+//      Set on return to (neighborRateRatio - 1) in parts per billion; 0
+//      until P2P_RATIO_WINDOW two-step exchanges have completed.
+//
+//  Returns
+//      TRUE if the link delay is valid, FALSE if none has been measured yet
+//      or more than the allowed number of consecutive responses were lost.
+//****************************************************************************
+{
+    *linkDelay = engine->linkDelay;
+    *rateRatioPpb = engine->rateRatioPpb;
+    return (engine->haveLinkDelay && engine->lostInRow <= engine->cfg.allowedLost);
+}
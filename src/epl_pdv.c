@@ -0,0 +1,342 @@
+//****************************************************************************
+// epl_pdv.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Contains sources for the packet delay variation filters, which reduce
+// the queueing noise of delay and offset measurements before they reach
+// the servo.
+//
+//      Minimum         Smallest sample of the last window samples (lucky
+//                      packet). Queueing only ever adds delay, so the
+//                      least delayed packet carries the least noise.
+//                      Monotonic queue, O(1) amortized.
+//      Median          Median of the last window samples. Rejects outliers
+//                      in either direction. Two heaps around the median
+//                      indexed by ring slot, O(log window).
+//      Exponential     average += (sample - average) / 2^shift. O(1).
+//
+// All work on the scaled ns values of the E2E engine (or any other signed
+// 64 bit value) in fixed memory; nothing is allocated. EPLPdvFilter() has
+// the EPL_E2E_FILTER signature, so a filter is selected for a port by
+// installing it on that port's engine:
+//
+//      EPLE2ESetFilter( &engine, E2E_FILTER_OFFSET, EPLPdvFilter, &filter);
+//
+// Sliding windows pass every sample and add a lag of about half a window
+// (minimum, median) or 2^shift samples (exponential) to the loop;
+// decimated windows pass one sample per window. After a clock step the
+// offset window no longer applies and should be emptied with EPLPdvReset().
+//
+// The following functions are implemented in this module:
+//
+//      EPLPdvGetDefaultConfig
+//      EPLPdvInit
+//      EPLPdvReset
+//      EPLPdvFilter
+//****************************************************************************
+
+#include "epl/epl.h"
+
+// heap[] index of heap position 0 (the median)
+#define PDV_HEAP_ORIGIN         (PDV_MAX_WINDOW / 2)
+
+#define PDV_HEAP_SLOT(filter, pos)  ((filter)->heap[PDV_HEAP_ORIGIN + (pos)])
+#define PDV_HEAP_VALUE(filter, pos) ((filter)->sample[PDV_HEAP_SLOT( filter, pos)])
+
+//****************************************************************************
+static NS_BOOL
+    PdvSwapIfLess (
+        IN OUT PEPL_PDV_FILTER filter,
+        IN NS_SINT a,
+        IN NS_SINT b)
+//  Swaps the samples at heap positions a and b if the one at a is smaller.
+//  Returns TRUE if they were swapped.
+//****************************************************************************
+{
+NS_UINT8 slot;
+
+    if ( PDV_HEAP_VALUE( filter, a) >= PDV_HEAP_VALUE( filter, b))
+        return FALSE;
+
+    slot = PDV_HEAP_SLOT( filter, a);
+    PDV_HEAP_SLOT( filter, a) = PDV_HEAP_SLOT( filter, b);
+    PDV_HEAP_SLOT( filter, b) = slot;
+    filter->heapPos[PDV_HEAP_SLOT( filter, a)] = (NS_SINT8)a;
+    filter->heapPos[PDV_HEAP_SLOT( filter, b)] = (NS_SINT8)b;
+    return TRUE;
+}
+
+//****************************************************************************
+static void
+    PdvSiftDownUpper (
+        IN OUT PEPL_PDV_FILTER filter,
+        IN NS_SINT pos)
+//  Moves the sample at pos (0 or upper half) up the order until it is no
+//  larger than the upper half samples below it.
+//****************************************************************************
+{
+NS_SINT child, last = (NS_SINT)(filter->count - 1) / 2;
+
+    for ( ;;)
+    {
+        child = pos ? 2 * pos : 1;
+        if ( child > last)
+            break;
+        if ( pos && child < last && PDV_HEAP_VALUE( filter, child + 1) < PDV_HEAP_VALUE( filter, child))
+            child++;
+        if ( !PdvSwapIfLess( filter, child, pos))
+            break;
+        pos = child;
+    }
+    return;
+}
+
+//****************************************************************************
+static void
+    PdvSiftDownLower (
+        IN OUT PEPL_PDV_FILTER filter,
+        IN NS_SINT pos)
+//  Moves the sample at pos (0 or lower half) down the order until it is no
+//  smaller than the lower half samples below it.
+//****************************************************************************
+{
+NS_SINT child, last = -(NS_SINT)(filter->count / 2);
+
+    for ( ;;)
+    {
+        child = pos ? 2 * pos : -1;
+        if ( child < last)
+            break;
+        if ( pos && child > last && PDV_HEAP_VALUE( filter, child) < PDV_HEAP_VALUE( filter, child - 1))
+            child--;
+        if ( !PdvSwapIfLess( filter, pos, child))
+            break;
+        pos = child;
+    }
+    return;
+}
+
+//****************************************************************************
+static void
+    PdvMedianUpdate (
+        IN OUT PEPL_PDV_FILTER filter,
+        IN NS_UINT slot,
+        IN NS_BOOL added,
+        IN NS_SINT64 old)
+//  Restores the heap order after the sample in a ring slot was added or
+//  replaced (old is the value it replaced).
+//****************************************************************************
+{
+NS_SINT pos = filter->heapPos[slot];
+NS_SINT64 value = filter->sample[slot];
+
+    if ( pos > 0)
+    {
+        if ( !added && value > old)
+        {
+            PdvSiftDownUpper( filter, pos);
+            return;
+        }
+        // Towards the median; past it into the lower half if smaller
+        while ( pos > 0 && PdvSwapIfLess( filter, pos, pos / 2))
+            pos /= 2;
+        if ( !pos)
+            PdvSiftDownLower( filter, 0);
+    }
+    else if ( pos < 0)
+    {
+        if ( !added && value < old)
+        {
+            PdvSiftDownLower( filter, pos);
+            return;
+        }
+        while ( pos < 0 && PdvSwapIfLess( filter, pos / 2, pos))
+            pos /= 2;
+        if ( !pos)
+            PdvSiftDownUpper( filter, 0);
+    }
+    else if ( !added)
+    {
+        if ( value < old)
+            PdvSiftDownLower( filter, 0);
+        else
+            PdvSiftDownUpper( filter, 0);
+    }
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLPdvGetDefaultConfig (
+        IN OUT PEPL_PDV_CFG pdvConfig)
+
+//  Returns a configuration for a sliding median of 15 samples. The
+//  exponential shift is set to 4 and decimation is off.
+//
+//  pdvConfig
+//      Configuration structure to fill in.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    pdvConfig->type = PDV_FILTER_MEDIAN;
+    pdvConfig->window = 15;
+    pdvConfig->decimate = FALSE;
+    pdvConfig->shift = 4;
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLPdvInit (
+        IN OUT PEPL_PDV_FILTER filter,
+        IN PEPL_PDV_CFG pdvConfig)
+
+//  Initializes a filter with an empty window.
+//
+//  filter
+//      Caller allocated filter object, one per filtered quantity.
+//  pdvConfig
+//      Configuration, see EPLPdvGetDefaultConfig(). Copied.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM if the configuration is
+//      not usable.
+//****************************************************************************
+{
+    if ( pdvConfig->type >= PDV_NUM_FILTERS || pdvConfig->shift > PDV_MAX_SHIFT ||
+         ((pdvConfig->type == PDV_FILTER_MINIMUM || pdvConfig->type == PDV_FILTER_MEDIAN) &&
+          (!pdvConfig->window || pdvConfig->window > PDV_MAX_WINDOW)))
+    {
+        return NS_STATUS_INVALID_PARM;
+    }
+
+    memset( filter, 0, sizeof( EPL_PDV_FILTER));
+    filter->cfg = *pdvConfig;
+    EPLPdvReset( filter);
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLPdvReset (
+        IN OUT PEPL_PDV_FILTER filter)
+
+//  Empties the window (or restarts the average) of a filter, e.g. after
+//  the clock was stepped. The sample counters are kept.
+//
+//  filter
+//      Filter initialized with EPLPdvInit().
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+NS_SINT pos;
+NS_UINT slot;
+
+    filter->next = filter->count = filter->phase = 0;
+    filter->queueHead = filter->queueCount = 0;
+
+    // Ring slots fill heap positions 0, -1, 1, -2, 2, ..
+    for ( slot = 0; slot < PDV_MAX_WINDOW; slot++)
+    {
+        pos = (NS_SINT)((slot + 1) / 2);
+        if ( slot & 1)
+            pos = -pos;
+        filter->heapPos[slot] = (NS_SINT8)pos;
+        PDV_HEAP_SLOT( filter, pos) = (NS_UINT8)slot;
+    }
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLPdvFilter (
+        IN OUT void *context,
+        IN OUT NS_SINT64 *value)
+
+//  Filters a sample. Has the EPL_E2E_FILTER signature.
+//
+//  context
+//      Filter initialized with EPLPdvInit().
+//  value
+//      Sample (e.g. scaled ns), replaced on return by the filter output.
+//
+//  Returns
+//      TRUE if value was set, FALSE if the sample was only added to the
+//      window (decimated filters between outputs).
+//****************************************************************************
+{
+PEPL_PDV_FILTER filter = (PEPL_PDV_FILTER)context;
+NS_UINT slot, last;
+NS_SINT64 old;
+NS_BOOL added;
+
+    filter->samples++;
+    switch ( filter->cfg.type)
+    {
+    case PDV_FILTER_MINIMUM:
+    case PDV_FILTER_MEDIAN:
+        slot = filter->next;
+        old = filter->sample[slot];
+        added = (filter->count < filter->cfg.window);
+        filter->sample[slot] = *value;
+        filter->next = (slot + 1 < filter->cfg.window) ? slot + 1 : 0;
+        if ( added)
+            filter->count++;
+
+        if ( filter->cfg.type == PDV_FILTER_MINIMUM)
+        {
+            // The overwritten slot leaves the window; larger samples
+            // before the new one can no longer be the minimum
+            if ( !added && filter->queueCount && filter->queue[filter->queueHead] == slot)
+            {
+                filter->queueHead = (filter->queueHead + 1) % PDV_MAX_WINDOW;
+                filter->queueCount--;
+            }
+            while ( filter->queueCount)
+            {
+                last = (filter->queueHead + filter->queueCount - 1) % PDV_MAX_WINDOW;
+                if ( filter->sample[filter->queue[last]] < *value)
+                    break;
+                filter->queueCount--;
+            }
+            filter->queue[(filter->queueHead + filter->queueCount) % PDV_MAX_WINDOW] = (NS_UINT8)slot;
+            filter->queueCount++;
+            *value = filter->sample[filter->queue[filter->queueHead]];
+        }
+        else
+        {
+            PdvMedianUpdate( filter, slot, added, old);
+            *value = PDV_HEAP_VALUE( filter, 0);
+            if ( !(filter->count & 1))
+                *value = (*value + PDV_HEAP_VALUE( filter, -1)) / 2;
+        }
+
+        if ( filter->cfg.decimate)
+        {
+            if ( ++filter->phase < filter->cfg.window)
+                return FALSE;
+            filter->phase = 0;
+        }
+        break;
+
+    case PDV_FILTER_EXPONENTIAL:
+        if ( filter->count)
+            filter->average += (*value - filter->average) / ((NS_SINT64)1 << filter->cfg.shift);
+        else
+            filter->average = *value;
+        filter->count = 1;
+        *value = filter->average;
+        break;
+
+    default:
+        break;
+    }
+    filter->outputs++;
+    return TRUE;
+}
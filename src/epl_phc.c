@@ -0,0 +1,387 @@
+//****************************************************************************
+// epl_phc.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Contains sources for the PHC style clock adapter, which drives the IEEE
+// 1588 clock of a port with the operations of a Linux PTP hardware clock:
+//
+//      EPLPhcAdjFine()     adjfine, frequency in scaled ppm (ppm * 2^16)
+//      EPLPhcAdjFreq()     adjfreq, frequency in ppb
+//      EPLPhcAdjTime()     adjtime, by a step or a temporary rate slew
+//      EPLPhcGetTime()     gettime64, 48-bit seconds
+//      EPLPhcSetTime()     settime64
+//
+// The rate registers hold a 26-bit magnitude in 2^-32ns per 8ns cycle and
+// a direction, i.e. a frequency offset of rate / 2^35. The conversions are
+// exact rationals, rounded to the nearest rate unit:
+//
+//      rate = scaledPpm * 2^35 / (2^16 * 10^6) = scaledPpm * 2^13 / 5^6
+//      rate = ppb * 2^35 / 10^9                = ppb * 2^26 / 5^9
+//
+// The denominators are odd, so there are no ties and the error is below
+// half a unit, 2^-36 (0.0146ppb). One rate unit is 1.907 scaled ppm
+// (0.0291ppb), so neighbouring scaledPpm values often give the same rate;
+// the rate last written is cached and an adjustment that does not change
+// it does not access the PHY. Linux's dp83640 driver truncates instead,
+// which biases every adjustment towards zero by up to one unit.
+//
+// Steps are written as given; like the Linux driver, the two cycles the
+// hardware takes to apply a step are not compensated.
+//
+// The following functions are implemented in this module:
+//
+//      EPLPhcScaledPpmToRate
+//      EPLPhcPpbToRate
+//      EPLPhcRateToScaledPpm
+//      EPLPhcGetDefaultConfig
+//      EPLPhcInit
+//      EPLPhcAdjFine
+//      EPLPhcAdjFreq
+//      EPLPhcAdjTime
+//      EPLPhcService
+//      EPLPhcGetTime
+//      EPLPhcSetTime
+//****************************************************************************
+
+#include "epl/epl.h"
+
+//****************************************************************************
+static NS_STATUS
+    PhcSetRate (
+        IN OUT PEPL_PHC phc,
+        IN NS_SINT32 rate)
+//  Writes a normal rate unless it is the one already programmed, and moves
+//  a running slew to it.
+//****************************************************************************
+{
+    if ( phc->rateValid && rate == phc->rate)
+    {
+        phc->rateWritesSkipped++;
+        return NS_STATUS_SUCCESS;
+    }
+
+    PTPClockSetRateAdjustment( phc->portHandle, (NS_UINT32)((rate < 0) ? -rate : rate), FALSE, (rate < 0));
+    phc->rate = rate;
+    phc->rateValid = TRUE;
+    phc->rateWrites++;
+
+    // Segments not yet started are planned relative to the normal rate
+    if ( phc->slew.active && EPLSlewSetNormalRate( &phc->slew, rate) != NS_STATUS_SUCCESS)
+        EPLSlewCancel( &phc->slew);
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT NS_SINT32
+    EPLPhcScaledPpmToRate (
+        IN NS_SINT64 scaledPpm)
+
+//  Converts a frequency offset in scaled ppm to a rate adjustment.
+//
+//  scaledPpm
+//      Frequency offset, ppm with a 16-bit fraction (Linux scaled_ppm),
+//      positive to speed the clock up.
+//
+//  Returns
+//      Signed rate in 2^-32ns per 8ns cycle (negative slows the clock down,
+//      see PTPClockSetRateAdjustment()), rounded to nearest and saturated
+//      at +/- SLEW_MAX_RATE.
+//****************************************************************************
+{
+NS_UINT64 magnitude, rate;
+
+    magnitude = (NS_UINT64)((scaledPpm < 0) ? -scaledPpm : scaledPpm);
+    if ( magnitude > PHC_MAX_SCALED_PPM)
+        rate = SLEW_MAX_RATE;
+    else
+        rate = (magnitude * 8192 + 15625 / 2) / 15625;
+    return (scaledPpm < 0) ? -(NS_SINT32)rate : (NS_SINT32)rate;
+}
+
+//****************************************************************************
+EXPORT NS_SINT32
+    EPLPhcPpbToRate (
+        IN NS_SINT32 ppb)
+
+//  Converts a frequency offset in ppb to a rate adjustment.
+//
+//  ppb
+//      Frequency offset, parts per billion, positive to speed the clock up.
+//
+//  Returns
+//      Signed rate in 2^-32ns per 8ns cycle, rounded to nearest and
+//      saturated at +/- SLEW_MAX_RATE.
+//****************************************************************************
+{
+NS_UINT64 magnitude, rate;
+
+    magnitude = (NS_UINT64)((ppb < 0) ? -(NS_SINT64)ppb : (NS_SINT64)ppb);
+    if ( magnitude > PHC_MAX_ADJ_PPB)
+        rate = SLEW_MAX_RATE;
+    else
+        rate = ((magnitude << 26) + 1953125 / 2) / 1953125;
+    return (ppb < 0) ? -(NS_SINT32)rate : (NS_SINT32)rate;
+}
+
+//****************************************************************************
+EXPORT NS_SINT64
+    EPLPhcRateToScaledPpm (
+        IN NS_SINT32 rate)
+
+//  Converts a rate adjustment to a frequency offset in scaled ppm.
+//
+//  rate
+//      Signed rate in 2^-32ns per 8ns cycle.
+//
+//  Returns
+//      Frequency offset in scaled ppm, rounded to nearest. Converting it
+//      back with EPLPhcScaledPpmToRate() gives rate again.
+//****************************************************************************
+{
+NS_UINT64 magnitude, scaledPpm;
+
+    magnitude = (NS_UINT64)((rate < 0) ? -(NS_SINT64)rate : (NS_SINT64)rate);
+    scaledPpm = (magnitude * 15625 + 4096) >> 13;
+    return (rate < 0) ? -(NS_SINT64)scaledPpm : (NS_SINT64)scaledPpm;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLPhcGetDefaultConfig (
+        IN OUT PEPL_PHC_CFG phcConfig)
+
+//  Returns a configuration that slews time adjustments of up to 1ms (at
+//  most about half a second at the full temporary rate) and steps larger
+//  ones.
+//
+//  phcConfig
+//      Configuration structure to fill in.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    phcConfig->slewMaxNs = 1000000;
+    EPLSlewGetDefaultConfig( &phcConfig->slew);
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLPhcInit (
+        IN OUT PEPL_PHC phc,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN PEPL_PHC_CFG phcConfig)
+
+//  Initializes the clock adapter of a port and reads the programmed rate.
+//
+//  phc
+//      Caller allocated adapter object, one per port.
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort
+//      function.
+//  phcConfig
+//      Configuration, see EPLPhcGetDefaultConfig(). Copied.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM if the configuration is
+//      not usable.
+//
+//  Takes two register reads. If a temporary rate was the last rate written
+//  the normal rate is not readable; the next adjustment is then written
+//  whatever its value. Initialize again after writing the rate by other
+//  means (e.g. EPLCheckpointWarmStart()).
+//****************************************************************************
+{
+NS_UINT32 rate;
+NS_BOOL temporary, negative;
+
+    if ( phcConfig->slewMaxNs > SLEW_MAX_OFFSET_NS || !phcConfig->slew.maxRate ||
+         phcConfig->slew.maxRate > SLEW_MAX_RATE)
+    {
+        return NS_STATUS_INVALID_PARM;
+    }
+
+    memset( phc, 0, sizeof( EPL_PHC));
+    phc->portHandle = portHandle;
+    phc->cfg = *phcConfig;
+
+    PTPClockGetRateAdjustment( portHandle, &rate, &temporary, &negative);
+    phc->rate = negative ? -(NS_SINT32)rate : (NS_SINT32)rate;
+    phc->rateValid = !temporary;
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLPhcAdjFine (
+        IN OUT PEPL_PHC phc,
+        IN NS_SINT64 scaledPpm)
+
+//  Sets the frequency offset of the clock (PHC adjfine).
+//
+//  phc
+//      Adapter initialized with EPLPhcInit().
+//  scaledPpm
+//      Frequency offset, ppm with a 16-bit fraction, positive to speed the
+//      clock up, +/- PHC_MAX_SCALED_PPM.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM if the offset is out of
+//      range.
+//
+//  Takes two register writes, or none if the rate does not change.
+//****************************************************************************
+{
+    if ( scaledPpm > PHC_MAX_SCALED_PPM || scaledPpm < -PHC_MAX_SCALED_PPM)
+        return NS_STATUS_INVALID_PARM;
+    return PhcSetRate( phc, EPLPhcScaledPpmToRate( scaledPpm));
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLPhcAdjFreq (
+        IN OUT PEPL_PHC phc,
+        IN NS_SINT32 ppb)
+
+//  Sets the frequency offset of the clock in ppb (PHC adjfreq).
+//
+//  phc
+//      Adapter initialized with EPLPhcInit().
+//  ppb
+//      Frequency offset, parts per billion, positive to speed the clock up,
+//      +/- PHC_MAX_ADJ_PPB.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM if the offset is out of
+//      range.
+//****************************************************************************
+{
+    if ( ppb > PHC_MAX_ADJ_PPB || ppb < -PHC_MAX_ADJ_PPB)
+        return NS_STATUS_INVALID_PARM;
+    return PhcSetRate( phc, EPLPhcPpbToRate( ppb));
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLPhcAdjTime (
+        IN OUT PEPL_PHC phc,
+        IN NS_SINT64 deltaNs)
+
+//  Adds a time offset to the clock (PHC adjtime).
+//
+//  phc
+//      Adapter initialized with EPLPhcInit().
+//  deltaNs
+//      Time to add, ns.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM if more than 2^32
+//      seconds.
+//
+//  An offset of up to cfg.slewMaxNs is slewed with temporary rate
+//  segments (see EPLSlewStart()) when the normal rate is known and no
+//  slew is running; EPLPhcService() must then be called until it returns
+//  FALSE. Anything else, including an adjustment made while slewing, is
+//  stepped at once.
+//****************************************************************************
+{
+NS_UINT64 magnitude;
+PTP_TIME finishTime;
+
+    magnitude = (NS_UINT64)((deltaNs < 0) ? -deltaNs : deltaNs);
+    if ( magnitude / PTP_NS_PER_SEC > 0xFFFFFFFF)
+        return NS_STATUS_INVALID_PARM;
+
+    if ( magnitude <= phc->cfg.slewMaxNs && phc->rateValid && !phc->slew.active &&
+         EPLSlewStart( &phc->slew, phc->portHandle, &phc->cfg.slew, deltaNs,
+                       phc->rate, &finishTime) == NS_STATUS_SUCCESS)
+    {
+        phc->slews++;
+        return NS_STATUS_SUCCESS;
+    }
+
+    PTPClockStepAdjustment( phc->portHandle, (NS_UINT32)(magnitude / PTP_NS_PER_SEC),
+                            (NS_UINT32)(magnitude % PTP_NS_PER_SEC), (deltaNs < 0));
+    phc->steps++;
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLPhcService (
+        IN OUT PEPL_PHC phc,
+        IN PPTP_TIME currentTime)
+
+//  Continues a time adjustment being slewed.
+//
+//  phc
+//      Adapter initialized with EPLPhcInit().
+//  currentTime
+//      Current clock time or NULL when the running slew segment is known
+//      to be done, see EPLSlewService().
+//
+//  Returns
+//      TRUE while slewing.
+//****************************************************************************
+{
+    return EPLSlewService( &phc->slew, currentTime, NULL);
+}
+
+//****************************************************************************
+EXPORT void
+    EPLPhcGetTime (
+        IN OUT PEPL_PHC phc,
+        OUT PPTP_TIME time)
+
+//  Reads the clock (PHC gettime64).
+//
+//  phc
+//      Adapter initialized with EPLPhcInit().
+//  time
+//      Set on return to the clock time with 48-bit seconds. The upper 16
+//      bits follow the port's timestamp reference (see
+//      PTPSetTimestampReference()), which the read updates.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+NS_UINT32 seconds, nanoSeconds;
+NS_UINT64 fullSeconds;
+
+    PTPClockReadCurrent( phc->portHandle, &seconds, &nanoSeconds);
+    PTPExtendTimestamp( phc->portHandle, seconds, 32, nanoSeconds, &fullSeconds);
+    time->seconds = (NS_SINT64)fullSeconds;
+    time->nanoSeconds = (NS_SINT32)nanoSeconds;
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLPhcSetTime (
+        IN OUT PEPL_PHC phc,
+        IN PPTP_TIME time)
+
+//  Sets the clock (PHC settime64).
+//
+//  phc
+//      Adapter initialized with EPLPhcInit().
+//  time
+//      Normalized time to set, 48-bit seconds. The lower 32 bits are loaded
+//      into the PHY and the upper 16 bits into the port's timestamp
+//      reference.
+//
+//  Returns
+//      Nothing
+//
+//  A running slew is cancelled first.
+//****************************************************************************
+{
+    EPLSlewCancel( &phc->slew);
+    PTPClockSet( phc->portHandle, (NS_UINT32)(time->seconds & 0xFFFFFFFF), (NS_UINT32)time->nanoSeconds);
+    PTPSetTimestampReference( phc->portHandle, (NS_UINT64)time->seconds, (NS_UINT32)time->nanoSeconds);
+    return;
+}
@@ -0,0 +1,499 @@
+//****************************************************************************
+// epl_quality.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Contains sources for the Link Quality Monitor functions.
+//
+// The link quality monitor samples the receive DSP parameters (DEQ C1,
+// DAGC, DBLW, frequency offset and frequency control) of one or more ports
+// within a fixed share of the MDIO bus bandwidth, keeps rolling statistics
+// per parameter and reports threshold crossings through a callback.
+//
+// On ports attached to an MDIO scheduler the samples are monitor class
+// requests in which each parameter (LQDR write and read) is its own group,
+// so pending timestamp reads run between parameters.
+//
+// The following functions are implemented in this module:
+//
+//      EPLLqSampleParam
+//      EPLLqInitMonitor
+//      EPLLqAddPort
+//      EPLLqSetThreshold
+//      EPLLqPoll
+//      EPLLqGetStats
+//      EPLLqResetStats
+//****************************************************************************
+
+#include "epl/epl.h"
+
+// Crossed thresholds are only cleared once the value moves this far back
+#define LQ_HYSTERESIS           2
+
+// Credit is kept in units of 1e-9 MDIO transactions
+#define LQ_CREDIT_SCALE         1000000000ULL
+
+//****************************************************************************
+static NS_SINT
+    LqDecode (
+        IN EPL_LQ_PARAM_ENUM param,
+        IN NS_UINT data)
+//  Converts the 8-bit LQDR value into a signed value. Only DAGC is unsigned.
+//****************************************************************************
+{
+    data &= P849_LQ_THR_DATA_MASK;
+    if ( param != LQ_PARAM_DAGC && (data & 0x80))
+        return (NS_SINT)data - 0x100;
+    return (NS_SINT)data;
+}
+
+//****************************************************************************
+static NS_UINT
+    LqEncode (
+        IN EPL_LQ_PARAM_ENUM param,
+        IN NS_SINT value)
+//  Converts a threshold into the 8-bit LQDR format, clamping to the range
+//  of the parameter.
+//****************************************************************************
+{
+NS_SINT lo, hi;
+
+    lo = (param == LQ_PARAM_DAGC) ? 0 : -128;
+    hi = (param == LQ_PARAM_DAGC) ? 255 : 127;
+    if ( value < lo) value = lo;
+    if ( value > hi) value = hi;
+    return (NS_UINT)value & P849_LQ_THR_DATA_MASK;
+}
+
+//****************************************************************************
+static EPL_LQ_PORT *
+    LqFindPort (
+        IN PEPL_LQ_MONITOR monitor,
+        IN PEPL_PORT_HANDLE portHandle)
+//****************************************************************************
+{
+NS_UINT x;
+
+    for ( x = 0; x < monitor->numPorts; x++)
+    {
+        if ( monitor->ports[x].portHandle == portHandle)
+            return &monitor->ports[x];
+    }
+    return NULL;
+}
+
+//****************************************************************************
+static NS_UINT64
+    LqBatchCost (
+        IN EPL_LQ_PORT *lqPort)
+//  Worst case credit needed to sample a port: one write and one read per
+//  parameter plus the LQMR read and a page select.
+//****************************************************************************
+{
+NS_UINT mask, numParams;
+
+    for ( numParams = 0, mask = lqPort->paramMask; mask; mask >>= 1)
+        numParams += mask & 1;
+    return (NS_UINT64)(numParams * 2 + 2) * LQ_CREDIT_SCALE;
+}
+
+//****************************************************************************
+static void
+    LqReport (
+        IN PEPL_LQ_MONITOR monitor,
+        IN EPL_LQ_PORT *lqPort,
+        IN EPL_LQ_PARAM_ENUM param,
+        IN EPL_LQ_STATE_ENUM state)
+//****************************************************************************
+{
+    if ( state != LQ_STATE_NORMAL)
+        lqPort->stats[param].crossings++;
+    if ( monitor->callback)
+        monitor->callback( lqPort->portHandle, param, state, lqPort->stats[param].last,
+                           monitor->context);
+}
+
+//****************************************************************************
+static void
+    LqUpdate (
+        IN PEPL_LQ_MONITOR monitor,
+        IN EPL_LQ_PORT *lqPort,
+        IN EPL_LQ_PARAM_ENUM param,
+        IN NS_SINT value,
+        IN NS_UINT hwWarnings)
+//  Folds a new sample into the rolling statistics and evaluates thresholds.
+//****************************************************************************
+{
+EPL_LQ_STATS *stats = &lqPort->stats[param];
+EPL_LQ_THRESHOLD *thr = &lqPort->thresholds[param];
+EPL_LQ_STATE_ENUM state;
+NS_SINT32 x, diff;
+NS_UINT32 sq;
+
+    x = (NS_SINT32)value << LQ_STAT_FRAC_BITS;
+    stats->last = value;
+    if ( !stats->samples)
+    {
+        stats->min = stats->max = value;
+        stats->mean = x;
+        stats->variance = 0;
+    }
+    else
+    {
+        if ( value < stats->min) stats->min = value;
+        if ( value > stats->max) stats->max = value;
+
+        // Exponentially weighted mean and variance
+        diff = x - stats->mean;
+        stats->mean += diff >> LQ_EWMA_SHIFT;
+        sq = (NS_UINT32)(((NS_SINT64)diff * diff) >> LQ_STAT_FRAC_BITS);
+        if ( sq >= stats->variance)
+            stats->variance += (sq - stats->variance) >> LQ_EWMA_SHIFT;
+        else
+            stats->variance -= (stats->variance - sq) >> LQ_EWMA_SHIFT;
+    }
+    stats->samples++;
+
+    if ( !thr->enabled)
+        return;
+
+    state = stats->state;
+    if ( value >= thr->high)
+        state = LQ_STATE_HIGH;
+    else if ( value <= thr->low)
+        state = LQ_STATE_LOW;
+    else if ( value < thr->high - LQ_HYSTERESIS && value > thr->low + LQ_HYSTERESIS)
+        state = LQ_STATE_NORMAL;
+
+    if ( state != stats->state)
+    {
+        stats->state = state;
+        LqReport( monitor, lqPort, param, state);
+    }
+    else if ( state == LQ_STATE_NORMAL && hwWarnings)
+    {
+        // The hardware saw an excursion between samples
+        LqReport( monitor, lqPort, param, (hwWarnings & 0x2) ? LQ_STATE_HIGH : LQ_STATE_LOW);
+    }
+}
+
+//****************************************************************************
+static void
+    LqSamplePort (
+        IN PEPL_LQ_MONITOR monitor,
+        IN EPL_LQ_PORT *lqPort)
+//  Samples all selected parameters of a port in a single batch. All
+//  registers involved are on page 2, so at most one page select is needed.
+//****************************************************************************
+{
+EPL_MDIO_OP ops[LQ_NUM_PARAMS * 2 + 1];
+NS_UINT idx[LQ_NUM_PARAMS];
+NS_UINT param, numOps, lqmr;
+
+    numOps = 0;
+    for ( param = 0; param < LQ_NUM_PARAMS; param++)
+    {
+        if ( !(lqPort->paramMask & LQ_PARAM_BIT( param)))
+            continue;
+        ops[numOps].flags = MDIO_OP_WRITE | MDIO_OP_CHAIN;
+        ops[numOps].registerIndex = PHY_PG2_LQDR;
+        ops[numOps++].value = (param << P849_LQ_PARAM_SEL_SHIFT) | P849_SAMPLE_PARAM;
+        idx[param] = numOps;
+        ops[numOps].flags = MDIO_OP_READ;
+        ops[numOps++].registerIndex = PHY_PG2_LQDR;
+    }
+    if ( lqPort->lqmrConfig & P849_LQM_ENABLE)
+    {
+        ops[numOps].flags = MDIO_OP_READ;
+        ops[numOps++].registerIndex = PHY_PG2_LQMR;
+    }
+    if ( !numOps)
+        return;
+    EPLMdioRun( lqPort->portHandle, MDIO_CLASS_MONITOR, ops, numOps, FALSE);
+
+    lqmr = (lqPort->lqmrConfig & P849_LQM_ENABLE) ? ops[numOps - 1].value : 0;
+    for ( param = 0; param < LQ_NUM_PARAMS; param++)
+    {
+        if ( lqPort->paramMask & LQ_PARAM_BIT( param))
+            LqUpdate( monitor, lqPort, (EPL_LQ_PARAM_ENUM)param,
+                      LqDecode( (EPL_LQ_PARAM_ENUM)param, ops[idx[param]].value),
+                      (lqmr >> (param * 2)) & 0x3);
+    }
+}
+
+//****************************************************************************
+EXPORT NS_SINT
+    EPLLqSampleParam (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN EPL_LQ_PARAM_ENUM param)
+
+//  Takes a single sample of one DSP parameter.
+//
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort
+//      function.
+//  param
+//      The parameter to sample, one of the LQ_PARAM_??? values.
+//
+//  Returns
+//      The sampled value. DAGC is returned as 0 - 255, all other parameters
+//      are signed (-128 - 127).
+//****************************************************************************
+{
+EPL_MDIO_OP ops[2];
+
+    ops[0].flags = MDIO_OP_WRITE;
+    ops[0].registerIndex = PHY_PG2_LQDR;
+    ops[0].value = (param << P849_LQ_PARAM_SEL_SHIFT) | P849_SAMPLE_PARAM;
+    ops[1].flags = MDIO_OP_READ;
+    ops[1].registerIndex = PHY_PG2_LQDR;
+    EPLMdioRun( portHandle, MDIO_CLASS_MONITOR, ops, 2, TRUE);
+    return LqDecode( param, ops[1].value);
+}
+
+//****************************************************************************
+EXPORT void
+    EPLLqInitMonitor (
+        IN OUT PEPL_LQ_MONITOR monitor,
+        IN NS_UINT sharePermille,
+        IN NS_UINT32 mdioOpsPerSec,
+        IN EPL_LQ_CALLBACK callback,
+        IN void *context)
+
+//  Initializes a link quality monitor object.
+//
+//  monitor
+//      Caller allocated monitor object.
+//  sharePermille
+//      Share of the MDIO bus capacity the monitor may use, in 1/1000ths.
+//      For example 50 limits monitoring to 5% of the bus.
+//  mdioOpsPerSec
+//      MDIO transactions per second the bus can sustain. Use
+//      LQ_DEFAULT_MDIO_OPS_PER_SEC for a 2.5MHz MDC without preamble
+//      suppression.
+//  callback
+//      Called on every threshold state change. May be NULL.
+//  context
+//      Passed through to the callback.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    memset( monitor, 0, sizeof( EPL_LQ_MONITOR));
+    monitor->sharePermille = (sharePermille > 1000) ? 1000 : sharePermille;
+    monitor->mdioOpsPerSec = mdioOpsPerSec;
+    monitor->callback = callback;
+    monitor->context = context;
+    monitor->lastPollTime = OAIGetTimeStamp();
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLLqAddPort (
+        IN OUT PEPL_LQ_MONITOR monitor,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_UINT paramMask)
+
+//  Adds a port to the monitor.
+//
+//  monitor
+//      Monitor object initialized with EPLLqInitMonitor().
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort
+//      function.
+//  paramMask
+//      LQ_PARAM_BIT() values of the parameters to sample, or LQ_PARAM_ALL.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, NS_STATUS_RESOURCES if the monitor is full or
+//      NS_STATUS_INVALID_PARM if the port was already added.
+//****************************************************************************
+{
+EPL_LQ_PORT *lqPort;
+
+    if ( LqFindPort( monitor, portHandle))
+        return NS_STATUS_INVALID_PARM;
+    if ( monitor->numPorts >= LQ_MAX_PORTS)
+        return NS_STATUS_RESOURCES;
+
+    lqPort = &monitor->ports[monitor->numPorts++];
+    memset( lqPort, 0, sizeof( EPL_LQ_PORT));
+    lqPort->portHandle = portHandle;
+    lqPort->paramMask = paramMask & LQ_PARAM_ALL;
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLLqSetThreshold (
+        IN OUT PEPL_LQ_MONITOR monitor,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN EPL_LQ_PARAM_ENUM param,
+        IN NS_SINT low,
+        IN NS_SINT high,
+        IN NS_BOOL breakLink)
+
+//  Sets the low and high thresholds of a parameter and programs them into
+//  the device's link quality monitor.
+//
+//  monitor
+//      Monitor object the port was added to.
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort
+//      function.
+//  param
+//      The parameter, one of the LQ_PARAM_??? values.
+//  low, high
+//      Thresholds. A crossing is reported when a sample is at or beyond a
+//      threshold, and cleared once it is LQ_HYSTERESIS inside again.
+//  breakLink
+//      If TRUE, the device drops the link when the hardware monitor sees
+//      the parameter cross a threshold.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM if the port is not part
+//      of the monitor or low is above high.
+//
+//  The hardware monitor evaluates the thresholds continuously, its warning
+//  bits are collected with every sample so excursions shorter than the
+//  sampling interval are still reported.
+//****************************************************************************
+{
+EPL_LQ_PORT *lqPort;
+EPL_MDIO_OP ops[3];
+NS_UINT reg, x;
+
+    lqPort = LqFindPort( monitor, portHandle);
+    if ( !lqPort || param >= LQ_NUM_PARAMS || low > high)
+        return NS_STATUS_INVALID_PARM;
+
+    lqPort->thresholds[param].enabled = TRUE;
+    lqPort->thresholds[param].low = low;
+    lqPort->thresholds[param].high = high;
+    lqPort->thresholds[param].breakLink = breakLink;
+    lqPort->stats[param].state = LQ_STATE_NORMAL;
+
+    lqPort->lqmrConfig |= P849_LQM_ENABLE;
+    if ( breakLink)
+        lqPort->lqmrConfig |= P849_BRK_LNK_C1 << param;
+    else
+        lqPort->lqmrConfig &= ~(P849_BRK_LNK_C1 << param);
+
+    reg = (param << P849_LQ_PARAM_SEL_SHIFT) | P849_WRITE_LQ_THR;
+    for ( x = 0; x < 3; x++)
+        ops[x].flags = MDIO_OP_WRITE;
+    ops[0].registerIndex = PHY_PG2_LQDR;
+    ops[0].value = reg | LqEncode( param, low);
+    ops[1].registerIndex = PHY_PG2_LQDR;
+    ops[1].value = reg | P849_LQ_THR_SEL | LqEncode( param, high);
+    ops[2].registerIndex = PHY_PG2_LQMR;
+    ops[2].value = lqPort->lqmrConfig;
+    EPLMdioRun( portHandle, MDIO_CLASS_CONFIG, ops, 3, TRUE);
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT NS_UINT
+    EPLLqPoll (
+        IN OUT PEPL_LQ_MONITOR monitor)
+
+//  Services the monitor. Should be called periodically, e.g. from a low
+//  priority task every few milliseconds.
+//
+//  monitor
+//      Monitor object initialized with EPLLqInitMonitor().
+//
+//  Returns
+//      Number of ports sampled by this call.
+//
+//  MDIO credit accrues with elapsed time at the configured share of the
+//  bus capacity. Ports are sampled round robin, each as a single batch,
+//  while enough credit for a batch is available. Credit is charged with the
+//  actual number of transactions used and is capped at one full round so
+//  a late poll does not cause a burst of traffic.
+//****************************************************************************
+{
+EPL_LQ_PORT *lqPort;
+NS_UINT32 now, startMdio, used;
+NS_UINT64 cost, maxCredit;
+NS_UINT x, sampled;
+
+    now = OAIGetTimeStamp();
+    monitor->credit += (NS_UINT64)(now - monitor->lastPollTime) *
+                       monitor->mdioOpsPerSec * monitor->sharePermille;
+    monitor->lastPollTime = now;
+
+    if ( !monitor->numPorts)
+        return 0;
+
+    // Cap the credit at one round of all ports (worst case estimate)
+    maxCredit = 0;
+    for ( x = 0; x < monitor->numPorts; x++)
+        maxCredit += LqBatchCost( &monitor->ports[x]);
+    if ( monitor->credit > maxCredit)
+        monitor->credit = maxCredit;
+
+    for ( sampled = 0; sampled < monitor->numPorts; sampled++)
+    {
+        lqPort = &monitor->ports[monitor->nextPort];
+        if ( monitor->credit < LqBatchCost( lqPort))
+            break;
+
+        startMdio = EPLGetMdioAccessCount( lqPort->portHandle);
+        LqSamplePort( monitor, lqPort);
+        used = EPLGetMdioAccessCount( lqPort->portHandle) - startMdio;
+        monitor->mdioUsed += used;
+
+        cost = (NS_UINT64)used * LQ_CREDIT_SCALE;
+        monitor->credit = (monitor->credit > cost) ? monitor->credit - cost : 0;
+        monitor->nextPort = (monitor->nextPort + 1) % monitor->numPorts;
+    }
+
+    return sampled;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLLqGetStats (
+        IN PEPL_LQ_MONITOR monitor,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN EPL_LQ_PARAM_ENUM param,
+        OUT PEPL_LQ_STATS stats)
+
+//  Returns a copy of the rolling statistics of a parameter.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM if the port is not part
+//      of the monitor.
+//****************************************************************************
+{
+EPL_LQ_PORT *lqPort;
+
+    lqPort = LqFindPort( monitor, portHandle);
+    if ( !lqPort || param >= LQ_NUM_PARAMS)
+        return NS_STATUS_INVALID_PARM;
+
+    *stats = lqPort->stats[param];
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLLqResetStats (
+        IN OUT PEPL_LQ_MONITOR monitor)
+
+//  Clears the rolling statistics of all ports. Thresholds are kept.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+NS_UINT x;
+
+    for ( x = 0; x < monitor->numPorts; x++)
+        memset( monitor->ports[x].stats, 0, sizeof( monitor->ports[x].stats));
+    return;
+}
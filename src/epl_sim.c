@@ -0,0 +1,1023 @@
+//****************************************************************************
+// epl_sim.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Simulated PHY register model for host builds (EPL_SIMULATION). It stands
+// in for the MAC driver's ETH_ReadPHYRegister/ETH_WritePHYRegister so the
+// library can be exercised without hardware.
+//
+// The model implements register paging, MDIO transaction timing and the
+// TDR engine (with synthetic cable reflections), link quality monitor,
+// receive error counters, the IEEE 1588 clock (read, load, step, normal
+// and temporary rate adjustment, trigger expiration) and the timestamp unit
+// (transmit and receive timestamp queues, one-step Sync insertion and NTP
+// mode). Each PHY clock starts at the simulated time and keeps it until it
+// is set, stepped or rate adjusted, or its oscillator is given a frequency
+// error with EPLSimSetClockDrift.
+//
+// The following functions are implemented in this module:
+//
+//      EPLSimReset
+//      EPLSimAddPhy
+//      EPLSimGetPhy
+//      EPLSimAddReflection
+//      EPLSimSetLinkQuality
+//      EPLSimAddRxErrors
+//      EPLSimTransmit
+//      EPLSimReceive
+//      EPLSimReceiveAt
+//      EPLSimGetTime
+//      EPLSimAdvanceTime
+//      EPLSimGetPhyTime
+//      EPLSimSetClockDrift
+//      ETH_ReadPHYRegister
+//      ETH_WritePHYRegister
+//****************************************************************************
+
+#include "epl/epl.h"
+
+#ifdef EPL_SIMULATION
+
+// Amplitude of the launched TDR pulse as seen by the receiver
+#define SIM_TDR_LAUNCH_AMPLITUDE    40
+#define SIM_TDR_MAX_PEAK            (P849_TDR_PEAK_MASK >> P849_TDR_PEAK_SHIFT)
+
+// Clear on read warning bits of PHY_PG2_LQMR
+#define SIM_LQMR_WARN_MASK          0x03FF
+
+// Receive error counters stick at this value
+#define SIM_ERRCNT_MAX              0xFF
+
+// IEEE 1588 clock reference period
+#define SIM_CLOCK_CYCLE_NS          8
+
+static EPL_SIM_PHY simPhys[EPL_SIM_MAX_PHYS];
+static NS_UINT64 simTime;
+static NS_UINT32 simNoiseSeed = 1;
+
+//****************************************************************************
+static NS_SINT
+    SimNoise(
+        IN NS_UINT amplitude)
+//  Returns deterministic pseudo random noise in the range +/- amplitude.
+//****************************************************************************
+{
+    if ( !amplitude)
+        return 0;
+    simNoiseSeed = simNoiseSeed * 1103515245 + 12345;
+    return (NS_SINT)((simNoiseSeed >> 16) % (2 * amplitude + 1)) - (NS_SINT)amplitude;
+}
+
+//****************************************************************************
+static NS_UINT16 *
+    SimRegister(
+        IN PEPL_SIM_PHY simPhy,
+        IN NS_UINT page,
+        IN NS_UINT reg)
+//  Returns the storage location of a register on the given page.
+//****************************************************************************
+{
+    if ( reg < 0x14)
+        return &simPhy->baseRegs[reg];
+    return &simPhy->pageRegs[page & 0x07][reg - 0x14];
+}
+
+//****************************************************************************
+static void
+    SimResetRegisters(
+        IN PEPL_SIM_PHY simPhy)
+//  Loads the register reset values. Cable faults and statistics are kept.
+//****************************************************************************
+{
+    memset( simPhy->baseRegs, 0, sizeof( simPhy->baseRegs));
+    memset( simPhy->pageRegs, 0, sizeof( simPhy->pageRegs));
+    memset( simPhy->lqThreshold, 0, sizeof( simPhy->lqThreshold));
+    simPhy->page = 0;
+    memset( &simPhy->txTs, 0, sizeof( simPhy->txTs));
+    memset( &simPhy->rxTs, 0, sizeof( simPhy->rxTs));
+    simPhy->rate = simPhy->tempRate = 0;
+    simPhy->tempCycles = 0;
+    simPhy->tdrInCount = simPhy->tdrOutWord = 0;
+    simPhy->trigArmed = 0;
+    simPhy->trigDone = FALSE;
+    simPhy->baseRegs[PHY_BMCR] = BMCR_AUTO_NEG_ENABLE | BMCR_FORCE_SPEED_100 | BMCR_FORCE_FULL_DUP;
+    simPhy->baseRegs[PHY_BMSR] = BMSR_EXTENDED_CAPABLE | BMSR_AUTO_NEG_ABILITY | BMSR_PREAMBLE_SUPPRESS |
+                                 BMSR_10T_HALF_DUP | BMSR_10T_FULL_DUP | BMSR_100X_HALF_DUP | BMSR_100X_FULL_DUP;
+    simPhy->baseRegs[PHY_IDR1] = IDR1_NATIONAL_OUI_VAL;
+    simPhy->baseRegs[PHY_IDR2] = IDR2_NATIONAL_OUI_VAL | IDR2_MODEL_DP83640_VAL | 0x0001;
+}
+
+//****************************************************************************
+static NS_SINT
+    SimTdrSample(
+        IN PEPL_SIM_PHY simPhy,
+        IN NS_BOOL txOnRx,
+        IN NS_BOOL rxOnRx,
+        IN NS_UINT width,
+        IN NS_UINT tick)
+//  Returns the receiver's view of the line at a given tick after launch.
+//****************************************************************************
+{
+EPL_SIM_REFLECTION *refl;
+NS_SINT sample;
+NS_UINT x;
+
+    // Reflections are only seen on the pair the pulse was launched on
+    if ( txOnRx != rxOnRx)
+        return 0;
+
+    sample = 0;
+    if ( tick < width)
+        sample += SIM_TDR_LAUNCH_AMPLITUDE;
+
+    for ( x = 0; x < simPhy->numReflections; x++)
+    {
+        refl = &simPhy->reflections[x];
+        if ( refl->rxPair != rxOnRx)
+            continue;
+        if ( tick < refl->delayTicks || tick >= refl->delayTicks + width)
+            continue;
+
+        // Narrow pulses lose more energy over long cable runs
+        sample += refl->amplitude * (NS_SINT)width /
+                  (NS_SINT)(width + refl->delayTicks / 32);
+    }
+
+    return sample;
+}
+
+//****************************************************************************
+static void
+    SimSendTdr(
+        IN PEPL_SIM_PHY simPhy)
+//  Fires a TDR pulse using the current TDR_CTRL/TDR_WIN settings and latches
+//  the results in TDR_PEAK/TDR_THR.
+//****************************************************************************
+{
+NS_UINT ctrl, win, width, thr, start, stop, tick;
+NS_UINT peak, peakTime, thrTime;
+NS_BOOL minMode, thrMet;
+NS_SINT sample;
+
+    ctrl = *SimRegister( simPhy, 2, PHY_PG2_TDR_CTRL & 0x1F);
+    win = *SimRegister( simPhy, 2, PHY_PG2_TDR_WIN & 0x1F);
+
+    width = (ctrl & P849_TDR_WIDTH_MASK) >> P849_TDR_WIDTH_SHIFT;
+    if ( !width) width = 1;
+    thr = (ctrl & P849_RX_THRESHOLD_MASK) >> P849_RX_THRESHOLD_SHIFT;
+    minMode = (ctrl & P849_TDR_MIN_MODE) ? TRUE : FALSE;
+    start = (win & P849_TDR_START_MASK) >> P849_TDR_START_SHIFT;
+    stop = (win & P849_TDR_STOP_MASK) >> P849_TDR_STOP_SHIFT;
+
+    peak = peakTime = thrTime = 0;
+    thrMet = FALSE;
+    for ( tick = start; tick <= stop; tick++)
+    {
+        sample = SimTdrSample( simPhy, (ctrl & P849_TX_CHANNEL) ? TRUE : FALSE,
+                               (ctrl & P849_RX_CHANNEL) ? TRUE : FALSE, width, tick);
+        sample += SimNoise( simPhy->tdrNoise);
+        if ( minMode) sample = -sample;
+        if ( sample <= 0)
+            continue;
+
+        if ( (NS_UINT)sample > peak)
+        {
+            peak = sample;
+            peakTime = tick;
+        }
+        if ( !thrMet && thr && (NS_UINT)sample >= thr)
+        {
+            thrMet = TRUE;
+            thrTime = tick;
+        }
+    }
+    if ( peak > SIM_TDR_MAX_PEAK)
+        peak = SIM_TDR_MAX_PEAK;
+
+    *SimRegister( simPhy, 2, PHY_PG2_TDR_PEAK & 0x1F) =
+        (NS_UINT16)((peak << P849_TDR_PEAK_SHIFT) | (peakTime << P849_TDR_PEAK_TIME_SHIFT));
+    *SimRegister( simPhy, 2, PHY_PG2_TDR_THR & 0x1F) =
+        (NS_UINT16)((thrMet ? P849_TDR_THR_MET : 0) | (thrTime << P849_TDR_THR_TIME_SHIFT));
+    *SimRegister( simPhy, 2, PHY_PG2_TDR_CTRL & 0x1F) = (NS_UINT16)(ctrl & ~P849_SEND_TDR);
+    simPhy->tdrPulseCount++;
+}
+
+//****************************************************************************
+static void
+    SimCheckLinkQuality(
+        IN PEPL_SIM_PHY simPhy,
+        IN NS_UINT param)
+//  Latches the LQMR warning bits of a parameter if it is beyond a threshold.
+//****************************************************************************
+{
+NS_UINT16 *lqmr = SimRegister( simPhy, 2, PHY_PG2_LQMR & 0x1F);
+
+    if ( !(*lqmr & P849_LQM_ENABLE))
+        return;
+    if ( simPhy->lqValue[param] <= simPhy->lqThreshold[param][0])
+        *lqmr |= (NS_UINT16)(P849_C1_LO_WARN << (param * 2));
+    if ( simPhy->lqValue[param] >= simPhy->lqThreshold[param][1])
+        *lqmr |= (NS_UINT16)(P849_C1_HI_WARN << (param * 2));
+}
+
+//****************************************************************************
+static void
+    SimWriteLqdr(
+        IN PEPL_SIM_PHY simPhy,
+        IN NS_UINT16 value)
+//  Handles threshold writes and parameter sampling through PHY_PG2_LQDR.
+//****************************************************************************
+{
+NS_UINT param;
+NS_SINT data;
+
+    param = (value & P849_LQ_PARAM_SEL_MASK) >> P849_LQ_PARAM_SEL_SHIFT;
+    if ( param >= EPL_SIM_NUM_LQ_PARAMS)
+        return;
+
+    if ( value & P849_WRITE_LQ_THR)
+    {
+        data = value & P849_LQ_THR_DATA_MASK;
+        if ( param != 1 && (data & 0x80))      // Only DAGC is unsigned
+            data -= 0x100;
+        simPhy->lqThreshold[param][(value & P849_LQ_THR_SEL) ? 1 : 0] = data;
+    }
+    if ( value & P849_SAMPLE_PARAM)
+    {
+        *SimRegister( simPhy, 2, PHY_PG2_LQDR & 0x1F) =
+            (NS_UINT16)((value & ~(P849_SAMPLE_PARAM | P849_LQ_THR_DATA_MASK)) |
+                        (simPhy->lqValue[param] & P849_LQ_THR_DATA_MASK));
+    }
+}
+
+//****************************************************************************
+static NS_UINT16
+    SimChecksum(
+        IN NS_UINT8 *data,
+        IN NS_UINT length)
+//  Returns the folded ones complement sum of big endian 16-bit words.
+//****************************************************************************
+{
+NS_UINT32 sum = 0;
+NS_UINT x;
+
+    for ( x = 0; x + 1 < length; x += 2)
+        sum += (data[x] << 8) | data[x + 1];
+    while ( sum >> 16)
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    return (NS_UINT16)sum;
+}
+
+//****************************************************************************
+static void
+    SimClockAdvance(
+        IN OUT PEPL_SIM_PHY simPhy,
+        IN NS_UINT64 cycles,
+        IN NS_SINT32 rate)
+//  Advances the 1588 clock by a number of cycles at a rate.
+//****************************************************************************
+{
+NS_SINT64 frac;
+
+    // cycles * rate / 2^32 in two parts, so long runs cannot overflow
+    frac = simPhy->clockFrac + (NS_SINT64)(cycles & 0xFFFFFFFF) * rate;
+    simPhy->clockNs += cycles * SIM_CLOCK_CYCLE_NS +
+                       (NS_UINT64)((NS_SINT64)(cycles >> 32) * rate + (frac >> 32));
+    simPhy->clockFrac = frac & 0xFFFFFFFF;
+}
+
+//****************************************************************************
+static NS_UINT64
+    SimClockNow(
+        IN OUT PEPL_SIM_PHY simPhy)
+//  Brings the 1588 clock up to the simulated time and returns it in
+//  nanoseconds. A partial cycle counts at the nominal rate.
+//****************************************************************************
+{
+NS_UINT64 cycles, tempCycles;
+
+    cycles = (simTime - simPhy->clockUpdated) / SIM_CLOCK_CYCLE_NS;
+    simPhy->clockUpdated += cycles * SIM_CLOCK_CYCLE_NS;
+    tempCycles = (cycles < simPhy->tempCycles) ? cycles : simPhy->tempCycles;
+    if ( tempCycles)
+    {
+        SimClockAdvance( simPhy, tempCycles, simPhy->tempRate + simPhy->oscError);
+        simPhy->tempCycles -= (NS_UINT32)tempCycles;
+    }
+    SimClockAdvance( simPhy, cycles - tempCycles, simPhy->rate + simPhy->oscError);
+    return simPhy->clockNs + (simTime - simPhy->clockUpdated);
+}
+
+//****************************************************************************
+static void
+    SimCheckTriggers(
+        IN OUT PEPL_SIM_PHY simPhy)
+//  Completes armed triggers whose expiration time has passed.
+//****************************************************************************
+{
+NS_UINT64 now;
+NS_UINT x;
+
+    if ( !simPhy->trigArmed)
+        return;
+    now = SimClockNow( simPhy);
+    for ( x = 0; x < 8; x++)
+    {
+        if ( (simPhy->trigArmed & (1 << x)) && now >= simPhy->trigTime[x])
+        {
+            simPhy->trigArmed &= ~(1 << x);
+            simPhy->trigDone = TRUE;
+        }
+    }
+}
+
+//****************************************************************************
+static void
+    SimWritePtpCtl(
+        IN OUT PEPL_SIM_PHY simPhy,
+        IN NS_UINT16 value)
+//  Executes the clock and trigger commands of a PTP_CTL write, using the
+//  PTP_TDR words written since the previous PTP_CTL write.
+//****************************************************************************
+{
+NS_UINT16 *tdr = simPhy->tdrIn;
+NS_UINT64 now, time;
+NS_UINT trigger;
+
+    now = SimClockNow( simPhy);
+    time = ((NS_UINT64)(tdr[2] | (tdr[3] << 16)) * 1000000000) +
+           (tdr[0] | ((NS_UINT64)(tdr[1] & 0x3FFF) << 16));
+    trigger = (value & P640_TRIG_SEL_MASK) >> P640_TRIG_SEL_SHIFT;
+
+    if ( value & P640_PTP_RD_CLK)
+    {
+        simPhy->tdrOut[0] = (NS_UINT16)((now % 1000000000) & 0xFFFF);
+        simPhy->tdrOut[1] = (NS_UINT16)((now % 1000000000) >> 16);
+        simPhy->tdrOut[2] = (NS_UINT16)((now / 1000000000) & 0xFFFF);
+        simPhy->tdrOut[3] = (NS_UINT16)((now / 1000000000) >> 16);
+        simPhy->tdrOutWord = 0;
+    }
+    if ( (value & P640_PTP_LOAD_CLK) && simPhy->tdrInCount >= 4)
+    {
+        simPhy->clockNs = time - (simTime - simPhy->clockUpdated);
+        simPhy->clockFrac = 0;
+    }
+    if ( (value & P640_PTP_STEP_CLK) && simPhy->tdrInCount >= 4)
+    {
+        // Seconds and nanoseconds are separate 2's complement values
+        simPhy->clockNs += (NS_UINT64)((NS_SINT64)(NS_SINT32)(tdr[2] | (tdr[3] << 16)) * 1000000000 +
+                                       (NS_SINT32)(tdr[0] | (tdr[1] << 16)));
+    }
+    if ( value & P640_TRIG_LOAD)
+        simPhy->trigSelect = trigger;
+    if ( (value & P640_TRIG_EN) && trigger == simPhy->trigSelect && simPhy->tdrInCount >= 4)
+    {
+        simPhy->trigTime[trigger] = time;
+        simPhy->trigArmed |= 1 << trigger;
+    }
+    if ( value & P640_TRIG_DIS)
+        simPhy->trigArmed &= ~(1 << trigger);
+    simPhy->tdrInCount = 0;
+}
+
+//****************************************************************************
+static void
+    SimWriteRate(
+        IN OUT PEPL_SIM_PHY simPhy)
+//  Latches the rate in PTP_RATEH/PTP_RATEL, written low word last, as the
+//  normal or (for PTP_TRD cycles) the temporary rate.
+//****************************************************************************
+{
+NS_UINT16 rateH;
+NS_SINT32 rate;
+
+    SimClockNow( simPhy);
+    rateH = *SimRegister( simPhy, 4, PHY_PG4_PTP_RATEH & 0x1F);
+    rate = (NS_SINT32)((((NS_UINT32)rateH & P640_PTP_RATE_HI_MASK) << P640_PTP_RATE_HI_SHIFT) |
+                       *SimRegister( simPhy, 4, PHY_PG4_PTP_RATEL & 0x1F));
+    if ( rateH & P640_PTP_RATE_DIR)
+        rate = -rate;
+    if ( rateH & P640_PTP_TMP_RATE)
+    {
+        simPhy->tempRate = rate;
+        simPhy->tempCycles = (((NS_UINT32)*SimRegister( simPhy, 5, PHY_PG5_PTP_TRDH & 0x1F) &
+                               P640_PTP_RATE_HI_MASK) << P640_PTP_RATE_HI_SHIFT) |
+                             *SimRegister( simPhy, 5, PHY_PG5_PTP_TRDL & 0x1F);
+    }
+    else
+    {
+        simPhy->rate = rate;
+    }
+}
+
+//****************************************************************************
+static void
+    SimQueueTs(
+        IN OUT EPL_SIM_TS_QUEUE *queue,
+        IN NS_UINT64 time,
+        IN NS_UINT16 sequenceId,
+        IN NS_UINT16 typeHash)
+//  Adds a timestamp to a timestamp queue, or counts it as dropped if the
+//  queue is full.
+//****************************************************************************
+{
+    if ( queue->count < EPL_SIM_TS_DEPTH)
+    {
+        queue->seconds[queue->count] = (NS_UINT32)(time / 1000000000);
+        queue->nanoSeconds[queue->count] = (NS_UINT32)(time % 1000000000);
+        queue->sequenceId[queue->count] = sequenceId;
+        queue->typeHash[queue->count] = typeHash;
+        queue->count++;
+    }
+    else if ( queue->overflow < 3)
+    {
+        queue->overflow++;
+    }
+}
+
+//****************************************************************************
+static NS_UINT16
+    SimReadTs(
+        IN OUT EPL_SIM_TS_QUEUE *queue,
+        IN NS_UINT numWords)
+//  Returns the next word of the timestamp at the head of the queue, removing
+//  the entry once all numWords words (4 for PTP_TXTS, 6 for PTP_RXTS) have
+//  been read.
+//****************************************************************************
+{
+NS_UINT16 value;
+NS_UINT x;
+
+    if ( !queue->count)
+        return 0;
+
+    switch ( queue->word)
+    {
+    case 0:  value = (NS_UINT16)queue->nanoSeconds[0];                       break;
+    case 1:  value = (NS_UINT16)((queue->overflow << 14) |
+                                 ((queue->nanoSeconds[0] >> 16) & 0x3FFF));  break;
+    case 2:  value = (NS_UINT16)queue->seconds[0];                           break;
+    case 3:  value = (NS_UINT16)(queue->seconds[0] >> 16);                   break;
+    case 4:  value = queue->sequenceId[0];                                   break;
+    default: value = queue->typeHash[0];                                     break;
+    }
+
+    if ( ++queue->word == numWords)
+    {
+        for ( x = 1; x < queue->count; x++)
+        {
+            queue->seconds[x - 1] = queue->seconds[x];
+            queue->nanoSeconds[x - 1] = queue->nanoSeconds[x];
+            queue->sequenceId[x - 1] = queue->sequenceId[x];
+            queue->typeHash[x - 1] = queue->typeHash[x];
+        }
+        queue->count--;
+        queue->overflow = 0;
+        queue->word = 0;
+    }
+    return value;
+}
+
+//****************************************************************************
+static NS_UINT8 *
+    SimFindEvent(
+        IN PEPL_SIM_PHY simPhy,
+        IN NS_UINT8 *frameBuffer,
+        IN NS_UINT frameLength,
+        IN NS_UINT cfg,
+        OUT NS_UINT8 **udp)
+//  Returns the start of the PTP (or, with NTP_TS_EN, NTP) message in a
+//  frame accepted by the transport enables in cfg, or NULL. PTP_TXCFG0 and
+//  PTP_RXCFG0 use the same bits for L2_EN, IPV6_EN, IPV4_EN and the PTP
+//  version. udp is set to the UDP header, or NULL for Layer 2 frames.
+//****************************************************************************
+{
+NS_UINT8 *ptp = NULL;
+NS_UINT value, port;
+NS_BOOL ntp;
+
+    ntp = (*SimRegister( simPhy, 5, PHY_PG5_PTP_TXCFG0 & 0x1F) & P640_NTP_TS_EN) ? TRUE : FALSE;
+    port = ntp ? 123 : 319;
+
+    *udp = NULL;
+    if ( frameLength < 14)
+        return NULL;
+
+    value = (frameBuffer[12] << 8) | frameBuffer[13];
+    if ( value == 0x88F7 && (cfg & P640_TX_L2_EN) && !ntp)
+        ptp = &frameBuffer[14];
+    else if ( value == 0x0800 && (cfg & P640_TX_IPV4_EN) && frameLength >= 42 && frameBuffer[23] == 17)
+        *udp = &frameBuffer[14 + (frameBuffer[14] & 0x0F) * 4];
+    else if ( value == 0x86DD && (cfg & P640_TX_IPV6_EN) && frameLength >= 62 && frameBuffer[20] == 17)
+        *udp = &frameBuffer[54];
+    if ( *udp && (NS_UINT)(((*udp)[2] << 8) | (*udp)[3]) == port)
+        ptp = &(*udp)[8];
+    if ( !ptp || ptp + PTP_HDR_LENGTH > frameBuffer + frameLength)
+        return NULL;
+
+    // NTP packets carry no PTP version or messageType
+    if ( ntp)
+        return ptp;
+
+    value = (cfg & P640_TX_PTP_VER_MASK) >> P640_TX_PTP_VER_SHIFT;
+    if ( (value && (ptp[1] & 0x0F) != value) || (ptp[0] & 0x0F) > PTP_MSG_PDELAY_RESP)
+        return NULL;
+    return ptp;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLSimReset(
+        void)
+
+//  Removes all simulated PHYs and resets the simulated time to zero.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    memset( simPhys, 0, sizeof( simPhys));
+    simTime = 0;
+    simNoiseSeed = 1;
+    return;
+}
+
+//****************************************************************************
+EXPORT PEPL_SIM_PHY
+    EPLSimAddPhy(
+        IN NS_UINT mdioAddress)
+
+//  Adds a simulated DP83640 at the specified MDIO address. All registers
+//  start at their reset values.
+//
+//  mdioAddress
+//      MDIO address the simulated PHY responds to, 0 - 31.
+//
+//  Returns
+//      Pointer to the simulated PHY, or NULL if no slot is available or the
+//      address is already in use.
+//****************************************************************************
+{
+PEPL_SIM_PHY simPhy = NULL;
+NS_UINT x;
+
+    if ( EPLSimGetPhy( mdioAddress))
+        return NULL;
+
+    for ( x = 0; x < EPL_SIM_MAX_PHYS; x++)
+    {
+        if ( !simPhys[x].present)
+        {
+            simPhy = &simPhys[x];
+            break;
+        }
+    }
+    if ( !simPhy)
+        return NULL;
+
+    memset( simPhy, 0, sizeof( EPL_SIM_PHY));
+    simPhy->present = TRUE;
+    simPhy->mdioAddress = mdioAddress;
+    simPhy->clockNs = simPhy->clockUpdated = simTime;
+    SimResetRegisters( simPhy);
+    return simPhy;
+}
+
+//****************************************************************************
+EXPORT PEPL_SIM_PHY
+    EPLSimGetPhy(
+        IN NS_UINT mdioAddress)
+
+//  Looks up a simulated PHY by MDIO address.
+//
+//  Returns
+//      Pointer to the simulated PHY, or NULL if none is present.
+//****************************************************************************
+{
+NS_UINT x;
+
+    for ( x = 0; x < EPL_SIM_MAX_PHYS; x++)
+    {
+        if ( simPhys[x].present && simPhys[x].mdioAddress == mdioAddress)
+            return &simPhys[x];
+    }
+    return NULL;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLSimAddReflection(
+        IN PEPL_SIM_PHY simPhy,
+        IN NS_BOOL rxPair,
+        IN NS_UINT delayTicks,
+        IN NS_SINT amplitude)
+
+//  Adds a synthetic cable reflection seen by the TDR engine.
+//
+//  simPhy
+//      Simulated PHY returned by EPLSimAddPhy.
+//  rxPair
+//      TRUE if the fault is on the RX pair, FALSE for the TX pair.
+//  delayTicks
+//      Round trip delay from the PHY to the fault in 8ns units.
+//  amplitude
+//      Signed reflection amplitude. Positive values model an open (or high
+//      impedance) fault, negative values model a short.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_RESOURCES if the reflection table
+//      is full.
+//****************************************************************************
+{
+EPL_SIM_REFLECTION *refl;
+
+    if ( simPhy->numReflections >= EPL_SIM_MAX_REFLECTIONS)
+        return NS_STATUS_RESOURCES;
+
+    refl = &simPhy->reflections[simPhy->numReflections++];
+    refl->rxPair = rxPair;
+    refl->delayTicks = delayTicks;
+    refl->amplitude = amplitude;
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLSimSetLinkQuality(
+        IN PEPL_SIM_PHY simPhy,
+        IN NS_UINT param,
+        IN NS_SINT value)
+
+//  Sets the current value of a simulated receive DSP parameter.
+//
+//  simPhy
+//      Simulated PHY returned by EPLSimAddPhy.
+//  param
+//      Parameter index as used by LQ_PARAM_SEL (0 = C1, 1 = DAGC, 2 = DBLW,
+//      3 = frequency offset, 4 = frequency control).
+//  value
+//      New value. The hardware monitor warning bits latch immediately if
+//      the value is beyond a programmed threshold.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    if ( param >= EPL_SIM_NUM_LQ_PARAMS)
+        return;
+    simPhy->lqValue[param] = value;
+    SimCheckLinkQuality( simPhy, param);
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLSimAddRxErrors(
+        IN PEPL_SIM_PHY simPhy,
+        IN NS_UINT falseCarriers,
+        IN NS_UINT rxErrors)
+
+//  Counts simulated false carrier and receive error events.
+//
+//  simPhy
+//      Simulated PHY returned by EPLSimAddPhy.
+//  falseCarriers
+//      Events added to PHY_FCSCR.
+//  rxErrors
+//      Events added to PHY_RECR.
+//
+//  Returns
+//      Nothing
+//
+//  Like the hardware, the counters stick at 0xFF and clear when read.
+//****************************************************************************
+{
+NS_UINT16 *reg;
+
+    reg = SimRegister( simPhy, 0, PHY_FCSCR);
+    *reg = (NS_UINT16)((*reg + falseCarriers > SIM_ERRCNT_MAX) ? SIM_ERRCNT_MAX : *reg + falseCarriers);
+    reg = SimRegister( simPhy, 0, PHY_RECR);
+    *reg = (NS_UINT16)((*reg + rxErrors > SIM_ERRCNT_MAX) ? SIM_ERRCNT_MAX : *reg + rxErrors);
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLSimTransmit(
+        IN PEPL_SIM_PHY simPhy,
+        IN OUT NS_UINT8 *frameBuffer,
+        IN NS_UINT frameLength)
+
+//  Passes a frame (without FCS) through the transmit timestamp unit of a
+//  simulated PHY, as configured in PTP_TXCFG0.
+//
+//  simPhy
+//      Simulated PHY.
+//  frameBuffer
+//      Frame as sent by the MAC. Modified in place like the frame on the
+//      wire when a one-step timestamp is inserted.
+//  frameLength
+//      Frame length.
+//
+//  Returns
+//      TRUE if a timestamp was inserted into the frame. Other PTP event
+//      messages, or NTP packets with NTP_TS_EN set, have their timestamp
+//      added to the PTP_TXTS queue.
+//****************************************************************************
+{
+NS_UINT8 *ptp, *udp, *field, *trailer;
+NS_UINT cfg, udpLength;
+NS_UINT32 seconds, nanoSeconds, sum;
+NS_UINT16 before, after;
+NS_UINT64 now;
+
+    cfg = *SimRegister( simPhy, 5, PHY_PG5_PTP_TXCFG0 & 0x1F);
+    if ( !(cfg & P640_TX_TS_EN))
+        return FALSE;
+    ptp = SimFindEvent( simPhy, frameBuffer, frameLength, cfg, &udp);
+    if ( !ptp)
+        return FALSE;
+
+    now = SimClockNow( simPhy);
+    seconds = (NS_UINT32)(now / 1000000000);
+    nanoSeconds = (NS_UINT32)(now % 1000000000);
+
+    if ( !(cfg & P640_NTP_TS_EN) && (ptp[0] & 0x0F) == PTP_MSG_SYNC && (cfg & P640_SYNC_1STEP) &&
+         (!(ptp[PTP_HDR_FLAGS_OFFSET] & PTP_FLAG_TWO_STEP) || (cfg & P640_IGNORE_2STEP)) &&
+         ptp + PTP_HDR_LENGTH + 10 <= frameBuffer + frameLength)
+    {
+        field = &ptp[PTP_HDR_LENGTH];
+        before = SimChecksum( field, 10);
+        field[0] = field[1] = 0;
+        field[2] = (NS_UINT8)(seconds >> 24);
+        field[3] = (NS_UINT8)(seconds >> 16);
+        field[4] = (NS_UINT8)(seconds >> 8);
+        field[5] = (NS_UINT8)seconds;
+        field[6] = (NS_UINT8)(nanoSeconds >> 24);
+        field[7] = (NS_UINT8)(nanoSeconds >> 16);
+        field[8] = (NS_UINT8)(nanoSeconds >> 8);
+        field[9] = (NS_UINT8)nanoSeconds;
+        after = SimChecksum( field, 10);
+
+        // Compensate the UDP checksum in the last two bytes of the datagram
+        udpLength = udp ? (NS_UINT)((udp[4] << 8) | udp[5]) : 0;
+        if ( udp && (cfg & P640_CHK_1STEP) && udpLength >= 10 &&
+             udp + udpLength <= frameBuffer + frameLength)
+        {
+            trailer = &udp[udpLength - 2];
+            sum = SimChecksum( trailer, 2) + before + (NS_UINT16)~after;
+            while ( sum >> 16)
+                sum = (sum & 0xFFFF) + (sum >> 16);
+            trailer[0] = (NS_UINT8)(sum >> 8);
+            trailer[1] = (NS_UINT8)sum;
+        }
+        simPhy->oneStepCount++;
+        return TRUE;
+    }
+
+    SimQueueTs( &simPhy->txTs, now, 0, 0);
+    return FALSE;
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLSimReceive(
+        IN PEPL_SIM_PHY simPhy,
+        IN NS_UINT8 *frameBuffer,
+        IN NS_UINT frameLength)
+
+//  Passes a received frame (without FCS) through the receive timestamp unit
+//  of a simulated PHY, as configured in PTP_RXCFG0.
+//
+//  simPhy
+//      Simulated PHY.
+//  frameBuffer
+//      Frame as received from the wire.
+//  frameLength
+//      Frame length.
+//
+//  Returns
+//      TRUE if the frame was timestamped. The timestamp, sequenceId,
+//      messageType and source identity hash are added to the PTP_RXTS
+//      queue. With NTP_TS_EN set these are taken from the same offsets of
+//      the NTP packet.
+//
+//  Domain, slave and source identity hash filtering and timestamp insertion
+//  into the frame are not modelled.
+//****************************************************************************
+{
+    return EPLSimReceiveAt( simPhy, frameBuffer, frameLength, simTime);
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLSimReceiveAt(
+        IN PEPL_SIM_PHY simPhy,
+        IN NS_UINT8 *frameBuffer,
+        IN NS_UINT frameLength,
+        IN NS_UINT64 arrivalTime)
+
+//  Like EPLSimReceive, for a frame that arrived at an earlier simulated
+//  time, e.g. while MDIO transactions for another PHY were in progress.
+//
+//  arrivalTime
+//      Simulated time the frame arrived at, not later than EPLSimGetTime().
+//
+//  Returns
+//      TRUE if the frame was timestamped, with the clock value at
+//      arrivalTime.
+//****************************************************************************
+{
+NS_UINT8 *ptp, *udp;
+NS_UINT cfg;
+NS_UINT64 late, now;
+
+    cfg = *SimRegister( simPhy, 5, PHY_PG5_PTP_RXCFG0 & 0x1F);
+    if ( !(cfg & P640_RX_TS_EN))
+        return FALSE;
+    ptp = SimFindEvent( simPhy, frameBuffer, frameLength, cfg, &udp);
+    if ( !ptp)
+        return FALSE;
+
+    // Wind the clock back to the arrival, at the normal rate
+    now = SimClockNow( simPhy);
+    late = (arrivalTime < simTime) ? simTime - arrivalTime : 0;
+    now -= late + (NS_UINT64)(((NS_SINT64)(late / SIM_CLOCK_CYCLE_NS) *
+                               (simPhy->rate + simPhy->oscError)) >> 32);
+
+    SimQueueTs( &simPhy->rxTs, now,
+                (NS_UINT16)((ptp[PTP_HDR_SEQUENCE_ID_OFFSET] << 8) | ptp[PTP_HDR_SEQUENCE_ID_OFFSET + 1]),
+                (NS_UINT16)(((ptp[PTP_HDR_MSG_TYPE_OFFSET] & 0x0F) << 12) |
+                            PTPCalcSourceIdHash( &ptp[PTP_HDR_SOURCE_PORT_ID_OFFSET])));
+    return TRUE;
+}
+
+//****************************************************************************
+EXPORT NS_UINT64
+    EPLSimGetTime(
+        void)
+
+//  Returns the simulated time in nanoseconds. Time advances with every MDIO
+//  transaction and with calls to EPLSimAdvanceTime.
+//****************************************************************************
+{
+    return simTime;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLSimAdvanceTime(
+        IN NS_UINT64 nanoSeconds)
+
+//  Advances the simulated time.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    simTime += nanoSeconds;
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_UINT64
+    EPLSimGetPhyTime(
+        IN PEPL_SIM_PHY simPhy)
+
+//  Returns the IEEE 1588 clock of a simulated PHY in nanoseconds, without
+//  an MDIO transaction.
+//****************************************************************************
+{
+    return SimClockNow( simPhy);
+}
+
+//****************************************************************************
+EXPORT void
+    EPLSimSetClockDrift(
+        IN PEPL_SIM_PHY simPhy,
+        IN NS_SINT32 ppb)
+
+//  Sets the frequency error of the oscillator that drives the IEEE 1588
+//  clock of a simulated PHY. It adds to the rate adjustment and is kept
+//  across PHY resets.
+//
+//  ppb
+//      Frequency error in parts per billion, positive = fast.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    SimClockNow( simPhy);
+    simPhy->oscError = (NS_SINT32)(((NS_SINT64)ppb << 35) / 1000000000);
+    return;
+}
+
+//****************************************************************************
+NS_UINT32
+    ETH_ReadPHYRegister(
+        NS_UINT16 PHYAddress,
+        NS_UINT16 PHYReg)
+//  Simulated MDIO read. Unpopulated addresses read back as 0xFFFF, like an
+//  undriven MDIO line.
+//****************************************************************************
+{
+PEPL_SIM_PHY simPhy;
+NS_UINT16 *reg, value;
+NS_UINT x;
+
+    simTime += EPL_SIM_MDIO_FRAME_NS;
+    simPhy = EPLSimGetPhy( PHYAddress);
+    if ( !simPhy || PHYReg > 0x1F)
+        return 0xFFFF;
+
+    simPhy->readCount++;
+    if ( PHYReg == PHY_PAGESEL)
+        return simPhy->page;
+
+    reg = SimRegister( simPhy, simPhy->page, PHYReg);
+    value = *reg;
+
+    if ( simPhy->page == 4 && PHYReg == (PHY_PG4_PTP_TXTS & 0x1F))
+        return SimReadTs( &simPhy->txTs, 4);
+    if ( simPhy->page == 4 && PHYReg == (PHY_PG4_PTP_RXTS & 0x1F))
+        return SimReadTs( &simPhy->rxTs, 6);
+    if ( simPhy->page == 4 && PHYReg == (PHY_PG4_PTP_STS & 0x1F))
+    {
+        SimCheckTriggers( simPhy);
+        return value | (simPhy->txTs.count ? P640_TXTS_RDY : 0) |
+                       (simPhy->rxTs.count ? P640_RXTS_RDY : 0) |
+                       (simPhy->trigDone ? P640_TRIG_DONE : 0);
+    }
+    if ( simPhy->page == 4 && PHYReg == (PHY_PG4_PTP_TSTS & 0x1F))
+    {
+        // Active bits of the armed triggers, reading clears TRIG_DONE
+        SimCheckTriggers( simPhy);
+        simPhy->trigDone = FALSE;
+        for ( value = 0, x = 0; x < 8; x++)
+            value |= (simPhy->trigArmed & (1 << x)) ? (P640_TRIG0_ACTIVE << (x * 2)) : 0;
+        return value;
+    }
+    if ( simPhy->page == 4 && PHYReg == (PHY_PG4_PTP_TDR & 0x1F))
+        return simPhy->tdrOut[simPhy->tdrOutWord++ & 0x03];
+
+    // Clear on read bits
+    if ( simPhy->page == 2 && PHYReg == (PHY_PG2_LQMR & 0x1F))
+        *reg &= ~SIM_LQMR_WARN_MASK;
+    if ( simPhy->page == 0 && (PHYReg == PHY_FCSCR || PHYReg == PHY_RECR))
+        *reg = 0;
+    return value;
+}
+
+//****************************************************************************
+NS_UINT32
+    ETH_WritePHYRegister(
+        NS_UINT16 PHYAddress,
+        NS_UINT16 PHYReg,
+        NS_UINT16 PHYValue)
+//  Simulated MDIO write.
+//****************************************************************************
+{
+PEPL_SIM_PHY simPhy;
+
+    simTime += EPL_SIM_MDIO_FRAME_NS;
+    simPhy = EPLSimGetPhy( PHYAddress);
+    if ( !simPhy || PHYReg > 0x1F)
+        return 0;
+
+    simPhy->writeCount++;
+    if ( PHYReg == PHY_PAGESEL)
+    {
+        simPhy->page = PHYValue & 0x07;
+        simPhy->pageSelectCount++;
+        return 1;
+    }
+
+    if ( PHYReg == PHY_BMCR && (PHYValue & BMCR_RESET))
+    {
+        SimResetRegisters( simPhy);
+        return 1;
+    }
+
+    *SimRegister( simPhy, simPhy->page, PHYReg) = PHYValue;
+
+    // Register side effects
+    if ( simPhy->page == 2 && PHYReg == (PHY_PG2_TDR_CTRL & 0x1F) &&
+         (PHYValue & (P849_TDR_ENABLE | P849_SEND_TDR)) == (P849_TDR_ENABLE | P849_SEND_TDR))
+        SimSendTdr( simPhy);
+    if ( simPhy->page == 2 && PHYReg == (PHY_PG2_LQDR & 0x1F))
+        SimWriteLqdr( simPhy, PHYValue);
+    if ( simPhy->page == 4 && PHYReg == (PHY_PG4_PTP_TDR & 0x1F) &&
+         simPhy->tdrInCount < 8)
+        simPhy->tdrIn[simPhy->tdrInCount++] = PHYValue;
+    if ( simPhy->page == 4 && PHYReg == (PHY_PG4_PTP_CTL & 0x1F))
+        SimWritePtpCtl( simPhy, PHYValue);
+    if ( simPhy->page == 4 && PHYReg == (PHY_PG4_PTP_RATEL & 0x1F))
+        SimWriteRate( simPhy);
+
+    return 1;
+}
+
+#endif // EPL_SIMULATION
@@ -0,0 +1,307 @@
+//****************************************************************************
+// epl_slew.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Contains sources for the temporary rate slew planner, which removes a
+// clock offset without a step adjustment.
+//
+// A temporary rate can change the clock by at most about 1.05ms: 2^26-1
+// units of 2^-32ns per cycle for 2^26-1 8ns cycles. The planner splits a
+// larger offset into segments of equal rate and (within one cycle) equal
+// duration, using the lowest rate that needs the fewest segments:
+//
+//      segments = ceil( offset / (maxDelta * SLEW_MAX_DURATION))
+//      delta    = ceil( offset / (segments * SLEW_MAX_DURATION))
+//      cycles   = round( offset / delta)
+//
+// where delta is the temporary rate less the normal rate and all values
+// are in 2^-32ns. The rounding error of the whole correction is below
+// 0.01ns. The clock runs at the normal rate between segments, so late
+// chaining only delays the finish.
+//
+// A segment is started with two rate register writes (two more when the
+// duration changes, which happens at most twice per plan) and one clock
+// read for its end time. The next segment is started from
+// EPLSlewService(), called from a timer or when the trigger armed at the
+// end of the segment is done.
+//
+// The following functions are implemented in this module:
+//
+//      EPLSlewGetDefaultConfig
+//      EPLSlewStart
+//      EPLSlewService
+//      EPLSlewSetNormalRate
+//      EPLSlewCancel
+//****************************************************************************
+
+#include "epl/epl.h"
+
+//****************************************************************************
+static NS_SINT64
+    SlewElapsedNs (
+        IN NS_UINT64 cycles,
+        IN NS_SINT32 rate)
+//  Returns the clock time, rounded up, that passes in a number of cycles at
+//  a rate.
+//****************************************************************************
+{
+NS_SINT64 adj;
+
+    adj = (NS_SINT64)cycles * rate;
+    return (NS_SINT64)cycles * 8 + (adj >> 32) + ((adj & 0xFFFFFFFF) ? 1 : 0);
+}
+
+//****************************************************************************
+static void
+    SlewStartSegment (
+        IN OUT PEPL_SLEW slew)
+//  Programs the next segment and computes its end time and the finish time.
+//****************************************************************************
+{
+PTP_TIME elapsed;
+NS_UINT32 duration, seconds, nanoSeconds;
+NS_UINT64 remaining;
+
+    duration = slew->segmentCycles + ((slew->nextSegment < slew->longSegments) ? 1 : 0);
+    if ( duration != slew->lastDuration)
+    {
+        PTPSetTempRateDurationConfig( slew->portHandle, duration);
+        slew->lastDuration = duration;
+    }
+    PTPClockSetRateAdjustment( slew->portHandle,
+                               (NS_UINT32)((slew->tempRate < 0) ? -slew->tempRate : slew->tempRate),
+                               TRUE, (slew->tempRate < 0));
+    slew->nextSegment++;
+
+    // Read after the rate write, so the end time errs late
+    PTPClockReadCurrent( slew->portHandle, &seconds, &nanoSeconds);
+    slew->segmentEnd.seconds = seconds;
+    slew->segmentEnd.nanoSeconds = (NS_SINT32)nanoSeconds;
+    PTPTimeFromNs( &elapsed, SlewElapsedNs( duration, slew->tempRate));
+    PTPTimeAdd( &slew->segmentEnd, &slew->segmentEnd, &elapsed);
+
+    remaining = (NS_UINT64)(slew->numSegments - slew->nextSegment) * slew->segmentCycles;
+    if ( slew->longSegments > slew->nextSegment)
+        remaining += slew->longSegments - slew->nextSegment;
+    PTPTimeFromNs( &elapsed, SlewElapsedNs( remaining, slew->tempRate));
+    PTPTimeAdd( &slew->finishTime, &slew->segmentEnd, &elapsed);
+
+    if ( slew->cfg.trigger != SLEW_NO_TRIGGER)
+        PTPArmTrigger( slew->portHandle, slew->cfg.trigger,
+                       (NS_UINT32)slew->segmentEnd.seconds, (NS_UINT32)slew->segmentEnd.nanoSeconds,
+                       FALSE, FALSE, 0, 0);
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLSlewGetDefaultConfig (
+        IN OUT PEPL_SLEW_CFG slewConfig)
+
+//  Returns a slew planner configuration using the full temporary rate range
+//  and no trigger.
+//
+//  slewConfig
+//      Configuration structure to fill in.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    slewConfig->maxRate = SLEW_MAX_RATE;
+    slewConfig->trigger = SLEW_NO_TRIGGER;
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLSlewStart (
+        IN OUT PEPL_SLEW slew,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN PEPL_SLEW_CFG slewConfig,
+        IN NS_SINT64 offsetNs,
+        IN NS_SINT32 normalRate,
+        OUT PPTP_TIME finishTime)
+
+//  Plans the removal of a clock offset with temporary rate segments and
+//  starts the first segment.
+//
+//  slew
+//      Caller allocated slew planner object.
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort
+//      function.
+//  slewConfig
+//      Configuration, see EPLSlewGetDefaultConfig(). Copied. A trigger is
+//      configured by this function, with notification and no GPIO.
+//  offsetNs
+//      Time to add to the clock, +/- SLEW_MAX_OFFSET_NS.
+//  normalRate
+//      The normal rate adjustment currently programmed, in 2^-32ns per
+//      cycle, negative when the clock is slowed down (see
+//      PTPClockSetRateAdjustment()). To change it while slewing, see
+//      EPLSlewSetNormalRate().
+//  finishTime
+//      Set on return to the clock time the correction is expected to be
+//      complete by, if every segment is started as soon as the previous one
+//      is done.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM if the offset is too
+//      large, the configuration is not usable or the normal rate leaves no
+//      room for a correction in the required direction.
+//****************************************************************************
+{
+NS_UINT64 need, perSegment, delta, cycles;
+NS_SINT64 maxDelta;
+NS_UINT32 seconds, nanoSeconds;
+
+    if ( offsetNs > SLEW_MAX_OFFSET_NS || offsetNs < -SLEW_MAX_OFFSET_NS ||
+         !slewConfig->maxRate || slewConfig->maxRate > SLEW_MAX_RATE ||
+         (slewConfig->trigger > 7 && slewConfig->trigger != SLEW_NO_TRIGGER))
+    {
+        return NS_STATUS_INVALID_PARM;
+    }
+
+    // Room for the rate change in the direction of the offset
+    maxDelta = (NS_SINT64)slewConfig->maxRate - ((offsetNs < 0) ? -normalRate : normalRate);
+    if ( maxDelta <= 0)
+        return NS_STATUS_INVALID_PARM;
+
+    memset( slew, 0, sizeof( EPL_SLEW));
+    slew->portHandle = portHandle;
+    slew->cfg = *slewConfig;
+    slew->offsetNs = offsetNs;
+    slew->normalRate = normalRate;
+
+    if ( !offsetNs)
+    {
+        PTPClockReadCurrent( portHandle, &seconds, &nanoSeconds);
+        finishTime->seconds = seconds;
+        finishTime->nanoSeconds = (NS_SINT32)nanoSeconds;
+        slew->finishTime = *finishTime;
+        return NS_STATUS_SUCCESS;
+    }
+
+    need = (NS_UINT64)((offsetNs < 0) ? -offsetNs : offsetNs) << 32;
+    perSegment = (NS_UINT64)maxDelta * SLEW_MAX_DURATION;
+    slew->numSegments = (NS_UINT32)((need + perSegment - 1) / perSegment);
+    perSegment = (NS_UINT64)slew->numSegments * SLEW_MAX_DURATION;
+    delta = (need + perSegment - 1) / perSegment;
+    cycles = (need + delta / 2) / delta;
+    slew->segmentCycles = (NS_UINT32)(cycles / slew->numSegments);
+    slew->longSegments = (NS_UINT32)(cycles % slew->numSegments);
+    slew->tempRate = normalRate + ((offsetNs < 0) ? -(NS_SINT32)delta : (NS_SINT32)delta);
+
+    if ( slewConfig->trigger != SLEW_NO_TRIGGER)
+        PTPSetTriggerConfig( portHandle, slewConfig->trigger, TRGOPT_NOTIFY_EN | TRGOPT_TRG_IF_LATE, 0);
+
+    slew->active = TRUE;
+    SlewStartSegment( slew);
+    *finishTime = slew->finishTime;
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLSlewService (
+        IN OUT PEPL_SLEW slew,
+        IN PPTP_TIME currentTime,
+        OUT PPTP_TIME finishTime)
+
+//  Starts the next segment once the running one is done.
+//
+//  slew
+//      Slew planner started with EPLSlewStart().
+//  currentTime
+//      Current clock time, e.g. from a timer that tracks the clock or a
+//      recent timestamp, or NULL when the running segment is known to be
+//      done (the slew trigger has expired). Only used to check the end of
+//      the running segment.
+//  finishTime
+//      If not NULL, set on return to the expected end of the correction.
+//
+//  Returns
+//      TRUE while slewing, FALSE once the last segment is done.
+//
+//  Does not access the PHY until a segment is done. If the next segment is
+//  started late, the clock runs at the normal rate in between and the
+//  correction finishes that much later.
+//****************************************************************************
+{
+    if ( slew->active && (!currentTime || PTPTimeCompare( currentTime, &slew->segmentEnd) >= 0))
+    {
+        if ( slew->nextSegment < slew->numSegments)
+            SlewStartSegment( slew);
+        else
+            slew->active = FALSE;
+    }
+
+    if ( finishTime)
+        *finishTime = slew->finishTime;
+    return slew->active;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLSlewSetNormalRate (
+        IN OUT PEPL_SLEW slew,
+        IN NS_SINT32 normalRate)
+
+//  Moves the segments not yet started to a new normal rate, keeping their
+//  correction. Call after writing the new normal rate with
+//  PTPClockSetRateAdjustment(); the hardware keeps a running temporary rate.
+//
+//  slew
+//      Slew planner started with EPLSlewStart().
+//  normalRate
+//      The normal rate now programmed, signed, 2^-32ns per cycle.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM if the segment rate
+//      would exceed the configured maxRate; nothing is changed then and the
+//      slew should be cancelled.
+//
+//  The running segment keeps the temporary rate it was started with, so
+//  its correction is off by the rate change times its remaining cycles.
+//****************************************************************************
+{
+NS_SINT64 tempRate;
+
+    tempRate = (NS_SINT64)normalRate + slew->tempRate - slew->normalRate;
+    if ( tempRate > (NS_SINT64)slew->cfg.maxRate || tempRate < -(NS_SINT64)slew->cfg.maxRate)
+        return NS_STATUS_INVALID_PARM;
+
+    slew->tempRate = (NS_SINT32)tempRate;
+    slew->normalRate = normalRate;
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLSlewCancel (
+        IN OUT PEPL_SLEW slew)
+
+//  Stops slewing. The running segment continues at the normal rate, so the
+//  correction made so far is kept.
+//
+//  slew
+//      Slew planner started with EPLSlewStart().
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    if ( !slew->active)
+        return;
+
+    PTPClockSetRateAdjustment( slew->portHandle,
+                               (NS_UINT32)((slew->normalRate < 0) ? -slew->normalRate : slew->normalRate),
+                               TRUE, (slew->normalRate < 0));
+    if ( slew->cfg.trigger != SLEW_NO_TRIGGER)
+        PTPCancelTrigger( slew->portHandle, slew->cfg.trigger);
+    slew->active = FALSE;
+    return;
+}
@@ -0,0 +1,436 @@
+//****************************************************************************
+// epl_stability.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Contains sources for the clock stability analysis, which computes MTIE,
+// TDEV and the Allan deviation from a stream of time error samples as
+// they are taken, so they can be queried on the target instead of being
+// post-processed offline.
+//
+// Samples are time errors in ns taken every sampleIntervalUs, e.g. the
+// servo offset each Sync interval or the difference of two ports' event
+// timestamps of the same edge. They must be evenly spaced; after a gap or
+// a clock step the object should be initialized again.
+//
+// MTIE (maximum time interval error) of a window of n samples is the
+// largest peak to peak time error of any n consecutive samples, at
+// tau = (n - 1) * sampleIntervalUs. Each window keeps the minimum and
+// maximum of blocks of samples in monotonic queues, so a sample costs O(1)
+// amortized per window and the memory is STAB_MTIE_BLOCKS entries per
+// window whatever its length. Windows of up to STAB_MTIE_BLOCKS samples
+// have one sample per block and are exact; longer windows are only
+// evaluated at block boundaries and can be short of the exact MTIE by the
+// wander within one block.
+//
+// The Allan deviation (ADEV) and time deviation (TDEV) are computed for
+// tau = 2^k samples. Blocks of 2^k samples are formed by pairing the
+// blocks of level k - 1, so all levels together cost O(1) amortized per
+// sample. With x the time error at the start of each block and X the
+// mean of each block, consecutive blocks give
+//
+//      ADEV^2(tau) = < (x[i + 2] - 2x[i + 1] + x[i])^2 > / (2 tau^2)
+//      TDEV^2(tau) = < (X[i + 2] - 2X[i + 1] + X[i])^2 > / 6
+//
+// These are the estimators of ITU-T G.810 evaluated once per block rather
+// than once per sample, which keeps the memory bounded at the cost of wider
+// confidence intervals than the fully overlapping ones of offline tools.
+//
+// The following functions are implemented in this module:
+//
+//      EPLStabilityGetDefaultConfig
+//      EPLStabilityInit
+//      EPLStabilityAddSample
+//      EPLStabilityGetMtie
+//      EPLStabilityGetDeviation
+//****************************************************************************
+
+#include "epl/epl.h"
+
+// Second differences are limited to this, 2^-STAB_FRAC_BITS ns (about
+// 8ms), so their squares fit in 62 bits
+#define STAB_MAX_DIFF           0x7FFFFFFFLL
+
+//****************************************************************************
+static NS_UINT64
+    StabSqrt (
+        IN NS_UINT64 value)
+//  Returns the integer square root of value.
+//****************************************************************************
+{
+NS_UINT64 root, bit;
+
+    root = 0;
+    for ( bit = (NS_UINT64)1 << 62; bit > value; bit >>= 2)
+        ;
+    while ( bit)
+    {
+        if ( value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+//****************************************************************************
+static NS_UINT64
+    StabMulDiv (
+        IN NS_UINT64 value,
+        IN NS_UINT64 mul,
+        IN NS_UINT64 div)
+//  Returns value * mul / div, dividing first if the product would not fit.
+//****************************************************************************
+{
+    if ( value < 0xFFFFFFFFFFFFFFFFULL / mul)
+        return value * mul / div;
+    return value / div * mul;
+}
+
+//****************************************************************************
+static void
+    StabAccumulate (
+        IN OUT NS_UINT64 *sum,
+        IN NS_SINT64 diff)
+//  Adds the square of a second difference to a 128 bit sum.
+//****************************************************************************
+{
+NS_UINT64 square;
+
+    if ( diff > STAB_MAX_DIFF)
+        diff = STAB_MAX_DIFF;
+    if ( diff < -STAB_MAX_DIFF)
+        diff = -STAB_MAX_DIFF;
+    square = (NS_UINT64)(diff * diff);
+    sum[0] += square;
+    if ( sum[0] < square)
+        sum[1]++;
+    return;
+}
+
+//****************************************************************************
+static NS_UINT64
+    StabMeanSquare (
+        IN NS_UINT64 *sum,
+        IN NS_UINT32 terms)
+//  Returns a 128 bit sum of squares divided by the number of terms.
+//****************************************************************************
+{
+NS_UINT64 low = sum[0], high = sum[1];
+NS_UINT shift = 0;
+
+    while ( high)
+    {
+        low = (low >> 1) | (high << 63);
+        high >>= 1;
+        shift++;
+    }
+    return (low / terms) << shift;
+}
+
+//****************************************************************************
+static void
+    StabQueuePush (
+        IN OUT EPL_STAB_QUEUE *queue,
+        IN NS_SINT32 value,
+        IN NS_UINT32 block,
+        IN NS_BOOL maximum)
+//  Appends a block extreme, first dropping the newer entries it makes
+//  irrelevant (those not above it for a minimum queue, not below it for a
+//  maximum queue).
+//****************************************************************************
+{
+EPL_STAB_EXTREME *last;
+
+    while ( queue->count)
+    {
+        last = &queue->entry[(queue->head + queue->count - 1) % STAB_MTIE_BLOCKS];
+        if ( maximum ? last->value > value : last->value < value)
+            break;
+        queue->count--;
+    }
+    last = &queue->entry[(queue->head + queue->count) % STAB_MTIE_BLOCKS];
+    last->value = value;
+    last->block = block;
+    queue->count++;
+    return;
+}
+
+//****************************************************************************
+static void
+    StabQueueExpire (
+        IN OUT EPL_STAB_QUEUE *queue,
+        IN NS_UINT32 block,
+        IN NS_UINT32 windowBlocks)
+//  Drops the entries that are no longer in a window ending with block.
+//****************************************************************************
+{
+    while ( queue->count &&
+            ((block - queue->entry[queue->head].block) & 0xFFFFFFFF) >= windowBlocks)
+    {
+        queue->head = (queue->head + 1) % STAB_MTIE_BLOCKS;
+        queue->count--;
+    }
+    return;
+}
+
+//****************************************************************************
+static void
+    StabMtieAdd (
+        IN OUT EPL_STAB_MTIE *mtie,
+        IN NS_SINT32 timeErrorNs)
+//  Adds a sample to an MTIE window.
+//****************************************************************************
+{
+NS_UINT32 peakToPeak;
+
+    if ( !mtie->samples || timeErrorNs < mtie->blockMin)
+        mtie->blockMin = timeErrorNs;
+    if ( !mtie->samples || timeErrorNs > mtie->blockMax)
+        mtie->blockMax = timeErrorNs;
+    if ( ++mtie->samples < mtie->blockSamples)
+        return;
+
+    // Block complete
+    mtie->samples = 0;
+    StabQueueExpire( &mtie->minQueue, mtie->block, mtie->windowBlocks);
+    StabQueueExpire( &mtie->maxQueue, mtie->block, mtie->windowBlocks);
+    StabQueuePush( &mtie->minQueue, mtie->blockMin, mtie->block, FALSE);
+    StabQueuePush( &mtie->maxQueue, mtie->blockMax, mtie->block, TRUE);
+    if ( ((mtie->block + 1) & 0xFFFFFFFF) >= mtie->windowBlocks)
+        mtie->full = TRUE;
+    mtie->block = (mtie->block + 1) & 0xFFFFFFFF;
+
+    if ( mtie->full)
+    {
+        peakToPeak = (NS_UINT32)((NS_SINT64)mtie->maxQueue.entry[mtie->maxQueue.head].value -
+                                 mtie->minQueue.entry[mtie->minQueue.head].value);
+        if ( peakToPeak > mtie->mtieNs)
+            mtie->mtieNs = peakToPeak;
+    }
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLStabilityGetDefaultConfig (
+        IN OUT PEPL_STABILITY_CFG stabilityConfig)
+
+//  Returns a configuration for one sample per second with MTIE windows of
+//  4, 16, 64, 256, 1024, 4096, 16384 and 65536 samples.
+//
+//  stabilityConfig
+//      Configuration structure to fill in.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+NS_UINT x;
+
+    stabilityConfig->sampleIntervalUs = 1000000;
+    for ( x = 0; x < STAB_MTIE_WINDOWS; x++)
+        stabilityConfig->mtieWindow[x] = (NS_UINT32)4 << (2 * x);
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLStabilityInit (
+        IN OUT PEPL_STABILITY stability,
+        IN PEPL_STABILITY_CFG stabilityConfig)
+
+//  Initializes a stability analysis with no samples.
+//
+//  stability
+//      Caller allocated stability object.
+//  stabilityConfig
+//      Configuration, see EPLStabilityGetDefaultConfig(). Copied.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM if the configuration is
+//      not usable.
+//
+//  A window of more than STAB_MTIE_BLOCKS samples is tracked in blocks of
+//  (window + STAB_MTIE_BLOCKS - 1) / STAB_MTIE_BLOCKS samples and shortened
+//  to a whole number of blocks; EPLStabilityGetMtie() returns the window
+//  as tracked.
+//****************************************************************************
+{
+EPL_STAB_MTIE *mtie;
+NS_UINT32 window;
+NS_UINT x;
+
+    if ( !stabilityConfig->sampleIntervalUs)
+        return NS_STATUS_INVALID_PARM;
+    for ( x = 0; x < STAB_MTIE_WINDOWS && stabilityConfig->mtieWindow[x]; x++)
+    {
+        if ( stabilityConfig->mtieWindow[x] < 2)
+            return NS_STATUS_INVALID_PARM;
+    }
+
+    memset( stability, 0, sizeof( EPL_STABILITY));
+    stability->sampleIntervalUs = stabilityConfig->sampleIntervalUs;
+    for ( x = 0; x < STAB_MTIE_WINDOWS && stabilityConfig->mtieWindow[x]; x++)
+    {
+        mtie = &stability->mtie[x];
+        window = stabilityConfig->mtieWindow[x];
+        mtie->blockSamples = (window + STAB_MTIE_BLOCKS - 1) / STAB_MTIE_BLOCKS;
+        mtie->windowBlocks = window / mtie->blockSamples;
+    }
+    stability->numWindows = x;
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLStabilityAddSample (
+        IN OUT PEPL_STABILITY stability,
+        IN NS_SINT32 timeErrorNs)
+
+//  Adds a time error sample. O(1) amortized per MTIE window and O(1)
+//  amortized for all deviation levels together.
+//
+//  stability
+//      Stability object initialized with EPLStabilityInit().
+//  timeErrorNs
+//      Time error of the clock, ns. Samples must be sampleIntervalUs apart.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+EPL_STAB_LEVEL *level;
+NS_SINT64 sum, phase, diff;
+NS_UINT x;
+
+    for ( x = 0; x < stability->numWindows; x++)
+        StabMtieAdd( &stability->mtie[x], timeErrorNs);
+    stability->samples++;
+
+    // A level 0 block is one sample; each completed pair of blocks is
+    // passed up to the next level
+    sum = phase = (NS_SINT64)timeErrorNs << STAB_FRAC_BITS;
+    for ( x = 0; x < STAB_DEV_LEVELS; x++)
+    {
+        level = &stability->level[x];
+        if ( level->blocks == 2)
+        {
+            // Block sums are 2^x times the means
+            diff = sum - 2 * level->sum[1] + level->sum[0];
+            StabAccumulate( level->adevSum, phase - 2 * level->phase[1] + level->phase[0]);
+            StabAccumulate( level->tdevSum, x ? (diff + ((NS_SINT64)1 << (x - 1))) >> x : diff);
+            level->terms++;
+        }
+        else
+        {
+            level->blocks++;
+        }
+        level->sum[0] = level->sum[1];
+        level->sum[1] = sum;
+        level->phase[0] = level->phase[1];
+        level->phase[1] = phase;
+
+        if ( !level->pending)
+        {
+            level->pending = TRUE;
+            level->pendingSum = sum;
+            level->pendingPhase = phase;
+            break;
+        }
+        level->pending = FALSE;
+        sum += level->pendingSum;
+        phase = level->pendingPhase;
+    }
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLStabilityGetMtie (
+        IN PEPL_STABILITY stability,
+        IN NS_UINT window,
+        OUT PEPL_STAB_MTIE_POINT point)
+
+//  Returns the MTIE of an observation window.
+//
+//  stability
+//      Stability object initialized with EPLStabilityInit().
+//  window
+//      Index of the window in the configuration's mtieWindow list.
+//  point
+//      Set on return to the observation interval and MTIE.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, NS_STATUS_INVALID_PARM if there is no such window
+//      or NS_STATUS_FAILURE if fewer samples than a window have been added
+//      (point is set with mtieNs 0).
+//****************************************************************************
+{
+EPL_STAB_MTIE *mtie;
+
+    if ( window >= stability->numWindows)
+        return NS_STATUS_INVALID_PARM;
+
+    mtie = &stability->mtie[window];
+    point->windowSamples = mtie->blockSamples * mtie->windowBlocks;
+    point->tauUs = (NS_UINT64)(point->windowSamples - 1) * stability->sampleIntervalUs;
+    point->mtieNs = mtie->mtieNs;
+    return mtie->full ? NS_STATUS_SUCCESS : NS_STATUS_FAILURE;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLStabilityGetDeviation (
+        IN PEPL_STABILITY stability,
+        IN NS_UINT level,
+        OUT PEPL_STAB_DEV_POINT point)
+
+//  Returns the time and Allan deviations at an averaging time.
+//
+//  stability
+//      Stability object initialized with EPLStabilityInit().
+//  level
+//      Averaging time is 2^level samples, 0 .. STAB_DEV_LEVELS - 1.
+//  point
+//      Set on return to the averaging time, deviations and the number of
+//      second differences they are estimated from. Few terms (under 10 or
+//      so) give only a rough estimate.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, NS_STATUS_INVALID_PARM if level is out of range or
+//      NS_STATUS_FAILURE if fewer than 3 * 2^level samples have been added
+//      (point is set with deviations of 0).
+//****************************************************************************
+{
+EPL_STAB_LEVEL *stabLevel;
+NS_UINT64 meanSquare, rmsFs;
+
+    if ( level >= STAB_DEV_LEVELS)
+        return NS_STATUS_INVALID_PARM;
+
+    stabLevel = &stability->level[level];
+    point->tauUs = (NS_UINT64)stability->sampleIntervalUs << level;
+    point->terms = stabLevel->terms;
+    point->tdevPs = point->adev = 0;
+    if ( !stabLevel->terms)
+        return NS_STATUS_FAILURE;
+
+    // 2^-8 ns to ps is 1000 / 256, squared 15625 / 1024
+    meanSquare = StabMeanSquare( stabLevel->tdevSum, stabLevel->terms);
+    point->tdevPs = StabSqrt( StabMulDiv( meanSquare, 15625, 6 * 1024));
+
+    // ADEV = rms / (sqrt(2) * tau), with the rms in fs; fs / us is 10^-9,
+    // so 10^6 in units of 10^-15
+    meanSquare = StabMeanSquare( stabLevel->adevSum, stabLevel->terms);
+    rmsFs = StabSqrt( StabMulDiv( meanSquare, 15625000000ULL, 2 * 1024));
+    point->adev = StabMulDiv( rmsFs, 1000000, point->tauUs);
+    return NS_STATUS_SUCCESS;
+}
@@ -0,0 +1,423 @@
+//****************************************************************************
+// epl_tc.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Contains sources for a two-step transparent clock built from several
+// DP83640 ports.
+//
+// Event messages are timestamped by the PHYs on ingress (RXOPT_TS_INSERT,
+// extracted with PTPGetTimestampFromFrame(), or a PHY Status Frame) and on
+// egress (transmit timestamp Status Frames). Their residence time is then
+// added to the correctionField of the associated general message:
+//
+//      Sync        ->  Follow_Up, sent out of the port the Sync left on
+//      Delay_Req   ->  Delay_Resp (end-to-end mode only), received on the
+//                      port the Delay_Req left on and sent out of the port
+//                      the Delay_Req arrived on
+//
+//      residence = (tx + txLatency - offset[egress]) -
+//                  (rx - rxLatency - offset[ingress])
+//
+// In peer-to-peer mode the delay of the ingress link is added to Sync as
+// well. offset[] is the difference between each PHY clock and the common
+// reference; keep it up to date from whatever keeps the PHY clocks of the
+// board in lockstep (a value of 0 if they share a synchronized clock).
+//
+// The forwarding path does a fixed amount of work per frame and never
+// touches the PHY: no MDIO accesses are made by this module. A transparent
+// clock must be driven from one context; no locking is done.
+//
+// The following functions are implemented in this module:
+//
+//      EPLTCInit
+//      EPLTCSetPortLatency
+//      EPLTCSetPortOffset
+//      EPLTCSetLinkDelay
+//      EPLTCEventIngress
+//      EPLTCEventEgress
+//      EPLTCPatchGeneral
+//****************************************************************************
+
+#include "epl/epl.h"
+
+//****************************************************************************
+static EPL_TC_ENTRY *
+    TCLookup (
+        IN OUT PEPL_TC tc,
+        IN EPL_TC_CLASS_ENUM msgClass,
+        IN NS_UINT8 *ptpMessage,
+        IN NS_UINT8 *portIdentity,
+        IN NS_BOOL claim)
+//  Returns the table entry of an event message identified by its domain,
+//  port identity and sequenceId. If claim is TRUE the entry is taken over
+//  for the message, otherwise NULL is returned if it is not present.
+//****************************************************************************
+{
+EPL_TC_ENTRY *entry;
+NS_UINT16 sequenceId;
+NS_UINT8 domain;
+
+    sequenceId = (NS_UINT16)((ptpMessage[PTP_HDR_SEQUENCE_ID_OFFSET] << 8) |
+                             ptpMessage[PTP_HDR_SEQUENCE_ID_OFFSET + 1]);
+    domain = ptpMessage[PTP_HDR_DOMAIN_OFFSET];
+    entry = &tc->table[msgClass][(sequenceId ^ portIdentity[7] ^ (portIdentity[9] << 2)) &
+                                 (TC_TABLE_SIZE - 1)];
+
+    if ( entry->valid && entry->sequenceId == sequenceId && entry->domain == domain &&
+         !memcmp( entry->portIdentity, portIdentity, PTP_PORT_ID_LENGTH))
+    {
+        return entry;
+    }
+    if ( !claim)
+        return NULL;
+
+    if ( entry->valid)
+        tc->stats.overwritten++;
+    entry->valid = TRUE;
+    entry->sequenceId = sequenceId;
+    entry->domain = domain;
+    memcpy( entry->portIdentity, portIdentity, PTP_PORT_ID_LENGTH);
+    entry->egressMask = 0;
+    return entry;
+}
+
+//****************************************************************************
+static NS_BOOL
+    TCEventClass (
+        IN PEPL_TC tc,
+        IN NS_UINT8 *ptpMessage,
+        OUT EPL_TC_CLASS_ENUM *msgClass)
+//  Classifies an event message. Returns FALSE for messages the transparent
+//  clock does not correct.
+//****************************************************************************
+{
+    switch ( ptpMessage[PTP_HDR_MSG_TYPE_OFFSET] & 0x0F)
+    {
+    case PTP_MSG_SYNC:
+        *msgClass = TC_CLASS_SYNC;
+        return TRUE;
+    case PTP_MSG_DELAY_REQ:
+        *msgClass = TC_CLASS_DELAY_REQ;
+        return (tc->mode == TC_MODE_E2E);
+    default:
+        return FALSE;
+    }
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLTCInit (
+        IN OUT PEPL_TC tc,
+        IN EPL_TC_MODE_ENUM mode,
+        IN NS_UINT numPorts)
+
+//  Initializes a transparent clock object.
+//
+//  tc
+//      Caller allocated transparent clock object.
+//  mode
+//      TC_MODE_E2E or TC_MODE_P2P.
+//  numPorts
+//      Number of ports, 2 - TC_MAX_PORTS. Ports are identified by their
+//      index 0 - numPorts-1 in all other calls.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM.
+//****************************************************************************
+{
+    if ( numPorts < 2 || numPorts > TC_MAX_PORTS)
+        return NS_STATUS_INVALID_PARM;
+
+    memset( tc, 0, sizeof( EPL_TC));
+    tc->mode = mode;
+    tc->numPorts = numPorts;
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLTCSetPortLatency (
+        IN OUT PEPL_TC tc,
+        IN NS_UINT port,
+        IN NS_UINT32 rxLatencyNs,
+        IN NS_UINT32 txLatencyNs)
+
+//  Sets the fixed latencies between the wire and the timestamp points of a
+//  port.
+//
+//  tc
+//      Transparent clock initialized with EPLTCInit().
+//  port
+//      Port index.
+//  rxLatencyNs
+//      Receive latency, e.g. 210ns for PTPGetTimestampFromFrame() values.
+//  txLatencyNs
+//      Transmit latency.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM.
+//****************************************************************************
+{
+    if ( port >= tc->numPorts)
+        return NS_STATUS_INVALID_PARM;
+
+    tc->port[port].rxLatencyNs = rxLatencyNs;
+    tc->port[port].txLatencyNs = txLatencyNs;
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLTCSetPortOffset (
+        IN OUT PEPL_TC tc,
+        IN NS_UINT port,
+        IN NS_SINT64 clockOffset)
+
+//  Updates the offset of a port's PHY clock from the board reference.
+//
+//  tc
+//      Transparent clock initialized with EPLTCInit().
+//  port
+//      Port index.
+//  clockOffset
+//      PHY clock minus reference clock, in scaled nanoseconds.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM.
+//
+//  Messages already timestamped on ingress keep the offset they arrived
+//  with, so the offsets can be updated while frames are in flight.
+//****************************************************************************
+{
+    if ( port >= tc->numPorts)
+        return NS_STATUS_INVALID_PARM;
+
+    tc->port[port].clockOffset = clockOffset;
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLTCSetLinkDelay (
+        IN OUT PEPL_TC tc,
+        IN NS_UINT port,
+        IN NS_SINT64 linkDelay)
+
+//  Updates the delay of the link attached to a port (peer-to-peer mode).
+//
+//  tc
+//      Transparent clock initialized with EPLTCInit().
+//  port
+//      Port index.
+//  linkDelay
+//      Link delay in scaled nanoseconds, e.g. from EPLP2PGetLinkDelay().
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM.
+//****************************************************************************
+{
+    if ( port >= tc->numPorts)
+        return NS_STATUS_INVALID_PARM;
+
+    tc->port[port].linkDelay = linkDelay;
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLTCEventIngress (
+        IN OUT PEPL_TC tc,
+        IN NS_UINT port,
+        IN NS_UINT8 *ptpMessage,
+        IN NS_UINT32 rxSeconds,
+        IN NS_UINT32 rxNanoSeconds)
+
+//  Records the arrival of an event message to be forwarded.
+//
+//  tc
+//      Transparent clock initialized with EPLTCInit().
+//  port
+//      Ingress port index.
+//  ptpMessage
+//      Points to the start of the PTP header.
+//  rxSeconds, rxNanoSeconds
+//      Receive timestamp of the message from the ingress PHY. Only the low
+//      8 bits of the seconds are used, so any RXOPT_TS_SEC_EN length works.
+//
+//  Returns
+//      TRUE if the message will be corrected, FALSE if it is not a message
+//      type handled in the current mode.
+//
+//  A one-step Sync has no Follow_Up to carry the correction; the caller
+//  must forward it as two-step (set the twoStepFlag and generate the
+//  Follow_Up) for its residence time to be accounted for.
+//****************************************************************************
+{
+EPL_TC_CLASS_ENUM msgClass;
+EPL_TC_ENTRY *entry;
+EPL_TC_PORT *tcPort;
+
+    if ( port >= tc->numPorts || !TCEventClass( tc, ptpMessage, &msgClass))
+        return FALSE;
+
+    entry = TCLookup( tc, msgClass, ptpMessage,
+                      &ptpMessage[PTP_HDR_SOURCE_PORT_ID_OFFSET], TRUE);
+    tcPort = &tc->port[port];
+    entry->ingressPort = (NS_UINT8)port;
+    entry->rxSeconds = rxSeconds;
+    entry->rxNanoSeconds = rxNanoSeconds;
+    entry->ingressAdjust = E2E_NS_TO_SCALED( tcPort->rxLatencyNs) + tcPort->clockOffset;
+    if ( tc->mode == TC_MODE_P2P && msgClass == TC_CLASS_SYNC)
+        entry->ingressAdjust += tcPort->linkDelay;
+    tc->stats.ingress++;
+    return TRUE;
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLTCEventEgress (
+        IN OUT PEPL_TC tc,
+        IN NS_UINT port,
+        IN NS_UINT8 *ptpMessage,
+        IN NS_UINT32 txSeconds,
+        IN NS_UINT32 txNanoSeconds)
+
+//  Records the transmit timestamp of a forwarded event message and
+//  computes its residence time for the egress port.
+//
+//  tc
+//      Transparent clock initialized with EPLTCInit().
+//  port
+//      Egress port index.
+//  ptpMessage
+//      Points to the start of the PTP header of the forwarded message.
+//  txSeconds, txNanoSeconds
+//      Transmit timestamp from the egress PHY. Transmit timestamps carry no
+//      sequenceId; the caller pairs them with the frame it sent.
+//
+//  Returns
+//      TRUE if the residence time was recorded, FALSE if the message was
+//      not seen on ingress (or has been displaced from the table).
+//****************************************************************************
+{
+EPL_TC_CLASS_ENUM msgClass;
+EPL_TC_ENTRY *entry;
+EPL_TC_PORT *tcPort;
+NS_SINT64 ns;
+
+    if ( port >= tc->numPorts || !TCEventClass( tc, ptpMessage, &msgClass))
+        return FALSE;
+
+    entry = TCLookup( tc, msgClass, ptpMessage,
+                      &ptpMessage[PTP_HDR_SOURCE_PORT_ID_OFFSET], FALSE);
+    if ( !entry)
+    {
+        tc->stats.unmatched++;
+        return FALSE;
+    }
+
+    // Residence times are well below a second, so the seconds of the two
+    // PHYs only need to agree in their low bits
+    ns = (NS_SINT64)(NS_SINT8)(NS_UINT8)(txSeconds - entry->rxSeconds) * 1000000000 +
+         ((NS_SINT64)txNanoSeconds - (NS_SINT64)entry->rxNanoSeconds);
+
+    tcPort = &tc->port[port];
+    entry->residence[port] = E2E_NS_TO_SCALED( ns + tcPort->txLatencyNs) - tcPort->clockOffset +
+                             entry->ingressAdjust;
+    entry->egressMask |= (NS_UINT8)(1 << port);
+    tc->stats.egress++;
+    return TRUE;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLTCPatchGeneral (
+        IN OUT PEPL_TC tc,
+        IN NS_UINT port,
+        IN NS_UINT rxPort,
+        IN OUT NS_UINT8 *ptpMessage)
+
+//  Adds the residence time of the matching event message to the
+//  correctionField of a general message about to be sent.
+//
+//  tc
+//      Transparent clock initialized with EPLTCInit().
+//  port
+//      Egress port index of the general message.
+//  rxPort
+//      Port index the general message was received on. A Delay_Resp is
+//      corrected with the residence time of its Delay_Req on this port,
+//      i.e. the port the Delay_Req was forwarded out of towards the master.
+//      Not used for a Follow_Up.
+//  ptpMessage
+//      Points to the start of the PTP header of a Follow_Up or Delay_Resp.
+//      Modified in place.
+//
+//  Returns
+//      NS_STATUS_SUCCESS if the message was corrected.
+//      NS_STATUS_NOT_SUPPORTED if the message needs no correction.
+//      NS_STATUS_FAILURE if no residence time is known (the transmit
+//      timestamp has not been recorded yet, or the event message was never
+//      seen), or a Delay_Resp is not sent out of the port its Delay_Req
+//      arrived on.
+//
+//  For UDP over IPv4 the caller should zero the UDP checksum of the
+//  modified frame; for IPv6 it must be recomputed.
+//****************************************************************************
+{
+EPL_TC_CLASS_ENUM msgClass;
+EPL_TC_ENTRY *entry;
+NS_UINT8 *portIdentity, *field;
+NS_UINT64 correction;
+NS_UINT x, resPort;
+
+    switch ( ptpMessage[PTP_HDR_MSG_TYPE_OFFSET] & 0x0F)
+    {
+    case PTP_MSG_FOLLOW_UP:
+        msgClass = TC_CLASS_SYNC;
+        portIdentity = &ptpMessage[PTP_HDR_SOURCE_PORT_ID_OFFSET];
+        break;
+    case PTP_MSG_DELAY_RESP:
+        if ( tc->mode != TC_MODE_E2E)
+            return NS_STATUS_NOT_SUPPORTED;
+        msgClass = TC_CLASS_DELAY_REQ;
+        portIdentity = &ptpMessage[PTP_REQ_PORT_ID_OFFSET];
+        break;
+    default:
+        return NS_STATUS_NOT_SUPPORTED;
+    }
+    if ( port >= tc->numPorts || rxPort >= tc->numPorts)
+        return NS_STATUS_INVALID_PARM;
+
+    // A Follow_Up leaves with its Sync, a Delay_Resp returns the way its
+    // Delay_Req came in
+    resPort = (msgClass == TC_CLASS_SYNC) ? port : rxPort;
+    entry = TCLookup( tc, msgClass, ptpMessage, portIdentity, FALSE);
+    if ( !entry || !(entry->egressMask & (1 << resPort)) ||
+         (msgClass == TC_CLASS_DELAY_REQ && port != entry->ingressPort))
+    {
+        tc->stats.unmatched++;
+        return NS_STATUS_FAILURE;
+    }
+
+    field = &ptpMessage[PTP_HDR_CORRECTION_OFFSET];
+    correction = 0;
+    for ( x = 0; x < 8; x++)
+        correction = (correction << 8) | field[x];
+    correction += (NS_UINT64)entry->residence[resPort];
+    for ( x = 8; x > 0; x--)
+    {
+        field[x - 1] = (NS_UINT8)correction;
+        correction >>= 8;
+    }
+
+    // Free the entry once every egress port has been corrected. Only one
+    // Delay_Resp answers a Delay_Req, even if it was flooded.
+    entry->egressMask &= (NS_UINT8)~(1 << resPort);
+    if ( !entry->egressMask || msgClass == TC_CLASS_DELAY_REQ)
+        entry->valid = FALSE;
+    tc->stats.patched++;
+    return NS_STATUS_SUCCESS;
+}
@@ -0,0 +1,276 @@
+//****************************************************************************
+// epl_tdr.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Contains sources for the TDR (Time Domain Reflectometry) cable diagnostic
+// functions.
+//
+// The following functions are implemented in this module:
+//
+//      EPLTdrGetDefaultConfig
+//      EPLTdrRun
+//      EPLTdrTicksToCm
+//****************************************************************************
+
+#include "epl/epl.h"
+
+// Number of TDR_CTRL reads to wait for SEND_TDR to self clear. A pulse
+// completes well within a single MDIO transaction time.
+#define TDR_MAX_POLLS           8
+
+typedef struct TDR_SHOT {
+    NS_BOOL thrMet;
+    NS_UINT thrTime;
+    NS_UINT peak;
+    NS_UINT peakTime;
+} TDR_SHOT;
+
+//****************************************************************************
+static NS_STATUS
+    TdrFirePulse (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_UINT ctrl,
+        IN NS_UINT win,
+        IN OUT NS_UINT *winShadow,
+        OUT TDR_SHOT *shot)
+//  Fires a single TDR pulse and collects the peak and threshold results.
+//  The window register is only rewritten if it changed since the last pulse.
+//  All registers are on page 2, so the page is only selected once per sweep.
+//****************************************************************************
+{
+NS_UINT reg, x;
+
+    OAIBeginMultiCriticalSection( portHandle->oaiDevHandle);
+    if ( win != *winShadow)
+    {
+        EPLWriteReg( portHandle, PHY_PG2_TDR_WIN, win);
+        *winShadow = win;
+    }
+    EPLWriteReg( portHandle, PHY_PG2_TDR_CTRL, ctrl | P849_SEND_TDR);
+
+    for ( x = 0; x < TDR_MAX_POLLS; x++)
+    {
+        reg = EPLReadReg( portHandle, PHY_PG2_TDR_CTRL);
+        if ( !(reg & P849_SEND_TDR))
+            break;
+    }
+    if ( x == TDR_MAX_POLLS)
+    {
+        OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
+        return NS_STATUS_HARDWARE_FAILURE;
+    }
+
+    reg = EPLReadReg( portHandle, PHY_PG2_TDR_PEAK);
+    shot->peak = (reg & P849_TDR_PEAK_MASK) >> P849_TDR_PEAK_SHIFT;
+    shot->peakTime = (reg & P849_TDR_PEAK_TIME_MASK) >> P849_TDR_PEAK_TIME_SHIFT;
+
+    reg = EPLReadReg( portHandle, PHY_PG2_TDR_THR);
+    shot->thrMet = (reg & P849_TDR_THR_MET) ? TRUE : FALSE;
+    shot->thrTime = (reg & P849_TDR_THR_TIME_MASK) >> P849_TDR_THR_TIME_SHIFT;
+    OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
+
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+static NS_STATUS
+    TdrSweepPair (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN PEPL_TDR_CFG cfg,
+        IN EPL_TDR_PAIR_ENUM pair,
+        IN OUT NS_UINT *winShadow,
+        IN OUT NS_UINT *pulsesSent,
+        OUT EPL_TDR_PAIR_RESULT *result)
+//  Locates up to cfg->maxFaults reflections on one cable pair.
+//
+//  Each step fires one pulse in maximum (open) mode and one in minimum
+//  (short) mode over the remaining window, so a single step finds the
+//  nearest fault of either polarity. The window then restarts just past
+//  that reflection. If nothing crosses the threshold the pulse width is
+//  widened to put more energy on the line before giving up, so the number
+//  of steps is bounded by maxFaults plus the number of width increases.
+//****************************************************************************
+{
+EPL_TDR_FAULT *fault;
+TDR_SHOT posShot, negShot, *hit;
+NS_UINT ctrlBase, ctrl, width, start, win, lastHit;
+NS_STATUS status;
+
+    ctrlBase = P849_TDR_ENABLE | (cfg->threshold << P849_RX_THRESHOLD_SHIFT);
+    if ( cfg->use100MbDriver) ctrlBase |= P849_TDR_100MB;
+    if ( pair == TDR_PAIR_RX) ctrlBase |= P849_TX_CHANNEL | P849_RX_CHANNEL;
+
+    result->numFaults = 0;
+    width = cfg->minPulseWidth;
+    start = width + TDR_BLANK_TICKS;
+    lastHit = 0;
+
+    while ( result->numFaults < cfg->maxFaults && start <= cfg->maxTicks)
+    {
+        ctrl = ctrlBase | (width << P849_TDR_WIDTH_SHIFT);
+        win = (start << P849_TDR_START_SHIFT) | (cfg->maxTicks << P849_TDR_STOP_SHIFT);
+
+        status = TdrFirePulse( portHandle, ctrl, win, winShadow, &posShot);
+        if ( status != NS_STATUS_SUCCESS)
+            return status;
+        status = TdrFirePulse( portHandle, ctrl | P849_TDR_MIN_MODE, win, winShadow, &negShot);
+        if ( status != NS_STATUS_SUCCESS)
+            return status;
+        *pulsesSent += 2;
+
+        if ( !posShot.thrMet && !negShot.thrMet)
+        {
+            // Nothing found - try again with a wider pulse
+            if ( width >= cfg->maxPulseWidth)
+                break;
+            width = width * 2 + 1;
+            if ( width > cfg->maxPulseWidth)
+                width = cfg->maxPulseWidth;
+            // A wider pulse also lengthens the last reflection found
+            start = lastHit + width + TDR_BLANK_TICKS;
+            continue;
+        }
+
+        // Take the nearest reflection of either polarity
+        if ( !negShot.thrMet)
+            hit = &posShot;
+        else if ( !posShot.thrMet)
+            hit = &negShot;
+        else if ( posShot.thrTime != negShot.thrTime)
+            hit = (posShot.thrTime < negShot.thrTime) ? &posShot : &negShot;
+        else
+            hit = (posShot.peak >= negShot.peak) ? &posShot : &negShot;
+
+        fault = &result->faults[result->numFaults++];
+        fault->type = (hit == &posShot) ? TDR_FAULT_OPEN : TDR_FAULT_SHORT;
+        fault->timeTicks = (hit->thrTime > cfg->calOffsetTicks) ? hit->thrTime - cfg->calOffsetTicks : 0;
+        fault->distanceCm = EPLTdrTicksToCm( fault->timeTicks, cfg->nvpPercent);
+        fault->peak = hit->peak;
+        fault->pulseWidth = width;
+
+        // Continue the search beyond this reflection
+        lastHit = hit->thrTime;
+        start = lastHit + width + TDR_BLANK_TICKS;
+    }
+
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLTdrGetDefaultConfig (
+        IN OUT PEPL_TDR_CFG tdrConfig)
+
+//  Fills in a TDR configuration suitable for CAT5 cable runs up to 100m.
+//
+//  tdrConfig
+//      Configuration structure to initialize.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    tdrConfig->minPulseWidth = 1;
+    tdrConfig->maxPulseWidth = 7;
+    tdrConfig->threshold = 8;
+    tdrConfig->maxTicks = 255;
+    tdrConfig->calOffsetTicks = 0;
+    tdrConfig->nvpPercent = TDR_DEFAULT_NVP;
+    tdrConfig->maxFaults = 2;
+    tdrConfig->use100MbDriver = TRUE;
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLTdrRun (
+        IN PEPL_PORT_HANDLE portHandle,
+        IN PEPL_TDR_CFG tdrConfig,
+        IN OUT PEPL_TDR_RESULTS tdrResults)
+
+//  Runs a TDR sweep on both cable pairs of a port and estimates the
+//  distance to any open or short found.
+//
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort
+//      function.
+//  tdrConfig
+//      Sweep configuration. See EPLTdrGetDefaultConfig().
+//  tdrResults
+//      Set on return to the faults found on each pair, along with the number
+//      of pulses, MDIO transactions and time the sweep took.
+//
+//  Returns
+//      NS_STATUS_SUCCESS
+//          The sweep completed. Pairs without faults report numFaults = 0.
+//      NS_STATUS_INVALID_PARM
+//          A configuration value is out of range.
+//      NS_STATUS_ABORTED
+//          The link is up. TDR requires a quiet cable, the link partner must
+//          be disconnected or powered down.
+//      NS_STATUS_HARDWARE_FAILURE
+//          The device never completed a TDR pulse.
+//
+//  The TDR engine is disabled again when the sweep completes.
+//****************************************************************************
+{
+NS_UINT winShadow, pair;
+NS_UINT32 startTime, startMdio;
+NS_STATUS status;
+
+    if ( tdrConfig->minPulseWidth < 1 || tdrConfig->minPulseWidth > 7 ||
+         tdrConfig->maxPulseWidth < tdrConfig->minPulseWidth || tdrConfig->maxPulseWidth > 7 ||
+         tdrConfig->threshold < 1 || tdrConfig->threshold > 63 ||
+         tdrConfig->maxTicks > 255 || tdrConfig->nvpPercent == 0 || tdrConfig->nvpPercent > 100 ||
+         tdrConfig->maxFaults < 1 || tdrConfig->maxFaults > TDR_MAX_FAULTS)
+        return NS_STATUS_INVALID_PARM;
+
+    memset( tdrResults, 0, sizeof( EPL_TDR_RESULTS));
+    startTime = OAIGetTimeStamp();
+    startMdio = EPLGetMdioAccessCount( portHandle);
+
+    // BMSR link status is latched low, the second read gives the current state
+    EPLReadReg( portHandle, PHY_BMSR);
+    if ( EPLReadReg( portHandle, PHY_BMSR) & BMSR_LINK_STATUS)
+        return NS_STATUS_ABORTED;
+
+    winShadow = ~0U;
+    status = NS_STATUS_SUCCESS;
+    for ( pair = 0; pair < TDR_NUM_PAIRS && status == NS_STATUS_SUCCESS; pair++)
+    {
+        status = TdrSweepPair( portHandle, tdrConfig, (EPL_TDR_PAIR_ENUM)pair, &winShadow,
+                               &tdrResults->pulsesSent, &tdrResults->pair[pair]);
+    }
+
+    EPLWriteReg( portHandle, PHY_PG2_TDR_CTRL, 0);
+
+    tdrResults->mdioAccesses = EPLGetMdioAccessCount( portHandle) - startMdio;
+    tdrResults->durationUs = OAIGetTimeStamp() - startTime;
+    return status;
+}
+
+//****************************************************************************
+EXPORT NS_UINT
+    EPLTdrTicksToCm (
+        IN NS_UINT timeTicks,
+        IN NS_UINT nvpPercent)
+
+//  Converts a TDR round trip time into a cable distance.
+//
+//  timeTicks
+//      Round trip time in 8ns TDR ticks.
+//  nvpPercent
+//      Nominal velocity of propagation of the cable as a percentage of the
+//      speed of light.
+//
+//  Returns
+//      One way distance in centimeters.
+//
+//  distance = ticks * 8ns * (nvp/100 * 29.9792cm/ns) / 2, which reduces to
+//  ticks * nvp * 299792 / 250000.
+//****************************************************************************
+{
+    return (NS_UINT)(((NS_UINT64)timeTicks * nvpPercent * 299792 + 125000) / 250000);
+}
@@ -0,0 +1,118 @@
+//****************************************************************************
+// epl_trace.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Contains sources for the register level trace ring. Only built when
+// EPL_TRACE_ENABLE is defined.
+//
+// Writers claim a slot with a single atomic increment of the ring head and
+// never block, so tracepoints can be hit from any task (or interrupt)
+// without extra locking. The sequence field of each record is written last;
+// a reader (debugger dump or tools/epl_tracedec.c) drops records whose
+// sequence does not match their ring position, which covers slots still
+// being written or already overwritten.
+//
+// The following functions are implemented in this module:
+//
+//      EPLTraceRecord
+//      EPLTraceReset
+//      EPLTraceGetRing
+//****************************************************************************
+
+#include "epl/epl.h"
+
+#ifdef EPL_TRACE_ENABLE
+
+EPL_TRACE_RING eplTraceRing = {
+    EPL_TRACE_MAGIC,
+    EPL_TRACE_RING_SIZE,
+    sizeof( EPL_TRACE_RECORD),
+    EPL_TRACE_TIME_UNIT_NS,
+    0,
+    { { 0 } }
+};
+
+//****************************************************************************
+void
+    EPLTraceRecord(
+        IN PEPL_PORT_HANDLE portHandle,
+        IN EPL_TRACE_TYPE_ENUM type,
+        IN NS_UINT registerIndex,
+        IN NS_UINT value,
+        IN NS_UINT callerId)
+
+//  Appends a record to the trace ring. Called through the EPL_TRACE_xxx
+//  tracepoint macros.
+//
+//  portHandle
+//      Port the record belongs to.
+//  type
+//      Record type.
+//  registerIndex
+//      MDIO register number as sent on the bus (register records only).
+//      The page is taken from the port's page cache.
+//  value
+//      Register data (register records only).
+//  callerId
+//      EPL_TRACE_ID_xxx of the API entry point.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+EPL_TRACE_RECORD *rec;
+NS_UINT idx;
+
+    idx = __sync_fetch_and_add( &eplTraceRing.head, 1);
+    rec = &eplTraceRing.records[idx & (EPL_TRACE_RING_SIZE - 1)];
+
+    rec->timeStamp = EPL_TRACE_TIMESTAMP();
+    rec->value = (NS_UINT16)value;
+    rec->type = (NS_UINT8)type;
+    rec->port = (NS_UINT8)portHandle->portMdioAddress;
+    rec->page = (NS_UINT8)(portHandle->pageCache ? portHandle->pageCache - 1 : 0xFF);
+    rec->reg = (NS_UINT8)(registerIndex & 0x1F);
+    rec->callerId = (NS_UINT16)callerId;
+    rec->reserved = 0;
+    __sync_synchronize();
+    rec->seq = (NS_UINT16)idx;
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLTraceReset(
+        void)
+
+//  Discards all records in the trace ring.
+//
+//  Returns
+//      Nothing
+//
+//  Must not be called while other tasks may be recording.
+//****************************************************************************
+{
+    memset( eplTraceRing.records, 0, sizeof( eplTraceRing.records));
+    eplTraceRing.head = 0;
+    return;
+}
+
+//****************************************************************************
+EXPORT PEPL_TRACE_RING
+    EPLTraceGetRing(
+        void)
+
+//  Returns the trace ring, e.g. to write it to a file for the host decoder.
+//  On targets without a file system the eplTraceRing symbol can be dumped
+//  with the debugger instead (gdb: dump binary value trace.bin eplTraceRing).
+//
+//  Returns
+//      Pointer to the trace ring.
+//****************************************************************************
+{
+    return &eplTraceRing;
+}
+
+#endif // EPL_TRACE_ENABLE
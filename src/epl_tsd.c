@@ -0,0 +1,691 @@
+//****************************************************************************
+// epl_tsd.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Contains sources for the timestamp delivery manager, which hands out the
+// transmit and receive timestamps of a port through one interface whichever
+// way the PHY delivers them:
+//
+//      Register    PTP_TXTS/PTP_RXTS reads, 5 and 7 MDIO transactions per
+//                  timestamp. No frame overhead, but at 2.5MHz MDC a few
+//                  thousand timestamps a second fill the bus.
+//      Insert      Receive timestamps written into the frame (RXOPT_TS_INSERT),
+//                  no MDIO and no extra frames; transmit timestamps are still
+//                  read from PTP_TXTS. The frame must have room for them.
+//      PSF         PHY Status Frames, no MDIO, one extra frame for the MAC
+//                  driver per group of timestamps.
+//
+// The port is configured by the application as usual (PTPSetReceiveConfig()
+// with the insertion offsets, PTPSetPhyStatusFrameConfig() with the
+// addresses) for every mode listed in cfg.modeMask. The manager switches
+// modes by changing only the PSF_CFG0 TXTS_EN/RXTS_EN and RXCFG3 TS_INSERT
+// bits, a read and a write each.
+//
+// EPLTsdService() measures, per window, the timestamps taken and the MDIO
+// transactions of the port, and projects the MDIO utilization of each mode
+// from them: the transactions not spent on timestamps plus the register
+// reads that mode would need. It stays in the current mode until that is
+// projected above cfg.highPermille, and moves back to a preferred mode
+// (register, then insert) once that is projected below cfg.lowPermille.
+//
+// No timestamp is lost on a switch. Register timestamps already queued are
+// read at once. Status Frames and frames with inserted timestamps that are
+// in flight keep being accepted for cfg.drainUs; transmit timestamps read
+// from the registers meanwhile are held back so they are still taken in
+// transmit order.
+//
+// The following functions are implemented in this module:
+//
+//      EPLTsdGetDefaultConfig
+//      EPLTsdInit
+//      EPLTsdProcessFrame
+//      EPLTsdGetTxTimestamp
+//      EPLTsdGetRxTimestamp
+//      EPLTsdSetMode
+//      EPLTsdService
+//****************************************************************************
+
+#include "epl/epl.h"
+
+// MDIO transactions per transmit and receive timestamp of each mode
+static const NS_UINT tsdTxOps[TSD_NUM_MODES] = { TSD_TX_REG_OPS, TSD_TX_REG_OPS, 0 };
+static const NS_UINT tsdRxOps[TSD_NUM_MODES] = { TSD_RX_REG_OPS, 0, 0 };
+
+//****************************************************************************
+static void
+    TsdQueueTx (
+        IN OUT PEPL_TSD tsd,
+        IN PPTP_TIME time,
+        IN NS_BOOL psf)
+//  Adds a transmit timestamp in time order. A full queue drops its oldest.
+//****************************************************************************
+{
+NS_UINT x;
+
+    if ( tsd->txCount == TSD_TX_QUEUE)
+    {
+        memmove( &tsd->txQueue[0], &tsd->txQueue[1], (TSD_TX_QUEUE - 1) * sizeof( EPL_TSD_TS));
+        tsd->txCount--;
+        tsd->discarded++;
+    }
+    for ( x = tsd->txCount; x && PTPTimeCompare( &tsd->txQueue[x - 1].time, time) > 0; x--)
+        tsd->txQueue[x] = tsd->txQueue[x - 1];
+    tsd->txQueue[x].time = *time;
+    tsd->txQueue[x].psf = psf;
+    tsd->txCount++;
+    return;
+}
+
+//****************************************************************************
+static void
+    TsdQueueRx (
+        IN OUT PEPL_TSD tsd,
+        IN PPTP_TIME time,
+        IN NS_UINT sequenceId,
+        IN NS_UINT messageType,
+        IN NS_UINT hash,
+        IN NS_BOOL psf)
+//  Adds a receive timestamp. A full queue drops its oldest.
+//****************************************************************************
+{
+EPL_TSD_TS *entry;
+
+    if ( tsd->rxCount == TSD_RX_QUEUE)
+    {
+        memmove( &tsd->rxQueue[0], &tsd->rxQueue[1], (TSD_RX_QUEUE - 1) * sizeof( EPL_TSD_TS));
+        tsd->rxCount--;
+        tsd->discarded++;
+    }
+    entry = &tsd->rxQueue[tsd->rxCount++];
+    entry->time = *time;
+    entry->sequenceId = (NS_UINT16)sequenceId;
+    entry->typeHash = (NS_UINT16)(((messageType & 0x0F) << 12) | (hash & 0x0FFF));
+    entry->psf = psf;
+    return;
+}
+
+//****************************************************************************
+static NS_STATUS
+    TsdTakeRx (
+        IN OUT PEPL_TSD tsd,
+        IN NS_UINT sequenceId,
+        IN NS_UINT typeHash,
+        OUT PPTP_TIME timestamp)
+//  Takes the queued receive timestamp of a message.
+//****************************************************************************
+{
+NS_UINT x;
+
+    for ( x = 0; x < tsd->rxCount; x++)
+    {
+        if ( tsd->rxQueue[x].sequenceId == sequenceId && tsd->rxQueue[x].typeHash == typeHash)
+        {
+            *timestamp = tsd->rxQueue[x].time;
+            tsd->rxCount--;
+            memmove( &tsd->rxQueue[x], &tsd->rxQueue[x + 1], (tsd->rxCount - x) * sizeof( EPL_TSD_TS));
+            tsd->rxTimestamps++;
+            tsd->windowRx++;
+            return NS_STATUS_SUCCESS;
+        }
+    }
+    return NS_STATUS_FAILURE;
+}
+
+//****************************************************************************
+static NS_STATUS
+    TsdFullTime (
+        IN OUT PEPL_TSD tsd,
+        IN NS_UINT32 seconds,
+        IN NS_UINT secondsBits,
+        IN NS_UINT32 nanoSeconds,
+        OUT PPTP_TIME time)
+//  Extends a timestamp to 48-bit seconds. Register reads and Status Frames
+//  make their timestamp the port's reference, inserted timestamps only use
+//  it; without one (e.g. after EPLCheckpointWarmStart()) the clock is read
+//  once to set it. A timestamp that still cannot be extended is counted
+//  and must be dropped.
+//****************************************************************************
+{
+PEPL_PORT_HANDLE portHandle = tsd->portHandle;
+NS_UINT32 clockSeconds, clockNanoSeconds;
+NS_UINT64 fullSeconds;
+
+    if ( PTPExtendTimestamp( portHandle, seconds, secondsBits, nanoSeconds, &fullSeconds) !=
+         NS_STATUS_SUCCESS)
+    {
+        PTPClockReadCurrent( portHandle, &clockSeconds, &clockNanoSeconds);
+        if ( PTPExtendTimestamp( portHandle, seconds, secondsBits, nanoSeconds, &fullSeconds) !=
+             NS_STATUS_SUCCESS)
+        {
+            tsd->unextended++;
+            return NS_STATUS_FAILURE;
+        }
+    }
+    time->seconds = (NS_SINT64)fullSeconds;
+    time->nanoSeconds = (NS_SINT32)nanoSeconds;
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+static void
+    TsdPollRegisters (
+        IN OUT PEPL_TSD tsd)
+//  Reads every timestamp queued in PTP_TXTS and PTP_RXTS. A transmit queue
+//  held behind a Status Frame drain and without room for a full PTP_TXTS
+//  ends the drain instead of dropping its oldest.
+//****************************************************************************
+{
+PEPL_PORT_HANDLE portHandle = tsd->portHandle;
+NS_UINT32 seconds, nanoSeconds, mdio;
+NS_UINT events, overflow, sequenceId, hash;
+NS_UINT8 messageType;
+PTP_TIME time;
+
+    if ( tsd->psfDraining && tsd->txCount > TSD_TX_QUEUE - TSD_PHY_TX_QUEUE &&
+         !tsd->txQueue[0].psf)
+    {
+        tsd->psfDraining = FALSE;
+        tsd->drainsCut++;
+    }
+    mdio = portHandle->mdioAccessCount;
+    for ( ;;)
+    {
+        events = PTPCheckForEvents( portHandle);
+        if ( !(events & (PTPEVT_TRANSMIT_TIMESTAMP_BIT | PTPEVT_RECEIVE_TIMESTAMP_BIT)))
+            break;
+
+        if ( events & PTPEVT_TRANSMIT_TIMESTAMP_BIT)
+        {
+            PTPGetTransmitTimestamp( portHandle, &seconds, &nanoSeconds, &overflow);
+            tsd->overflows += overflow;
+            if ( TsdFullTime( tsd, seconds, 32, nanoSeconds, &time) == NS_STATUS_SUCCESS)
+                TsdQueueTx( tsd, &time, FALSE);
+        }
+        if ( events & PTPEVT_RECEIVE_TIMESTAMP_BIT)
+        {
+            PTPGetReceiveTimestamp( portHandle, &seconds, &nanoSeconds, &overflow,
+                                    &sequenceId, &messageType, &hash);
+            tsd->overflows += overflow;
+            if ( TsdFullTime( tsd, seconds, 32, nanoSeconds, &time) == NS_STATUS_SUCCESS)
+                TsdQueueRx( tsd, &time, sequenceId, messageType, hash, FALSE);
+        }
+    }
+    mdio = (portHandle->mdioAccessCount - mdio) & 0xFFFFFFFF;
+    tsd->windowTsMdio += mdio;
+    tsd->tsMdio += mdio;
+    return;
+}
+
+//****************************************************************************
+static NS_STATUS
+    TsdGetInserted (
+        IN OUT PEPL_TSD tsd,
+        IN OUT NS_UINT8 *ptpMessage,
+        OUT PPTP_TIME timestamp)
+//  Takes the timestamp inserted into a received message, at the locations
+//  set up by PTPSetReceiveConfig(). All zero fields mean none was inserted.
+//  The fields are cleared even if the timestamp has to be dropped.
+//****************************************************************************
+{
+PEPL_PORT_HANDLE portHandle = tsd->portHandle;
+NS_UINT8 *nanoField, *secField;
+NS_UINT32 nanoSeconds = 0, seconds = 0;
+NS_UINT x;
+
+    nanoField = &ptpMessage[portHandle->rxTsNanoField];
+    secField = &ptpMessage[portHandle->rxTsSecField];
+    for ( x = 0; x < 4; x++)
+        nanoSeconds |= (NS_UINT32)nanoField[x] << (8 * x);
+    for ( x = 0; x < portHandle->rxTsSecBytes; x++)
+        seconds |= (NS_UINT32)secField[x] << (8 * x);
+    if ( !nanoSeconds && !seconds)
+        return NS_STATUS_FAILURE;
+
+    memset( nanoField, 0, 4);
+    memset( secField, 0, portHandle->rxTsSecBytes);
+    return TsdFullTime( tsd, seconds, portHandle->rxTsSecBytes * 8, nanoSeconds, timestamp);
+}
+
+//****************************************************************************
+static void
+    TsdCheckDrain (
+        IN OUT PEPL_TSD tsd,
+        IN NS_UINT32 now)
+//  Ends the drain period of the previous mode.
+//****************************************************************************
+{
+    if ( (tsd->psfDraining || tsd->insertDraining) &&
+         ((now - tsd->switchTime) & 0xFFFFFFFF) >= tsd->cfg.drainUs)
+    {
+        tsd->psfDraining = tsd->insertDraining = FALSE;
+    }
+    return;
+}
+
+//****************************************************************************
+static void
+    TsdProgram (
+        IN OUT PEPL_TSD tsd,
+        IN EPL_TSD_MODE_ENUM mode)
+//  Sets the PSF and insertion enables for a mode. Registers of modes not in
+//  cfg.modeMask are left alone.
+//****************************************************************************
+{
+PEPL_PORT_HANDLE portHandle = tsd->portHandle;
+NS_UINT reg, newReg;
+
+    if ( tsd->cfg.modeMask & TSD_MODE_BIT( TSD_MODE_PSF))
+    {
+        reg = EPLReadReg( portHandle, PHY_PG5_PSF_CFG0);
+        newReg = reg & ~(P640_PKT_TXTS_EN | P640_PKT_RXTS_EN);
+        portHandle->psfConfigOptions &= ~(STSOPT_TXTS_EN | STSOPT_RXTS_EN);
+        if ( mode == TSD_MODE_PSF)
+        {
+            newReg |= P640_PKT_TXTS_EN | P640_PKT_RXTS_EN;
+            portHandle->psfConfigOptions |= STSOPT_TXTS_EN | STSOPT_RXTS_EN;
+        }
+        if ( newReg != reg)
+            EPLWriteReg( portHandle, PHY_PG5_PSF_CFG0, newReg);
+    }
+
+    if ( tsd->cfg.modeMask & TSD_MODE_BIT( TSD_MODE_INSERT))
+    {
+        reg = EPLReadReg( portHandle, PHY_PG5_PTP_RXCFG3);
+        newReg = reg & ~P640_TS_INSERT;
+        portHandle->rxConfigOptions &= ~RXOPT_TS_INSERT;
+        if ( mode == TSD_MODE_INSERT)
+        {
+            newReg |= P640_TS_INSERT;
+            portHandle->rxConfigOptions |= RXOPT_TS_INSERT;
+        }
+        if ( newReg != reg)
+            EPLWriteReg( portHandle, PHY_PG5_PTP_RXCFG3, newReg);
+    }
+    tsd->mode = mode;
+    return;
+}
+
+//****************************************************************************
+static void
+    TsdSwitch (
+        IN OUT PEPL_TSD tsd,
+        IN EPL_TSD_MODE_ENUM mode)
+//  Switches to another mode and takes over what the previous one still has
+//  to deliver.
+//****************************************************************************
+{
+EPL_TSD_MODE_ENUM oldMode = tsd->mode;
+
+    TsdProgram( tsd, mode);
+
+    // New timestamps now go elsewhere; the register queues hold only older
+    // ones. Frames of the old mode may still be on their way.
+    TsdPollRegisters( tsd);
+    if ( oldMode == TSD_MODE_PSF)
+        tsd->psfDraining = TRUE;
+    if ( oldMode == TSD_MODE_INSERT)
+        tsd->insertDraining = TRUE;
+    tsd->switchTime = OAIGetTimeStamp();
+    tsd->switches++;
+    return;
+}
+
+//****************************************************************************
+static EPL_TSD_MODE_ENUM
+    TsdSelect (
+        IN PEPL_TSD tsd)
+//  Returns the mode to use given the projected utilizations.
+//****************************************************************************
+{
+NS_UINT mode, best;
+const NS_UINT *projected = tsd->projectedPermille;
+
+    // Back to a preferred mode with room to spare
+    for ( mode = 0; mode < (NS_UINT)tsd->mode; mode++)
+    {
+        if ( (tsd->cfg.modeMask & TSD_MODE_BIT( mode)) && projected[mode] < tsd->cfg.lowPermille)
+            return (EPL_TSD_MODE_ENUM)mode;
+    }
+    if ( projected[tsd->mode] <= tsd->cfg.highPermille)
+        return tsd->mode;
+
+    // Overloaded: the most preferred mode that fits, else the cheapest
+    best = tsd->mode;
+    for ( mode = 0; mode < TSD_NUM_MODES; mode++)
+    {
+        if ( !(tsd->cfg.modeMask & TSD_MODE_BIT( mode)))
+            continue;
+        if ( projected[mode] <= tsd->cfg.highPermille)
+            return (EPL_TSD_MODE_ENUM)mode;
+        if ( projected[mode] < projected[best])
+            best = mode;
+    }
+    return (EPL_TSD_MODE_ENUM)best;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLTsdGetDefaultConfig (
+        IN OUT PEPL_TSD_CFG tsdConfig)
+
+//  Returns a configuration for register delivery only, with automatic
+//  selection, a 1s window and switching at 25% / 10% of the nominal MDIO
+//  capacity. Add the modes the port is set up for to modeMask.
+//
+//  tsdConfig
+//      Configuration structure to fill in.
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    tsdConfig->modeMask = TSD_MODE_BIT( TSD_MODE_REGISTER);
+    tsdConfig->initialMode = TSD_MODE_REGISTER;
+    tsdConfig->autoSelect = TRUE;
+    tsdConfig->windowUs = 1000000;
+    tsdConfig->mdioOpsPerSec = LQ_DEFAULT_MDIO_OPS_PER_SEC;
+    tsdConfig->highPermille = 250;
+    tsdConfig->lowPermille = 100;
+    tsdConfig->drainUs = 10000;
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLTsdInit (
+        IN OUT PEPL_TSD tsd,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN PEPL_TSD_CFG tsdConfig,
+        IN EPL_TSD_CALLBACK callback,
+        IN void *context)
+
+//  Initializes the timestamp delivery manager of a port, programs the
+//  initial mode and reads the clock, so the truncated seconds of inserted
+//  timestamps can be extended from the first message on.
+//
+//  tsd
+//      Caller allocated manager object, one per port.
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort
+//      function. Timestamping, and the PSF and insertion parameters of the
+//      modes in modeMask, must already be configured.
+//  tsdConfig
+//      Configuration, see EPLTsdGetDefaultConfig(). Copied.
+//  callback
+//      Called from EPLTsdProcessFrame() with the Status Frame messages other
+//      than timestamps (trigger, event, error, register read), or NULL.
+//  context
+//      Passed to the callback.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM if the configuration is
+//      not usable.
+//****************************************************************************
+{
+NS_UINT32 seconds, nanoSeconds;
+
+    if ( tsdConfig->initialMode >= TSD_NUM_MODES ||
+         !(tsdConfig->modeMask & TSD_MODE_BIT( tsdConfig->initialMode)) ||
+         (tsdConfig->modeMask & ~(TSD_MODE_BIT( TSD_NUM_MODES) - 1)) ||
+         !tsdConfig->windowUs || !tsdConfig->mdioOpsPerSec ||
+         tsdConfig->lowPermille > tsdConfig->highPermille)
+    {
+        return NS_STATUS_INVALID_PARM;
+    }
+
+    memset( tsd, 0, sizeof( EPL_TSD));
+    tsd->portHandle = portHandle;
+    tsd->cfg = *tsdConfig;
+    tsd->callback = callback;
+    tsd->context = context;
+    PTPClockReadCurrent( portHandle, &seconds, &nanoSeconds);
+    TsdProgram( tsd, tsdConfig->initialMode);
+
+    tsd->windowStart = tsd->switchTime = OAIGetTimeStamp();
+    tsd->windowMdio = portHandle->mdioAccessCount;
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLTsdProcessFrame (
+        IN OUT PEPL_TSD tsd,
+        IN NS_UINT8 *frameBuffer,
+        IN NS_UINT frameLength)
+
+//  Takes the timestamps of a PHY Status Frame. Every received frame can be
+//  passed; Status Frames are accepted in any mode.
+//
+//  tsd
+//      Manager initialized with EPLTsdInit().
+//  frameBuffer
+//      Received frame, from the start of the Ethernet header.
+//  frameLength
+//      Frame length.
+//
+//  Returns
+//      TRUE if the frame was a Status Frame and need not be passed on.
+//****************************************************************************
+{
+PEPL_PORT_HANDLE portHandle = tsd->portHandle;
+NS_UINT8 *msg, *next;
+PHYMSG_MESSAGE_TYPE_ENUM messageType;
+PHYMSG_MESSAGE message;
+PTP_TIME time;
+
+    msg = IsPhyStatusFrame( portHandle, frameBuffer, (NS_UINT16)frameLength);
+    if ( !msg)
+        return FALSE;
+    tsd->psfFrames++;
+
+    while ( (next = GetNextPhyMessage( portHandle, msg, &messageType, &message)) != NULL)
+    {
+        switch ( messageType)
+        {
+        case PHYMSG_STATUS_TX:
+            tsd->overflows += message.TxStatus.txOverflowCount;
+            if ( TsdFullTime( tsd, message.TxStatus.txTimestampSecs, 32,
+                              message.TxStatus.txTimestampNanoSecs, &time) == NS_STATUS_SUCCESS)
+                TsdQueueTx( tsd, &time, TRUE);
+            break;
+
+        case PHYMSG_STATUS_RX:
+            tsd->overflows += message.RxStatus.rxOverflowCount;
+            if ( TsdFullTime( tsd, message.RxStatus.rxTimestampSecs, 32,
+                              message.RxStatus.rxTimestampNanoSecs, &time) == NS_STATUS_SUCCESS)
+            {
+                TsdQueueRx( tsd, &time, message.RxStatus.sequenceId,
+                            message.RxStatus.messageType, message.RxStatus.sourceHash, TRUE);
+            }
+            break;
+
+        default:
+            if ( tsd->callback)
+                tsd->callback( portHandle, messageType, &message, tsd->context);
+            break;
+        }
+        msg = next;
+    }
+    return TRUE;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLTsdGetTxTimestamp (
+        IN OUT PEPL_TSD tsd,
+        OUT PPTP_TIME timestamp)
+
+//  Returns the next transmit timestamp, in transmit order.
+//
+//  tsd
+//      Manager initialized with EPLTsdInit().
+//  timestamp
+//      Set on return to the timestamp, 48-bit seconds. Like
+//      PTPGetTransmitTimestamp(), not corrected for the transmit latency.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_FAILURE if no timestamp is available
+//      yet. Status Frames must be passed to EPLTsdProcessFrame() first.
+//
+//  Reads the registers (5 MDIO transactions per timestamp, 1 if there is
+//  none) in the register and insert modes.
+//****************************************************************************
+{
+    // While the queue is held the registers must still be emptied
+    TsdCheckDrain( tsd, OAIGetTimeStamp());
+    if ( tsd->mode != TSD_MODE_PSF && (!tsd->txCount || tsd->psfDraining))
+        TsdPollRegisters( tsd);
+
+    // Status Frames still in flight carry older timestamps than the
+    // registers
+    if ( !tsd->txCount || (tsd->psfDraining && !tsd->txQueue[0].psf))
+        return NS_STATUS_FAILURE;
+
+    *timestamp = tsd->txQueue[0].time;
+    memmove( &tsd->txQueue[0], &tsd->txQueue[1], (tsd->txCount - 1) * sizeof( EPL_TSD_TS));
+    tsd->txCount--;
+    tsd->txTimestamps++;
+    tsd->windowTx++;
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLTsdGetRxTimestamp (
+        IN OUT PEPL_TSD tsd,
+        IN OUT NS_UINT8 *ptpMessage,
+        OUT PPTP_TIME timestamp)
+
+//  Returns the receive timestamp of a PTP event message.
+//
+//  tsd
+//      Manager initialized with EPLTsdInit().
+//  ptpMessage
+//      Received message, from the start of the PTP header. An inserted
+//      timestamp is cleared from it.
+//  timestamp
+//      Set on return to the timestamp, 48-bit seconds. Like
+//      PTPGetReceiveTimestamp(), not corrected for the receive latency.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_FAILURE if the timestamp is not
+//      available (yet). A Status Frame follows the message it timestamps;
+//      hold the message and retry after passing the next received frames to
+//      EPLTsdProcessFrame().
+//
+//  Matches on messageType, sequenceId and the source port identity hash.
+//  Reads the registers (7 MDIO transactions per timestamp) in register mode
+//  only.
+//****************************************************************************
+{
+NS_UINT typeHash, sequenceId;
+
+    if ( tsd->rxCount || tsd->mode == TSD_MODE_REGISTER)
+    {
+        typeHash = ((ptpMessage[PTP_HDR_MSG_TYPE_OFFSET] & 0x0F) << 12) |
+                   PTPCalcSourceIdHash( &ptpMessage[PTP_HDR_SOURCE_PORT_ID_OFFSET]);
+        sequenceId = (ptpMessage[PTP_HDR_SEQUENCE_ID_OFFSET] << 8) |
+                     ptpMessage[PTP_HDR_SEQUENCE_ID_OFFSET + 1];
+        if ( TsdTakeRx( tsd, sequenceId, typeHash, timestamp) == NS_STATUS_SUCCESS)
+            return NS_STATUS_SUCCESS;
+        if ( tsd->mode == TSD_MODE_REGISTER)
+        {
+            TsdPollRegisters( tsd);
+            if ( TsdTakeRx( tsd, sequenceId, typeHash, timestamp) == NS_STATUS_SUCCESS)
+                return NS_STATUS_SUCCESS;
+        }
+    }
+
+    TsdCheckDrain( tsd, OAIGetTimeStamp());
+    if ( (tsd->mode == TSD_MODE_INSERT || tsd->insertDraining) &&
+         TsdGetInserted( tsd, ptpMessage, timestamp) == NS_STATUS_SUCCESS)
+    {
+        tsd->rxTimestamps++;
+        tsd->windowRx++;
+        return NS_STATUS_SUCCESS;
+    }
+    return NS_STATUS_FAILURE;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLTsdSetMode (
+        IN OUT PEPL_TSD tsd,
+        IN EPL_TSD_MODE_ENUM mode)
+
+//  Switches to a delivery mode, e.g. with cfg.autoSelect off.
+//
+//  tsd
+//      Manager initialized with EPLTsdInit().
+//  mode
+//      Mode to use, one of cfg.modeMask.
+//
+//  Returns
+//      NS_STATUS_SUCCESS, or NS_STATUS_INVALID_PARM if the mode is not
+//      enabled.
+//****************************************************************************
+{
+    if ( mode >= TSD_NUM_MODES || !(tsd->cfg.modeMask & TSD_MODE_BIT( mode)))
+        return NS_STATUS_INVALID_PARM;
+    if ( mode != tsd->mode)
+        TsdSwitch( tsd, mode);
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT EPL_TSD_MODE_ENUM
+    EPLTsdService (
+        IN OUT PEPL_TSD tsd)
+
+//  Ends drain periods and, at the end of each measurement window, updates
+//  the rates and projected utilizations and selects the mode.
+//
+//  tsd
+//      Manager initialized with EPLTsdInit().
+//
+//  Returns
+//      The mode in use.
+//
+//  Call regularly, e.g. from the PTP task's main loop; it does no MDIO
+//  access unless the mode changes.
+//****************************************************************************
+{
+NS_UINT32 now, elapsed, mdio;
+NS_UINT64 other, ops, scale;
+NS_UINT mode;
+EPL_TSD_MODE_ENUM target;
+
+    now = OAIGetTimeStamp();
+    TsdCheckDrain( tsd, now);
+    elapsed = (now - tsd->windowStart) & 0xFFFFFFFF;
+    if ( elapsed < tsd->cfg.windowUs)
+        return tsd->mode;
+
+    mdio = (tsd->portHandle->mdioAccessCount - tsd->windowMdio) & 0xFFFFFFFF;
+    tsd->txPerSec = (NS_UINT32)((NS_UINT64)tsd->windowTx * 1000000 / elapsed);
+    tsd->rxPerSec = (NS_UINT32)((NS_UINT64)tsd->windowRx * 1000000 / elapsed);
+
+    // Utilization = ops per second / capacity, in permille
+    scale = (NS_UINT64)elapsed * tsd->cfg.mdioOpsPerSec;
+    tsd->mdioPermille = (NS_UINT)((NS_UINT64)mdio * 1000000000 / scale);
+    other = (mdio > tsd->windowTsMdio) ? mdio - tsd->windowTsMdio : 0;
+    for ( mode = 0; mode < TSD_NUM_MODES; mode++)
+    {
+        ops = other + (NS_UINT64)tsd->windowTx * tsdTxOps[mode] + (NS_UINT64)tsd->windowRx * tsdRxOps[mode];
+        tsd->projectedPermille[mode] = (NS_UINT)(ops * 1000000000 / scale);
+    }
+
+    if ( tsd->cfg.autoSelect)
+    {
+        target = TsdSelect( tsd);
+        if ( target != tsd->mode)
+            TsdSwitch( tsd, target);
+    }
+
+    tsd->windowStart = now;
+    tsd->windowMdio = tsd->portHandle->mdioAccessCount;
+    tsd->windowTx = tsd->windowRx = tsd->windowTsMdio = 0;
+    return tsd->mode;
+}
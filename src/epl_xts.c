@@ -0,0 +1,399 @@
+//****************************************************************************
+// epl_xts.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Contains sources for cross-timestamping between the PHY IEEE 1588 clock
+// and a system (MCU or host) clock.
+//
+// Reading the PHY clock with PTPClockReadCurrent() leaves an uncertainty of
+// several MDIO transactions. Instead, the system toggles a GPIO wired to a
+// PHY event input and records its own clock at the edge; the PHY timestamps
+// the same edge in hardware. Each edge gives an exact (system, PHC) pair
+// at the cost of one PTPGetEvent().
+//
+// A least squares line is fitted through the last XTS_WINDOW pairs. The
+// mapping is expressed around the centroid of the pairs, where it is most
+// accurate:
+//
+//      phc = phcRef + (sys - sysRef) * (1 + rate / 2^32)
+//
+// All arithmetic is integer. The fit is recomputed in O(XTS_WINDOW) for
+// every pair added.
+//
+// The following functions are implemented in this module:
+//
+//      EPLXtsInit
+//      EPLXtsCapture
+//      EPLXtsAddPair
+//      EPLXtsGetMapping
+//      EPLXtsSysToPhc
+//      EPLXtsPhcToSys
+//****************************************************************************
+
+#include "epl/epl.h"
+
+//****************************************************************************
+static NS_SINT64
+    XtsScale (
+        IN NS_SINT64 delta,
+        IN NS_SINT64 rate)
+//  Returns delta * rate / 2^32 without overflowing for the deltas and rates
+//  seen in practice (deltas of days, rates of up to 2^22 or 1000ppm).
+//****************************************************************************
+{
+    return (delta / 65536) * rate / 65536 + (delta % 65536) * rate / 4294967296LL;
+}
+
+//****************************************************************************
+static NS_SINT64
+    XtsDivShift (
+        IN NS_SINT64 num,
+        IN NS_SINT64 den,
+        IN NS_UINT shift)
+//  Returns (num * 2^shift) / den by long division, for num * 2^shift too
+//  large for 64 bits. den must be positive.
+//****************************************************************************
+{
+NS_UINT64 quotient, remainder;
+NS_BOOL negative;
+
+    negative = (num < 0);
+    quotient = (NS_UINT64)(negative ? -num : num) / (NS_UINT64)den;
+    remainder = (NS_UINT64)(negative ? -num : num) % (NS_UINT64)den;
+    while ( shift--)
+    {
+        quotient <<= 1;
+        remainder <<= 1;
+        if ( remainder >= (NS_UINT64)den)
+        {
+            quotient |= 1;
+            remainder -= (NS_UINT64)den;
+        }
+    }
+    return negative ? -(NS_SINT64)quotient : (NS_SINT64)quotient;
+}
+
+//****************************************************************************
+static NS_UINT32
+    XtsSqrt (
+        IN NS_UINT64 value)
+//  Returns the integer square root of value.
+//****************************************************************************
+{
+NS_UINT64 root, bit;
+
+    root = 0;
+    for ( bit = (NS_UINT64)1 << 62; bit > value; bit >>= 2)
+        ;
+    while ( bit)
+    {
+        if ( value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (NS_UINT32)root;
+}
+
+//****************************************************************************
+static void
+    XtsFit (
+        IN OUT PEPL_XTS xts)
+//  Fits the mapping to the pairs in the window.
+//****************************************************************************
+{
+EPL_XTS_MAPPING *map = &xts->mapping;
+EPL_XTS_PAIR *first, *pair;
+NS_SINT64 dx[XTS_WINDOW], dy[XTS_WINDOW];
+NS_SINT64 sumDx, sumDy, meanDx, meanDy, scale, cx, var, cov, residual;
+NS_UINT64 sumSquares;
+NS_UINT x, n, shift;
+
+    n = xts->count;
+    first = &xts->pair[(xts->head + XTS_WINDOW - n) % XTS_WINDOW];
+
+    // Work relative to the oldest pair; dy is the PHC - system divergence
+    sumDx = sumDy = 0;
+    for ( x = 0; x < n; x++)
+    {
+        pair = &xts->pair[(xts->head + XTS_WINDOW - n + x) % XTS_WINDOW];
+        dx[x] = (NS_SINT64)(pair->sysTime - first->sysTime);
+        dy[x] = (NS_SINT64)(pair->phcTime - first->phcTime) - dx[x];
+        sumDx += dx[x];
+        sumDy += dy[x];
+    }
+    meanDx = sumDx / (NS_SINT64)n;
+    meanDy = sumDy / (NS_SINT64)n;
+
+    // Scale the system deltas to 24 bits to keep the sums in 64 bits
+    for ( shift = 0; (dx[n - 1] >> shift) > (1 << 24); shift++)
+        ;
+    scale = (NS_SINT64)1 << shift;
+
+    var = cov = 0;
+    for ( x = 0; x < n; x++)
+    {
+        cx = (dx[x] - meanDx) / scale;
+        var += cx * cx;
+        cov += cx * (dy[x] - meanDy);
+    }
+    map->rate = (var > 0 && shift <= 32) ? XtsDivShift( cov, var, 32 - shift) : 0;
+
+    map->sysRef = first->sysTime + (NS_UINT64)meanDx;
+    map->phcRef = first->phcTime + (NS_UINT64)(meanDx + meanDy);
+    map->ratePpb = (NS_SINT32)(map->rate * 1000000000 / 4294967296LL);
+    map->numPairs = n;
+
+    sumSquares = 0;
+    map->residualMaxNs = 0;
+    for ( x = 0; x < n; x++)
+    {
+        residual = dy[x] - meanDy - XtsScale( dx[x] - meanDx, map->rate);
+        if ( residual < 0)
+            residual = -residual;
+        if ( residual > (NS_SINT64)map->residualMaxNs)
+            map->residualMaxNs = (NS_UINT32)residual;
+        sumSquares += (NS_UINT64)(residual * residual);
+    }
+    map->residualRmsNs = XtsSqrt( sumSquares / n);
+
+    // Standard error of the fitted line at its centroid
+    map->errorNs = XtsSqrt( sumSquares / ((n - 2) * n));
+    return;
+}
+
+//****************************************************************************
+EXPORT void
+    EPLXtsInit (
+        IN OUT PEPL_XTS xts,
+        IN PEPL_PORT_HANDLE portHandle,
+        IN NS_UINT event,
+        IN NS_UINT gpio)
+
+//  Initializes a cross-timestamper and enables the PHY event used.
+//
+//  xts
+//      Caller allocated cross-timestamp object.
+//  portHandle
+//      Handle that represents a port. This is obtained using the EPLEnumPort
+//      function.
+//  event
+//      PHY event to use, 0 - 7. It should not be shared with other users.
+//  gpio
+//      PHY GPIO wired to the system GPIO, 1 - 12. Both edges are captured,
+//      so every toggle of the system GPIO gives a pair. If 0, the event is
+//      not configured (pairs are supplied with EPLXtsAddPair()).
+//
+//  Returns
+//      Nothing
+//****************************************************************************
+{
+    memset( xts, 0, sizeof( EPL_XTS));
+    xts->portHandle = portHandle;
+    xts->event = event;
+    if ( gpio)
+        PTPSetEventConfig( portHandle, event, TRUE, TRUE, FALSE, gpio);
+    return;
+}
+
+//****************************************************************************
+EXPORT NS_STATUS
+    EPLXtsCapture (
+        IN OUT PEPL_XTS xts,
+        IN NS_UINT64 sysTime)
+
+//  Reads the PHY timestamp of the GPIO edge just generated and adds the
+//  (system, PHC) pair.
+//
+//  xts
+//      Cross-timestamper initialized with EPLXtsInit().
+//  sysTime
+//      System time of the edge, in nanoseconds. Any latency between reading
+//      the system clock and the pin changing should be compensated by the
+//      caller.
+//
+//  Returns
+//      NS_STATUS_SUCCESS if the pair was added.
+//      NS_STATUS_FAILURE if the PHY has not captured the edge.
+//      NS_STATUS_ABORTED if PHY events were lost, so the captured timestamp
+//      cannot be trusted to belong to this edge.
+//
+//  Costs a single PTPGetEvent() (six MDIO transactions).
+//****************************************************************************
+{
+NS_UINT eventBits, riseFlags, eventsMissed;
+NS_UINT32 seconds, nanoSeconds;
+
+    if ( !PTPGetEvent( xts->portHandle, &eventBits, &riseFlags, &seconds, &nanoSeconds,
+                       &eventsMissed) ||
+         !(eventBits & (1 << xts->event)))
+    {
+        return NS_STATUS_FAILURE;
+    }
+    if ( eventsMissed)
+        return NS_STATUS_ABORTED;
+
+    EPLXtsAddPair( xts, sysTime, seconds, nanoSeconds);
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLXtsAddPair (
+        IN OUT PEPL_XTS xts,
+        IN NS_UINT64 sysTime,
+        IN NS_UINT32 phcSeconds,
+        IN NS_UINT32 phcNanoSeconds)
+
+//  Adds a (system, PHC) timestamp pair of the same edge, e.g. with the PHY
+//  timestamp taken from an event PHY Status Frame.
+//
+//  xts
+//      Cross-timestamper initialized with EPLXtsInit().
+//  sysTime
+//      System time of the edge in nanoseconds. Must increase from pair to
+//      pair.
+//  phcSeconds, phcNanoSeconds
+//      PHY event timestamp of the edge.
+//
+//  Returns
+//      TRUE if the mapping was updated (at least 3 pairs are needed), FALSE
+//      otherwise.
+//
+//  A pair that disagrees with the current mapping by more than
+//  XTS_RESTART_NS means a clock was stepped; the window is restarted.
+//****************************************************************************
+{
+EPL_XTS_PAIR *pair;
+NS_UINT64 phcTime;
+NS_SINT64 error;
+NS_UINT32 predSeconds, predNanoSeconds;
+
+    if ( xts->count && sysTime <= xts->pair[(xts->head + XTS_WINDOW - 1) % XTS_WINDOW].sysTime)
+        return FALSE;
+
+    phcTime = (NS_UINT64)phcSeconds * 1000000000 + phcNanoSeconds;
+    if ( EPLXtsSysToPhc( xts, sysTime, &predSeconds, &predNanoSeconds))
+    {
+        error = (NS_SINT64)(phcTime - ((NS_UINT64)predSeconds * 1000000000 + predNanoSeconds));
+        if ( error > XTS_RESTART_NS || error < -XTS_RESTART_NS)
+        {
+            xts->count = 0;
+            xts->haveMapping = FALSE;
+            xts->restarts++;
+        }
+    }
+
+    pair = &xts->pair[xts->head];
+    pair->sysTime = sysTime;
+    pair->phcTime = phcTime;
+    xts->head = (xts->head + 1) % XTS_WINDOW;
+    if ( xts->count < XTS_WINDOW)
+        xts->count++;
+    if ( xts->count < 3)
+        return FALSE;
+
+    XtsFit( xts);
+    xts->haveMapping = TRUE;
+    return TRUE;
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLXtsGetMapping (
+        IN PEPL_XTS xts,
+        OUT PEPL_XTS_MAPPING mapping)
+
+//  Returns the current (system, PHC) mapping and its error estimate.
+//
+//  xts
+//      Cross-timestamper initialized with EPLXtsInit().
+//  mapping
+//      Set on return to the mapping.
+//
+//  Returns
+//      TRUE if a mapping is available, FALSE otherwise.
+//****************************************************************************
+{
+    if ( !xts->haveMapping)
+        return FALSE;
+    *mapping = xts->mapping;
+    return TRUE;
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLXtsSysToPhc (
+        IN PEPL_XTS xts,
+        IN NS_UINT64 sysTime,
+        OUT NS_UINT32 *phcSeconds,
+        OUT NS_UINT32 *phcNanoSeconds)
+
+//  Converts a system time to PHY clock time.
+//
+//  xts
+//      Cross-timestamper initialized with EPLXtsInit().
+//  sysTime
+//      System time in nanoseconds.
+//  phcSeconds, phcNanoSeconds
+//      Set on return to the corresponding PHY clock time.
+//
+//  Returns
+//      TRUE on success, FALSE if no mapping is available yet.
+//****************************************************************************
+{
+NS_SINT64 delta;
+NS_UINT64 phcTime;
+
+    if ( !xts->haveMapping)
+        return FALSE;
+
+    delta = (NS_SINT64)(sysTime - xts->mapping.sysRef);
+    phcTime = xts->mapping.phcRef + (NS_UINT64)(delta + XtsScale( delta, xts->mapping.rate));
+    *phcSeconds = (NS_UINT32)(phcTime / 1000000000);
+    *phcNanoSeconds = (NS_UINT32)(phcTime % 1000000000);
+    return TRUE;
+}
+
+//****************************************************************************
+EXPORT NS_BOOL
+    EPLXtsPhcToSys (
+        IN PEPL_XTS xts,
+        IN NS_UINT32 phcSeconds,
+        IN NS_UINT32 phcNanoSeconds,
+        OUT NS_UINT64 *sysTime)
+
+//  Converts a PHY clock time, e.g. a packet timestamp, to system time.
+//
+//  xts
+//      Cross-timestamper initialized with EPLXtsInit().
+//  phcSeconds, phcNanoSeconds
+//      PHY clock time.
+//  sysTime
+//      Set on return to the corresponding system time in nanoseconds.
+//
+//  Returns
+//      TRUE on success, FALSE if no mapping is available yet.
+//****************************************************************************
+{
+NS_SINT64 phcDelta, delta;
+
+    if ( !xts->haveMapping)
+        return FALSE;
+
+    // Invert the mapping; the second pass removes the rate^2 term
+    phcDelta = (NS_SINT64)((NS_UINT64)phcSeconds * 1000000000 + phcNanoSeconds -
+                           xts->mapping.phcRef);
+    delta = phcDelta - XtsScale( phcDelta, xts->mapping.rate);
+    delta = phcDelta - XtsScale( delta, xts->mapping.rate);
+    *sysTime = xts->mapping.sysRef + (NS_UINT64)delta;
+    return TRUE;
+}
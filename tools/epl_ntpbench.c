@@ -0,0 +1,213 @@
+//****************************************************************************
+// epl_ntpbench.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// NTP server response throughput benchmark against the simulated PHY.
+//
+// Client requests are passed through the simulated receive timestamp unit
+// in NTP mode. For every request the server polls PTP_STS, reads the
+// receive timestamp, builds the response and, after the simulated PHY has
+// timestamped the response on transmit, reads the transmit timestamp as
+// an interleaved mode server would.
+//
+// Build:
+//      cc -O2 -DEPL_SIMULATION -I../inc -o epl_ntpbench epl_ntpbench.c ../src/*.c
+//
+// Usage:
+//      epl_ntpbench [requests]
+//
+// Reports the host CPU time per response, the MDIO transactions per
+// response and the response rate the MDIO bus allows, checks every
+// timestamp against the simulated time, and times the batch conversions.
+//****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "epl/epl.h"
+
+#define BENCH_MDIO_ADDRESS      1
+#define BENCH_UTC_OFFSET        37
+#define BENCH_FRAME_LENGTH      (14 + 20 + 8 + NTP_PACKET_LENGTH)
+#define BENCH_BATCH             1024
+#define BENCH_BATCH_ROUNDS      1000
+
+//****************************************************************************
+static void
+    BuildFrame(
+        NS_UINT8 *frame,
+        NS_UINT8 *ntpPacket,
+        NS_UINT srcHost,
+        NS_UINT dstHost)
+//  Wraps an NTP packet in a UDP/IPv4 frame between port 123 of two hosts.
+//****************************************************************************
+{
+NS_UINT8 *ip = &frame[14], *udp = &frame[34];
+
+    memset( frame, 0, 34);
+    frame[0] = 0x02; frame[5] = (NS_UINT8)dstHost;
+    frame[6] = 0x02; frame[11] = (NS_UINT8)srcHost;
+    frame[12] = 0x08;
+    ip[0] = 0x45;
+    ip[3] = 20 + 8 + NTP_PACKET_LENGTH;
+    ip[8] = 64;
+    ip[9] = 17;
+    ip[12] = 10; ip[15] = (NS_UINT8)srcHost;
+    ip[16] = 10; ip[19] = (NS_UINT8)dstHost;
+    udp[0] = NTP_UDP_PORT >> 8; udp[1] = NTP_UDP_PORT & 0xFF;
+    udp[2] = NTP_UDP_PORT >> 8; udp[3] = NTP_UDP_PORT & 0xFF;
+    udp[4] = 0; udp[5] = 8 + NTP_PACKET_LENGTH;
+    udp[6] = udp[7] = 0;
+    memcpy( &udp[8], ntpPacket, NTP_PACKET_LENGTH);
+}
+
+//****************************************************************************
+static NS_BOOL
+    CheckTime(
+        PEPL_NTP_TIMESCALE timescale,
+        PEPL_NTP_TS ntpTime,
+        NS_UINT64 simTime)
+//  Returns TRUE if an NTP timestamp converts back to the given sim time.
+//****************************************************************************
+{
+NS_UINT32 seconds, nanoSeconds;
+
+    EPLNtpToPhc( timescale, ntpTime, &seconds, &nanoSeconds);
+    return (seconds == (NS_UINT32)(simTime / 1000000000) &&
+            nanoSeconds == (NS_UINT32)(simTime % 1000000000)) ? TRUE : FALSE;
+}
+
+//****************************************************************************
+int
+    main(
+        int argc,
+        char **argv)
+//****************************************************************************
+{
+static EPL_NTP_PHC_TS phcTimes[BENCH_BATCH];
+static EPL_NTP_TS ntpTimes[BENCH_BATCH];
+OAI_DEV_HANDLE_STRUCT oaiDev;
+PORT_OBJ port;
+PEPL_SIM_PHY simPhy;
+EPL_NTP_TIMESCALE timescale;
+EPL_NTP_SERVER_CFG serverCfg;
+EPL_NTP_TS clientTx, rxTime, txTime, hwTxTime, check;
+NS_UINT8 request[NTP_PACKET_LENGTH], response[NTP_PACKET_LENGTH];
+NS_UINT8 frame[BENCH_FRAME_LENGTH];
+NS_UINT64 rxSimTime, txSimTime, simStart, simMdio;
+NS_UINT32 mdioStart, seconds, nanoSeconds;
+NS_UINT overflow, requests, x, y, errors, built;
+clock_t start;
+double cpuNs, mdioNs;
+
+    requests = (argc > 1) ? (NS_UINT)strtoul( argv[1], NULL, 0) : 100000;
+
+    EPLSimReset();
+    simPhy = EPLSimAddPhy( BENCH_MDIO_ADDRESS);
+    memset( &port, 0, sizeof( port));
+    port.oaiDevHandle = &oaiDev;
+    port.portMdioAddress = BENCH_MDIO_ADDRESS;
+    OAIInitialize( &oaiDev);
+
+    EPLNtpConfigure( &port, FALSE);
+    EPLNtpSetTimescale( &timescale, FALSE, BENCH_UTC_OFFSET);
+    EPLSimAdvanceTime( 1300000000ULL * 1000000000);
+
+    memset( &serverCfg, 0, sizeof( serverCfg));
+    serverCfg.stratum = 1;
+    serverCfg.precision = -27;
+    serverCfg.refId = 0x50505300;   // "PPS"
+    memset( request, 0, sizeof( request));
+    request[NTP_LI_VN_MODE_OFFSET] = (NTP_VERSION << 3) | NTP_MODE_CLIENT;
+    request[NTP_POLL_OFFSET] = 4;
+
+    errors = built = 0;
+    simStart = EPLSimGetTime();
+    mdioStart = port.mdioAccessCount;
+    start = clock();
+    for ( x = 0; x < requests; x++)
+    {
+        // Client request arrives
+        EPLSimAdvanceTime( 100000 + (x % 7) * 1000);
+        clientTx.seconds = x;
+        clientTx.fraction = 0x12345678;
+        EPLNtpPutTimestamp( &request[NTP_TRANSMIT_TS_OFFSET], &clientTx);
+        BuildFrame( frame, request, 2, 1);
+        rxSimTime = EPLSimGetTime();
+        if ( !EPLSimReceive( simPhy, frame, sizeof( frame)))
+            errors++;
+
+        // Server: receive timestamp, response, transmit timestamp
+        if ( !(PTPCheckForEvents( &port) & PTPEVT_RECEIVE_TIMESTAMP_BIT))
+        {
+            errors++;
+            continue;
+        }
+        EPLNtpGetReceiveTimestamp( &port, &timescale, &rxTime, &overflow);
+        EPLNtpFromPhc( &timescale, (NS_UINT32)(EPLSimGetTime() / 1000000000),
+                       (NS_UINT32)(EPLSimGetTime() % 1000000000), &txTime);
+        if ( EPLNtpBuildResponse( &serverCfg, &frame[42], NTP_PACKET_LENGTH,
+                                  &rxTime, &txTime, response) == NS_STATUS_SUCCESS)
+            built++;
+        BuildFrame( frame, response, 1, 2);
+        txSimTime = EPLSimGetTime();
+        EPLSimTransmit( simPhy, frame, sizeof( frame));
+        if ( !(PTPCheckForEvents( &port) & PTPEVT_TRANSMIT_TIMESTAMP_BIT))
+        {
+            errors++;
+            continue;
+        }
+        EPLNtpGetTransmitTimestamp( &port, &timescale, &hwTxTime, &overflow);
+
+        // Check against the simulated PHY clock
+        EPLNtpGetTimestamp( &response[NTP_ORIGIN_TS_OFFSET], &check);
+        if ( overflow || !CheckTime( &timescale, &rxTime, rxSimTime) ||
+             !CheckTime( &timescale, &hwTxTime, txSimTime) ||
+             check.seconds != clientTx.seconds || check.fraction != clientTx.fraction ||
+             (response[NTP_LI_VN_MODE_OFFSET] & 0x07) != NTP_MODE_SERVER)
+            errors++;
+    }
+    cpuNs = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC;
+    simMdio = (NS_UINT64)(port.mdioAccessCount - mdioStart) * EPL_SIM_MDIO_FRAME_NS;
+    mdioNs = requests ? (double)simMdio / requests : 0;
+
+    printf( "requests          %u (%u responses built, %u errors)\n", requests, built, errors);
+    printf( "host CPU          %.0f ns/response, %.0f responses/s\n",
+            requests ? cpuNs / requests : 0, cpuNs > 0 ? requests * 1e9 / cpuNs : 0);
+    printf( "MDIO              %.1f transactions/response, %.1f us/response\n",
+            requests ? (double)(port.mdioAccessCount - mdioStart) / requests : 0, mdioNs / 1000);
+    printf( "MDIO bound        %.0f responses/s\n", mdioNs > 0 ? 1e9 / mdioNs : 0);
+    printf( "simulated time    %.3f s\n", (double)(EPLSimGetTime() - simStart) / 1e9);
+
+    // Batch conversion
+    for ( x = 0; x < BENCH_BATCH; x++)
+    {
+        phcTimes[x].seconds = 1300000000 + x;
+        phcTimes[x].nanoSeconds = (NS_UINT32)((x * 977777UL + 123) % 1000000000);
+    }
+    start = clock();
+    for ( y = 0; y < BENCH_BATCH_ROUNDS; y++)
+        EPLNtpFromPhcArray( &timescale, phcTimes, ntpTimes, BENCH_BATCH);
+    cpuNs = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC;
+    printf( "PHC -> NTP batch  %.2f ns/timestamp\n", cpuNs / (BENCH_BATCH * (double)BENCH_BATCH_ROUNDS));
+
+    start = clock();
+    for ( y = 0; y < BENCH_BATCH_ROUNDS; y++)
+        EPLNtpToPhcArray( &timescale, ntpTimes, phcTimes, BENCH_BATCH);
+    cpuNs = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC;
+    printf( "NTP -> PHC batch  %.2f ns/timestamp\n", cpuNs / (BENCH_BATCH * (double)BENCH_BATCH_ROUNDS));
+
+    for ( x = 0; x < BENCH_BATCH; x++)
+    {
+        seconds = 1300000000 + x;
+        nanoSeconds = (NS_UINT32)((x * 977777UL + 123) % 1000000000);
+        if ( phcTimes[x].seconds != seconds || phcTimes[x].nanoSeconds != nanoSeconds)
+            errors++;
+    }
+    printf( "round trip        %s\n", errors ? "FAILED" : "ok");
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,147 @@
+//****************************************************************************
+// epl_pdvbench.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Packet delay variation filter (epl_pdv.h) benchmark.
+//
+// Feeds each filter offset samples with a constant true value plus
+// queueing delay (uniform 0 - 1000ns, 5% of samples up to 5 times that, as
+// epl_ptpbench's pdv scenario) in the scaled ns of the E2E engine and
+// reports the time per sample and the mean and standard deviation of the
+// output. The mean includes the filter's bias from the least delayed
+// packet; the standard deviation is the noise left for the servo.
+//
+// Given the CPU clock in MHz the time is also shown in cycles per sample.
+// Host cycles are only a rough guide for a Cortex-M; on the target, read
+// the DWT cycle counter around EPLPdvFilter().
+//
+// Build:
+//      cc -O2 -DEPL_SIMULATION -I../inc -o epl_pdvbench epl_pdvbench.c ../src/*.c -lm
+//
+// Usage:
+//      epl_pdvbench [samples [MHz]]
+//****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "epl/epl.h"
+
+#define BENCH_COUNT             4096
+#define BENCH_PDV_NS            1000
+
+typedef struct BENCH_FILTER {
+    const char *name;
+    EPL_PDV_FILTER_ENUM type;
+    NS_UINT window;
+    NS_BOOL decimate;
+    NS_UINT shift;
+} BENCH_FILTER;
+
+static const BENCH_FILTER benchFilters[] = {
+    { "none",                PDV_FILTER_NONE,        0,  FALSE, 0 },
+    { "minimum 8",           PDV_FILTER_MINIMUM,     8,  FALSE, 0 },
+    { "minimum 16",          PDV_FILTER_MINIMUM,     16, FALSE, 0 },
+    { "minimum 16 decimate", PDV_FILTER_MINIMUM,     16, TRUE,  0 },
+    { "minimum 64",          PDV_FILTER_MINIMUM,     64, FALSE, 0 },
+    { "median 7",            PDV_FILTER_MEDIAN,      7,  FALSE, 0 },
+    { "median 15",           PDV_FILTER_MEDIAN,      15, FALSE, 0 },
+    { "median 15 decimate",  PDV_FILTER_MEDIAN,      15, TRUE,  0 },
+    { "median 63",           PDV_FILTER_MEDIAN,      63, FALSE, 0 },
+    { "exponential 1/8",     PDV_FILTER_EXPONENTIAL, 0,  FALSE, 3 },
+    { "exponential 1/16",    PDV_FILTER_EXPONENTIAL, 0,  FALSE, 4 },
+};
+
+static NS_UINT32 randomSeed = 1;
+static NS_SINT64 input[BENCH_COUNT], output[BENCH_COUNT];
+static NS_BOOL passed[BENCH_COUNT];
+static EPL_PDV_FILTER filter;
+
+//****************************************************************************
+static NS_UINT32
+    Random(
+        NS_UINT32 range)
+//  Returns a repeatable pseudo random number 0 - range-1.
+//****************************************************************************
+{
+    randomSeed = randomSeed * 1664525 + 1013904223;
+    return range ? (randomSeed >> 8) % range : 0;
+}
+
+//****************************************************************************
+int
+    main(
+        int argc,
+        char **argv)
+//****************************************************************************
+{
+const BENCH_FILTER *bench;
+EPL_PDV_CFG pdvConfig;
+NS_UINT32 samples, done, x, y, n;
+double mhz, ns, sum, sumSquares, mean;
+clock_t start, ticks;
+
+    samples = (argc > 1) ? (NS_UINT32)strtoul( argv[1], NULL, 0) : 10000000;
+    mhz = (argc > 2) ? atof( argv[2]) : 0;
+    if ( samples < BENCH_COUNT)
+        samples = BENCH_COUNT;
+
+    for ( x = 0; x < BENCH_COUNT; x++)
+    {
+        input[x] = Random( BENCH_PDV_NS + 1);
+        if ( Random( 20) == 0)
+            input[x] += Random( 4 * BENCH_PDV_NS + 1);
+        input[x] = E2E_NS_TO_SCALED( input[x]);
+    }
+
+    printf( "%lu samples per filter, queueing delay 0 - %u ns\n\n", (unsigned long)samples, BENCH_PDV_NS);
+    printf( "%-20s %8s%s %10s %10s\n", "filter", "ns/smpl", mhz ? "  cyc/smpl" : "", "mean ns", "stddev ns");
+    for ( x = 0; x < sizeof( benchFilters) / sizeof( benchFilters[0]); x++)
+    {
+        bench = &benchFilters[x];
+        EPLPdvGetDefaultConfig( &pdvConfig);
+        pdvConfig.type = bench->type;
+        if ( bench->window)
+            pdvConfig.window = bench->window;
+        pdvConfig.decimate = bench->decimate;
+        pdvConfig.shift = bench->shift;
+        EPLPdvInit( &filter, &pdvConfig);
+
+        start = clock();
+        for ( done = 0; done < samples; done += BENCH_COUNT)
+        {
+            for ( y = 0; y < BENCH_COUNT; y++)
+            {
+                output[y] = input[y];
+                passed[y] = EPLPdvFilter( &filter, &output[y]);
+            }
+        }
+        ticks = clock() - start;
+        ns = (double)ticks / CLOCKS_PER_SEC * 1e9 / done;
+
+        // Output statistics of the last pass, after the window has filled
+        sum = sumSquares = 0;
+        n = 0;
+        for ( y = PDV_MAX_WINDOW; y < BENCH_COUNT; y++)
+        {
+            if ( passed[y])
+            {
+                sum += (double)output[y] / (1 << E2E_SCALED_NS_SHIFT);
+                sumSquares += ((double)output[y] / (1 << E2E_SCALED_NS_SHIFT)) *
+                              ((double)output[y] / (1 << E2E_SCALED_NS_SHIFT));
+                n++;
+            }
+        }
+        mean = n ? sum / n : 0;
+        printf( "%-20s %8.1f", bench->name, ns);
+        if ( mhz)
+            printf( "  %8.0f", ns * mhz / 1000);
+        printf( " %10.1f %10.1f\n", mean, n ? sqrt( sumSquares / n - mean * mean) : 0);
+    }
+    return 0;
+}
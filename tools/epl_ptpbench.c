@@ -0,0 +1,702 @@
+//****************************************************************************
+// epl_ptpbench.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Closed loop PTP synchronization benchmark against the simulated PHY.
+//
+// One master and up to BENCH_MAX_SLAVES slaves, each a simulated DP83640
+// with its own oscillator frequency error and random walk wander, exchange
+// two-step Sync/Follow_Up and Delay_Req/Delay_Resp frames in memory over
+// links with a configurable delay, asymmetry and packet delay variation,
+// optionally filtered with a minimum or median filter (epl_pdv.h).
+// Frames go through the simulated timestamp units and timestamps are read
+// with PTPGetTransmitTimestamp()/PTPGetReceiveTimestamp(). Each slave feeds
+// them to an E2E engine and steers its clock with a PI servo through
+// PTPClockStepAdjustment() and PTPClockSetRateAdjustment().
+//
+// Events run in simulated time order; every MDIO transaction advances the
+// simulated time, so register access delays are part of the loop.
+//
+// Scenarios marked for it are then restarted twice, as after a controller
+// reboot: the slave PHYs are reset and left free running for
+// BENCH_REBOOT_NS, then brought up again, first from the checkpoint taken
+// at the end of the run (EPLCheckpointWarmStart()) and then with the
+// configuration calls and a servo starting from zero rate. Each restart
+// runs for the same time and is reported like a scenario, with the lock
+// time counted from the moment the slave is brought up.
+//
+// Build:
+//      cc -O2 -DEPL_SIMULATION -I../inc -o epl_ptpbench epl_ptpbench.c ../src/*.c
+//
+// Usage:
+//      epl_ptpbench [seconds [seed]]
+//
+// For every scenario and slave, reports the convergence time (from which
+// the true offset, taken from the simulated clocks, stays within
+// BENCH_LOCK_NS for BENCH_LOCK_HOLD seconds), the 50/95/99th percentile
+// and maximum of the true offset magnitude from then on and the MDIO
+// transactions per second, then the MTIE and TDEV of the true offset after
+// lock (epl_stability.h). The results depend only on the arguments.
+//****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "epl/epl.h"
+
+#define BENCH_MAX_SLAVES        3
+#define BENCH_MAX_SECONDS       3600
+#define BENCH_SAMPLE_HZ         16          // True offset samples per second
+#define BENCH_MAX_SAMPLES       (BENCH_MAX_SECONDS * BENCH_SAMPLE_HZ)
+#define BENCH_MAX_FRAMES        64          // Frames in flight
+#define BENCH_FRAME_LENGTH      (14 + 44)
+#define BENCH_LOCK_NS           1000
+#define BENCH_LOCK_HOLD         10          // Seconds within BENCH_LOCK_NS
+#define BENCH_STEP_NS           1000000     // Offsets above this are stepped
+#define BENCH_MASTER_ADDRESS    1
+#define BENCH_FOLLOW_UP_NS      20000       // Follow_Up/Delay_Resp turnaround
+#define BENCH_DELAY_REQ_NS      2000000     // Delay_Req after the Sync
+#define BENCH_PDV_WINDOW        16          // Filter window, samples
+#define BENCH_REBOOT_NS         3000000000ULL   // Controller restart time
+
+typedef struct BENCH_SCENARIO {
+    const char *name;
+    NS_UINT32 delayNs;          // Mean one way link delay
+    NS_SINT32 asymmetryNs;      // Master to slave minus slave to master delay
+    NS_UINT32 pdvNs;            // Queueing delay, uniform 0 - pdvNs, 5% of
+                                // frames up to 5 times that
+    NS_UINT32 wanderPpb;        // Oscillator random walk per second
+    NS_UINT32 intervalMs;       // Sync and Delay_Req interval
+    EPL_PDV_FILTER_ENUM filter; // Delay and offset filter (epl_pdv.h)
+    NS_BOOL restart;            // Compare warm and cold restarts
+} BENCH_SCENARIO;
+
+typedef struct BENCH_FRAME {
+    NS_BOOL used;
+    NS_UINT64 deliverTime;      // Simulated time of arrival
+    NS_UINT node;               // Receiving node, 0 = master
+    NS_UINT from;               // Sending node
+    NS_UINT8 data[BENCH_FRAME_LENGTH];
+} BENCH_FRAME;
+
+typedef struct BENCH_NODE {
+    PORT_OBJ port;
+    PEPL_SIM_PHY simPhy;
+    EPL_E2E_ENGINE e2e;
+    EPL_PDV_FILTER delayFilter;
+    EPL_PDV_FILTER offsetFilter;
+    NS_SINT32 oscPpb;           // Initial oscillator error
+    double wander;              // Random walk, ppb
+    double drift;               // Servo integrator, ppb
+    NS_BOOL stepped;
+    NS_BOOL down;               // Controller restarting, frames ignored
+    EPL_CHECKPOINT checkpoint;  // Taken at the end of the run
+    NS_UINT64 lastSampleNs;     // Receive time of the last sample used
+    NS_UINT skip;               // Samples to ignore after a step
+    NS_UINT16 delaySeq;
+    NS_UINT32 mdioStart;
+    NS_UINT32 numSamples;
+    NS_SINT32 offsets[BENCH_MAX_SAMPLES];
+} BENCH_NODE;
+
+static const BENCH_SCENARIO scenarios[] = {
+    // name         delay asym  pdv   wander interval filter              restart
+    { "ideal",      500,  0,    0,    0,     125,     PDV_FILTER_NONE,    TRUE },
+    { "asymmetric", 500,  400,  0,    0,     125,     PDV_FILTER_NONE,    FALSE },
+    { "pdv",        5000, 0,    1000, 0,     125,     PDV_FILTER_NONE,    FALSE },
+    { "pdv min",    5000, 0,    1000, 0,     125,     PDV_FILTER_MINIMUM, TRUE },
+    { "pdv median", 5000, 0,    1000, 0,     125,     PDV_FILTER_MEDIAN,  FALSE },
+    { "wander",     500,  0,    100,  2,     125,     PDV_FILTER_NONE,    FALSE },
+    { "slow sync",  500,  0,    100,  2,     1000,    PDV_FILTER_NONE,    TRUE },
+};
+
+static const NS_SINT32 slaveOscPpb[BENCH_MAX_SLAVES] = { 20000, -35000, 4000 };
+
+static OAI_DEV_HANDLE_STRUCT oaiDev;
+static BENCH_NODE nodes[BENCH_MAX_SLAVES + 1];
+static BENCH_FRAME frames[BENCH_MAX_FRAMES];
+static NS_UINT32 randomSeed;
+static EPL_STABILITY stability;
+
+// Event schedule, carried over from a run to the restarts that follow it
+static NS_UINT64 nextSync, nextDelay, nextSample, nextWander;
+static NS_UINT16 syncSeq;
+
+//****************************************************************************
+static NS_UINT32
+    Random(
+        NS_UINT32 range)
+//  Returns a repeatable pseudo random number 0 - range-1.
+//****************************************************************************
+{
+    randomSeed = randomSeed * 1664525 + 1013904223;
+    return range ? (randomSeed >> 8) % range : 0;
+}
+
+//****************************************************************************
+static void
+    PutTimestamp(
+        NS_UINT8 *field,
+        NS_UINT32 seconds,
+        NS_UINT32 nanoSeconds)
+//  Stores a PTP timestamp (48-bit seconds, 32-bit nanoseconds).
+//****************************************************************************
+{
+    field[0] = field[1] = 0;
+    field[2] = (NS_UINT8)(seconds >> 24); field[3] = (NS_UINT8)(seconds >> 16);
+    field[4] = (NS_UINT8)(seconds >> 8);  field[5] = (NS_UINT8)seconds;
+    field[6] = (NS_UINT8)(nanoSeconds >> 24); field[7] = (NS_UINT8)(nanoSeconds >> 16);
+    field[8] = (NS_UINT8)(nanoSeconds >> 8);  field[9] = (NS_UINT8)nanoSeconds;
+}
+
+//****************************************************************************
+static void
+    GetTimestamp(
+        NS_UINT8 *field,
+        NS_UINT32 *seconds,
+        NS_UINT32 *nanoSeconds)
+//  Loads a PTP timestamp, lower 32 bits of the seconds.
+//****************************************************************************
+{
+    *seconds = ((NS_UINT32)field[2] << 24) | ((NS_UINT32)field[3] << 16) |
+               ((NS_UINT32)field[4] << 8) | field[5];
+    *nanoSeconds = ((NS_UINT32)field[6] << 24) | ((NS_UINT32)field[7] << 16) |
+                   ((NS_UINT32)field[8] << 8) | field[9];
+}
+
+//****************************************************************************
+static NS_UINT8 *
+    BuildFrame(
+        NS_UINT8 *frame,
+        NS_UINT messageType,
+        NS_UINT from,
+        NS_UINT16 sequenceId)
+//  Builds a Layer 2 PTPv2 message and returns the start of its body.
+//****************************************************************************
+{
+NS_UINT8 *ptp = &frame[14];
+
+    memset( frame, 0, BENCH_FRAME_LENGTH);
+    frame[0] = 0x01; frame[1] = 0x1B; frame[2] = 0x19;
+    frame[6] = 0x02; frame[11] = (NS_UINT8)from;
+    frame[12] = 0x88; frame[13] = 0xF7;
+    ptp[PTP_HDR_MSG_TYPE_OFFSET] = (NS_UINT8)messageType;
+    ptp[1] = 2;
+    ptp[3] = 44;
+    if ( messageType == PTP_MSG_SYNC)
+        ptp[PTP_HDR_FLAGS_OFFSET] = PTP_FLAG_TWO_STEP;
+    ptp[PTP_HDR_SOURCE_PORT_ID_OFFSET + 7] = (NS_UINT8)from;
+    ptp[PTP_HDR_SEQUENCE_ID_OFFSET] = (NS_UINT8)(sequenceId >> 8);
+    ptp[PTP_HDR_SEQUENCE_ID_OFFSET + 1] = (NS_UINT8)sequenceId;
+    return &ptp[PTP_HDR_LENGTH];
+}
+
+//****************************************************************************
+static void
+    SendFrame(
+        const BENCH_SCENARIO *scenario,
+        NS_UINT8 *frame,
+        NS_UINT from,
+        NS_UINT to,
+        NS_UINT64 extraNs)
+//  Puts a frame on the link between a slave and the master.
+//****************************************************************************
+{
+NS_UINT64 delay;
+NS_UINT x;
+
+    delay = scenario->delayNs + extraNs + Random( scenario->pdvNs + 1);
+    if ( Random( 20) == 0)
+        delay += Random( 4 * scenario->pdvNs + 1);
+    if ( to)
+        delay += scenario->asymmetryNs / 2;
+    else
+        delay -= scenario->asymmetryNs / 2;
+
+    for ( x = 0; x < BENCH_MAX_FRAMES; x++)
+    {
+        if ( !frames[x].used)
+        {
+            frames[x].used = TRUE;
+            frames[x].deliverTime = EPLSimGetTime() + delay;
+            frames[x].node = to;
+            frames[x].from = from;
+            memcpy( frames[x].data, frame, BENCH_FRAME_LENGTH);
+            return;
+        }
+    }
+    printf( "frame queue full\n");
+    exit( 2);
+}
+
+//****************************************************************************
+static void
+    RunServo(
+        BENCH_NODE *node,
+        const BENCH_SCENARIO *scenario)
+//  Steers a slave clock from its latest E2E sample with a PI servo.
+//****************************************************************************
+{
+EPL_E2E_SAMPLE sample;
+NS_SINT64 offset, magnitude;
+NS_UINT64 sampleNs;
+double interval, ppb;
+NS_SINT32 rate;
+
+    if ( !EPLE2EGetSample( &node->e2e, &sample))
+        return;
+
+    // Time since the previous sample; filters may pass one sample per window
+    sampleNs = (NS_UINT64)sample.rxSeconds * 1000000000 + sample.rxNanoSeconds;
+    interval = scenario->intervalMs / 1000.0;
+    if ( node->lastSampleNs && sampleNs > node->lastSampleNs)
+        interval = (double)(sampleNs - node->lastSampleNs) / 1e9;
+    node->lastSampleNs = sampleNs;
+
+    if ( node->skip)
+    {
+        node->skip--;
+        return;
+    }
+
+    offset = sample.offset >> 16;
+    magnitude = (offset < 0) ? -offset : offset;
+    if ( !node->stepped || magnitude > BENCH_STEP_NS)
+    {
+        PTPClockStepAdjustment( &node->port, (NS_UINT32)(magnitude / 1000000000),
+                                (NS_UINT32)(magnitude % 1000000000), (offset > 0));
+        node->stepped = TRUE;
+        node->skip = 2;
+        node->lastSampleNs = 0;
+        EPLPdvReset( &node->offsetFilter);
+        return;
+    }
+
+    // Per sample gains of 0.7 (proportional) and 0.3 (integral)
+    node->drift += 0.3 * offset / interval;
+    ppb = 0.7 * offset / interval + node->drift;
+    rate = (NS_SINT32)(-ppb * 34.359738368);
+    if ( rate > 0x03FFFFFF) rate = 0x03FFFFFF;
+    if ( rate < -0x03FFFFFF) rate = -0x03FFFFFF;
+    PTPClockSetRateAdjustment( &node->port, (NS_UINT32)((rate < 0) ? -rate : rate), FALSE, (rate < 0));
+}
+
+//****************************************************************************
+static void
+    Deliver(
+        const BENCH_SCENARIO *scenario,
+        BENCH_FRAME *frame)
+//  Processes a frame arriving at a node.
+//****************************************************************************
+{
+BENCH_NODE *node = &nodes[frame->node];
+NS_UINT8 *ptp = &frame->data[14], reply[BENCH_FRAME_LENGTH], messageType;
+NS_UINT32 seconds, nanoSeconds;
+NS_UINT overflow, sequenceId, hash;
+NS_UINT16 seq;
+
+    seq = (NS_UINT16)((ptp[PTP_HDR_SEQUENCE_ID_OFFSET] << 8) | ptp[PTP_HDR_SEQUENCE_ID_OFFSET + 1]);
+    if ( node->down)
+        return;
+
+    switch ( ptp[PTP_HDR_MSG_TYPE_OFFSET] & 0x0F)
+    {
+    case PTP_MSG_SYNC:
+        EPLSimReceiveAt( node->simPhy, frame->data, BENCH_FRAME_LENGTH, frame->deliverTime);
+        PTPGetReceiveTimestamp( &node->port, &seconds, &nanoSeconds, &overflow,
+                                &sequenceId, &messageType, &hash);
+        if ( EPLE2ESyncReceived( &node->e2e, (NS_UINT16)sequenceId, seconds, nanoSeconds))
+            RunServo( node, scenario);
+        break;
+
+    case PTP_MSG_FOLLOW_UP:
+        GetTimestamp( &ptp[PTP_HDR_LENGTH], &seconds, &nanoSeconds);
+        if ( EPLE2ESyncOrigin( &node->e2e, seq, seconds, nanoSeconds, 0))
+            RunServo( node, scenario);
+        break;
+
+    case PTP_MSG_DELAY_REQ:
+        // Master: timestamp and answer
+        EPLSimReceiveAt( node->simPhy, frame->data, BENCH_FRAME_LENGTH, frame->deliverTime);
+        PTPGetReceiveTimestamp( &node->port, &seconds, &nanoSeconds, &overflow,
+                                &sequenceId, &messageType, &hash);
+        PutTimestamp( BuildFrame( reply, PTP_MSG_DELAY_RESP, 0, seq), seconds, nanoSeconds);
+        SendFrame( scenario, reply, 0, frame->from, BENCH_FOLLOW_UP_NS);
+        break;
+
+    case PTP_MSG_DELAY_RESP:
+        GetTimestamp( &ptp[PTP_HDR_LENGTH], &seconds, &nanoSeconds);
+        EPLE2EDelayResp( &node->e2e, seq, seconds, nanoSeconds, 0);
+        break;
+    }
+}
+
+//****************************************************************************
+static int
+    CompareOffsets(
+        const void *a,
+        const void *b)
+//****************************************************************************
+{
+    return (*(const NS_SINT32 *)a > *(const NS_SINT32 *)b) - (*(const NS_SINT32 *)a < *(const NS_SINT32 *)b);
+}
+
+//****************************************************************************
+static void
+    StartSlave(
+        BENCH_NODE *node,
+        const BENCH_SCENARIO *scenario)
+//  Resets the E2E engine, filters and servo of a node about to run.
+//****************************************************************************
+{
+EPL_PDV_CFG pdvConfig;
+
+    EPLE2EInit( &node->e2e);
+    if ( scenario->filter != PDV_FILTER_NONE)
+    {
+        // Sliding window for the delay, one offset per window
+        EPLPdvGetDefaultConfig( &pdvConfig);
+        pdvConfig.type = scenario->filter;
+        pdvConfig.window = BENCH_PDV_WINDOW;
+        EPLPdvInit( &node->delayFilter, &pdvConfig);
+        pdvConfig.decimate = TRUE;
+        EPLPdvInit( &node->offsetFilter, &pdvConfig);
+        EPLE2ESetFilter( &node->e2e, E2E_FILTER_DELAY, EPLPdvFilter, &node->delayFilter);
+        EPLE2ESetFilter( &node->e2e, E2E_FILTER_OFFSET, EPLPdvFilter, &node->offsetFilter);
+    }
+    node->drift = 0;
+    node->stepped = FALSE;
+    node->down = FALSE;
+    node->lastSampleNs = 0;
+    node->skip = 0;
+    node->numSamples = 0;
+}
+
+//****************************************************************************
+static void
+    ConfigurePort(
+        BENCH_NODE *node)
+//  Configures and enables the PTP function of a node from reset.
+//****************************************************************************
+{
+RX_CFG_ITEMS rxConfig;
+
+    memset( &rxConfig, 0, sizeof( rxConfig));
+    rxConfig.ptpVersion = 2;
+    PTPSetTransmitConfig( &node->port, TXOPT_TS_EN | TXOPT_L2_EN, 2, 0, 0);
+    PTPSetReceiveConfig( &node->port, RXOPT_RX_TS_EN | RXOPT_RX_L2_EN, &rxConfig);
+    PTPEnable( &node->port, TRUE);
+}
+
+//****************************************************************************
+static void
+    RunNodes(
+        const BENCH_SCENARIO *scenario,
+        NS_UINT64 end,
+        NS_UINT numSlaves)
+//  Runs the master and slaves until the simulated time reaches end.
+//****************************************************************************
+{
+NS_UINT8 frame[BENCH_FRAME_LENGTH];
+NS_UINT64 interval, now, next;
+NS_UINT32 txSeconds, txNanoSeconds, x;
+NS_UINT overflow;
+NS_SINT64 offset;
+BENCH_FRAME *due;
+BENCH_NODE *node;
+
+    interval = (NS_UINT64)scenario->intervalMs * 1000000;
+    while ( (now = EPLSimGetTime()) < end)
+    {
+        // Next event: frame arrival, Sync, Delay_Req, sample or wander step
+        due = NULL;
+        next = nextSync;
+        if ( nextDelay < next) next = nextDelay;
+        if ( nextSample < next) next = nextSample;
+        if ( nextWander < next) next = nextWander;
+        for ( x = 0; x < BENCH_MAX_FRAMES; x++)
+        {
+            if ( frames[x].used && frames[x].deliverTime < next)
+            {
+                next = frames[x].deliverTime;
+                due = &frames[x];
+            }
+        }
+        if ( next > now)
+            EPLSimAdvanceTime( next - now);
+
+        if ( due)
+        {
+            due->used = FALSE;
+            Deliver( scenario, due);
+        }
+        else if ( next == nextSync)
+        {
+            node = &nodes[0];
+            BuildFrame( frame, PTP_MSG_SYNC, 0, syncSeq);
+            EPLSimTransmit( node->simPhy, frame, BENCH_FRAME_LENGTH);
+            for ( x = 1; x <= numSlaves; x++)
+                SendFrame( scenario, frame, 0, x, 0);
+            PTPGetTransmitTimestamp( &node->port, &txSeconds, &txNanoSeconds, &overflow);
+            PutTimestamp( BuildFrame( frame, PTP_MSG_FOLLOW_UP, 0, syncSeq), txSeconds, txNanoSeconds);
+            for ( x = 1; x <= numSlaves; x++)
+                SendFrame( scenario, frame, 0, x, BENCH_FOLLOW_UP_NS);
+            syncSeq++;
+            nextSync += interval;
+        }
+        else if ( next == nextDelay)
+        {
+            for ( x = 1; x <= numSlaves; x++)
+            {
+                node = &nodes[x];
+                if ( node->down)
+                    continue;
+                BuildFrame( frame, PTP_MSG_DELAY_REQ, x, node->delaySeq);
+                EPLSimTransmit( node->simPhy, frame, BENCH_FRAME_LENGTH);
+                SendFrame( scenario, frame, x, 0, 0);
+                PTPGetTransmitTimestamp( &node->port, &txSeconds, &txNanoSeconds, &overflow);
+                EPLE2EDelayReqSent( &node->e2e, node->delaySeq++, txSeconds, txNanoSeconds);
+            }
+            nextDelay += interval;
+        }
+        else if ( next == nextSample)
+        {
+            // True offsets, straight from the simulated clocks
+            for ( x = 1; x <= numSlaves; x++)
+            {
+                node = &nodes[x];
+                offset = (NS_SINT64)(EPLSimGetPhyTime( node->simPhy) - EPLSimGetPhyTime( nodes[0].simPhy));
+                if ( offset > 0x7FFFFFFF) offset = 0x7FFFFFFF;
+                if ( offset < -0x7FFFFFFF) offset = -0x7FFFFFFF;
+                if ( !node->down && node->numSamples < BENCH_MAX_SAMPLES)
+                    node->offsets[node->numSamples++] = (NS_SINT32)offset;
+            }
+            nextSample += 1000000000 / BENCH_SAMPLE_HZ;
+        }
+        else
+        {
+            for ( x = 0; x <= numSlaves && scenario->wanderPpb; x++)
+            {
+                node = &nodes[x];
+                node->wander += (double)((NS_SINT32)Random( 2001) - 1000) / 1000 * scenario->wanderPpb;
+                EPLSimSetClockDrift( node->simPhy, node->oscPpb + (NS_SINT32)node->wander);
+            }
+            nextWander += 1000000000;
+        }
+    }
+}
+
+//****************************************************************************
+static void
+    Report(
+        const char *name,
+        NS_UINT seconds,
+        NS_UINT numSlaves)
+//  Prints the lock time, offset statistics and stability of every slave.
+//****************************************************************************
+{
+NS_UINT32 lock, count, x, y;
+EPL_STABILITY_CFG stabilityConfig;
+EPL_STAB_MTIE_POINT mtie;
+EPL_STAB_DEV_POINT dev;
+NS_SINT64 offset;
+BENCH_NODE *node;
+
+    for ( x = 1; x <= numSlaves; x++)
+    {
+        node = &nodes[x];
+        // Start of the first BENCH_LOCK_HOLD seconds within BENCH_LOCK_NS
+        lock = 0;
+        for ( y = 0; y < node->numSamples && y - lock < BENCH_LOCK_HOLD * BENCH_SAMPLE_HZ; y++)
+        {
+            if ( node->offsets[y] > BENCH_LOCK_NS || node->offsets[y] < -BENCH_LOCK_NS)
+                lock = y + 1;
+        }
+        count = (y - lock < BENCH_LOCK_HOLD * BENCH_SAMPLE_HZ) ? 0 : node->numSamples - lock;
+
+        // Stability of the locked clock: MTIE at about 1, 10 and 100 s
+        EPLStabilityGetDefaultConfig( &stabilityConfig);
+        stabilityConfig.sampleIntervalUs = 1000000 / BENCH_SAMPLE_HZ;
+        stabilityConfig.mtieWindow[0] = BENCH_SAMPLE_HZ + 1;
+        stabilityConfig.mtieWindow[1] = 10 * BENCH_SAMPLE_HZ + 1;
+        stabilityConfig.mtieWindow[2] = 100 * BENCH_SAMPLE_HZ + 1;
+        stabilityConfig.mtieWindow[3] = 0;
+        EPLStabilityInit( &stability, &stabilityConfig);
+        for ( y = 0; y < count; y++)
+            EPLStabilityAddSample( &stability, node->offsets[lock + y]);
+
+        for ( y = 0; y < count; y++)
+        {
+            offset = node->offsets[lock + y];
+            node->offsets[y] = (NS_SINT32)((offset < 0) ? -offset : offset);
+        }
+        qsort( node->offsets, count, sizeof( NS_SINT32), CompareOffsets);
+
+        printf( "%-11s %2u ppm%+4d  ", name, (unsigned)x, (int)(node->oscPpb / 1000));
+        if ( count)
+            printf( "lock %7.2f s  |offset| p50 %5ld p95 %5ld p99 %5ld max %5ld ns",
+                    (double)lock / BENCH_SAMPLE_HZ, (long)node->offsets[count / 2],
+                    (long)node->offsets[count * 95 / 100], (long)node->offsets[count * 99 / 100],
+                    (long)node->offsets[count - 1]);
+        else
+            printf( "no lock                                                         ");
+        printf( "  MDIO %5.1f/s\n", (double)(node->port.mdioAccessCount - node->mdioStart) / seconds);
+
+        printf( "%-11s %*s", "", 13, "MTIE");
+        for ( y = 0; EPLStabilityGetMtie( &stability, y, &mtie) == NS_STATUS_SUCCESS; y++)
+            printf( " %.1fs %lu", (double)mtie.tauUs / 1000000, (unsigned long)mtie.mtieNs);
+        printf( " ns  TDEV");
+        for ( y = 4; y < STAB_DEV_LEVELS; y += 3)
+        {
+            if ( EPLStabilityGetDeviation( &stability, y, &dev) == NS_STATUS_SUCCESS && dev.terms >= 10)
+                printf( " %.0fs %.2f", (double)dev.tauUs / 1000000, (double)dev.tdevPs / 1000);
+        }
+        printf( " ns\n");
+    }
+}
+
+//****************************************************************************
+static void
+    RestartSlaves(
+        const BENCH_SCENARIO *scenario,
+        NS_UINT seconds,
+        NS_UINT numSlaves,
+        NS_BOOL warm)
+//  Resets the slave PHYs, lets them run free for BENCH_REBOOT_NS, brings
+//  them up from their checkpoint (warm) or from scratch (cold) and runs
+//  them for seconds.
+//****************************************************************************
+{
+NS_SINT64 integrator, meanPathDelay;
+BENCH_NODE *node;
+NS_UINT x;
+
+    for ( x = 1; x <= numSlaves; x++)
+    {
+        node = &nodes[x];
+        EPLWriteReg( &node->port, PHY_BMCR, BMCR_RESET);
+        memset( &node->port, 0, sizeof( PORT_OBJ));
+        node->port.oaiDevHandle = &oaiDev;
+        node->port.portMdioAddress = BENCH_MASTER_ADDRESS + x;
+        node->down = TRUE;
+    }
+    RunNodes( scenario, EPLSimGetTime() + BENCH_REBOOT_NS, numSlaves);
+
+    for ( x = 1; x <= numSlaves; x++)
+    {
+        node = &nodes[x];
+        StartSlave( node, scenario);
+        if ( warm)
+        {
+            if ( EPLCheckpointWarmStart( &node->port, &node->checkpoint, &integrator, &meanPathDelay) !=
+                 NS_STATUS_SUCCESS)
+            {
+                printf( "warm start failed\n");
+                exit( 2);
+            }
+            node->drift = (double)integrator / 65536;
+            EPLE2ESetMeanPathDelay( &node->e2e, meanPathDelay);
+        }
+        else
+        {
+            ConfigurePort( node);
+        }
+        node->mdioStart = node->port.mdioAccessCount;
+    }
+    RunNodes( scenario, EPLSimGetTime() + (NS_UINT64)seconds * 1000000000, numSlaves);
+    Report( warm ? "warm start" : "cold start", seconds, numSlaves);
+}
+
+//****************************************************************************
+static void
+    RunScenario(
+        const BENCH_SCENARIO *scenario,
+        NS_UINT seconds,
+        NS_UINT numSlaves)
+//  Runs one scenario from power up and prints a line per slave, then the
+//  restarts if the scenario asks for them.
+//****************************************************************************
+{
+NS_UINT64 start;
+BENCH_NODE *node;
+clock_t cpuStart;
+NS_UINT x;
+
+    EPLSimReset();
+    memset( frames, 0, sizeof( frames));
+    for ( x = 0; x <= numSlaves; x++)
+    {
+        node = &nodes[x];
+        memset( node, 0, sizeof( BENCH_NODE));
+        node->simPhy = EPLSimAddPhy( BENCH_MASTER_ADDRESS + x);
+        node->port.oaiDevHandle = &oaiDev;
+        node->port.portMdioAddress = BENCH_MASTER_ADDRESS + x;
+        node->oscPpb = x ? slaveOscPpb[x - 1] : 0;
+        EPLSimSetClockDrift( node->simPhy, node->oscPpb);
+        StartSlave( node, scenario);
+        ConfigurePort( node);
+        node->mdioStart = node->port.mdioAccessCount;
+    }
+
+    cpuStart = clock();
+    start = EPLSimGetTime();
+    syncSeq = 0;
+    nextSync = start;
+    nextDelay = start + BENCH_DELAY_REQ_NS;
+    nextSample = nextWander = start;
+    RunNodes( scenario, start + (NS_UINT64)seconds * 1000000000, numSlaves);
+    Report( scenario->name, seconds, numSlaves);
+    printf( "%-11s  master MDIO %.1f/s, %.0fx real time\n\n", scenario->name,
+            (double)(nodes[0].port.mdioAccessCount - nodes[0].mdioStart) / seconds,
+            (double)seconds * CLOCKS_PER_SEC / ((clock() - cpuStart) ? (double)(clock() - cpuStart) : 1));
+    if ( !scenario->restart)
+        return;
+
+    // Servo integrator kept as ppb * 2^16
+    for ( x = 1; x <= numSlaves; x++)
+    {
+        node = &nodes[x];
+        if ( EPLCheckpointSave( &node->port, (NS_SINT64)(node->drift * 65536),
+                                node->e2e.meanPathDelay, &node->checkpoint) != NS_STATUS_SUCCESS)
+        {
+            printf( "checkpoint failed\n");
+            exit( 2);
+        }
+    }
+    RestartSlaves( scenario, seconds, numSlaves, TRUE);
+    RestartSlaves( scenario, seconds, numSlaves, FALSE);
+    printf( "\n");
+}
+
+//****************************************************************************
+int
+    main(
+        int argc,
+        char **argv)
+//****************************************************************************
+{
+NS_UINT seconds, x;
+NS_UINT32 seed;
+
+    seconds = (argc > 1) ? (NS_UINT)strtoul( argv[1], NULL, 0) : 600;
+    seed = (argc > 2) ? (NS_UINT32)strtoul( argv[2], NULL, 0) : 1;
+    if ( !seconds || seconds > BENCH_MAX_SECONDS)
+    {
+        printf( "seconds must be 1 - %u\n", BENCH_MAX_SECONDS);
+        return 1;
+    }
+    OAIInitialize( &oaiDev);
+
+    printf( "%u s per scenario, seed %u, lock = |offset| < %u ns\n\n",
+            seconds, (unsigned)seed, BENCH_LOCK_NS);
+    for ( x = 0; x < sizeof( scenarios) / sizeof( scenarios[0]); x++)
+    {
+        randomSeed = seed;
+        RunScenario( &scenarios[x], seconds, BENCH_MAX_SLAVES);
+    }
+    return 0;
+}
@@ -0,0 +1,2562 @@
+//****************************************************************************
+// epl_simcheck.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Functional checks of the library modules against the simulated PHY.
+//
+// Each check drives one module through the simulated DP83640 register
+// model and compares what the module reports with what the model knows:
+// the injected faults, counters and clock errors, and the simulated PHY
+// clocks. Where the model lacks a hardware path (Status Frames, hash
+// filtering), the check emulates it in a few lines. A check prints one
+// line with its figures, or the first expectation that failed.
+//
+// Build:
+//      cc -O2 -DEPL_SIMULATION -I../inc -o epl_simcheck epl_simcheck.c ../src/*.c
+//
+// Add -DEPL_TRACE_ENABLE to include the trace check.
+//
+// Usage:
+//      epl_simcheck [check ...]
+//
+// Runs the named checks, or all of them, and exits with 1 if any failed.
+// The results do not depend on the host.
+//****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "epl/epl.h"
+
+// Fails the running check, naming the expectation
+#define EXPECT(condition)                                               \
+    do {                                                                \
+        if ( !(condition))                                              \
+        {                                                               \
+            printf( "FAILED line %d: %s\n", __LINE__, #condition);      \
+            return FALSE;                                               \
+        }                                                               \
+    } while ( 0)
+
+typedef struct CHECK {
+    const char *name;
+    NS_BOOL (*run)( void);
+} CHECK;
+
+static OAI_DEV_HANDLE_STRUCT oaiDev;
+static PORT_OBJ ports[16];
+static NS_UINT32 randomSeed;
+
+//****************************************************************************
+static NS_UINT32
+    Random(
+        NS_UINT32 range)
+//  Returns a repeatable pseudo random number 0 - range-1.
+//****************************************************************************
+{
+    randomSeed = randomSeed * 1664525 + 1013904223;
+    return range ? (randomSeed >> 8) % range : 0;
+}
+
+//****************************************************************************
+static void
+    AddNs(
+        NS_UINT32 *seconds,
+        NS_UINT32 *nanoSeconds,
+        NS_SINT64 ns)
+//  Adds a signed number of nanoseconds to a seconds/nanoseconds time.
+//****************************************************************************
+{
+NS_SINT64 time;
+
+    time = (NS_SINT64)*seconds * 1000000000 + *nanoSeconds + ns;
+    *seconds = (NS_UINT32)(time / 1000000000);
+    *nanoSeconds = (NS_UINT32)(time % 1000000000);
+}
+
+//****************************************************************************
+static PEPL_PORT_HANDLE
+    AddPort(
+        NS_UINT index)
+//  Adds a simulated PHY at MDIO address index + 1 and returns its port.
+//****************************************************************************
+{
+PPORT_OBJ port = &ports[index];
+
+    memset( port, 0, sizeof( PORT_OBJ));
+    port->oaiDevHandle = &oaiDev;
+    port->portMdioAddress = index + 1;
+    EPLSimAddPhy( index + 1);
+    return port;
+}
+
+//****************************************************************************
+static NS_BOOL
+    CheckTdr( void)
+//  Three reflections on both pairs, one beyond the reach of the narrowest
+//  pulse: each must be located at its delay, with its polarity, in one
+//  page select.
+//****************************************************************************
+{
+PEPL_PORT_HANDLE port;
+PEPL_SIM_PHY simPhy;
+EPL_TDR_CFG config;
+EPL_TDR_RESULTS results;
+EPL_TDR_FAULT *fault;
+
+    port = AddPort( 0);
+    simPhy = EPLSimGetPhy( 1);
+    simPhy->tdrNoise = 2;
+    EPLSimAddReflection( simPhy, FALSE, 20, 30);
+    EPLSimAddReflection( simPhy, TRUE, 60, -25);
+    EPLSimAddReflection( simPhy, TRUE, 200, 20);
+
+    EPLTdrGetDefaultConfig( &config);
+    config.maxFaults = 3;
+    memset( &results, 0, sizeof( results));
+    EXPECT( EPLTdrRun( port, &config, &results) == NS_STATUS_SUCCESS);
+
+    EXPECT( results.pair[TDR_PAIR_TX].numFaults == 1);
+    fault = &results.pair[TDR_PAIR_TX].faults[0];
+    EXPECT( fault->type == TDR_FAULT_OPEN && fault->timeTicks == 20);
+    EXPECT( fault->distanceCm == EPLTdrTicksToCm( 20, config.nvpPercent));
+
+    EXPECT( results.pair[TDR_PAIR_RX].numFaults == 2);
+    fault = &results.pair[TDR_PAIR_RX].faults[0];
+    EXPECT( fault->type == TDR_FAULT_SHORT && fault->timeTicks == 60);
+    fault = &results.pair[TDR_PAIR_RX].faults[1];
+    EXPECT( fault->type == TDR_FAULT_OPEN && fault->timeTicks == 200);
+    EXPECT( fault->pulseWidth > config.minPulseWidth);
+
+    EXPECT( results.mdioAccesses == port->mdioAccessCount);
+    EXPECT( simPhy->pageSelectCount == 1);
+    printf( "%u pulses, %lu MDIO, %lu us, 1 page select\n", (unsigned)results.pulsesSent,
+            (unsigned long)results.mdioAccesses, (unsigned long)results.durationUs);
+    return TRUE;
+}
+
+//****************************************************************************
+static void
+    LqCallback(
+        PEPL_PORT_HANDLE portHandle,
+        EPL_LQ_PARAM_ENUM param,
+        EPL_LQ_STATE_ENUM state,
+        NS_SINT value,
+        void *context)
+//  Records threshold crossings as port * 1000 + state * 100 + value.
+//****************************************************************************
+{
+NS_SINT *events = (NS_SINT *)context;
+
+    if ( param == LQ_PARAM_FREQ && events[0] < 7)
+        events[++events[0]] = (NS_SINT)portHandle->portMdioAddress * 1000 + state * 100 + value;
+}
+
+//****************************************************************************
+static NS_BOOL
+    CheckLinkQuality( void)
+//  Two ports sampled for 2 s at a 5% share of the MDIO capacity, with a
+//  frequency offset excursion injected on the second: the monitor must
+//  stay within its budget, report the crossing and the recovery once
+//  each and keep exact statistics of the constant parameters.
+//****************************************************************************
+{
+static EPL_LQ_MONITOR monitor;
+PEPL_PORT_HANDLE port0, port1;
+PEPL_SIM_PHY simPhy1;
+EPL_LQ_STATS stats;
+NS_SINT events[8];
+NS_UINT64 start;
+double seconds, budget;
+NS_UINT x;
+
+    port0 = AddPort( 0);
+    port1 = AddPort( 1);
+    simPhy1 = EPLSimGetPhy( 2);
+    EPLSimSetLinkQuality( EPLSimGetPhy( 1), LQ_PARAM_C1, -10);
+    EPLSimSetLinkQuality( EPLSimGetPhy( 1), LQ_PARAM_DAGC, 200);
+    EPLSimSetLinkQuality( simPhy1, LQ_PARAM_FREQ, 5);
+
+    memset( events, 0, sizeof( events));
+    EPLLqInitMonitor( &monitor, 50, LQ_DEFAULT_MDIO_OPS_PER_SEC, LqCallback, events);
+    EXPECT( EPLLqAddPort( &monitor, port0, LQ_PARAM_ALL) == NS_STATUS_SUCCESS);
+    EXPECT( EPLLqAddPort( &monitor, port1, LQ_PARAM_BIT( LQ_PARAM_FREQ)) == NS_STATUS_SUCCESS);
+    EXPECT( EPLLqSetThreshold( &monitor, port1, LQ_PARAM_FREQ, -20, 20, FALSE) == NS_STATUS_SUCCESS);
+
+    start = EPLSimGetTime();
+    monitor.mdioUsed = 0;
+    for ( x = 0; x < 2000; x++)
+    {
+        EPLSimAdvanceTime( 1000000);
+        if ( x == 1000)
+            EPLSimSetLinkQuality( simPhy1, LQ_PARAM_FREQ, 40);
+        if ( x == 1500)
+            EPLSimSetLinkQuality( simPhy1, LQ_PARAM_FREQ, 0);
+        EPLLqPoll( &monitor);
+    }
+    seconds = (double)(EPLSimGetTime() - start) / 1e9;
+    budget = LQ_DEFAULT_MDIO_OPS_PER_SEC * 0.05;
+    EXPECT( monitor.mdioUsed / seconds <= budget);
+    EXPECT( monitor.mdioUsed / seconds > 0.95 * budget);
+
+    EXPECT( events[0] == 2);
+    EXPECT( events[1] == 2000 + LQ_STATE_HIGH * 100 + 40);
+    EXPECT( events[2] == 2000 + LQ_STATE_NORMAL * 100 + 0);
+    EXPECT( EPLLqGetStats( &monitor, port1, LQ_PARAM_FREQ, &stats) == NS_STATUS_SUCCESS);
+    EXPECT( stats.min == 0 && stats.max == 40 && stats.crossings == 1 && stats.last == 0);
+    EXPECT( EPLLqGetStats( &monitor, port0, LQ_PARAM_DAGC, &stats) == NS_STATUS_SUCCESS);
+    EXPECT( stats.last == 200 && stats.mean == 200 << LQ_STAT_FRAC_BITS && stats.variance == 0);
+    EXPECT( EPLLqGetStats( &monitor, port0, LQ_PARAM_C1, &stats) == NS_STATUS_SUCCESS);
+    EXPECT( stats.min == -10 && stats.max == -10);
+
+    printf( "%.1f MDIO/s against %.1f, crossing and recovery reported\n",
+            monitor.mdioUsed / seconds, budget);
+    return TRUE;
+}
+
+//****************************************************************************
+static NS_BOOL
+    CheckErrorCounters( void)
+//  100 harvests at 100 ms of two ports, one with steady errors and one with
+//  a burst that saturates its 8-bit counter: the totals must match what was
+//  injected, the burst must be flagged, and each harvest must cost two
+//  reads per port and no page select.
+//****************************************************************************
+{
+static EPL_ERRCNT_HARVESTER harvester;
+PEPL_PORT_HANDLE port0, port1;
+PEPL_SIM_PHY simPhy0, simPhy1;
+EPL_ERRCNT_SAMPLE sample;
+NS_UINT32 reads, pageSelects, rate;
+NS_UINT x;
+
+    port0 = AddPort( 0);
+    port1 = AddPort( 1);
+    simPhy0 = EPLSimGetPhy( 1);
+    simPhy1 = EPLSimGetPhy( 2);
+    EPLSimAddRxErrors( simPhy0, 5, 5);
+
+    // Adding a port clears its counters
+    EPLErrCntInit( &harvester);
+    EXPECT( EPLErrCntAddPort( &harvester, port0) == NS_STATUS_SUCCESS);
+    EXPECT( EPLErrCntAddPort( &harvester, port1) == NS_STATUS_SUCCESS);
+
+    reads = simPhy0->readCount + simPhy1->readCount;
+    pageSelects = simPhy0->pageSelectCount + simPhy1->pageSelectCount;
+    for ( x = 0; x < 100; x++)
+    {
+        EPLSimAdvanceTime( 100000000);
+        EPLSimAddRxErrors( simPhy0, 3, 1);
+        if ( x == 80)
+            EPLSimAddRxErrors( simPhy1, 0, 1000);
+        EPLErrCntHarvest( &harvester);
+    }
+    reads = simPhy0->readCount + simPhy1->readCount - reads;
+    pageSelects = simPhy0->pageSelectCount + simPhy1->pageSelectCount - pageSelects;
+    EXPECT( reads == 400 && pageSelects == 0);
+
+    EXPECT( EPLErrCntGetTotal( &harvester, port0, ERRCNT_FALSE_CARRIER) == 300);
+    EXPECT( EPLErrCntGetTotal( &harvester, port0, ERRCNT_RX_ERROR) == 100);
+    EXPECT( EPLErrCntGetTotal( &harvester, port1, ERRCNT_RX_ERROR) == ERRCNT_HW_MAX);
+    EXPECT( harvester.ports[1].saturations[ERRCNT_RX_ERROR] == 1);
+
+    // The burst was harvested 19 intervals before the last one
+    EXPECT( EPLErrCntGetHistory( &harvester, port1, 19, &sample) == NS_STATUS_SUCCESS);
+    EXPECT( sample.delta[ERRCNT_RX_ERROR] == ERRCNT_HW_MAX);
+    EXPECT( sample.saturated == (1 << ERRCNT_RX_ERROR));
+    EXPECT( sample.intervalUs >= 99000 && sample.intervalUs <= 101000);
+    EXPECT( EPLErrCntGetHistory( &harvester, port1, ERRCNT_HISTORY_LEN, &sample) != NS_STATUS_SUCCESS);
+
+    // 3 false carrier events per 100 ms
+    rate = EPLErrCntGetRate( &harvester, port0, ERRCNT_FALSE_CARRIER, 10);
+    EXPECT( rate > 29700 && rate < 30300);
+
+    printf( "%lu reads, %lu page selects, burst flagged, %.2f events/s\n",
+            (unsigned long)reads, (unsigned long)pageSelects, rate / 1000.0);
+    return TRUE;
+}
+
+//****************************************************************************
+static NS_BOOL
+    CheckMdioScheduler( void)
+//  A 300-op configuration burst is interrupted by a TXTS read and an atomic
+//  PTP_TDR/PTP_CTL sequence, 20 times: the read must wait for one group at
+//  most (under 130 us, 5 MDIO frames, against a 200 us deadline). Then the
+//  port is attached to the scheduler and the timestamp, event, link quality
+//  and error counter reads must go through it and return the same data, an
+//  event read as one request of PTP_ESTS and only the PTP_EDATA it
+//  announces.
+//****************************************************************************
+{
+static EPL_MDIO_SCHED sched;
+static EPL_MDIO_OP configOps[300], tsOps[MDIO_TXTS_OPS], tdrOps[6];
+static EPL_LQ_MONITOR monitor;
+static EPL_ERRCNT_HARVESTER harvester;
+EPL_MDIO_REQUEST configRequest, tsRequest, tdrRequest;
+EPL_MDIO_CLASS_STATS stats[MDIO_NUM_CLASSES];
+PEPL_PORT_HANDLE port;
+PEPL_SIM_PHY simPhy;
+EPL_LQ_STATS lqStats;
+NS_UINT32 seconds, nanoSeconds;
+NS_UINT overflow, sequenceId, hash, x, y, eventBits, riseFlags, missed;
+NS_UINT32 operations;
+NS_UINT8 messageType;
+
+    port = AddPort( 0);
+    simPhy = EPLSimGetPhy( 1);
+    EPLMdioInitScheduler( &sched, &oaiDev);
+    EPLMdioSetDeadline( &sched, MDIO_CLASS_TIMESTAMP, 200);
+
+    // Configuration writes in atomic groups of three
+    for ( x = 0; x < 300; x++)
+    {
+        configOps[x].flags = MDIO_OP_WRITE | ((x % 3 != 2) ? MDIO_OP_CHAIN : 0);
+        configOps[x].registerIndex = PHY_PG5_PTP_RXCFG0;
+        configOps[x].value = x;
+    }
+    for ( x = 0; x < 6; x++)
+    {
+        tdrOps[x].flags = MDIO_OP_WRITE;
+        tdrOps[x].registerIndex = (x < 5) ? PHY_PG4_PTP_TDR : PHY_PG4_PTP_CTL;
+        tdrOps[x].value = x;
+    }
+
+    simPhy->txTs.seconds[0] = 0x12345678;
+    simPhy->txTs.nanoSeconds[0] = 123456789;
+    simPhy->txTs.count = 1;
+    for ( x = 0; x < 20; x++)
+    {
+        EPLMdioInitRequest( &configRequest, port, MDIO_CLASS_CONFIG, configOps, 300, FALSE);
+        EPLMdioSubmit( &sched, &configRequest);
+        for ( y = 0; y < 5; y++)
+            EPLMdioService( &sched, 1);
+        EPLMdioPrepareTxTimestamp( &tsRequest, port, tsOps);
+        EPLMdioSubmit( &sched, &tsRequest);
+        EPLMdioInitRequest( &tdrRequest, port, MDIO_CLASS_SERVO, tdrOps, 6, TRUE);
+        EPLMdioSubmit( &sched, &tdrRequest);
+        while ( EPLMdioService( &sched, 10))
+            ;
+        EXPECT( configRequest.done && tsRequest.done && tdrRequest.done);
+        if ( x == 0)
+        {
+            EPLMdioGetTxTimestamp( &tsRequest, &seconds, &nanoSeconds, &overflow);
+            EXPECT( seconds == 0x12345678 && nanoSeconds == 123456789 && overflow == 0);
+        }
+    }
+    for ( x = 0; x < MDIO_NUM_CLASSES; x++)
+        EPLMdioGetStats( &sched, x, &stats[x]);
+    EXPECT( stats[MDIO_CLASS_TIMESTAMP].requests == 20);
+    EXPECT( stats[MDIO_CLASS_TIMESTAMP].maxCompleteUs < 130);
+    EXPECT( stats[MDIO_CLASS_TIMESTAMP].deadlineMisses == 0);
+    EXPECT( stats[MDIO_CLASS_SERVO].requests == 20 && stats[MDIO_CLASS_SERVO].operations == 120);
+    EXPECT( stats[MDIO_CLASS_CONFIG].operations == 6000);
+    EXPECT( oaiDev.multiOpMutex == 0 && oaiDev.regularMutex == 0);
+    printf( "TXTS behind config done in %lu us; ", (unsigned long)stats[MDIO_CLASS_TIMESTAMP].maxCompleteUs);
+
+    // Attached port: the PTP and monitor reads are scheduled
+    EPLMdioInitScheduler( &sched, &oaiDev);
+    EPLMdioAttachPort( port, &sched);
+    simPhy->txTs.seconds[0] = 0x12345678;
+    simPhy->txTs.nanoSeconds[0] = 123456789;
+    simPhy->txTs.count = 1;
+    simPhy->rxTs.seconds[0] = 0x1234567A;
+    simPhy->rxTs.nanoSeconds[0] = 5;
+    simPhy->rxTs.sequenceId[0] = 77;
+    simPhy->rxTs.typeHash[0] = 0x1ABC;
+    simPhy->rxTs.count = 1;
+    EXPECT( PTPCheckForEvents( port) == (PTPEVT_TRANSMIT_TIMESTAMP_BIT | PTPEVT_RECEIVE_TIMESTAMP_BIT));
+    PTPGetTransmitTimestamp( port, &seconds, &nanoSeconds, &overflow);
+    EXPECT( seconds == 0x12345678 && nanoSeconds == 123456789);
+    PTPGetReceiveTimestamp( port, &seconds, &nanoSeconds, &overflow, &sequenceId, &messageType, &hash);
+    EXPECT( seconds == 0x1234567A && nanoSeconds == 5);
+    EXPECT( sequenceId == 77 && messageType == 1 && hash == 0xABC);
+
+    EPLMdioGetStats( &sched, MDIO_CLASS_TIMESTAMP, &stats[0]);
+    operations = stats[0].operations;
+    simPhy->pageRegs[4][(PHY_PG4_PTP_ESTS & 0x1F) - 0x14] =
+        P640_EVENT_DET | P640_EVNT_RF | (3 << P640_EVNT_NUM_SHIFT) | (2 << P640_EVNTS_MISSED_SHIFT);
+    simPhy->pageRegs[4][(PHY_PG4_PTP_EDATA & 0x1F) - 0x14] = 0x1234;
+    EXPECT( PTPGetEvent( port, &eventBits, &riseFlags, &seconds, &nanoSeconds, &missed));
+    EXPECT( eventBits == 0x08 && riseFlags == 0x08 && missed == 2);
+    EXPECT( seconds == 0x12341234 && nanoSeconds == 0x12341234 - PIN_INPUT_DELAY);
+    simPhy->pageRegs[4][(PHY_PG4_PTP_ESTS & 0x1F) - 0x14] = 0;
+    EXPECT( !PTPGetEvent( port, &eventBits, &riseFlags, &seconds, &nanoSeconds, &missed));
+    EXPECT( !eventBits && !missed);
+    EPLMdioGetStats( &sched, MDIO_CLASS_TIMESTAMP, &stats[0]);
+    EXPECT( stats[0].operations - operations == 5 + 1);
+
+    EPLLqInitMonitor( &monitor, 1000, LQ_DEFAULT_MDIO_OPS_PER_SEC, NULL, NULL);
+    EXPECT( EPLLqAddPort( &monitor, port, LQ_PARAM_ALL) == NS_STATUS_SUCCESS);
+    EPLSimSetLinkQuality( simPhy, LQ_PARAM_C1, -20);
+    EPLSimAdvanceTime( 10000000);
+    EPLLqPoll( &monitor);
+    EXPECT( EPLLqGetStats( &monitor, port, LQ_PARAM_C1, &lqStats) == NS_STATUS_SUCCESS);
+    EXPECT( lqStats.samples == 1 && lqStats.last == -20);
+
+    EPLErrCntInit( &harvester);
+    EXPECT( EPLErrCntAddPort( &harvester, port) == NS_STATUS_SUCCESS);
+    EPLSimAddRxErrors( simPhy, 3, 5);
+    EPLErrCntHarvest( &harvester);
+    EXPECT( EPLErrCntGetTotal( &harvester, port, ERRCNT_FALSE_CARRIER) == 3);
+    EXPECT( EPLErrCntGetTotal( &harvester, port, ERRCNT_RX_ERROR) == 5);
+
+    for ( x = 0; x < MDIO_NUM_CLASSES; x++)
+        EPLMdioGetStats( &sched, x, &stats[x]);
+    EXPECT( stats[MDIO_CLASS_TIMESTAMP].requests == 5);
+    EXPECT( stats[MDIO_CLASS_MONITOR].requests >= 2);
+    EXPECT( oaiDev.multiOpMutex == 0 && oaiDev.regularMutex == 0);
+    printf( "attached: %lu timestamp and %lu monitor requests\n",
+            (unsigned long)stats[MDIO_CLASS_TIMESTAMP].requests,
+            (unsigned long)stats[MDIO_CLASS_MONITOR].requests);
+    return TRUE;
+}
+
+//****************************************************************************
+static NS_BOOL
+    E2EOffsetFilter(
+        void *context,
+        NS_SINT64 *value)
+//  Rejects offsets beyond -1 ms.
+//****************************************************************************
+{
+    (void)context;
+    return *value > E2E_NS_TO_SCALED( -1000000);
+}
+
+//****************************************************************************
+static NS_BOOL
+    CheckE2E( void)
+//  10 minutes of 128 Sync/s and 8 Delay_Req/s with +/-20 ns receive noise,
+//  1% of the Syncs lost, the two halves of each exchange in random order
+//  and every 1000th Sync an outlier the offset filter rejects: each offset
+//  reported must be the programmed one within the noise and the delay
+//  estimate's error, and a rejected Sync must leave no sample.
+//****************************************************************************
+{
+static EPL_E2E_ENGINE engine;
+EPL_E2E_SAMPLE sample;
+NS_UINT32 t1s, t1n, t2s, t2n, t3s, t3n, t4s, t4n, samples = 0, rejected = 0;
+NS_SINT64 offset, error, maxError = 0, delayError, correction;
+NS_BOOL lost, done;
+NS_UINT x;
+
+    randomSeed = 1;
+    EPLE2EInit( &engine);
+    EPLE2ESetFilter( &engine, E2E_FILTER_OFFSET, E2EOffsetFilter, NULL);
+
+    // 100.5 ns of residence time in the correctionField
+    correction = E2E_NS_TO_SCALED( 100) + (1 << 15);
+    for ( x = 0; x < 128 * 600; x++)
+    {
+        offset = (x % 1000 == 999) ? -2000000 : -123456;
+        t1s = 1000 + x / 128;
+        t1n = (x % 128) * 7812500;
+        t2s = t1s;
+        t2n = t1n;
+        AddNs( &t2s, &t2n, 2500 + offset + 100 + (NS_SINT32)Random( 41) - 20);
+        lost = (Random( 100) == 0);
+        if ( Random( 2))
+        {
+            if ( !lost)
+                EPLE2ESyncReceived( &engine, (NS_UINT16)x, t2s, t2n);
+            done = EPLE2ESyncOrigin( &engine, (NS_UINT16)x, t1s, t1n, correction);
+        }
+        else
+        {
+            done = EPLE2ESyncOrigin( &engine, (NS_UINT16)x, t1s, t1n, correction);
+            if ( !lost)
+                done = EPLE2ESyncReceived( &engine, (NS_UINT16)x, t2s, t2n);
+        }
+
+        if ( done)
+        {
+            EXPECT( EPLE2EGetSample( &engine, &sample));
+            delayError = E2E_SCALED_TO_NS( engine.meanPathDelay) - 2500;
+            error = E2E_SCALED_TO_NS( sample.offset) - offset;
+            EXPECT( error <= 21 + (delayError < 0 ? -delayError : delayError));
+            EXPECT( error >= -21 - (delayError < 0 ? -delayError : delayError));
+            if ( error < 0) error = -error;
+            if ( error > maxError) maxError = error;
+            samples++;
+        }
+        else if ( !lost && engine.haveDelay)
+        {
+            EXPECT( !EPLE2EGetSample( &engine, &sample));
+            rejected++;
+        }
+
+        if ( x % 16 == 0)
+        {
+            t3s = t2s;
+            t3n = t2n;
+            AddNs( &t3s, &t3n, 1000);
+            t4s = t3s;
+            t4n = t3n;
+            AddNs( &t4s, &t4n, 2500 - offset);
+            if ( Random( 2))
+            {
+                EPLE2EDelayReqSent( &engine, (NS_UINT16)(x / 16), t3s, t3n);
+                EPLE2EDelayResp( &engine, (NS_UINT16)(x / 16), t4s, t4n, 0);
+            }
+            else
+            {
+                EPLE2EDelayResp( &engine, (NS_UINT16)(x / 16), t4s, t4n, 0);
+                EPLE2EDelayReqSent( &engine, (NS_UINT16)(x / 16), t3s, t3n);
+            }
+        }
+    }
+    EXPECT( engine.stats.unmatched == 0);
+    EXPECT( rejected == engine.stats.offsetsRejected && rejected > 0);
+    // The first Sync comes before the first delay measurement
+    EXPECT( samples + rejected + 1 == engine.stats.syncs);
+
+    printf( "%lu samples within %ld ns, delay %ld ns, %lu rejected without a sample\n",
+            (unsigned long)samples, (long)maxError, (long)E2E_SCALED_TO_NS( engine.meanPathDelay),
+            (unsigned long)rejected);
+    return TRUE;
+}
+
+//****************************************************************************
+static NS_BOOL
+    CheckP2P( void)
+//  Three ports at +50/-80/0 ppm from their neighbors over 500/1200/300 ns
+//  links with +/-8 ns timestamp noise, one Pdelay exchange per second for
+//  two minutes. The first two neighbors answer two-step and the first
+//  steps its clock by 5 s halfway; the third answers one-step and loses
+//  five responses in a row. Once the delay filter has settled (20 s) the
+//  delays must stay within 3 ns and the ratios within 2 ppb, and the lost
+//  responses must invalidate the third link until it answers again.
+//****************************************************************************
+{
+static const NS_SINT32 ppm[3] = { 50, -80, 0 };
+static const NS_SINT64 delayNs[3] = { 500, 1200, 300 };
+EPL_P2P_ENGINE engines[3];
+EPL_P2P_CFG config;
+NS_SINT64 t1, t2, t3, t4, linkDelay, error, maxError = 0, neighborOffset;
+NS_SINT32 ratioPpb, maxRatioError = 0;
+NS_UINT32 seconds, nanoSeconds, seconds2, nanoSeconds2;
+NS_UINT16 sequenceId;
+NS_UINT x, port;
+NS_BOOL valid;
+
+    randomSeed = 1;
+    EPLP2PGetDefaultConfig( &config);
+    for ( port = 0; port < 3; port++)
+        EPLP2PInit( &engines[port], &config);
+
+    for ( x = 0; x < 120; x++)
+    {
+        for ( port = 0; port < 3; port++)
+        {
+            EXPECT( EPLP2PStartRequest( &engines[port], &sequenceId));
+            neighborOffset = (port == 0 && x >= 60) ? 12000000000LL : 7000000000LL;
+            t1 = (NS_SINT64)EPLSimGetTime() + 1000000 + Random( 40);
+            t2 = (NS_SINT64)((t1 + delayNs[port]) * (1 + ppm[port] * 1e-6)) +
+                 neighborOffset + (NS_SINT32)Random( 16) - 8;
+            t3 = t2 + 123456;
+            t4 = (NS_SINT64)((t3 - neighborOffset) / (1 + ppm[port] * 1e-6)) +
+                 delayNs[port] + (NS_SINT32)Random( 16) - 8;
+            EPLP2PReqSent( &engines[port], sequenceId, (NS_UINT32)(t1 / 1000000000),
+                           (NS_UINT32)(t1 % 1000000000));
+            if ( port == 2 && x >= 100 && x < 105)
+                continue;
+
+            seconds = (NS_UINT32)(t4 / 1000000000);
+            nanoSeconds = (NS_UINT32)(t4 % 1000000000);
+            seconds2 = (NS_UINT32)(t2 / 1000000000);
+            nanoSeconds2 = (NS_UINT32)(t2 % 1000000000);
+            if ( port == 2)
+            {
+                EPLP2PRespReceived( &engines[port], sequenceId, seconds, nanoSeconds, 0, 0,
+                                    E2E_NS_TO_SCALED( t3 - t2), FALSE);
+            }
+            else
+            {
+                EPLP2PRespReceived( &engines[port], sequenceId, seconds, nanoSeconds,
+                                    seconds2, nanoSeconds2, 0, TRUE);
+                EPLP2PRespFollowUp( &engines[port], sequenceId, (NS_UINT32)(t3 / 1000000000),
+                                    (NS_UINT32)(t3 % 1000000000), 0);
+            }
+        }
+        EPLSimAdvanceTime( 1000000000);
+
+        for ( port = 0; port < 3; port++)
+        {
+            valid = EPLP2PGetLinkDelay( &engines[port], &linkDelay, &ratioPpb);
+            if ( port == 2 && x == 104)
+            {
+                EXPECT( !valid);
+                continue;
+            }
+            EXPECT( valid);
+            error = E2E_SCALED_TO_NS( linkDelay) - delayNs[port];
+            if ( error < 0) error = -error;
+            if ( x >= 20 && error > maxError) maxError = error;
+            if ( x >= P2P_RATIO_WINDOW)
+            {
+                ratioPpb -= ppm[port] * 1000;
+                if ( ratioPpb < 0) ratioPpb = -ratioPpb;
+                if ( ratioPpb > maxRatioError) maxRatioError = ratioPpb;
+            }
+        }
+    }
+    EXPECT( maxError <= 3 && maxRatioError <= 2);
+    EXPECT( engines[2].stats.lost == 5 && engines[0].stats.lost == 0);
+    EXPECT( engines[0].stats.completed == 120 && engines[2].stats.completed == 115);
+
+    printf( "delays within %ld ns, ratios within %ld ppb, 5 lost responses\n",
+            (long)maxError, (long)maxRatioError);
+    return TRUE;
+}
+
+//****************************************************************************
+static void
+    TcMessage(
+        NS_UINT8 *ptpMessage,
+        NS_UINT8 messageType,
+        NS_UINT16 sequenceId,
+        NS_UINT8 identity)
+//  Builds a two-step PTPv2 header from one sourcePortIdentity byte.
+//****************************************************************************
+{
+    memset( ptpMessage, 0, 64);
+    ptpMessage[PTP_HDR_MSG_TYPE_OFFSET] = messageType;
+    ptpMessage[1] = 2;
+    ptpMessage[PTP_HDR_FLAGS_OFFSET] = PTP_FLAG_TWO_STEP;
+    memset( &ptpMessage[PTP_HDR_SOURCE_PORT_ID_OFFSET], identity, PTP_PORT_ID_LENGTH);
+    ptpMessage[PTP_HDR_SEQUENCE_ID_OFFSET] = (NS_UINT8)(sequenceId >> 8);
+    ptpMessage[PTP_HDR_SEQUENCE_ID_OFFSET + 1] = (NS_UINT8)sequenceId;
+}
+
+//****************************************************************************
+static NS_SINT64
+    TcCorrectionNs(
+        NS_UINT8 *ptpMessage)
+//****************************************************************************
+{
+NS_UINT64 correction = 0;
+NS_UINT x;
+
+    for ( x = 0; x < 8; x++)
+        correction = (correction << 8) | ptpMessage[PTP_HDR_CORRECTION_OFFSET + x];
+    return E2E_SCALED_TO_NS( (NS_SINT64)correction);
+}
+
+//****************************************************************************
+static NS_BOOL
+    CheckTransparentClock( void)
+//  A Sync received on port 0 just before a seconds rollover is flooded out
+//  of ports 1 and 2, and a Delay_Req received on port 2 goes out of port 0,
+//  with different receive/transmit latencies and clock offsets on each
+//  port. The Follow_Up and Delay_Resp corrections must equal the residence
+//  times worked out below, and only once each egress timestamp is known.
+//****************************************************************************
+{
+static EPL_TC tc;
+NS_UINT8 sync[64], followUp1[64], followUp2[64], delayReq[64], delayResp[64];
+
+    EXPECT( EPLTCInit( &tc, TC_MODE_E2E, 3) == NS_STATUS_SUCCESS);
+    EPLTCSetPortLatency( &tc, 0, 210, 100);
+    EPLTCSetPortLatency( &tc, 1, 180, 90);
+    EPLTCSetPortLatency( &tc, 2, 240, 110);
+    EPLTCSetPortOffset( &tc, 0, E2E_NS_TO_SCALED( -25));
+    EPLTCSetPortOffset( &tc, 1, E2E_NS_TO_SCALED( 40));
+
+    TcMessage( sync, PTP_MSG_SYNC, 7, 0x11);
+    TcMessage( followUp1, PTP_MSG_FOLLOW_UP, 7, 0x11);
+    followUp1[PTP_HDR_CORRECTION_OFFSET + 5] = 5;
+    TcMessage( followUp2, PTP_MSG_FOLLOW_UP, 7, 0x11);
+
+    // Port 1 at 256.000010040 is 11040 ns after port 0 at 255.999999000:
+    // 11040 - 40 (port 1 ahead) - 25 (port 0 behind) + 210 (rx port 0) +
+    // 90 (tx port 1) = 11275 ns. Port 2 at 256.000012000 is
+    // 13000 - 25 + 210 + 110 = 13295 ns.
+    EXPECT( EPLTCEventIngress( &tc, 0, sync, 255, 999999000));
+    EXPECT( EPLTCEventEgress( &tc, 1, sync, 256, 10040));
+    EXPECT( EPLTCPatchGeneral( &tc, 2, 0, followUp2) == NS_STATUS_FAILURE);
+    EXPECT( EPLTCEventEgress( &tc, 2, sync, 256, 12000));
+    EXPECT( EPLTCPatchGeneral( &tc, 1, 0, followUp1) == NS_STATUS_SUCCESS);
+    EXPECT( TcCorrectionNs( followUp1) == 5 + 11275);
+    EXPECT( EPLTCPatchGeneral( &tc, 2, 0, followUp2) == NS_STATUS_SUCCESS);
+    EXPECT( TcCorrectionNs( followUp2) == 13295);
+    EXPECT( EPLTCPatchGeneral( &tc, 2, 0, followUp2) == NS_STATUS_FAILURE);
+
+    // 2000 + 25 + 240 (rx port 2) + 100 (tx port 0) = 2365 ns, applied to
+    // the Delay_Resp received on port 0 and sent back out of port 2 only
+    TcMessage( delayReq, PTP_MSG_DELAY_REQ, 3, 0x22);
+    TcMessage( delayResp, PTP_MSG_DELAY_RESP, 3, 0x11);
+    memset( &delayResp[PTP_REQ_PORT_ID_OFFSET], 0x22, PTP_PORT_ID_LENGTH);
+    EXPECT( EPLTCEventIngress( &tc, 2, delayReq, 10, 500));
+    EXPECT( EPLTCEventEgress( &tc, 0, delayReq, 10, 2500));
+    EXPECT( EPLTCPatchGeneral( &tc, 1, 0, delayResp) == NS_STATUS_FAILURE);
+    EXPECT( EPLTCPatchGeneral( &tc, 2, 1, delayResp) == NS_STATUS_FAILURE);
+    EXPECT( EPLTCPatchGeneral( &tc, 2, 0, delayResp) == NS_STATUS_SUCCESS);
+    EXPECT( TcCorrectionNs( delayResp) == 2365);
+
+    // Peer-to-peer: the ingress link delay is added to Sync, and Delay_Resp
+    // is left alone
+    EXPECT( EPLTCInit( &tc, TC_MODE_P2P, 2) == NS_STATUS_SUCCESS);
+    EPLTCSetLinkDelay( &tc, 0, E2E_NS_TO_SCALED( 500));
+    TcMessage( followUp1, PTP_MSG_FOLLOW_UP, 7, 0x11);
+    EXPECT( EPLTCEventIngress( &tc, 0, sync, 20, 1000));
+    EXPECT( EPLTCEventEgress( &tc, 1, sync, 20, 4000));
+    EXPECT( EPLTCPatchGeneral( &tc, 1, 0, followUp1) == NS_STATUS_SUCCESS);
+    EXPECT( TcCorrectionNs( followUp1) == 3500);
+    EXPECT( EPLTCPatchGeneral( &tc, 1, 0, delayResp) == NS_STATUS_NOT_SUPPORTED);
+
+    printf( "Follow_Up and Delay_Resp corrections exact across a rollover\n");
+    return TRUE;
+}
+
+//****************************************************************************
+static NS_BOOL
+    CheckBoardSync( void)
+//  Eight followers at -50..+37.5 ppm and up to 12 us from the leader, with
+//  +/-4 ns timestamp noise on each edge, for a minute of 1 s edges. Every
+//  follower must be within 25 ns from the 13th edge on and, over the last
+//  30 edges, hold an RMS offset under 4 ns and a rate within 7 ppb of its
+//  oscillator error without stepping. A poll with no events pending must
+//  cost 13 MDIO operations.
+//  Then a follower whole seconds off must be stepped back, and missed
+//  edges and a follower a second behind must be told apart.
+//****************************************************************************
+{
+static EPL_BSYNC bsync;
+EPL_BSYNC_CFG config;
+EPL_BSYNC_STATS stats;
+PEPL_PORT_HANDLE leader;
+NS_SINT64 offset[8], ppbError[8], edgeNs;
+NS_UINT32 steps, worstLocked = 0, worstMeanSquare = 0, worstRate = 0, mdioCount;
+NS_UINT32 seconds, nanoSeconds;
+NS_UINT x, k, index;
+
+    randomSeed = 1;
+    leader = AddPort( 0);
+    for ( k = 0; k < 8; k++)
+    {
+        AddPort( k + 1);
+        offset[k] = ((NS_SINT64)k - 4) * 3000;
+        ppbError[k] = ((NS_SINT64)k - 4) * 12500;
+    }
+
+    EPLBSyncGetDefaultConfig( &config);
+    config.triggerGpio = 1;
+    EXPECT( EPLBSyncInit( &bsync, leader, &config) == NS_STATUS_SUCCESS);
+    for ( k = 0; k < 8; k++)
+        EXPECT( EPLBSyncAddFollower( &bsync, &ports[k + 1], 2, &index) == NS_STATUS_SUCCESS);
+    EXPECT( EPLBSyncStart( &bsync) == NS_STATUS_SUCCESS);
+    PTPClockReadCurrent( leader, &seconds, &nanoSeconds);
+
+    for ( x = 0; x < 60; x++)
+    {
+        for ( k = 0; k < 8; k++)
+        {
+            EPLBSyncGetStats( &bsync, k, &stats);
+            steps = stats.steps;
+            offset[k] += ppbError[k] + stats.freqPpb;
+            edgeNs = (NS_SINT64)(seconds + 2 + x) * 1000000000 + offset[k] +
+                     (NS_SINT32)Random( 9) - 4;
+            EPLBSyncEventSample( &bsync, k, (NS_UINT32)(edgeNs / 1000000000),
+                                 (NS_UINT32)(edgeNs % 1000000000), 0);
+            EPLBSyncGetStats( &bsync, k, &stats);
+            if ( stats.steps != steps)
+                offset[k] -= stats.lastOffsetNs;
+            if ( x >= 12 && (NS_UINT32)llabs( offset[k]) > worstLocked)
+                worstLocked = (NS_UINT32)llabs( offset[k]);
+        }
+        if ( x == 29)
+            EPLBSyncResetStats( &bsync);
+    }
+    EXPECT( worstLocked <= 25);
+
+    for ( k = 0; k < 8; k++)
+    {
+        EPLBSyncGetStats( &bsync, k, &stats);
+        EXPECT( stats.steps == 0 && stats.samples == 30);
+        if ( stats.sumSquaresNs / stats.samples > worstMeanSquare)
+            worstMeanSquare = (NS_UINT32)(stats.sumSquaresNs / stats.samples);
+        if ( (NS_UINT32)llabs( stats.freqPpb + ppbError[k]) > worstRate)
+            worstRate = (NS_UINT32)llabs( stats.freqPpb + ppbError[k]);
+    }
+    EXPECT( worstMeanSquare < 16 && worstRate <= 7);
+
+    mdioCount = 0;
+    for ( k = 0; k < 8; k++)
+        mdioCount -= ports[k + 1].mdioAccessCount;
+    EPLBSyncPoll( &bsync);
+    for ( k = 0; k < 8; k++)
+        mdioCount += ports[k + 1].mdioAccessCount;
+    EXPECT( mdioCount == 13);
+
+    // An edge reported 3 s and 500 ns late: the follower is stepped back
+    // the whole seconds on the spot. Missed edges are not a second error,
+    // an edge a second late is.
+    EPLSimReset();
+    EPLSimAdvanceTime( 5000000000ULL);
+    leader = AddPort( 0);
+    AddPort( 1);
+    EXPECT( EPLBSyncInit( &bsync, leader, &config) == NS_STATUS_SUCCESS);
+    EXPECT( EPLBSyncAddFollower( &bsync, &ports[1], 2, &index) == NS_STATUS_SUCCESS);
+    EXPECT( EPLBSyncStart( &bsync) == NS_STATUS_SUCCESS);
+    PTPClockReadCurrent( leader, &seconds, &nanoSeconds);
+
+    EPLBSyncEventSample( &bsync, 0, seconds + 2 + 3, 500, 0);
+    EPLBSyncGetStats( &bsync, 0, &stats);
+    EXPECT( stats.secondErrors == 1);
+    EXPECT( EPLSimGetPhyTime( EPLSimGetPhy( 2)) / 1000000000 + 3 ==
+            EPLSimGetPhyTime( EPLSimGetPhy( 1)) / 1000000000);
+    for ( x = 1; x < 10; x++)
+        EPLBSyncEventSample( &bsync, 0, seconds + 2 + x, (x == 1) ? 200 : 100, 0);
+    EPLBSyncGetStats( &bsync, 0, &stats);
+    EXPECT( stats.secondErrors == 1 && stats.lastOffsetNs == 100);
+    EPLBSyncEventSample( &bsync, 0, seconds + 2 + 12, 50, 2);
+    EPLBSyncGetStats( &bsync, 0, &stats);
+    EXPECT( stats.secondErrors == 1 && stats.lastOffsetNs == 50);
+    EPLBSyncEventSample( &bsync, 0, seconds + 2 + 12, 10, 0);
+    EPLBSyncGetStats( &bsync, 0, &stats);
+    EXPECT( stats.secondErrors == 2);
+    EPLBSyncEventSample( &bsync, 0, seconds + 2 + 14, 20, 0);
+    EPLBSyncGetStats( &bsync, 0, &stats);
+    EXPECT( stats.lastOffsetNs == 20);
+
+    printf( "within %lu ns from edge 13, mean square %lu ns^2, rate within %lu ppb, "
+            "poll %lu MDIO\n", (unsigned long)worstLocked, (unsigned long)worstMeanSquare,
+            (unsigned long)worstRate, (unsigned long)mdioCount);
+    return TRUE;
+}
+
+//****************************************************************************
+static NS_UINT64
+    XtsTruth(
+        NS_UINT64 systemNs,
+        NS_SINT64 stepNs)
+//  PHC time at a system time for a PHC 37.25 ppm fast of the system clock.
+//****************************************************************************
+{
+    return 1700000000123456789ULL + systemNs + systemNs * 37250 / 1000000000 + stepNs;
+}
+
+//****************************************************************************
+static NS_BOOL
+    CheckCrossTimestamp( void)
+//  A system/PHC pair per second for 200 s, the PHC 37.25 ppm fast and
+//  stepped by 5 ms after 150 s, first with exact system timestamps and then
+//  with +/-50 ns of jitter on them. The rate must be exact to its 2^-32
+//  resolution without jitter and within 5 ppb with it, predictions 0.5 s past the last
+//  pair within 65 ns of the true PHC time (outside the window the step
+//  restarts) and PhcToSys must invert SysToPhc to within 1 ns.
+//****************************************************************************
+{
+static EPL_XTS xts;
+EPL_XTS_MAPPING mapping;
+NS_UINT64 systemNs, phcNs, queryNs, backNs;
+NS_SINT64 stepNs, error, maxError = 0, maxInverse = 0;
+NS_UINT32 seconds, nanoSeconds, jitterRange;
+NS_SINT32 rateError = 0;
+NS_UINT x;
+
+    randomSeed = 1;
+    for ( jitterRange = 1; jitterRange <= 101; jitterRange += 100)
+    {
+        EPLXtsInit( &xts, NULL, 0, 0);
+        systemNs = 5000000000ULL;
+        stepNs = 0;
+        for ( x = 0; x < 200; x++)
+        {
+            if ( x == 150)
+                stepNs = 5000000;
+            phcNs = XtsTruth( systemNs, stepNs);
+            EPLXtsAddPair( &xts,
+                           systemNs + (NS_SINT32)Random( jitterRange) - (NS_SINT32)jitterRange / 2,
+                           (NS_UINT32)(phcNs / 1000000000), (NS_UINT32)(phcNs % 1000000000));
+            if ( x >= 20 && (x < 150 || x > 152))
+            {
+                queryNs = systemNs + 500000000;
+                EXPECT( EPLXtsSysToPhc( &xts, queryNs, &seconds, &nanoSeconds));
+                error = (NS_SINT64)((NS_UINT64)seconds * 1000000000 + nanoSeconds -
+                                    XtsTruth( queryNs, stepNs));
+                if ( llabs( error) > maxError) maxError = llabs( error);
+                EXPECT( EPLXtsPhcToSys( &xts, seconds, nanoSeconds, &backNs));
+                if ( llabs( (NS_SINT64)(backNs - queryNs)) > maxInverse)
+                    maxInverse = llabs( (NS_SINT64)(backNs - queryNs));
+            }
+            systemNs += 1000000000;
+        }
+        EPLXtsGetMapping( &xts, &mapping);
+        EXPECT( xts.restarts == 1);
+        if ( jitterRange == 1)
+        {
+            // 37250 ppb is 159987.6 units of 2^-32
+            EXPECT( mapping.rate >= 159987 && mapping.rate <= 159988);
+            continue;
+        }
+        rateError = mapping.ratePpb - 37250;
+        EXPECT( rateError >= -5 && rateError <= 5);
+    }
+    EXPECT( maxError <= 65 && maxInverse <= 1);
+
+    printf( "rate exact, %ld ppb off with jitter, predictions within %ld ns, "
+            "inverse within %ld ns\n", (long)rateError, (long)maxError, (long)maxInverse);
+    return TRUE;
+}
+
+//****************************************************************************
+static NS_UINT32
+    OneStepSum(
+        NS_UINT8 *data,
+        NS_UINT length,
+        NS_UINT32 sum)
+//  Adds data to a ones' complement sum and returns it folded to 16 bits.
+//****************************************************************************
+{
+NS_UINT x;
+
+    for ( x = 0; x + 1 < length; x += 2)
+        sum += (NS_UINT32)(data[x] << 8) | data[x + 1];
+    if ( length & 1)
+        sum += (NS_UINT32)data[length - 1] << 8;
+    while ( sum >> 16)
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    return sum;
+}
+
+//****************************************************************************
+static NS_BOOL
+    OneStepUdpValid(
+        NS_UINT8 *frame,
+        PEPL_ONESTEP_FRAME frameInfo,
+        EPL_ONESTEP_TRANSPORT_ENUM transport)
+//  Returns TRUE if the UDP checksum of a frame built by EPLOneStepBuildSync()
+//  is valid, covering the pseudo header addresses.
+//****************************************************************************
+{
+NS_UINT8 *udp = &frame[frameInfo->udpOffset];
+NS_UINT udpLength = (NS_UINT)(udp[4] << 8) | udp[5];
+NS_UINT32 sum;
+
+    if ( transport == ONESTEP_IPV4)
+        sum = OneStepSum( &frame[14 + 12], 8, 17 + udpLength);
+    else
+        sum = OneStepSum( &frame[14 + 8], 32, 17 + udpLength);
+    return OneStepSum( udp, udpLength, sum) == 0xFFFF;
+}
+
+//****************************************************************************
+static NS_BOOL
+    CheckOneStep( void)
+//  1000 one-step Syncs per transport (L2, UDP/IPv4, UDP/IPv6) through the
+//  simulated PHY transmit path, each with a new sequenceId. The inserted
+//  originTimestamp must equal the PHY time, the UDP checksum must stay
+//  valid, and no transmit timestamp may be queued, TXTS_RDY must stay clear
+//  and no PHY register may be read. A two-step Sync must go out unmodified
+//  and its timestamp must be read back with PTPGetTransmitTimestamp().
+//****************************************************************************
+{
+PEPL_PORT_HANDLE port;
+PEPL_SIM_PHY simPhy;
+EPL_ONESTEP_CFG config;
+EPL_ONESTEP_FRAME frameInfo;
+EPL_ONESTEP_TRANSPORT_ENUM transport;
+NS_UINT8 frame[ONESTEP_MAX_FRAME_LENGTH], sent[ONESTEP_MAX_FRAME_LENGTH], *field;
+NS_UINT64 now;
+NS_UINT32 readCount, seconds, nanoSeconds;
+NS_UINT16 sequenceId;
+NS_UINT x, overflowCount;
+
+    port = AddPort( 0);
+    simPhy = EPLSimGetPhy( 1);
+    for ( transport = ONESTEP_L2; transport <= ONESTEP_IPV6; transport++)
+    {
+        EPLOneStepGetDefaultConfig( &config, transport);
+        for ( x = 0; x < 6; x++)
+            config.srcMac[x] = (NS_UINT8)(0x10 + x);
+        config.srcIp[0] = (transport == ONESTEP_IPV6) ? 0xFE : 192;
+        config.srcIp[1] = (transport == ONESTEP_IPV6) ? 0x80 : 168;
+        config.srcIp[(transport == ONESTEP_IPV6) ? 15 : 3] = 7;
+        for ( x = 0; x < PTP_PORT_ID_LENGTH; x++)
+            config.sourcePortIdentity[x] = (NS_UINT8)(0xA0 + x);
+        EPLOneStepConfigure( port, transport);
+        EXPECT( EPLOneStepBuildSync( &config, frame, sizeof( frame), &frameInfo) ==
+                NS_STATUS_SUCCESS);
+        if ( transport == ONESTEP_IPV4)
+            EXPECT( OneStepSum( &frame[14], 20, 0) == 0xFFFF);
+
+        readCount = simPhy->readCount;
+        for ( x = 0; x < 1000; x++)
+        {
+            sequenceId = (NS_UINT16)(x * 37 + 65000);
+            EPLOneStepSetSequenceId( &frameInfo, frame, sequenceId);
+            EPLSimAdvanceTime( 7812500 + x);
+            memcpy( sent, frame, frameInfo.length);
+            EXPECT( EPLSimTransmit( simPhy, sent, frameInfo.length));
+
+            now = EPLSimGetTime();
+            field = &sent[frameInfo.ptpOffset + ONESTEP_ORIGIN_TS_OFFSET];
+            EXPECT( field[0] == 0 && field[1] == 0);
+            seconds = ((NS_UINT32)field[2] << 24) | ((NS_UINT32)field[3] << 16) |
+                      ((NS_UINT32)field[4] << 8) | field[5];
+            nanoSeconds = ((NS_UINT32)field[6] << 24) | ((NS_UINT32)field[7] << 16) |
+                          ((NS_UINT32)field[8] << 8) | field[9];
+            EXPECT( seconds == now / 1000000000 && nanoSeconds == now % 1000000000);
+            EXPECT( sent[frameInfo.ptpOffset + PTP_HDR_SEQUENCE_ID_OFFSET] == (sequenceId >> 8) &&
+                    sent[frameInfo.ptpOffset + PTP_HDR_SEQUENCE_ID_OFFSET + 1] ==
+                    (NS_UINT8)sequenceId);
+            if ( transport != ONESTEP_L2)
+                EXPECT( OneStepUdpValid( sent, &frameInfo, transport));
+        }
+        EXPECT( simPhy->txTs.count == 0);
+        EXPECT( simPhy->readCount == readCount);
+        EXPECT( !(PTPCheckForEvents( port) & PTPEVT_TRANSMIT_TIMESTAMP_BIT));
+    }
+
+    // A two-step Sync on the same port is timestamped, not modified
+    frame[frameInfo.ptpOffset + PTP_HDR_FLAGS_OFFSET] |= PTP_FLAG_TWO_STEP;
+    memcpy( sent, frame, frameInfo.length);
+    EXPECT( !EPLSimTransmit( simPhy, sent, frameInfo.length));
+    now = EPLSimGetTime();
+    EXPECT( memcmp( sent, frame, frameInfo.length) == 0);
+    EXPECT( simPhy->txTs.count == 1);
+    EXPECT( PTPCheckForEvents( port) & PTPEVT_TRANSMIT_TIMESTAMP_BIT);
+    PTPGetTransmitTimestamp( port, &seconds, &nanoSeconds, &overflowCount);
+    EXPECT( seconds == now / 1000000000 && nanoSeconds == now % 1000000000);
+    EXPECT( overflowCount == 0 && simPhy->txTs.count == 0);
+
+    printf( "3000 Syncs stamped on the fly, checksums valid, no TXTS, no reads\n");
+    return TRUE;
+}
+
+//****************************************************************************
+static NS_BOOL
+    CheckExtend( void)
+//  20000 frames per inserted seconds length (none, 1 - 4 octets, and
+//  tsSecLen 4), starting just before a byte and a 32-bit seconds wrap.
+//  Time advances by up to 0.4 s with no seconds inserted, 90 s with one
+//  octet and 3000 s with more per frame. Every full timestamp must come
+//  back exact from PTPGetFullTimestampFromFrame() with no MDIO
+//  transactions, only the inserted octets may be cleared, and nothing may
+//  be extended without a reference.
+//****************************************************************************
+{
+PEPL_PORT_HANDLE port;
+PORT_OBJ noReference;
+RX_CFG_ITEMS rxCfgItems;
+NS_UINT8 frame[64];
+NS_UINT64 time, step, fullSeconds;
+NS_UINT32 mdioCount, nanoSeconds, seconds32;
+NS_UINT length, x, b, frames = 0;
+
+    port = AddPort( 0);
+    for ( length = 0; length <= 5; length++)
+    {
+        // length 0 is TS_SEC_EN clear, 1 - 4 insert that many octets
+        // (tsSecLen 0 - 3) and 5 passes tsSecLen 4, also 4 octets
+        memset( &rxCfgItems, 0, sizeof( rxCfgItems));
+        rxCfgItems.tsSecLen = length ? length - 1 : 0;
+        rxCfgItems.rxTsNanoSecOffset = 40;
+        rxCfgItems.rxTsSecondsOffset = 44;
+        PTPSetReceiveConfig( port, RXOPT_RX_TS_EN | RXOPT_TS_INSERT |
+                             (length ? RXOPT_TS_SEC_EN : 0), &rxCfgItems);
+        if ( length == 0)
+            step = 400000000ULL;
+        else if ( length == 1)
+            step = 90000000000ULL;
+        else
+            step = 3000000000000ULL;
+
+        time = 0x1FFFFFF00ULL * 1000000000 + 123;
+        PTPSetTimestampReference( port, 0x1FFFFFF00ULL, 100);
+        mdioCount = port->mdioAccessCount;
+        for ( x = 0; x < 20000; x++, frames++)
+        {
+            time += step / 2 + (x * 7919ULL % step) / 2;
+            memset( frame, 0xA5, sizeof( frame));
+            nanoSeconds = (NS_UINT32)(time % 1000000000);
+            seconds32 = (NS_UINT32)(time / 1000000000);
+            memcpy( &frame[40], &nanoSeconds, 4);
+            memcpy( &frame[44], &seconds32, port->rxTsSecBytes);
+            EXPECT( PTPGetFullTimestampFromFrame( port, frame, &fullSeconds, &nanoSeconds) ==
+                    NS_STATUS_SUCCESS);
+            EXPECT( fullSeconds == time / 1000000000 && nanoSeconds == time % 1000000000);
+            for ( b = 0; b < sizeof( frame); b++)
+                EXPECT( frame[b] == ((b >= 40 && b < 44 + port->rxTsSecBytes) ? 0 : 0xA5));
+        }
+        EXPECT( port->mdioAccessCount == mdioCount);
+    }
+
+    memset( &noReference, 0, sizeof( noReference));
+    noReference.oaiDevHandle = &oaiDev;
+    EXPECT( PTPExtendTimestamp( &noReference, 5, 8, 0, &fullSeconds) != NS_STATUS_SUCCESS);
+
+    printf( "%u frames exact across the wraps, no MDIO\n", frames);
+    return TRUE;
+}
+
+#define BATCH_FRAMES    256
+#define BATCH_STEP_NS   37000001ULL
+
+static NS_UINT8 batchBuffer[BATCH_FRAMES][160];
+static NS_UINT8 *batchFrames[BATCH_FRAMES];
+
+//****************************************************************************
+static void
+    BatchFill(
+        NS_UINT64 startNs,
+        NS_BOOL append)
+//  Writes the receive timestamps the PHY would have inserted (one seconds
+//  octet) into each frame, BATCH_STEP_NS apart from startNs.
+//****************************************************************************
+{
+NS_UINT64 time;
+NS_UINT8 *frame;
+NS_UINT x, b, nanoOffset, secondsOffset;
+
+    nanoOffset = append ? PTP_EVENT_PACKET_LENGTH + 3 : 20;
+    secondsOffset = append ? PTP_EVENT_PACKET_LENGTH + 3 + 4 : 16;
+    for ( x = 0; x < BATCH_FRAMES; x++)
+    {
+        time = startNs + x * BATCH_STEP_NS;
+        frame = batchFrames[x];
+        for ( b = 0; b < 4; b++)
+            frame[nanoOffset + b] = (NS_UINT8)((time % 1000000000) >> (8 * b));
+        frame[secondsOffset] = (NS_UINT8)(time / 1000000000);
+    }
+}
+
+//****************************************************************************
+static NS_BOOL
+    CheckBatch( void)
+//  256 frames at odd alignments, 37 ms apart, with the timestamp inserted
+//  in the message and appended after it. PTPGetTimestampsFromFrames() must
+//  return every time exactly, clear every timestamp field and agree with
+//  PTPGetFullTimestampFromFrame() frame by frame.
+//****************************************************************************
+{
+static NS_UINT64 batchTimes[BATCH_FRAMES];
+PEPL_PORT_HANDLE port;
+RX_CFG_ITEMS rxCfgItems;
+NS_UINT64 startNs = 0x123456789ULL * 1000000000 + 5, seconds;
+NS_UINT32 nanoSeconds;
+NS_UINT x, b;
+NS_BOOL append;
+
+    port = AddPort( 0);
+    for ( x = 0; x < BATCH_FRAMES; x++)
+        batchFrames[x] = &batchBuffer[x][1 + x % 3];
+
+    for ( append = FALSE; append <= TRUE; append++)
+    {
+        memset( batchBuffer, 0, sizeof( batchBuffer));
+        memset( &rxCfgItems, 0, sizeof( rxCfgItems));
+        rxCfgItems.rxTsNanoSecOffset = append ? 3 : 20;
+        rxCfgItems.rxTsSecondsOffset = append ? 4 : 16;
+        PTPSetReceiveConfig( port, RXOPT_RX_TS_EN | RXOPT_TS_INSERT | RXOPT_TS_SEC_EN |
+                             (append ? RXOPT_TS_APPEND : 0), &rxCfgItems);
+
+        PTPSetTimestampReference( port, startNs / 1000000000, 0);
+        BatchFill( startNs, append);
+        EXPECT( PTPGetTimestampsFromFrames( port, batchFrames, BATCH_FRAMES, batchTimes) ==
+                NS_STATUS_SUCCESS);
+        for ( x = 0; x < BATCH_FRAMES; x++)
+        {
+            EXPECT( batchTimes[x] == startNs + x * BATCH_STEP_NS);
+            for ( b = 0; b < sizeof( batchBuffer[x]); b++)
+                EXPECT( batchBuffer[x][b] == 0);
+        }
+
+        PTPSetTimestampReference( port, startNs / 1000000000, 0);
+        BatchFill( startNs, append);
+        for ( x = 0; x < BATCH_FRAMES; x++)
+        {
+            EXPECT( PTPGetFullTimestampFromFrame( port, batchFrames[x], &seconds,
+                                                  &nanoSeconds) == NS_STATUS_SUCCESS);
+            EXPECT( seconds * 1000000000 + nanoSeconds == batchTimes[x]);
+        }
+    }
+
+    printf( "%u misaligned frames per mode exact and cleared\n", BATCH_FRAMES);
+    return TRUE;
+}
+
+//****************************************************************************
+static NS_BOOL
+    SlewRun(
+        NS_SINT64 offsetNs,
+        NS_SINT32 normalRate,
+        NS_BOOL useTrigger,
+        NS_UINT32 pollMs,
+        NS_UINT *segments,
+        double *errorNs)
+//  Slews a fresh simulated PHY running at normalRate by offsetNs, serviced
+//  every pollMs from the timer or on the trigger, and returns the segments
+//  used and how far the clock ended up from the target.
+//****************************************************************************
+{
+PEPL_PORT_HANDLE port;
+PEPL_SIM_PHY simPhy;
+EPL_SLEW slew;
+EPL_SLEW_CFG config;
+PTP_TIME finishTime, now;
+NS_UINT64 startTime, startClock, phyTime;
+
+    EPLSimReset();
+    port = AddPort( 0);
+    simPhy = EPLSimGetPhy( 1);
+    EPLSimAdvanceTime( 1000000000ULL * 1000 + 123);
+    PTPClockSetRateAdjustment( port, (NS_UINT32)(normalRate < 0 ? -normalRate : normalRate),
+                               FALSE, normalRate < 0);
+    EPLSlewGetDefaultConfig( &config);
+    if ( useTrigger)
+        config.trigger = 2;
+
+    startTime = EPLSimGetTime();
+    startClock = EPLSimGetPhyTime( simPhy);
+    if ( EPLSlewStart( &slew, port, &config, offsetNs, normalRate, &finishTime) !=
+         NS_STATUS_SUCCESS)
+        return FALSE;
+    *segments = slew.numSegments;
+
+    for ( ;;)
+    {
+        EPLSimAdvanceTime( pollMs * 1000000ULL);
+        if ( useTrigger)
+        {
+            if ( !(PTPCheckForEvents( port) & PTPEVT_TRIGGER_DONE_BIT))
+                continue;
+            PTPHasTriggerExpired( port, 2);
+            if ( !EPLSlewService( &slew, NULL, NULL))
+                break;
+        }
+        else
+        {
+            phyTime = EPLSimGetPhyTime( simPhy);
+            now.seconds = phyTime / 1000000000;
+            now.nanoSeconds = phyTime % 1000000000;
+            if ( !EPLSlewService( &slew, &now, NULL))
+                break;
+        }
+    }
+
+    // The normal rate is in 2^-32 ns per 8 ns cycle
+    *errorNs = (double)(EPLSimGetPhyTime( simPhy) - startClock) - offsetNs -
+               (double)(EPLSimGetTime() - startTime) * (1.0 + normalRate / 34359738368.0);
+    return TRUE;
+}
+
+//****************************************************************************
+static NS_BOOL
+    CheckSlew( void)
+//  Offsets from 1 ns to 1 s at normal rates of -10 to +29 ppm, serviced
+//  from the timer and chained on the trigger. Every slew must land within
+//  1 ns of its target; 3.7 ms takes 4 segments and 123 ms takes 117.
+//****************************************************************************
+{
+static const struct {
+    NS_SINT64 offsetNs;
+    NS_SINT32 normalRate;
+    NS_BOOL useTrigger;
+    NS_UINT32 pollMs;
+    NS_UINT segments;           // 0 if not checked
+} runs[] = {
+    { 500000,      0,        FALSE, 1,   1 },
+    { -800000,     343597,   FALSE, 1,   1 },
+    { 3700000,     -343597,  FALSE, 10,  4 },
+    { 1,           0,        FALSE, 10,  1 },
+    { -123456789,  1000000,  FALSE, 10,  117 },
+    { 250000,      0,        TRUE,  1,   1 },
+    { -2500000,    20000,    TRUE,  1,   0 },
+    { 1000000000,  0,        FALSE, 100, 0 },
+};
+NS_UINT x, segments;
+double errorNs, worstError = 0;
+
+    for ( x = 0; x < sizeof( runs) / sizeof( runs[0]); x++)
+    {
+        EXPECT( SlewRun( runs[x].offsetNs, runs[x].normalRate, runs[x].useTrigger,
+                         runs[x].pollMs, &segments, &errorNs));
+        EXPECT( errorNs >= -1.0 && errorNs <= 1.0);
+        EXPECT( !runs[x].segments || segments == runs[x].segments);
+        if ( errorNs < 0) errorNs = -errorNs;
+        if ( errorNs > worstError) worstError = errorNs;
+    }
+
+    printf( "%u slews within %.2f ns of target\n", x, worstError);
+    return TRUE;
+}
+
+//****************************************************************************
+static double
+    HoldoverNoise(
+        double amplitude)
+//  Returns a repeatable pseudo random value in +/-amplitude.
+//****************************************************************************
+{
+    return ((NS_SINT32)Random( 2001) - 1000) * amplitude / 1000;
+}
+
+//****************************************************************************
+static NS_BOOL
+    HoldoverRun(
+        double rate0,
+        double drift,
+        double noise,
+        NS_UINT learnSeconds,
+        NS_UINT holdSeconds,
+        double *modelError,
+        double *frozenError,
+        NS_UINT64 *estimate)
+//  Learns an oscillator whose error is rate0 + drift * t rate units from
+//  noisy servo samples, then holds over and integrates the time error of
+//  the applied rate and of the last servo rate frozen. Also saves the
+//  model: restored at once it must give the rate being applied, restored
+//  100 s later without noise the true rate then, and a corrupted state
+//  must be refused.
+//****************************************************************************
+{
+static EPL_HOLDOVER holdover, restored;
+EPL_HOLDOVER_CFG config;
+EPL_HOLDOVER_STATE state;
+PEPL_PORT_HANDLE port;
+double sample, frozen = 0;
+NS_UINT32 time;
+NS_SINT32 restoredRate;
+
+    EPLSimReset();
+    port = AddPort( 0);
+    EPLHoldoverGetDefaultConfig( &config);
+    EPLHoldoverInit( &holdover, port, &config);
+    for ( time = 1000; time < 1000 + learnSeconds; time++)
+    {
+        sample = -(rate0 + drift * time) + HoldoverNoise( noise);
+        EPLHoldoverAddSample( &holdover, time,
+                              (NS_SINT32)(sample < 0 ? sample - 0.5 : sample + 0.5),
+                              (NS_SINT32)HoldoverNoise( noise / 10));
+        frozen = sample;
+    }
+    EXPECT( EPLHoldoverEnter( &holdover, time) == NS_STATUS_SUCCESS);
+
+    // Rate units are 2^-32 ns per 8 ns, 1953125 / 2^26 ns per second
+    *modelError = *frozenError = 0;
+    for ( ; time < 1000 + learnSeconds + holdSeconds; time++)
+    {
+        EPLHoldoverService( &holdover, time);
+        *modelError += (holdover.appliedRate + rate0 + drift * (time + 0.5)) *
+                       1953125.0 / 67108864.0;
+        *frozenError += (frozen + rate0 + drift * (time + 0.5)) * 1953125.0 / 67108864.0;
+    }
+    *estimate = EPLHoldoverGetTimeError( &holdover, time);
+
+    EXPECT( EPLHoldoverSave( &holdover, time, &state) == NS_STATUS_SUCCESS);
+    EPLHoldoverService( &holdover, time);
+    EPLHoldoverInit( &restored, port, &config);
+    EXPECT( EPLHoldoverRestore( &restored, &state, time, &restoredRate) ==
+            NS_STATUS_SUCCESS);
+    EXPECT( restoredRate >= holdover.appliedRate - 1 && restoredRate <= holdover.appliedRate + 1);
+    EXPECT( EPLHoldoverRestore( &restored, &state, time + 100, &restoredRate) ==
+            NS_STATUS_SUCCESS);
+    sample = restoredRate + rate0 + drift * (time + 100);
+    EXPECT( noise || (sample >= -2 && sample <= 2));
+    state.rate++;
+    EXPECT( EPLHoldoverRestore( &restored, &state, time, &restoredRate) ==
+            NS_STATUS_INVALID_PARM);
+    return TRUE;
+}
+
+//****************************************************************************
+static NS_BOOL
+    CheckHoldover( void)
+//  Linear oscillator drift, with and without servo noise, held over for
+//  10 minutes to a day. The model must never do worse than the frozen
+//  rate. An hour at 0.5 units/s must stay within 0.25 us against about
+//  94 us frozen, and the noisy long runs must stay within three times
+//  their error estimate, which is one standard deviation.
+//****************************************************************************
+{
+static const struct {
+    double rate0;
+    double drift;               // Rate units per second
+    double noise;
+    NS_UINT learnSeconds;
+    NS_UINT holdSeconds;
+    NS_BOOL checkEstimate;
+} runs[] = {
+    { 1000,    0,    0,   64,  3600,  FALSE },
+    { -50000,  0.5,  0,   64,  3600,  FALSE },
+    { 34359,   -2.0, 20,  64,  86400, TRUE },
+    { 200000,  3.0,  100, 200, 7200,  TRUE },
+    { 1000,    0.1,  5,   5,   600,   FALSE },
+};
+double modelError, frozenError, hourModel = 0, hourFrozen = 0, dayModel = 0, dayFrozen = 0;
+NS_UINT64 estimate;
+NS_UINT x;
+
+    randomSeed = 1;
+    for ( x = 0; x < sizeof( runs) / sizeof( runs[0]); x++)
+    {
+        EXPECT( HoldoverRun( runs[x].rate0, runs[x].drift, runs[x].noise, runs[x].learnSeconds,
+                             runs[x].holdSeconds, &modelError, &frozenError, &estimate));
+        if ( modelError < 0) modelError = -modelError;
+        if ( frozenError < 0) frozenError = -frozenError;
+        EXPECT( modelError <= frozenError + 50);
+        EXPECT( !runs[x].checkEstimate || modelError <= 3.0 * estimate);
+        if ( x == 1)
+        {
+            hourModel = modelError;
+            hourFrozen = frozenError;
+        }
+        else if ( x == 2)
+        {
+            dayModel = modelError;
+            dayFrozen = frozenError;
+        }
+    }
+    EXPECT( hourModel <= 250 && hourFrozen >= 90000);
+
+    printf( "hour %.2f us against %.1f us frozen, day %.2f ms against %.1f ms\n",
+            hourModel / 1000, hourFrozen / 1000, dayModel / 1000000, dayFrozen / 1000000);
+    return TRUE;
+}
+
+#define STAB_SAMPLES    65536
+
+static NS_SINT32 stabSamples[STAB_SAMPLES];
+
+//****************************************************************************
+static double
+    StabGauss( void)
+//  Returns a repeatable, roughly Gaussian value of unit variance (the sum
+//  of twelve uniform values).
+//****************************************************************************
+{
+double sum = -6;
+NS_UINT x;
+
+    for ( x = 0; x < 12; x++)
+        sum += Random( 65536) / 65536.0;
+    return sum;
+}
+
+//****************************************************************************
+static NS_BOOL
+    StabMatches(
+        NS_UINT64 value,
+        double referenceSquare)
+//  Returns TRUE if an integer deviation is within rounding of the square
+//  root of the floating point reference: 1 unit plus 20 ppm for the fixed
+//  point sums and the integer square root.
+//****************************************************************************
+{
+double tolerance = 1 + value / 50000.0;
+
+    return (value + tolerance) * (value + tolerance) >= referenceSquare &&
+           (value > tolerance ? (value - tolerance) * (value - tolerance) : 0) <=
+           referenceSquare;
+}
+
+//****************************************************************************
+static NS_BOOL
+    CheckStability( void)
+//  65536 samples of white phase noise (10 ns) and of a random walk with
+//  white noise on top. Every MTIE window from 2 to 4096 samples must equal
+//  a brute force search over the windows the module evaluates (every
+//  start up to STAB_MTIE_BLOCKS samples, block boundaries beyond) and
+//  never exceed the search over every start. TDEV and ADEV at every level
+//  must match a floating point version of the same non-overlapping
+//  estimators to within 1 unit plus 20 ppm. For white noise they must also be within 10% of
+//  sigma/sqrt(n) and sqrt(3)*sigma/tau while there are 1000 terms or more.
+//****************************************************************************
+{
+static EPL_STABILITY stability;
+static const NS_UINT32 windows[] = { 2, 10, 32, 100, 1000, 4096 };
+EPL_STABILITY_CFG config;
+EPL_STAB_MTIE_POINT mtiePoint;
+EPL_STAB_DEV_POINT devPoint;
+double walk = 0, adevSum, tdevSum, second, mean[3], ratio;
+NS_UINT32 aligned, every, range, step, n;
+NS_SINT32 low, high;
+NS_UINT mode, x, start, j, level, terms;
+
+    randomSeed = 5;
+    EPLStabilityGetDefaultConfig( &config);
+    for ( x = 0; x < STAB_MTIE_WINDOWS; x++)
+        config.mtieWindow[x] = (x < sizeof( windows) / sizeof( windows[0])) ? windows[x] : 0;
+
+    for ( mode = 0; mode < 2; mode++)
+    {
+        EXPECT( EPLStabilityInit( &stability, &config) == NS_STATUS_SUCCESS);
+        for ( x = 0; x < STAB_SAMPLES; x++)
+        {
+            if ( mode == 0)
+            {
+                stabSamples[x] = (NS_SINT32)(10 * StabGauss() + 1000.5) - 1000;
+            }
+            else
+            {
+                walk += 3 * StabGauss();
+                stabSamples[x] = (NS_SINT32)(walk + 2 * StabGauss() + 100000.5) - 100000;
+            }
+            EPLStabilityAddSample( &stability, stabSamples[x]);
+        }
+
+        for ( x = 0; x < sizeof( windows) / sizeof( windows[0]); x++)
+        {
+            EXPECT( EPLStabilityGetMtie( &stability, x, &mtiePoint) == NS_STATUS_SUCCESS);
+            n = mtiePoint.windowSamples;
+            step = (n <= STAB_MTIE_BLOCKS) ? 1 : stability.mtie[x].blockSamples;
+            aligned = every = 0;
+            for ( start = 0; start + n <= STAB_SAMPLES; start++)
+            {
+                low = high = stabSamples[start];
+                for ( j = 1; j < n; j++)
+                {
+                    if ( stabSamples[start + j] < low) low = stabSamples[start + j];
+                    if ( stabSamples[start + j] > high) high = stabSamples[start + j];
+                }
+                range = (NS_UINT32)(high - low);
+                if ( range > every) every = range;
+                if ( start % step == 0 && range > aligned) aligned = range;
+            }
+            EXPECT( mtiePoint.mtieNs == aligned && aligned <= every);
+        }
+
+        for ( level = 0; level < STAB_DEV_LEVELS; level++)
+        {
+            n = 1u << level;
+            if ( 3 * n > STAB_SAMPLES)
+            {
+                EXPECT( EPLStabilityGetDeviation( &stability, level, &devPoint) ==
+                        NS_STATUS_FAILURE);
+                break;
+            }
+            EXPECT( EPLStabilityGetDeviation( &stability, level, &devPoint) == NS_STATUS_SUCCESS);
+            adevSum = tdevSum = 0;
+            terms = 0;
+            for ( start = 0; start + 3 * n <= STAB_SAMPLES; start += n, terms++)
+            {
+                second = stabSamples[start + 2 * n] - 2.0 * stabSamples[start + n] +
+                         stabSamples[start];
+                adevSum += second * second;
+                mean[0] = mean[1] = mean[2] = 0;
+                for ( j = 0; j < n; j++)
+                {
+                    mean[0] += stabSamples[start + j];
+                    mean[1] += stabSamples[start + n + j];
+                    mean[2] += stabSamples[start + 2 * n + j];
+                }
+                second = (mean[2] - 2 * mean[1] + mean[0]) / n;
+                tdevSum += second * second;
+            }
+            EXPECT( devPoint.terms == terms);
+            // TDEV in ps, ADEV in 10^-15 at tau = n seconds
+            EXPECT( StabMatches( devPoint.tdevPs, tdevSum / terms / 6 * 1e6));
+            EXPECT( StabMatches( devPoint.adev, adevSum / terms / 2 / ((double)n * n) * 1e12));
+            if ( mode == 0 && terms >= 1000)
+            {
+                ratio = (double)devPoint.tdevPs * devPoint.tdevPs * n / 1e8;
+                EXPECT( ratio > 0.81 && ratio < 1.21);
+                ratio = (double)devPoint.adev * devPoint.adev * n * n / 3e14;
+                EXPECT( ratio > 0.81 && ratio < 1.21);
+            }
+        }
+    }
+
+    printf( "MTIE matches brute force, TDEV/ADEV match the float estimators\n");
+    return TRUE;
+}
+
+//****************************************************************************
+static int
+    PdvCompare(
+        const void *a,
+        const void *b)
+//****************************************************************************
+{
+NS_SINT64 x = *(const NS_SINT64 *)a, y = *(const NS_SINT64 *)b;
+
+    return (x > y) - (x < y);
+}
+
+//****************************************************************************
+static NS_BOOL
+    CheckPdv( void)
+//  Minimum and median filters of every window from 1 to PDV_MAX_WINDOW,
+//  sliding and decimated, on 3000 samples mixing small and large spreads
+//  and negative outliers, reset every 500 samples. Each output, and
+//  whether there is one, must match sorting the samples of the window
+//  since the last reset. An exponential filter must give the hand-worked
+//  value, and a zero window must be refused.
+//****************************************************************************
+{
+static EPL_PDV_FILTER filter;
+static NS_SINT64 history[3000];
+EPL_PDV_CFG config;
+NS_SINT64 sorted[PDV_MAX_WINDOW], value, expected;
+NS_UINT type, window, count, start, x, j, samples = 0;
+NS_BOOL decimate, passed;
+
+    randomSeed = 7;
+    for ( type = PDV_FILTER_MINIMUM; type <= PDV_FILTER_MEDIAN; type++)
+    {
+        for ( window = 1; window <= PDV_MAX_WINDOW; window++)
+        {
+            for ( decimate = FALSE; decimate <= TRUE; decimate++)
+            {
+                EPLPdvGetDefaultConfig( &config);
+                config.type = (EPL_PDV_FILTER_ENUM)type;
+                config.window = window;
+                config.decimate = decimate;
+                EXPECT( EPLPdvInit( &filter, &config) == NS_STATUS_SUCCESS);
+
+                start = 0;
+                for ( x = 0; x < 3000; x++, samples++)
+                {
+                    if ( x % 500 == 499)
+                    {
+                        EPLPdvReset( &filter);
+                        start = x;
+                    }
+                    history[x] = (NS_SINT64)Random( (x % 3) ? 1000 : 20) - ((x % 7) ? 0 : 500);
+                    value = history[x];
+                    passed = EPLPdvFilter( &filter, &value);
+
+                    count = x + 1 - start;
+                    EXPECT( passed == (!decimate || count % window == 0));
+                    if ( count > window)
+                        count = window;
+                    for ( j = 0; j < count; j++)
+                        sorted[j] = history[x + 1 - count + j];
+                    qsort( sorted, count, sizeof( sorted[0]), PdvCompare);
+                    if ( type == PDV_FILTER_MINIMUM)
+                        expected = sorted[0];
+                    else if ( count & 1)
+                        expected = sorted[count / 2];
+                    else
+                        expected = (sorted[count / 2 - 1] + sorted[count / 2]) / 2;
+                    EXPECT( !passed || value == expected);
+                }
+            }
+        }
+    }
+
+    // 1000, then 2000 with weight 1/8
+    EPLPdvGetDefaultConfig( &config);
+    config.type = PDV_FILTER_EXPONENTIAL;
+    config.shift = 3;
+    EXPECT( EPLPdvInit( &filter, &config) == NS_STATUS_SUCCESS);
+    value = 1000;
+    EPLPdvFilter( &filter, &value);
+    value = 2000;
+    EPLPdvFilter( &filter, &value);
+    EXPECT( value == 1125);
+
+    config.type = PDV_FILTER_MEDIAN;
+    config.window = 0;
+    EXPECT( EPLPdvInit( &filter, &config) == NS_STATUS_INVALID_PARM);
+
+    printf( "%u samples, every output matches its sorted window\n", samples);
+    return TRUE;
+}
+
+//****************************************************************************
+static NS_SINT64
+    PhcRound(
+        NS_SINT64 value,
+        NS_SINT64 multiplier,
+        NS_SINT64 divisor)
+//  Returns value * multiplier / divisor rounded to nearest (divisor odd,
+//  so there are no ties), clamped to the rate register range.
+//****************************************************************************
+{
+NS_SINT64 result;
+
+    result = ((value < 0 ? -value : value) * multiplier + divisor / 2) / divisor;
+    if ( value < 0) result = -result;
+    if ( result > SLEW_MAX_RATE) result = SLEW_MAX_RATE;
+    if ( result < -SLEW_MAX_RATE) result = -SLEW_MAX_RATE;
+    return result;
+}
+
+//****************************************************************************
+static NS_BOOL
+    CheckPhc( void)
+//  Every ppb in range and every scaled ppm below 2000000 (every 997th
+//  beyond) must convert to the exactly rounded rate, and every 7th rate
+//  must survive a round trip through scaled ppm. On the simulated PHY an
+//  unchanged rate is not written again, out of range adjustments are
+//  refused, 10 ppm gains 10 us per second, a step is exact, a slew with a
+//  frequency change midway lands on target, and a 48-bit time set reads
+//  back.
+//****************************************************************************
+{
+static EPL_PHC phc;
+EPL_PHC_CFG config;
+PEPL_PORT_HANDLE port;
+PEPL_SIM_PHY simPhy;
+PTP_TIME now, setTime;
+NS_UINT64 startTime, startClock;
+NS_SINT64 value, error;
+NS_UINT polls = 0;
+
+    for ( value = -PHC_MAX_SCALED_PPM - 5; value <= PHC_MAX_SCALED_PPM + 5;
+          value += (llabs( value) < 2000000) ? 1 : 997)
+        EXPECT( EPLPhcScaledPpmToRate( value) == PhcRound( value, 8192, 15625));
+    for ( value = -PHC_MAX_ADJ_PPB - 5; value <= PHC_MAX_ADJ_PPB + 5; value++)
+        EXPECT( EPLPhcPpbToRate( (NS_SINT32)value) == PhcRound( value, 67108864, 1953125));
+    for ( value = -SLEW_MAX_RATE; value <= SLEW_MAX_RATE; value += 7)
+        EXPECT( EPLPhcScaledPpmToRate( EPLPhcRateToScaledPpm( (NS_SINT32)value)) == value);
+
+    port = AddPort( 0);
+    simPhy = EPLSimGetPhy( 1);
+    EPLSimAdvanceTime( 100000000000ULL);
+    EPLPhcGetDefaultConfig( &config);
+    EXPECT( EPLPhcInit( &phc, port, &config) == NS_STATUS_SUCCESS);
+
+    // 10 ppm, then the same rate to within rounding twice
+    EPLPhcAdjFine( &phc, 65536 * 10);
+    EPLPhcAdjFine( &phc, 65536 * 10 - 1);
+    EPLPhcAdjFine( &phc, 65536 * 10);
+    EXPECT( phc.rateWrites == 1 && phc.rateWritesSkipped == 2);
+    EXPECT( EPLPhcAdjFine( &phc, PHC_MAX_SCALED_PPM + 1) == NS_STATUS_INVALID_PARM);
+    EXPECT( EPLPhcAdjFreq( &phc, -PHC_MAX_ADJ_PPB - 1) == NS_STATUS_INVALID_PARM);
+
+    startTime = EPLSimGetTime();
+    startClock = EPLSimGetPhyTime( simPhy);
+    EPLSimAdvanceTime( 1000000000);
+    error = (NS_SINT64)(EPLSimGetPhyTime( simPhy) - startClock) -
+            (NS_SINT64)(EPLSimGetTime() - startTime) - 10000;
+    EXPECT( error >= -2 && error <= 2);
+    EPLPhcAdjFreq( &phc, 0);
+
+    startTime = EPLSimGetTime();
+    startClock = EPLSimGetPhyTime( simPhy);
+    EXPECT( EPLPhcAdjTime( &phc, -5000000123LL) == NS_STATUS_SUCCESS);
+    EXPECT( (NS_SINT64)(EPLSimGetPhyTime( simPhy) - startClock) -
+            (NS_SINT64)(EPLSimGetTime() - startTime) == -5000000123LL);
+
+    // 300 us slewed, with 50 ppb applied 20 ms in: the error may only grow
+    // by what 50 ppb adds
+    startTime = EPLSimGetTime();
+    startClock = EPLSimGetPhyTime( simPhy);
+    EXPECT( EPLPhcAdjTime( &phc, 300000) == NS_STATUS_SUCCESS);
+    for ( ;;)
+    {
+        EPLSimAdvanceTime( 1000000);
+        if ( ++polls == 20)
+            EPLPhcAdjFreq( &phc, 50);
+        EPLPhcGetTime( &phc, &now);
+        if ( !EPLPhcService( &phc, &now))
+            break;
+    }
+    error = (NS_SINT64)(EPLSimGetPhyTime( simPhy) - startClock) -
+            (NS_SINT64)(EPLSimGetTime() - startTime) - 300000;
+    EXPECT( phc.slews == 1 && phc.steps == 1);
+    EXPECT( error >= -2 && error <= (NS_SINT64)(EPLSimGetTime() - startTime) * 50 / 1000000000 + 2);
+
+    setTime.seconds = 0x123400005678LL;
+    setTime.nanoSeconds = 999999000;
+    EPLPhcSetTime( &phc, &setTime);
+    EPLSimAdvanceTime( 2000);
+    EPLPhcGetTime( &phc, &now);
+    EXPECT( now.seconds == 0x123400005679LL);
+
+    printf( "conversions exactly rounded, step exact, slew %ld ns off\n", (long)error);
+    return TRUE;
+}
+
+#define TSD_ITERATIONS  400000      // 20 us each
+#define TSD_FRAMES      4096
+#define TSD_HELD        64
+
+typedef struct TSD_FRAME {
+    NS_UINT8 data[80];
+    NS_UINT due;                // Iteration the host takes the frame
+} TSD_FRAME;
+
+static EPL_TSD tsd;
+static TSD_FRAME tsdFrames[TSD_FRAMES];
+static NS_UINT tsdHead, tsdTail, tsdIteration;
+static NS_UINT8 tsdHeld[TSD_HELD][80];
+static NS_UINT64 tsdTxTimes[60000], tsdRxTimes[65536];
+
+//****************************************************************************
+static NS_BOOL
+    TsdEnabled(
+        PEPL_SIM_PHY simPhy,
+        NS_UINT reg,
+        NS_UINT bits)
+//  Returns whether the simulated PHY has the bits set in a page 5 register,
+//  without an MDIO access of the port.
+//****************************************************************************
+{
+    return (simPhy->pageRegs[5][(reg & 0x1F) - 0x14] & bits) != 0;
+}
+
+//****************************************************************************
+static void
+    TsdMessage(
+        NS_UINT8 *frame,
+        NS_UINT messageType,
+        NS_UINT sequenceId)
+//  Writes a layer 2 PTPv2 event message.
+//****************************************************************************
+{
+NS_UINT8 *message = &frame[14];
+NS_UINT x;
+
+    memset( frame, 0, 80);
+    memcpy( frame, "\x01\x1B\x19\x00\x00\x00", 6);
+    frame[12] = 0x88;
+    frame[13] = 0xF7;
+    message[0] = (NS_UINT8)messageType;
+    message[1] = 2;
+    for ( x = 0; x < 10; x++)
+        message[20 + x] = (NS_UINT8)(x * 7 + 1);
+    message[30] = (NS_UINT8)(sequenceId >> 8);
+    message[31] = (NS_UINT8)sequenceId;
+}
+
+//****************************************************************************
+static void
+    TsdStatusFrame(
+        EPL_SIM_TS_QUEUE *queue,
+        NS_BOOL transmit)
+//  Moves the newest timestamp of a simulated PHY queue into a Status Frame
+//  the host takes three iterations later.
+//****************************************************************************
+{
+TSD_FRAME *frame = &tsdFrames[tsdTail++ % TSD_FRAMES];
+NS_UINT8 *message = &frame->data[16];
+NS_UINT x, fields[7];
+
+    queue->count--;
+    fields[0] = transmit ? 0x1000 : 0x2000;
+    fields[1] = queue->nanoSeconds[queue->count] & 0xFFFF;
+    fields[2] = (queue->nanoSeconds[queue->count] >> 16) & 0x3FFF;
+    fields[3] = queue->seconds[queue->count] & 0xFFFF;
+    fields[4] = queue->seconds[queue->count] >> 16;
+    fields[5] = transmit ? 0 : queue->sequenceId[queue->count];
+    fields[6] = transmit ? 0 : queue->typeHash[queue->count];
+
+    memset( frame->data, 0, sizeof( frame->data));
+    memcpy( frame->data, "\x01\x1B\x19\x00\x00\x00\x08\x00\x17\x0B\x6B\x0F\x88\xF7", 14);
+    for ( x = 0; x < 7; x++)
+    {
+        message[2 * x] = (NS_UINT8)(fields[x] >> 8);
+        message[2 * x + 1] = (NS_UINT8)fields[x];
+    }
+    frame->due = tsdIteration + 3;
+}
+
+//****************************************************************************
+static void
+    TsdTransmit(
+        PEPL_SIM_PHY simPhy,
+        NS_UINT sequenceId)
+//  Transmits a Delay_Req, its timestamp in a Status Frame when enabled.
+//****************************************************************************
+{
+NS_UINT8 frame[80];
+
+    TsdMessage( frame, PTP_MSG_DELAY_REQ, sequenceId);
+    tsdTxTimes[sequenceId] = EPLSimGetPhyTime( simPhy);
+    EPLSimTransmit( simPhy, frame, sizeof( frame));
+    if ( TsdEnabled( simPhy, PHY_PG5_PSF_CFG0, P640_PKT_TXTS_EN))
+        TsdStatusFrame( &simPhy->txTs, TRUE);
+}
+
+//****************************************************************************
+static void
+    TsdReceive(
+        PEPL_SIM_PHY simPhy,
+        NS_UINT sequenceId)
+//  Receives a Sync the host takes next iteration, its timestamp inserted or
+//  in a Status Frame when enabled.
+//****************************************************************************
+{
+TSD_FRAME *frame = &tsdFrames[tsdTail++ % TSD_FRAMES];
+EPL_SIM_TS_QUEUE *queue = &simPhy->rxTs;
+NS_UINT8 *message = &frame->data[14];
+NS_UINT x;
+
+    TsdMessage( frame->data, PTP_MSG_SYNC, sequenceId);
+    frame->due = tsdIteration + 1;
+    tsdRxTimes[sequenceId] = EPLSimGetPhyTime( simPhy);
+    EPLSimReceive( simPhy, frame->data, sizeof( frame->data));
+    if ( TsdEnabled( simPhy, PHY_PG5_PTP_RXCFG3, P640_TS_INSERT))
+    {
+        queue->count--;
+        for ( x = 0; x < 4; x++)
+            message[16 + x] = (NS_UINT8)(queue->nanoSeconds[queue->count] >> (8 * x));
+        message[5] = (NS_UINT8)queue->seconds[queue->count];
+    }
+    else if ( TsdEnabled( simPhy, PHY_PG5_PSF_CFG0, P640_PKT_RXTS_EN))
+    {
+        TsdStatusFrame( queue, FALSE);
+    }
+}
+
+//****************************************************************************
+static NS_BOOL
+    TsdRun(
+        NS_BOOL forced,
+        NS_BOOL reverse,
+        NS_UINT *timestamps)
+//  Runs 8 s of low, high, higher and low load, every 100 ms on the next
+//  mode when forced, and checks every timestamp taken against the time the
+//  simulated PHY took it. Nothing reads the clock before EPLTsdInit(), the
+//  reverse run starts on Status Frames, and every run drops the timestamp
+//  reference halfway, as EPLCheckpointWarmStart() does.
+//****************************************************************************
+{
+PEPL_PORT_HANDLE port;
+PEPL_SIM_PHY simPhy;
+EPL_TSD_CFG config;
+RX_CFG_ITEMS rxCfgItems;
+PTP_TIME time;
+NS_UINT held[TSD_HELD], numHeld = 0, txSent = 0, txTaken = 0, rxSent = 0, rxTaken = 0;
+NS_UINT phase, x, mode;
+TSD_FRAME *frame;
+
+    EPLSimReset();
+    port = AddPort( 0);
+    simPhy = EPLSimGetPhy( 1);
+    EPLSimAdvanceTime( 1000000000ULL * 5000 + 77);
+    memset( &rxCfgItems, 0, sizeof( rxCfgItems));
+    rxCfgItems.ptpVersion = 2;
+    rxCfgItems.rxTsNanoSecOffset = 16;
+    rxCfgItems.rxTsSecondsOffset = 5;
+    PTPEnable( port, TRUE);
+    PTPSetTransmitConfig( port, TXOPT_TS_EN | TXOPT_L2_EN, 2, 0, 0);
+    PTPSetReceiveConfig( port, RXOPT_RX_TS_EN | RXOPT_RX_L2_EN | RXOPT_TS_SEC_EN, &rxCfgItems);
+    PTPSetPhyStatusFrameConfig( port, 0, STS_SRC_ADDR_2, 2, 0, 2, 0x0F, 0x0F, 0);
+
+    EPLTsdGetDefaultConfig( &config);
+    config.modeMask = TSD_MODE_BIT( TSD_MODE_REGISTER) | TSD_MODE_BIT( TSD_MODE_INSERT) |
+                      TSD_MODE_BIT( TSD_MODE_PSF);
+    config.windowUs = 200000;
+    config.initialMode = reverse ? TSD_MODE_PSF : TSD_MODE_REGISTER;
+    EXPECT( EPLTsdInit( &tsd, port, &config, NULL, NULL) == NS_STATUS_SUCCESS);
+
+    tsdHead = tsdTail = 0;
+    for ( tsdIteration = 0; tsdIteration < TSD_ITERATIONS; tsdIteration++)
+    {
+        if ( tsdIteration == TSD_ITERATIONS / 2)
+            port->tsRefValid = FALSE;
+        if ( forced && tsdIteration % 5000 == 0)
+        {
+            mode = (tsdIteration / 5000) % TSD_NUM_MODES;
+            EPLTsdSetMode( &tsd, (EPL_TSD_MODE_ENUM)(reverse ? TSD_NUM_MODES - 1 - mode : mode));
+        }
+
+        // 6250 and 50000 receptions per second, with 1250, 1250 and 25000
+        // transmissions, then 780 and 155
+        phase = tsdIteration / 100000;
+        if ( phase == 3)
+        {
+            if ( tsdIteration % 64 == 0)
+                TsdReceive( simPhy, rxSent++ & 0xFFFF);
+            if ( tsdIteration % 320 == 0)
+                TsdTransmit( simPhy, txSent++);
+        }
+        else
+        {
+            if ( tsdIteration % (phase ? 1 : 8) == 0)
+                TsdReceive( simPhy, rxSent++ & 0xFFFF);
+            if ( tsdIteration % (phase == 2 ? 2 : 40) == 0)
+                TsdTransmit( simPhy, txSent++);
+        }
+        EPLSimAdvanceTime( 20000);
+
+        for ( ; tsdHead != tsdTail && tsdFrames[tsdHead % TSD_FRAMES].due <= tsdIteration; tsdHead++)
+        {
+            frame = &tsdFrames[tsdHead % TSD_FRAMES];
+            if ( EPLTsdProcessFrame( &tsd, frame->data, sizeof( frame->data)))
+                continue;
+            EXPECT( numHeld < TSD_HELD);
+            memcpy( tsdHeld[numHeld], frame->data, sizeof( frame->data));
+            held[numHeld++] = (frame->data[44] << 8) | frame->data[45];
+        }
+        for ( x = 0; x < numHeld; )
+        {
+            if ( EPLTsdGetRxTimestamp( &tsd, &tsdHeld[x][14], &time) != NS_STATUS_SUCCESS)
+            {
+                x++;
+                continue;
+            }
+            EXPECT( (NS_UINT64)time.seconds * 1000000000 + time.nanoSeconds == tsdRxTimes[held[x]]);
+            rxTaken++;
+            numHeld--;
+            memmove( tsdHeld[x], tsdHeld[x + 1], (numHeld - x) * sizeof( tsdHeld[0]));
+            memmove( &held[x], &held[x + 1], (numHeld - x) * sizeof( held[0]));
+        }
+        while ( txTaken < txSent && EPLTsdGetTxTimestamp( &tsd, &time) == NS_STATUS_SUCCESS)
+        {
+            EXPECT( (NS_UINT64)time.seconds * 1000000000 + time.nanoSeconds == tsdTxTimes[txTaken]);
+            txTaken++;
+        }
+        EPLTsdService( &tsd);
+    }
+
+    EXPECT( txTaken == txSent && rxTaken == rxSent && !numHeld);
+    EXPECT( !tsd.discarded && !tsd.overflows && !tsd.unextended);
+    *timestamps = txTaken + rxTaken;
+    return TRUE;
+}
+
+//****************************************************************************
+static NS_BOOL
+    CheckTsd( void)
+//  Low, high and low load with the modes left to the manager, then with a
+//  switch every 100 ms in either order. Every transmit and receive
+//  timestamp must be taken, exact and for its message, with none dropped
+//  by the PHY or the manager.
+//****************************************************************************
+{
+NS_UINT timestamps, natural, forced = 0, cut = 0;
+NS_BOOL reverse;
+
+    EXPECT( TsdRun( FALSE, FALSE, &timestamps));
+    natural = tsd.switches;
+    EXPECT( natural >= 2);
+    for ( reverse = FALSE; reverse <= TRUE; reverse++)
+    {
+        EXPECT( TsdRun( TRUE, reverse, &timestamps));
+        forced += tsd.switches;
+        cut += tsd.drainsCut;
+    }
+
+    printf( "%u timestamps per run exact, %u natural and %u forced switches, %u drains cut\n",
+            timestamps, natural, forced, cut);
+    return TRUE;
+}
+
+static EPL_DEMUX demux;
+static PEPL_SIM_PHY demuxPhy;
+static NS_SINT64 demuxOffsets[256];
+static NS_UINT demuxSamples[256], demuxWrong;
+static const NS_UINT8 demuxPortIdentity[PTP_PORT_ID_LENGTH] = { 9, 8, 7, 6, 5, 4, 3, 2, 0, 1 };
+
+//****************************************************************************
+static void
+    DemuxSample(
+        void *context,
+        NS_UINT8 domainNumber,
+        PEPL_E2E_SAMPLE sample)
+//  Counts a domain's offset sample, and those not exactly the domain's
+//  offset or not with its context.
+//****************************************************************************
+{
+    demuxSamples[domainNumber]++;
+    if ( sample->offset != -E2E_NS_TO_SCALED( demuxOffsets[domainNumber]) ||
+         context != &demuxOffsets[domainNumber])
+    {
+        demuxWrong++;
+    }
+}
+
+//****************************************************************************
+static NS_UINT8 *
+    DemuxMessage(
+        NS_UINT8 *frame,
+        NS_UINT messageType,
+        NS_UINT domainNumber,
+        NS_UINT sequenceId,
+        NS_UINT source)
+//  Writes a layer 2 PTPv2 message of a source port identity and returns the
+//  message.
+//****************************************************************************
+{
+NS_UINT8 *message = &frame[14];
+NS_UINT x;
+
+    memset( frame, 0, 128);
+    memcpy( frame, "\x01\x1B\x19\x00\x00\x00", 6);
+    frame[12] = 0x88;
+    frame[13] = 0xF7;
+    message[0] = (NS_UINT8)messageType;
+    message[1] = 2;
+    message[4] = (NS_UINT8)domainNumber;
+    for ( x = 0; x < PTP_PORT_ID_LENGTH; x++)
+        message[20 + x] = (NS_UINT8)(x * 7 + source);
+    message[30] = (NS_UINT8)(sequenceId >> 8);
+    message[31] = (NS_UINT8)sequenceId;
+    return message;
+}
+
+//****************************************************************************
+static void
+    DemuxTimestamp(
+        NS_UINT8 *field,
+        NS_UINT64 time)
+//  Writes a PTP timestamp field.
+//****************************************************************************
+{
+NS_UINT x;
+
+    for ( x = 0; x < 6; x++)
+        field[x] = (NS_UINT8)((time / 1000000000) >> (8 * (5 - x)));
+    for ( x = 0; x < 4; x++)
+        field[6 + x] = (NS_UINT8)((time % 1000000000) >> (8 * (3 - x)));
+}
+
+//****************************************************************************
+static NS_BOOL
+    DemuxExchange(
+        NS_UINT domainNumber,
+        NS_UINT sequenceId,
+        NS_BOOL twoStep)
+//  A Sync (with its Follow_Up if two-step), a Delay_Req, a Delay_Resp to
+//  another port, the Delay_Resp and an Announce of one of six masters, with
+//  the master's time the domain's offset ahead of the PHY.
+//****************************************************************************
+{
+NS_UINT8 frame[128], *message;
+NS_UINT64 syncTime, delayReqTime;
+NS_SINT64 offset = demuxOffsets[domainNumber];
+
+    syncTime = EPLSimGetPhyTime( demuxPhy);
+    message = DemuxMessage( frame, PTP_MSG_SYNC, domainNumber, sequenceId, 1);
+    if ( twoStep)
+        message[6] = PTP_FLAG_TWO_STEP;
+    else
+        DemuxTimestamp( &message[34], syncTime + offset);
+    EPLSimReceive( demuxPhy, frame, 14 + 44);
+    EXPECT( EPLDemuxReceive( &demux, message, 44, NULL) != NS_STATUS_FAILURE);
+    EPLSimAdvanceTime( 100000);
+    if ( twoStep)
+    {
+        message = DemuxMessage( frame, PTP_MSG_FOLLOW_UP, domainNumber, sequenceId, 1);
+        DemuxTimestamp( &message[34], syncTime + offset);
+        EXPECT( EPLDemuxReceive( &demux, message, 44, NULL) != NS_STATUS_FAILURE);
+    }
+
+    message = DemuxMessage( frame, PTP_MSG_DELAY_REQ, domainNumber, sequenceId, 0);
+    memcpy( &message[20], demuxPortIdentity, PTP_PORT_ID_LENGTH);
+    delayReqTime = EPLSimGetPhyTime( demuxPhy);
+    EPLSimTransmit( demuxPhy, frame, 14 + 44);
+    EPLDemuxTransmitted( &demux, message);
+    EPLSimAdvanceTime( 100000);
+    EPLDemuxService( &demux);
+
+    message = DemuxMessage( frame, PTP_MSG_DELAY_RESP, domainNumber, sequenceId, 1);
+    DemuxTimestamp( &message[34], delayReqTime + offset + 777);
+    memcpy( &message[44], demuxPortIdentity, PTP_PORT_ID_LENGTH);
+    message[44] ^= 1;
+    EXPECT( EPLDemuxReceive( &demux, message, 54, NULL) != NS_STATUS_FAILURE);
+    DemuxTimestamp( &message[34], delayReqTime + offset);
+    message[44] ^= 1;
+    EXPECT( EPLDemuxReceive( &demux, message, 54, NULL) != NS_STATUS_FAILURE);
+
+    message = DemuxMessage( frame, PTP_MSG_ANNOUNCE, domainNumber, sequenceId,
+                            1 + sequenceId % 6);
+    message[47] = 128;
+    message[48] = 6;
+    EXPECT( EPLDemuxReceive( &demux, message, 64, NULL) != NS_STATUS_FAILURE);
+    EPLSimAdvanceTime( 100000);
+    return TRUE;
+}
+
+//****************************************************************************
+static NS_BOOL
+    CheckDemux( void)
+//  Domain 4 alone, then with domains 0 and 1 and Syncs of an unfollowed
+//  domain 9, then domain 1 alone, with one-step and two-step Syncs. Every
+//  sample must carry its domain's exact offset, Delay_Resps to another port
+//  must be ignored, the hardware filter must follow the single domain, and
+//  no timestamp may be left queued or dropped.
+//****************************************************************************
+{
+static EPL_TSD tsd;
+EPL_TSD_CFG config;
+RX_CFG_ITEMS rxCfgItems;
+PEPL_PORT_HANDLE port;
+PEPL_DEMUX_DOMAIN domain;
+NS_UINT x;
+
+    port = AddPort( 0);
+    demuxPhy = EPLSimGetPhy( 1);
+    EPLSimAdvanceTime( 1000000000ULL * 5000 + 77);
+    memset( &rxCfgItems, 0, sizeof( rxCfgItems));
+    rxCfgItems.ptpVersion = 2;
+    PTPEnable( port, TRUE);
+    PTPSetTransmitConfig( port, TXOPT_TS_EN | TXOPT_L2_EN, 2, 0, 0);
+    PTPSetReceiveConfig( port, RXOPT_RX_TS_EN | RXOPT_RX_L2_EN, &rxCfgItems);
+    EPLTsdGetDefaultConfig( &config);
+    EXPECT( EPLTsdInit( &tsd, port, &config, NULL, NULL) == NS_STATUS_SUCCESS);
+    EPLDemuxInit( &demux, port, &tsd, (NS_UINT8 *)demuxPortIdentity);
+
+    memset( demuxSamples, 0, sizeof( demuxSamples));
+    demuxWrong = 0;
+    demuxOffsets[0] = 1000;
+    demuxOffsets[1] = -5000;
+    demuxOffsets[4] = 123456;
+    EXPECT( EPLDemuxAddDomain( &demux, 4, DemuxSample, &demuxOffsets[4]) == NS_STATUS_SUCCESS);
+    EXPECT( EPLReadReg( port, PHY_PG5_PTP_RXCFG0) & P640_DOMAIN_EN);
+    EXPECT( (EPLReadReg( port, PHY_PG5_PTP_RXCFG3) & 0xFF) == 4);
+    EXPECT( port->rxConfigOptions & RXOPT_DOMAIN_EN);
+    for ( x = 0; x < 50; x++)
+        EXPECT( DemuxExchange( 4, x, x & 1));
+
+    EXPECT( EPLDemuxAddDomain( &demux, 4, DemuxSample, NULL) == NS_STATUS_INVALID_PARM);
+    EXPECT( EPLDemuxAddDomain( &demux, 0, DemuxSample, &demuxOffsets[0]) == NS_STATUS_SUCCESS);
+    EXPECT( EPLDemuxAddDomain( &demux, 1, DemuxSample, &demuxOffsets[1]) == NS_STATUS_SUCCESS);
+    EXPECT( !(EPLReadReg( port, PHY_PG5_PTP_RXCFG0) & P640_DOMAIN_EN));
+    for ( x = 0; x < 300; x++)
+    {
+        EXPECT( DemuxExchange( x % 3 == 2 ? 4 : x % 3, 1000 + x, x & 2));
+        if ( x % 7 == 0)
+            EXPECT( DemuxExchange( 9, x, FALSE));
+    }
+
+    EXPECT( EPLDemuxRemoveDomain( &demux, 4) == NS_STATUS_SUCCESS);
+    EXPECT( EPLDemuxRemoveDomain( &demux, 0) == NS_STATUS_SUCCESS);
+    EXPECT( EPLReadReg( port, PHY_PG5_PTP_RXCFG0) & P640_DOMAIN_EN);
+    EXPECT( (EPLReadReg( port, PHY_PG5_PTP_RXCFG3) & 0xFF) == 1);
+    for ( x = 0; x < 50; x++)
+        EXPECT( DemuxExchange( 1, 3000 + x, FALSE));
+
+    // The first exchange of a domain only measures the delay
+    domain = EPLDemuxGetDomain( &demux, 1);
+    EXPECT( !demuxWrong);
+    EXPECT( demuxSamples[4] == 149 && demuxSamples[0] == 99 && demuxSamples[1] == 149);
+    EXPECT( !demuxSamples[9] && demux.otherDomain == 43 * 4);
+    EXPECT( domain->numForeign == DEMUX_MAX_FOREIGN && domain->e2e.stats.delays == 150);
+    EXPECT( demux.filterWrites == 3 && !demux.txUnmatched && !demux.txDropped);
+    EXPECT( !tsd.rxCount && !tsd.txCount && !tsd.discarded);
+    EXPECT( !demuxPhy->rxTs.count && !demuxPhy->txTs.count);
+
+    printf( "%u samples exact in 3 domains, %u messages of domain 9 dropped, 3 filter writes\n",
+            demuxSamples[0] + demuxSamples[1] + demuxSamples[4], (unsigned)demux.otherDomain);
+    return TRUE;
+}
+
+static const NS_SINT64 hashOffsets[3] = { 0, 2000, -70000 };
+static NS_UINT hashMaster, hashSamples, hashWrong, hashTimestamped, hashSuppressed;
+
+//****************************************************************************
+static void
+    HashSample(
+        void *context,
+        NS_UINT8 domainNumber,
+        PEPL_E2E_SAMPLE sample)
+//  Counts an offset sample, and those not of the selected master or not of
+//  domain 3 with its context.
+//****************************************************************************
+{
+    hashSamples++;
+    if ( sample->offset != -E2E_NS_TO_SCALED( hashOffsets[hashMaster]) ||
+         domainNumber != 3 || context != &hashSamples)
+    {
+        hashWrong++;
+    }
+}
+
+//****************************************************************************
+static NS_BOOL
+    HashReceive(
+        NS_UINT8 *message,
+        NS_UINT length,
+        NS_BOOL event)
+//  Passes a received message on, an event message timestamped by the
+//  simulated PHY unless PTP_RXHASH filters its source out.
+//****************************************************************************
+{
+NS_UINT hash;
+
+    if ( event)
+    {
+        hash = demuxPhy->pageRegs[6][(PHY_PG6_PTP_RXHASH & 0x1F) - 0x14];
+        if ( !(hash & P640_RX_HASH_EN) || (hash & 0xFFF) == PTPCalcSourceIdHash( &message[20]))
+        {
+            EPLSimReceive( demuxPhy, message - 14, 14 + length);
+            hashTimestamped++;
+        }
+        else
+        {
+            hashSuppressed++;
+        }
+    }
+    return EPLDemuxReceive( &demux, message, length, NULL) != NS_STATUS_FAILURE;
+}
+
+//****************************************************************************
+static NS_BOOL
+    HashExchange(
+        NS_UINT sequenceId,
+        NS_UINT numMasters)
+//  A two-step Sync, Follow_Up and Announce of each master, then a Delay_Req
+//  answered by both masters.
+//****************************************************************************
+{
+NS_UINT8 frame[128], *message;
+NS_UINT64 syncTime, delayReqTime;
+NS_UINT master;
+
+    for ( master = 1; master <= numMasters; master++)
+    {
+        syncTime = EPLSimGetPhyTime( demuxPhy);
+        message = DemuxMessage( frame, PTP_MSG_SYNC, 3, sequenceId, master);
+        message[6] = PTP_FLAG_TWO_STEP;
+        EXPECT( HashReceive( message, 44, TRUE));
+        EPLSimAdvanceTime( 20000);
+        message = DemuxMessage( frame, PTP_MSG_FOLLOW_UP, 3, sequenceId, master);
+        DemuxTimestamp( &message[34], syncTime + hashOffsets[master]);
+        EXPECT( HashReceive( message, 44, FALSE));
+        message = DemuxMessage( frame, PTP_MSG_ANNOUNCE, 3, sequenceId, master);
+        EXPECT( HashReceive( message, 64, FALSE));
+    }
+
+    message = DemuxMessage( frame, PTP_MSG_DELAY_REQ, 3, sequenceId, 0);
+    memcpy( &message[20], demuxPortIdentity, PTP_PORT_ID_LENGTH);
+    delayReqTime = EPLSimGetPhyTime( demuxPhy);
+    EPLSimTransmit( demuxPhy, frame, 14 + 44);
+    EPLDemuxTransmitted( &demux, message);
+    EPLSimAdvanceTime( 20000);
+    EPLDemuxService( &demux);
+    for ( master = 1; master <= 2; master++)
+    {
+        message = DemuxMessage( frame, PTP_MSG_DELAY_RESP, 3, sequenceId, master);
+        DemuxTimestamp( &message[34], delayReqTime + hashOffsets[master]);
+        memcpy( &message[44], demuxPortIdentity, PTP_PORT_ID_LENGTH);
+        EXPECT( HashReceive( message, 54, FALSE));
+    }
+    return TRUE;
+}
+
+//****************************************************************************
+static NS_BOOL
+    CheckHash( void)
+//  Two masters in domain 3, with the hash filter managed and held off for
+//  500 ms after a change: master 1 selected, selected again, cleared with
+//  only master 1 left, then master 2 selected. Every sample must come from
+//  the selected master, the filter must be off during each hold and pass
+//  only the selected master after it, PTP_RXHASH must be written once per
+//  change and the page 5 receive configuration left alone. What the filter
+//  kept out must match what the PHY did not timestamp, and nothing may be
+//  left queued.
+//****************************************************************************
+{
+static EPL_TSD tsd;
+EPL_TSD_CFG config;
+RX_CFG_ITEMS rxCfgItems;
+PEPL_PORT_HANDLE port;
+PEPL_DEMUX_DOMAIN domain;
+NS_UINT8 masterIdentity[PTP_PORT_ID_LENGTH];
+NS_UINT16 page5[0x0C], hash;
+NS_UINT phase, x, sequenceId = 0;
+
+    port = AddPort( 0);
+    demuxPhy = EPLSimGetPhy( 1);
+    EPLSimAdvanceTime( 1000000000ULL * 5000 + 77);
+    memset( &rxCfgItems, 0, sizeof( rxCfgItems));
+    rxCfgItems.ptpVersion = 2;
+    PTPEnable( port, TRUE);
+    PTPSetTransmitConfig( port, TXOPT_TS_EN | TXOPT_L2_EN, 2, 0, 0);
+    PTPSetReceiveConfig( port, RXOPT_RX_TS_EN | RXOPT_RX_L2_EN, &rxCfgItems);
+    EPLTsdGetDefaultConfig( &config);
+    EXPECT( EPLTsdInit( &tsd, port, &config, NULL, NULL) == NS_STATUS_SUCCESS);
+    EPLDemuxInit( &demux, port, &tsd, (NS_UINT8 *)demuxPortIdentity);
+    EXPECT( EPLDemuxAddDomain( &demux, 3, HashSample, &hashSamples) == NS_STATUS_SUCCESS);
+    EPLDemuxSetMasterFilter( &demux, TRUE, 500000);
+    memcpy( page5, demuxPhy->pageRegs[5], sizeof( page5));
+
+    hashSamples = hashWrong = hashTimestamped = hashSuppressed = 0;
+    for ( phase = 0; phase < 4; phase++)
+    {
+        hashMaster = phase == 3 ? 2 : 1;
+        for ( x = 0; x < PTP_PORT_ID_LENGTH; x++)
+            masterIdentity[x] = (NS_UINT8)(x * 7 + hashMaster);
+        EXPECT( EPLDemuxSelectMaster( &demux, 3, masterIdentity) == NS_STATUS_SUCCESS);
+        if ( phase == 2)
+            EXPECT( EPLDemuxSelectMaster( &demux, 3, NULL) == NS_STATUS_SUCCESS);
+
+        for ( x = 0; x < 200; x++)
+        {
+            EXPECT( HashExchange( sequenceId++, phase == 2 ? 1 : 2));
+            EPLSimAdvanceTime( 10000000);
+            EPLDemuxService( &demux);
+
+            // About 10 ms an exchange
+            hash = demuxPhy->pageRegs[6][(PHY_PG6_PTP_RXHASH & 0x1F) - 0x14];
+            if ( phase == 2 || (phase != 1 && x < 45))
+            {
+                EXPECT( !(hash & P640_RX_HASH_EN) && !(port->rxConfigOptions & RXOPT_SRC_ID_HASH_EN));
+            }
+            else if ( phase == 1 || x > 55)
+            {
+                EXPECT( hash == (P640_RX_HASH_EN | PTPCalcSourceIdHash( masterIdentity)));
+                EXPECT( port->rxConfigOptions & RXOPT_SRC_ID_HASH_EN);
+            }
+        }
+    }
+
+    // The first exchange only measures the delay
+    domain = EPLDemuxGetDomain( &demux, 3);
+    EXPECT( hashSamples == 799 && !hashWrong);
+    EXPECT( domain->masterChanges == 3 && domain->numForeign == 2);
+    EXPECT( demux.hashWrites == 3);
+    EXPECT( demux.suppressed == hashSuppressed && hashSuppressed == 504);
+    EXPECT( !memcmp( page5, demuxPhy->pageRegs[5], sizeof( page5)));
+    EXPECT( !tsd.rxCount && !tsd.txCount && !tsd.discarded && !demuxPhy->rxTs.count);
+
+    printf( "%u samples all of the selected master, %u Syncs filtered out, %u hash writes\n",
+            hashSamples, hashSuppressed, (unsigned)demux.hashWrites);
+    return TRUE;
+}
+
+#ifdef EPL_TRACE_ENABLE
+//****************************************************************************
+static NS_BOOL
+    CheckTrace( void)
+//  50 servo iterations (clock read, event poll, rate write, and an event
+//  read every tenth) traced and decoded from the ring: every call must be
+//  an enter/exit pair that nothing nests in, its register records must be
+//  the MDIO transactions the port counted for it, and its latency must be
+//  their duration on the simulated bus.
+//****************************************************************************
+{
+PEPL_PORT_HANDLE port;
+PEPL_TRACE_RING ring;
+EPL_TRACE_RECORD *record;
+NS_UINT32 seconds, nanoSeconds, mdio[EPL_TRACE_NUM_IDS], traced[EPL_TRACE_NUM_IDS];
+NS_UINT32 calls[EPL_TRACE_NUM_IDS], count, enterTime;
+NS_UINT eventBits, riseFlags, missed, x, api, apiMdio;
+
+    port = AddPort( 0);
+    PTPEnable( port, TRUE);
+    EPLTraceReset();
+    memset( mdio, 0, sizeof( mdio));
+    for ( x = 0; x < 50; x++)
+    {
+        count = port->mdioAccessCount;
+        PTPClockReadCurrent( port, &seconds, &nanoSeconds);
+        mdio[EPL_TRACE_ID_PTPClockReadCurrent] += port->mdioAccessCount - count;
+        count = port->mdioAccessCount;
+        PTPCheckForEvents( port);
+        mdio[EPL_TRACE_ID_PTPCheckForEvents] += port->mdioAccessCount - count;
+        count = port->mdioAccessCount;
+        PTPClockSetRateAdjustment( port, 1000 + x, FALSE, TRUE);
+        mdio[EPL_TRACE_ID_PTPClockSetRateAdjustment] += port->mdioAccessCount - count;
+        if ( x % 10 == 0)
+        {
+            count = port->mdioAccessCount;
+            PTPGetEvent( port, &eventBits, &riseFlags, &seconds, &nanoSeconds, &missed);
+            mdio[EPL_TRACE_ID_PTPGetEvent] += port->mdioAccessCount - count;
+        }
+        EPLSimAdvanceTime( 1000000);
+    }
+
+    ring = EPLTraceGetRing();
+    EXPECT( ring->magic == EPL_TRACE_MAGIC && ring->head <= ring->numRecords);
+    memset( traced, 0, sizeof( traced));
+    memset( calls, 0, sizeof( calls));
+    api = EPL_TRACE_ID_None;
+    apiMdio = 0;
+    enterTime = 0;
+    for ( x = 0; x < ring->head; x++)
+    {
+        record = &ring->records[x];
+        EXPECT( record->seq == (NS_UINT16)x && record->port == 1);
+        if ( record->type == EPL_TRACE_API_ENTER)
+        {
+            EXPECT( api == EPL_TRACE_ID_None);
+            api = record->callerId;
+            apiMdio = 0;
+            enterTime = record->timeStamp;
+        }
+        else if ( record->type == EPL_TRACE_API_EXIT)
+        {
+            EXPECT( record->callerId == api);
+            // One simulated MDIO frame per transaction, microsecond stamps
+            EXPECT( record->timeStamp - enterTime >= apiMdio * EPL_SIM_MDIO_FRAME_NS / 1000 &&
+                    record->timeStamp - enterTime <= apiMdio * EPL_SIM_MDIO_FRAME_NS / 1000 + 1);
+            calls[api]++;
+            api = EPL_TRACE_ID_None;
+        }
+        else
+        {
+            EXPECT( record->callerId == api && api != EPL_TRACE_ID_None);
+            traced[api]++;
+            apiMdio++;
+        }
+    }
+    for ( x = 0; x < EPL_TRACE_NUM_IDS; x++)
+        EXPECT( traced[x] == mdio[x]);
+    EXPECT( calls[EPL_TRACE_ID_PTPClockReadCurrent] == 50 && calls[EPL_TRACE_ID_PTPGetEvent] == 5);
+
+    printf( "%lu records; MDIO per call: read %lu, poll %lu, rate %lu, event %lu\n",
+            (unsigned long)ring->head, (unsigned long)traced[EPL_TRACE_ID_PTPClockReadCurrent] / 50,
+            (unsigned long)traced[EPL_TRACE_ID_PTPCheckForEvents] / 50,
+            (unsigned long)traced[EPL_TRACE_ID_PTPClockSetRateAdjustment] / 50,
+            (unsigned long)traced[EPL_TRACE_ID_PTPGetEvent] / 5);
+    return TRUE;
+}
+#endif
+
+static const CHECK checks[] = {
+    { "tdr",        CheckTdr },
+    { "quality",    CheckLinkQuality },
+    { "errcnt",     CheckErrorCounters },
+    { "mdio",       CheckMdioScheduler },
+#ifdef EPL_TRACE_ENABLE
+    { "trace",      CheckTrace },
+#endif
+    { "e2e",        CheckE2E },
+    { "p2p",        CheckP2P },
+    { "tc",         CheckTransparentClock },
+    { "bsync",      CheckBoardSync },
+    { "xts",        CheckCrossTimestamp },
+    { "onestep",    CheckOneStep },
+    { "extend",     CheckExtend },
+    { "batch",      CheckBatch },
+    { "slew",       CheckSlew },
+    { "holdover",   CheckHoldover },
+    { "stability",  CheckStability },
+    { "pdv",        CheckPdv },
+    { "phc",        CheckPhc },
+    { "tsd",        CheckTsd },
+    { "demux",      CheckDemux },
+    { "hash",       CheckHash },
+};
+
+//****************************************************************************
+int
+    main(
+        int argc,
+        char **argv)
+//****************************************************************************
+{
+NS_UINT x, failures = 0, run = 0;
+int y;
+
+    for ( y = 1; y < argc; y++)
+    {
+        for ( x = 0; x < sizeof( checks) / sizeof( checks[0]) && strcmp( argv[y], checks[x].name); x++)
+            ;
+        if ( x == sizeof( checks) / sizeof( checks[0]))
+        {
+            printf( "unknown check %s\n", argv[y]);
+            return 1;
+        }
+    }
+
+    OAIInitialize( &oaiDev);
+    for ( x = 0; x < sizeof( checks) / sizeof( checks[0]); x++)
+    {
+        for ( y = 1; y < argc && strcmp( argv[y], checks[x].name); y++)
+            ;
+        if ( argc > 1 && y == argc)
+            continue;
+
+        printf( "%-10s ", checks[x].name);
+        fflush( stdout);
+        EPLSimReset();
+        if ( !checks[x].run())
+            failures++;
+        run++;
+    }
+    printf( "%u checks, %u failed\n", (unsigned)run, (unsigned)failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,413 @@
+//****************************************************************************
+// epl_timebench.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// PTP_TIME arithmetic (epl_time.h) benchmark.
+//
+// Times the PTP_TIME operations against the separate seconds/nanoseconds
+// carry code they replaced in epl_1588.c, on random times so the carries
+// are unpredictable, and checks that both give the same results. Old and
+// new code run in alternating trials and the fastest trial of each is
+// reported, so a busy host slows both alike:
+//
+//      add/sub     PTPClockStepAdjustment() reference update
+//      event       PTPGetEvent() pin input delay borrow and clamp
+//      compare     seconds then nanoseconds compare
+//      extend      PTPExtendTimestamp() seconds reconstruction, both with
+//                  the reference update and multi critical section of
+//                  the current API
+//
+// Build:
+//      cc -O2 -DEPL_SIMULATION -I../inc -o epl_timebench epl_timebench.c ../src/*.c
+//
+// Usage:
+//      epl_timebench [rounds]
+//****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "epl/epl.h"
+
+#define BENCH_COUNT             4096
+#define BENCH_TRIALS            50
+#define BENCH_NOINLINE          __attribute__((noinline))
+
+static NS_UINT64 benchSeed = 0x9E3779B97F4A7C15ULL;
+static PORT_OBJ benchPort;
+static NS_UINT benchBits;
+static PTP_TIME times[BENCH_COUNT], steps[BENCH_COUNT], newResult[BENCH_COUNT];
+static NS_UINT64 oldSeconds[BENCH_COUNT];
+static NS_UINT32 oldNanoSeconds[BENCH_COUNT];
+static NS_UINT8 negative[BENCH_COUNT];
+static NS_UINT32 partial[BENCH_COUNT];
+static NS_SINT newCompare[BENCH_COUNT], oldCompare[BENCH_COUNT];
+static NS_UINT64 newExtend[BENCH_COUNT], oldExtend[BENCH_COUNT];
+
+//****************************************************************************
+static NS_UINT64
+    Random(
+        void)
+//  xorshift64
+//****************************************************************************
+{
+    benchSeed ^= benchSeed << 13;
+    benchSeed ^= benchSeed >> 7;
+    benchSeed ^= benchSeed << 17;
+    return benchSeed;
+}
+
+//****************************************************************************
+static BENCH_NOINLINE void
+    OldStep(
+        void)
+//  Pre-PTP_TIME PTPClockStepAdjustment() reference update.
+//****************************************************************************
+{
+NS_UINT x;
+
+    for ( x = 0; x < BENCH_COUNT; x++)
+    {
+        oldSeconds[x] = (NS_UINT64)times[x].seconds;
+        oldNanoSeconds[x] = (NS_UINT32)times[x].nanoSeconds;
+        if ( negative[x])
+        {
+            oldSeconds[x] -= (NS_UINT64)-steps[x].seconds;
+            if ( oldNanoSeconds[x] < (NS_UINT32)-steps[x].nanoSeconds)
+            {
+                oldNanoSeconds[x] += 1000000000;
+                oldSeconds[x]--;
+            }
+            oldNanoSeconds[x] -= (NS_UINT32)-steps[x].nanoSeconds;
+        }
+        else
+        {
+            oldSeconds[x] += (NS_UINT64)steps[x].seconds;
+            oldNanoSeconds[x] += (NS_UINT32)steps[x].nanoSeconds;
+            if ( oldNanoSeconds[x] >= 1000000000)
+            {
+                oldNanoSeconds[x] -= 1000000000;
+                oldSeconds[x]++;
+            }
+        }
+    }
+}
+
+//****************************************************************************
+static BENCH_NOINLINE void
+    NewStep(
+        void)
+//****************************************************************************
+{
+NS_UINT x;
+
+    for ( x = 0; x < BENCH_COUNT; x++)
+        PTPTimeAdd( &newResult[x], &times[x], &steps[x]);
+}
+
+//****************************************************************************
+static BENCH_NOINLINE void
+    OldEvent(
+        void)
+//  Pre-PTP_TIME PTPGetEvent() input delay adjustment.
+//****************************************************************************
+{
+NS_UINT x;
+
+    for ( x = 0; x < BENCH_COUNT; x++)
+    {
+        oldSeconds[x] = (NS_UINT64)times[x].seconds & 0x3;
+        oldNanoSeconds[x] = (NS_UINT32)times[x].nanoSeconds % 70;
+        if( oldNanoSeconds[x] < PIN_INPUT_DELAY )
+        {
+            if( oldSeconds[x] > 0 )
+            {
+                oldSeconds[x] -= 1;
+                oldNanoSeconds[x] += ((NS_UINT)1e9 - PIN_INPUT_DELAY);
+            }
+            else
+                oldSeconds[x] = oldNanoSeconds[x] = 0;
+        }
+        else
+            oldNanoSeconds[x] -= PIN_INPUT_DELAY;
+    }
+}
+
+//****************************************************************************
+static BENCH_NOINLINE void
+    NewEvent(
+        void)
+//****************************************************************************
+{
+PTP_TIME inputDelay = { 0, PIN_INPUT_DELAY};
+NS_UINT x;
+
+    for ( x = 0; x < BENCH_COUNT; x++)
+    {
+        newResult[x].seconds = times[x].seconds & 0x3;
+        newResult[x].nanoSeconds = (NS_SINT32)((NS_UINT32)times[x].nanoSeconds % 70);
+        PTPTimeSub( &newResult[x], &newResult[x], &inputDelay);
+        if ( newResult[x].seconds < 0)
+            newResult[x].seconds = newResult[x].nanoSeconds = 0;
+    }
+}
+
+//****************************************************************************
+static BENCH_NOINLINE void
+    OldCompareAll(
+        void)
+//  Seconds, then nanoseconds compare of separate fields.
+//****************************************************************************
+{
+NS_UINT x, y;
+
+    for ( x = 0; x < BENCH_COUNT; x++)
+    {
+        y = (x + 1) % BENCH_COUNT;
+        if ( times[x].seconds < times[y].seconds)
+            oldCompare[x] = -1;
+        else if ( times[x].seconds > times[y].seconds)
+            oldCompare[x] = 1;
+        else if ( times[x].nanoSeconds < times[y].nanoSeconds)
+            oldCompare[x] = -1;
+        else if ( times[x].nanoSeconds > times[y].nanoSeconds)
+            oldCompare[x] = 1;
+        else
+            oldCompare[x] = 0;
+    }
+}
+
+//****************************************************************************
+static BENCH_NOINLINE void
+    NewCompareAll(
+        void)
+//****************************************************************************
+{
+NS_UINT x;
+
+    for ( x = 0; x < BENCH_COUNT; x++)
+        newCompare[x] = PTPTimeCompare( &times[x], &times[(x + 1) % BENCH_COUNT]);
+}
+
+//****************************************************************************
+static BENCH_NOINLINE NS_STATUS
+    OldExtendTimestamp(
+        PEPL_PORT_HANDLE portHandle,
+        NS_UINT32 partialSeconds,
+        NS_UINT secondsBits,
+        NS_UINT32 nanoSeconds,
+        NS_UINT64 *retNumberOfSeconds)
+//  Pre-PTP_TIME seconds reconstruction of epl_1588.c, with the locking of
+//  the current PTPExtendTimestamp().
+//****************************************************************************
+{
+NS_UINT64 refSeconds, mask;
+NS_UINT32 refNanoSeconds;
+NS_SINT64 period, delta;
+
+    if ( secondsBits > 32)
+        return NS_STATUS_INVALID_PARM;
+    OAIBeginMultiCriticalSection( portHandle->oaiDevHandle);
+    if ( !portHandle->tsRefValid)
+    {
+        OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
+        return NS_STATUS_FAILURE;
+    }
+    refSeconds = (NS_UINT64)portHandle->tsRef.seconds;
+    refNanoSeconds = (NS_UINT32)portHandle->tsRef.nanoSeconds;
+
+    mask = ((NS_UINT64)1 << secondsBits) - 1;
+    period = (NS_SINT64)(mask + 1) * 1000000000;
+
+    delta = (NS_SINT64)(((NS_UINT64)partialSeconds - refSeconds) & mask) * 1000000000 +
+            (NS_SINT64)nanoSeconds - (NS_SINT64)refNanoSeconds;
+    while ( delta >= period / 2)
+        delta -= period;
+    while ( delta < -(period / 2))
+        delta += period;
+
+    delta += (NS_SINT64)refNanoSeconds - (NS_SINT64)nanoSeconds;
+    *retNumberOfSeconds = (refSeconds + delta / 1000000000) & 0xFFFFFFFFFFFFULL;
+    portHandle->tsRef.seconds = (NS_SINT64)*retNumberOfSeconds;
+    portHandle->tsRef.nanoSeconds = (NS_SINT32)nanoSeconds;
+    OAIEndMultiCriticalSection( portHandle->oaiDevHandle);
+    return NS_STATUS_SUCCESS;
+}
+
+//****************************************************************************
+static BENCH_NOINLINE void
+    OldExtendAll(
+        void)
+//****************************************************************************
+{
+NS_UINT x;
+
+    PTPSetTimestampReference( &benchPort, (NS_UINT64)times[0].seconds,
+                              (NS_UINT32)times[0].nanoSeconds);
+    for ( x = 0; x < BENCH_COUNT; x++)
+        OldExtendTimestamp( &benchPort, partial[x], benchBits,
+                            (NS_UINT32)steps[x].nanoSeconds, &oldExtend[x]);
+}
+
+//****************************************************************************
+static BENCH_NOINLINE void
+    NewExtendAll(
+        void)
+//****************************************************************************
+{
+NS_UINT x;
+
+    PTPSetTimestampReference( &benchPort, (NS_UINT64)times[0].seconds,
+                              (NS_UINT32)times[0].nanoSeconds);
+    for ( x = 0; x < BENCH_COUNT; x++)
+        PTPExtendTimestamp( &benchPort, partial[x], benchBits,
+                            (NS_UINT32)steps[x].nanoSeconds, &newExtend[x]);
+}
+
+//****************************************************************************
+static void
+    Time(
+        void (*oldRun)( void),
+        void (*newRun)( void),
+        NS_UINT rounds,
+        clock_t *oldTicks,
+        clock_t *newTicks)
+//  Runs the old and new code rounds times each, in BENCH_TRIALS alternating
+//  trials, and returns the fastest trial of each scaled to rounds.
+//****************************************************************************
+{
+clock_t start, ticks;
+NS_UINT trial, y, trialRounds = (rounds + BENCH_TRIALS - 1) / BENCH_TRIALS;
+
+    *oldTicks = *newTicks = 0;
+    for ( trial = 0; trial < BENCH_TRIALS; trial++)
+    {
+        start = clock();
+        for ( y = 0; y < trialRounds; y++)
+            oldRun();
+        ticks = clock() - start;
+        if ( !trial || ticks < *oldTicks)
+            *oldTicks = ticks;
+
+        start = clock();
+        for ( y = 0; y < trialRounds; y++)
+            newRun();
+        ticks = clock() - start;
+        if ( !trial || ticks < *newTicks)
+            *newTicks = ticks;
+    }
+    *oldTicks = *oldTicks * rounds / trialRounds;
+    *newTicks = *newTicks * rounds / trialRounds;
+}
+
+//****************************************************************************
+static void
+    Report(
+        const char *name,
+        clock_t oldTicks,
+        clock_t newTicks,
+        NS_UINT rounds,
+        NS_UINT errors)
+//****************************************************************************
+{
+double count = (double)BENCH_COUNT * rounds;
+
+    printf( "%-12s old %6.2f ns  new %6.2f ns  %5.2fx  %s\n", name,
+            oldTicks * 1e9 / CLOCKS_PER_SEC / count, newTicks * 1e9 / CLOCKS_PER_SEC / count,
+            newTicks ? (double)oldTicks / newTicks : 0, errors ? "MISMATCH" : "ok");
+}
+
+//****************************************************************************
+int
+    main(
+        int argc,
+        char **argv)
+//****************************************************************************
+{
+static OAI_DEV_HANDLE_STRUCT oaiDev;
+NS_UINT rounds, x, y, errors, total = 0;
+NS_UINT secondsBits[] = { 8, 16, 32};
+char name[16];
+clock_t oldTicks, newTicks;
+
+    rounds = (argc > 1) ? (NS_UINT)strtoul( argv[1], NULL, 0) : 20000;
+
+    benchPort.oaiDevHandle = &oaiDev;
+    benchPort.portMdioAddress = 1;
+
+    for ( x = 0; x < BENCH_COUNT; x++)
+    {
+        times[x].seconds = (NS_SINT64)(Random() % 0xFFFF00000000ULL) + 0x10000;
+        times[x].nanoSeconds = (NS_SINT32)(Random() % PTP_NS_PER_SEC);
+        negative[x] = (NS_UINT8)(Random() & 1);
+        steps[x].seconds = (NS_SINT64)(Random() % 1000);
+        steps[x].nanoSeconds = (NS_SINT32)(Random() % PTP_NS_PER_SEC);
+        if ( negative[x])
+        {
+            steps[x].seconds = -steps[x].seconds;
+            steps[x].nanoSeconds = -steps[x].nanoSeconds;
+        }
+    }
+
+    // add/sub
+    Time( OldStep, NewStep, rounds, &oldTicks, &newTicks);
+    for ( x = errors = 0; x < BENCH_COUNT; x++)
+        if ( oldSeconds[x] != (NS_UINT64)newResult[x].seconds ||
+             oldNanoSeconds[x] != (NS_UINT32)newResult[x].nanoSeconds)
+            errors++;
+    Report( "add/sub", oldTicks, newTicks, rounds, errors);
+    total += errors;
+
+    // event
+    Time( OldEvent, NewEvent, rounds, &oldTicks, &newTicks);
+    for ( x = errors = 0; x < BENCH_COUNT; x++)
+        if ( oldSeconds[x] != (NS_UINT64)newResult[x].seconds ||
+             oldNanoSeconds[x] != (NS_UINT32)newResult[x].nanoSeconds)
+            errors++;
+    Report( "event", oldTicks, newTicks, rounds, errors);
+    total += errors;
+
+    // compare, half of the pairs with equal seconds
+    for ( x = 0; x < BENCH_COUNT; x += 2)
+        times[x].seconds = times[(x + 1) % BENCH_COUNT].seconds;
+    Time( OldCompareAll, NewCompareAll, rounds, &oldTicks, &newTicks);
+    for ( x = errors = 0; x < BENCH_COUNT; x++)
+        if ( (oldCompare[x] > 0) != (newCompare[x] > 0) ||
+             (oldCompare[x] < 0) != (newCompare[x] < 0))
+            errors++;
+    Report( "compare", oldTicks, newTicks, rounds, errors);
+    total += errors;
+
+    // extend, timestamps up to +/- 1/4 wrap period apart
+    for ( y = 0; y < sizeof( secondsBits) / sizeof( secondsBits[0]); y++)
+    {
+        for ( x = 0; x < BENCH_COUNT; x++)
+        {
+            times[x].seconds = (x == 0) ? (NS_SINT64)0x123400000000ULL :
+                               (NS_SINT64)oldExtend[x - 1];
+            times[x].seconds += (NS_SINT64)(Random() % (1ULL << (secondsBits[y] - 2))) -
+                                (NS_SINT64)(1ULL << (secondsBits[y] - 3));
+            partial[x] = (NS_UINT32)times[x].seconds;
+            steps[x].nanoSeconds = (NS_SINT32)(Random() % PTP_NS_PER_SEC);
+            oldExtend[x] = (NS_UINT64)times[x].seconds;
+        }
+        times[0].seconds = (NS_SINT64)0x123400000000ULL;
+        times[0].nanoSeconds = 0;
+
+        benchBits = secondsBits[y];
+        Time( OldExtendAll, NewExtendAll, rounds, &oldTicks, &newTicks);
+        for ( x = errors = 0; x < BENCH_COUNT; x++)
+            if ( oldExtend[x] != newExtend[x])
+                errors++;
+        sprintf( name, "extend %u", secondsBits[y]);
+        Report( name, oldTicks, newTicks, rounds, errors);
+        total += errors;
+    }
+
+    printf( "results           %s\n", total ? "FAILED" : "identical");
+    return total ? 1 : 0;
+}
@@ -0,0 +1,287 @@
+//****************************************************************************
+// epl_tracedec.c
+//
+// Copyright (c) 2026 ti-epl contributors
+// Not part of the original National Semiconductor EPL distribution
+//
+// Host side decoder for EPL register trace dumps (see epl_trace.h).
+//
+// The input is a binary image of the EPL_TRACE_RING, obtained either from
+// EPLTraceGetRing() in a host build or by dumping the eplTraceRing symbol
+// from the target, e.g. in gdb:
+//
+//      dump binary value trace.bin eplTraceRing
+//
+// Build:
+//      cc -O2 -I../inc -o epl_tracedec epl_tracedec.c
+//
+// Usage:
+//      epl_tracedec [-t] trace.bin
+//
+// Prints a latency histogram and MDIO transaction count for every traced
+// API entry point, followed by the MDIO transactions per caller. With -t
+// the decoded MDIO timeline is printed first.
+//****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "epl/epl_trace_ids.h"
+
+// Must match EPL_TRACE_RECORD / EPL_TRACE_RING (little endian, 32-bit int)
+typedef struct TRACE_RECORD {
+    uint32_t timeStamp;
+    uint16_t seq;
+    uint16_t value;
+    uint8_t type;
+    uint8_t port;
+    uint8_t page;
+    uint8_t reg;
+    uint16_t callerId;
+    uint16_t reserved;
+} TRACE_RECORD;
+
+typedef struct TRACE_HEADER {
+    uint32_t magic;
+    uint32_t numRecords;
+    uint32_t recordSize;
+    uint32_t timeUnitNs;
+    uint32_t head;
+} TRACE_HEADER;
+
+#define TRACE_MAGIC         0x544C5045
+#define TRACE_REG_READ      0
+#define TRACE_REG_WRITE     1
+#define TRACE_API_ENTER     2
+#define TRACE_API_EXIT      3
+
+#define MAX_PORTS           32
+#define NUM_BUCKETS         24      // Powers of 2 microseconds
+
+#define TRACE_ID_NAME(name) #name,
+static const char *idNames[] = { EPL_TRACE_ID_LIST(TRACE_ID_NAME) };
+#define NUM_IDS             (sizeof( idNames) / sizeof( idNames[0]))
+
+typedef struct API_STATS {
+    uint32_t calls;
+    uint64_t totalNs;
+    uint64_t minNs;
+    uint64_t maxNs;
+    uint64_t mdioOps;
+    uint32_t buckets[NUM_BUCKETS];
+} API_STATS;
+
+typedef struct OPEN_CALL {
+    int active;
+    unsigned id;
+    uint32_t start;
+    uint32_t mdioOps;
+} OPEN_CALL;
+
+static API_STATS apiStats[NUM_IDS];
+static uint64_t mdioByCaller[NUM_IDS];
+static OPEN_CALL openCalls[MAX_PORTS];
+
+//****************************************************************************
+static const char *
+    IdName (
+        unsigned id)
+//****************************************************************************
+{
+    return (id < NUM_IDS) ? idNames[id] : "?";
+}
+
+//****************************************************************************
+static void
+    RecordCall (
+        OPEN_CALL *call,
+        uint32_t endTime,
+        uint32_t timeUnitNs)
+//  Folds a completed API call into the per API statistics.
+//****************************************************************************
+{
+API_STATS *stats = &apiStats[call->id];
+uint64_t ns, us;
+unsigned bucket;
+
+    ns = (uint64_t)(uint32_t)(endTime - call->start) * timeUnitNs;
+    if ( stats->calls == 0 || ns < stats->minNs)
+        stats->minNs = ns;
+    if ( ns > stats->maxNs)
+        stats->maxNs = ns;
+    stats->calls++;
+    stats->totalNs += ns;
+    stats->mdioOps += call->mdioOps;
+
+    us = ns / 1000;
+    for ( bucket = 0; us && bucket < NUM_BUCKETS - 1; bucket++)
+        us >>= 1;
+    stats->buckets[bucket]++;
+}
+
+//****************************************************************************
+static void
+    PrintHistograms (
+        void)
+//****************************************************************************
+{
+API_STATS *stats;
+unsigned id, bucket, first, last;
+
+    printf( "%-30s %8s %10s %10s %10s %8s\n", "API", "calls", "min us", "avg us", "max us", "MDIO/call");
+    for ( id = 1; id < NUM_IDS; id++)
+    {
+        stats = &apiStats[id];
+        if ( !stats->calls)
+            continue;
+        printf( "%-30s %8u %10.1f %10.1f %10.1f %8.1f\n", idNames[id], stats->calls,
+                stats->minNs / 1000.0, stats->totalNs / 1000.0 / stats->calls,
+                stats->maxNs / 1000.0, (double)stats->mdioOps / stats->calls);
+
+        for ( first = 0; !stats->buckets[first]; first++)
+            ;
+        for ( last = NUM_BUCKETS; !stats->buckets[last - 1]; last--)
+            ;
+        for ( bucket = first; bucket < last; bucket++)
+        {
+            if ( bucket == 0)
+                printf( "    %10s  < 1us ", "");
+            else
+                printf( "    %6luus - %6luus ", 1UL << (bucket - 1), (1UL << bucket) - 1);
+            printf( "%8u ", stats->buckets[bucket]);
+            printf( "%.*s\n", (int)(stats->buckets[bucket] * 40 / stats->calls),
+                    "****************************************");
+        }
+    }
+
+    printf( "\nMDIO transactions by caller\n");
+    for ( id = 0; id < NUM_IDS; id++)
+    {
+        if ( mdioByCaller[id])
+            printf( "    %-30s %10llu\n", id ? idNames[id] : "(outside traced API)",
+                    (unsigned long long)mdioByCaller[id]);
+    }
+}
+
+//****************************************************************************
+int
+    main (
+        int argc,
+        char **argv)
+//****************************************************************************
+{
+TRACE_HEADER hdr;
+TRACE_RECORD *records, *rec;
+OPEN_CALL *call;
+FILE *file;
+const char *path;
+uint32_t count, x, idx, prevTime;
+unsigned long dropped;
+int timeline;
+
+    timeline = 0;
+    path = NULL;
+    for ( x = 1; x < (uint32_t)argc; x++)
+    {
+        if ( !strcmp( argv[x], "-t"))
+            timeline = 1;
+        else
+            path = argv[x];
+    }
+    if ( !path)
+    {
+        fprintf( stderr, "usage: %s [-t] trace.bin\n", argv[0]);
+        return 2;
+    }
+
+    file = fopen( path, "rb");
+    if ( !file || fread( &hdr, sizeof( hdr), 1, file) != 1)
+    {
+        fprintf( stderr, "%s: cannot read trace header\n", path);
+        return 1;
+    }
+    if ( hdr.magic != TRACE_MAGIC || hdr.recordSize != sizeof( TRACE_RECORD) ||
+         hdr.numRecords == 0 || (hdr.numRecords & (hdr.numRecords - 1)))
+    {
+        fprintf( stderr, "%s: not an EPL trace ring (or incompatible layout)\n", path);
+        return 1;
+    }
+
+    records = malloc( hdr.numRecords * sizeof( TRACE_RECORD));
+    if ( !records || fread( records, sizeof( TRACE_RECORD), hdr.numRecords, file) != hdr.numRecords)
+    {
+        fprintf( stderr, "%s: truncated trace\n", path);
+        return 1;
+    }
+    fclose( file);
+
+    count = (hdr.head < hdr.numRecords) ? hdr.head : hdr.numRecords;
+    printf( "%u records (%lu recorded, time unit %u ns)\n\n", count, (unsigned long)hdr.head, hdr.timeUnitNs);
+
+    dropped = 0;
+    prevTime = 0;
+    for ( x = 0; x < count; x++)
+    {
+        idx = hdr.head - count + x;
+        rec = &records[idx & (hdr.numRecords - 1)];
+        if ( rec->seq != (uint16_t)idx)
+        {
+            // Slot was still being written when the ring was captured
+            dropped++;
+            continue;
+        }
+
+        call = (rec->port < MAX_PORTS) ? &openCalls[rec->port] : NULL;
+        switch ( rec->type)
+        {
+        case TRACE_REG_READ:
+        case TRACE_REG_WRITE:
+            mdioByCaller[(rec->callerId < NUM_IDS) ? rec->callerId : 0]++;
+            if ( call && call->active)
+                call->mdioOps++;
+            if ( timeline)
+            {
+                printf( "%10lu %+7ld  port %2u  %s pg%-2d reg 0x%02X %s 0x%04X  [%s]\n",
+                        (unsigned long)rec->timeStamp, x ? (long)(int32_t)(rec->timeStamp - prevTime) : 0L,
+                        rec->port, (rec->type == TRACE_REG_READ) ? "RD" : "WR",
+                        (rec->page == 0xFF) ? -1 : rec->page, rec->reg,
+                        (rec->type == TRACE_REG_READ) ? "->" : "<-", rec->value, IdName( rec->callerId));
+            }
+            break;
+
+        case TRACE_API_ENTER:
+            if ( call && rec->callerId < NUM_IDS)
+            {
+                call->active = 1;
+                call->id = rec->callerId;
+                call->start = rec->timeStamp;
+                call->mdioOps = 0;
+            }
+            if ( timeline)
+                printf( "%10lu          port %2u  > %s\n", (unsigned long)rec->timeStamp, rec->port, IdName( rec->callerId));
+            break;
+
+        case TRACE_API_EXIT:
+            if ( call && call->active && call->id == rec->callerId)
+            {
+                RecordCall( call, rec->timeStamp, hdr.timeUnitNs);
+                call->active = 0;
+            }
+            if ( timeline)
+                printf( "%10lu          port %2u  < %s\n", (unsigned long)rec->timeStamp, rec->port, IdName( rec->callerId));
+            break;
+        }
+        prevTime = rec->timeStamp;
+    }
+
+    if ( timeline)
+        printf( "\n");
+    if ( dropped)
+        printf( "%lu incomplete records skipped\n\n", dropped);
+
+    PrintHistograms();
+    free( records);
+    return 0;
+}